@@ -133,6 +133,13 @@ namespace Chroma
 	// This is now set automagically -- constructor initialisation
       }
 
+      if( in.count("InnerSolve/RsdCGSingle") == 1 ) {
+	read(in, "InnerSolve/RsdCGSingle", invParamInner.RsdCGSingle);
+      }
+      else {
+	invParamInner.RsdCGSingle = 1.0e-5;
+      }
+
       if( in.count("InnerSolve/SolverType") == 1 ) { 
 	read(in, "InnerSolve/SolverType", inner_solver_type);
       }
@@ -163,6 +170,7 @@ namespace Chroma
     write(xml_out, "MaxCG", p.invParamInner.MaxCG);
     write(xml_out, "RsdCG", p.invParamInner.RsdCG);
     write(xml_out, "ReorthFreq", p.ReorthFreqInner);
+    write(xml_out, "RsdCGSingle", p.invParamInner.RsdCGSingle);
     write(xml_out, "SolverType", p.inner_solver_type);
     write(xml_out, "ApproximationType", p.approximation_type);
     write(xml_out, "ApproxMin", p.approxMin);
@@ -880,7 +888,8 @@ namespace Chroma
 			    NEig, EigValFunc, state.getEvectors(),
 			    params.invParamInner.MaxCG, 
 			    params.invParamInner.RsdCG, 
-			    params.ReorthFreqInner);
+			    params.ReorthFreqInner,
+			    params.invParamInner.RsdCGSingle);
 	break;
       case OVERLAP_INNER_CG_DOUBLE_PASS:
 	return new lovlap_double_pass(*Mact, state_, m_q,
@@ -956,7 +965,8 @@ namespace Chroma
 	return new lovlapms(*Mact, state_, params.Mass,
 			    numroot, coeffP, resP, rootQ, 
 			    NEig, EigValFunc, state.getEvectors(),
-			    params.invParamInner.MaxCG, params.invParamInner.RsdCG, params.ReorthFreqInner);
+			    params.invParamInner.MaxCG, params.invParamInner.RsdCG, params.ReorthFreqInner,
+			    params.invParamInner.RsdCGSingle);
 	break;
       case OVERLAP_INNER_CG_DOUBLE_PASS:
 	return new lovlap_double_pass(*Mact, state_, params.Mass,
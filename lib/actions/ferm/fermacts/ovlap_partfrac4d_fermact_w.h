@@ -29,7 +29,8 @@ namespace Chroma
   /*! \ingroup fermacts */
   struct OvlapPartFrac4DFermActParams
   {
-    OvlapPartFrac4DFermActParams() : ReorthFreqInner(10), inner_solver_type(OVERLAP_INNER_CG_SINGLE_PASS) {};
+    OvlapPartFrac4DFermActParams() : ReorthFreqInner(10), inner_solver_type(OVERLAP_INNER_CG_SINGLE_PASS) 
+      {invParamInner.RsdCGSingle = 1.0e-5;}
     OvlapPartFrac4DFermActParams(XMLReader& in, const std::string& path);
     
     Real Mass;
@@ -47,6 +48,7 @@ namespace Chroma
     {
       Real RsdCG;
       int  MaxCG;
+      Real RsdCGSingle;  // Targets at least this loose store the shifted vectors in single precision
     } invParamInner;
     OverlapInnerSolverType inner_solver_type;
 
@@ -1,4 +1,6 @@
 #include "chromabase.h"
+#include "chroma_config.h"
+#include "actions/ferm/invert/ord_kernels_simd.h"
 #include <cstddef>
 
 namespace Chroma {
@@ -29,6 +31,67 @@ namespace Chroma {
       return _reduction_space;
     }
 
+
+    namespace
+    {
+      bool      _kernel_isa_set = false;
+      KernelISA _kernel_isa = KERNEL_ISA_BASE;
+    }
+
+    // The widest instruction set supported by this build and this CPU
+    KernelISA getMaxKernelISA()
+    {
+#ifdef CHROMA_ORD_KERNELS_SIMD
+      __builtin_cpu_init();
+
+      if (__builtin_cpu_supports("avx512f"))
+	return KERNEL_ISA_AVX512;
+
+      if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+	return KERNEL_ISA_AVX2;
+#endif
+
+      return KERNEL_ISA_BASE;
+    }
+
+    // The instruction set used by the kernels
+    KernelISA getKernelISA()
+    {
+      if (! _kernel_isa_set) { 
+	_kernel_isa = getMaxKernelISA();
+	_kernel_isa_set = true;
+      }
+
+      return _kernel_isa;
+    }
+
+    // Override the instruction set
+    void setKernelISA(KernelISA isa)
+    {
+      KernelISA max_isa = getMaxKernelISA();
+
+      _kernel_isa = (isa > max_isa) ? max_isa : isa;
+      _kernel_isa_set = true;
+    }
+
+    // Name of an instruction set
+    std::string kernelISAName(KernelISA isa)
+    {
+      switch (isa)
+      {
+      case KERNEL_ISA_AVX512:
+	return "AVX512";
+      case KERNEL_ISA_AVX2:
+	return "AVX2";
+      default:
+#ifdef BUILD_SSE_SCALARSITE_BICGSTAB
+	return "SSE";
+#else
+	return "GENERIC";
+#endif
+      }
+    }
+
  
   }
 }
@@ -2,6 +2,7 @@
 #define BICGSTAB_KERNELS_SCALARSITE_H
 #include "chromabase.h"
 #include "chroma_config.h"
+#include "actions/ferm/invert/ord_kernels_simd.h"
 
 /* The funky kernels used by BiCGStab.
    These versions should always work... */
@@ -46,7 +47,7 @@ namespace Chroma {
 	ord_xymz_normx_arg  arg={x_ptr,y_ptr,z_ptr,norms,4*3*2};
 	int len = (s.end()-s.start()+1);
 	
-	dispatch_to_threads(len,arg,ord_xymz_normx_kernel);
+	dispatch_to_threads(len,arg, ORD_KERNEL(ord_xymz_normx_kernel));
 	norm = norms[0];
 	// Sum the norms...
 	for(int i=1 ; i < qdpNumThreads(); i++) { 
@@ -97,7 +98,7 @@ namespace Chroma {
 	ord_yxpaymabz_arg arg={x_ptr,y_ptr,z_ptr,a_re,a_im, b_re, b_im,4*3*2};
 
 	int len = (s.end()-s.start()+1);
-	dispatch_to_threads(len,arg,ord_yxpaymabz_kernel);
+	dispatch_to_threads(len,arg, ORD_KERNEL(ord_yxpaymabz_kernel));
       }
       else {
 	QDPIO::cerr << "I only work for ordered subsets for now" << std::endl;
@@ -134,7 +135,7 @@ namespace Chroma {
 	  
 	  int len = (s.end()-s.start()+1);
 	  ord_norm2x_cdotxy_arg arg={x_ptr,y_ptr,norm_space,4*3*2};
-	  dispatch_to_threads(len,arg, ord_norm2x_cdotxy_kernel);
+	  dispatch_to_threads(len,arg, ORD_KERNEL(ord_norm2x_cdotxy_kernel));
 
 	  for(int i=0; i < 3*qdpNumThreads(); i+=3) { 
 	    norm_array[0] += norm_space[i];
@@ -192,7 +193,7 @@ namespace Chroma {
 	ord_xpaypbz_arg arg={x_ptr,y_ptr,z_ptr,a_re,a_im,b_re,b_im,4*3*2};
 
 	int len=(s.end()-s.start()+1);
-	dispatch_to_threads(len,arg, ord_xpaypbz_kernel);
+	dispatch_to_threads(len,arg, ORD_KERNEL(ord_xpaypbz_kernel));
       }
       else {
 	QDPIO::cerr << "I only work for ordered subsets for now" << std::endl;
@@ -243,7 +244,7 @@ namespace Chroma {
 
 
 	int len =(s.end()-s.start()+1);
-	dispatch_to_threads(len,arg,ord_xmay_normx_cdotzx_kernel);
+	dispatch_to_threads(len,arg, ORD_KERNEL(ord_xmay_normx_cdotzx_kernel));
 
 	for(int i=0; i < 3*qdpNumThreads(); i+=3) { 
 	  norm_array[0] += norm_space[i];
@@ -295,7 +296,7 @@ namespace Chroma {
 	ord_cxmayf_arg arg={x_ptr,y_ptr,a_re,a_im,4*3*2};
 
 	int len=(s.end()-s.start()+1);
-	dispatch_to_threads(len,arg, ord_cxmayf_kernel);
+	dispatch_to_threads(len,arg, ORD_KERNEL(ord_cxmayf_kernel));
       }
       else {
 	QDPIO::cerr << "I only work for ordered subsets for now" << std::endl;
@@ -381,7 +382,7 @@ namespace Chroma {
 					beta_re, beta_im, delta_re, delta_im,4*3*2};
 
 	  int len=(sub.end()-sub.start()+1);
-	  dispatch_to_threads(len,arg, ord_ib_zvupdates_kernel_real32);
+	  dispatch_to_threads(len,arg, ORD_KERNEL(ord_ib_zvupdates_kernel_real32));
       }
       else {
 	QDPIO::cerr << "I only work for ordered subsets for now" << std::endl;
@@ -436,7 +437,7 @@ namespace Chroma {
 					beta_re, beta_im, delta_re, delta_im,4*3*2};
 
 	  int len=(sub.end()-sub.start()+1);
-	  dispatch_to_threads(len,arg, ord_ib_zvupdates_kernel_real64);
+	  dispatch_to_threads(len,arg, ORD_KERNEL(ord_ib_zvupdates_kernel_real64));
 	}
 	else {
 	  QDPIO::cerr << "I only work for ordered subsets for now" << std::endl;
@@ -487,7 +488,7 @@ namespace Chroma {
 					omega_re, omega_im,4*3*2};
 
 	  int len=(sub.end()-sub.start()+1);
-	  dispatch_to_threads(len,arg, ord_ib_rxupdate_kernel_real32);
+	  dispatch_to_threads(len,arg, ORD_KERNEL(ord_ib_rxupdate_kernel_real32));
 	}
 	else {
 	  QDPIO::cerr << "I only work for ordered subsets for now" << std::endl;
@@ -522,7 +523,7 @@ namespace Chroma {
 					omega_re, omega_im, 4*3*2};
 
 	  int len=(sub.end()-sub.start()+1);
-	  dispatch_to_threads(len,arg, ord_ib_rxupdate_kernel_real64);
+	  dispatch_to_threads(len,arg, ORD_KERNEL(ord_ib_rxupdate_kernel_real64));
 	}
 	else {
 	  QDPIO::cerr << "I only work for ordered subsets for now" << std::endl;
@@ -597,7 +598,7 @@ namespace Chroma {
 
 
 	  int len=(sub.end()-sub.start()+1);
-	  dispatch_to_threads(len,arg,ord_ib_stupdates_kernel_real32);
+	  dispatch_to_threads(len,arg, ORD_KERNEL(ord_ib_stupdates_kernel_real32));
 	  for(int i=0; i < qdpNumThreads(); i++) { 
 	    norm_array[0] += arg.norm_space[12*i];
 	    norm_array[1] += arg.norm_space[12*i+1];
@@ -685,7 +686,7 @@ namespace Chroma {
 	  }
 
 	  int len=(sub.end()-sub.start()+1);
-	  dispatch_to_threads(len,arg,ord_ib_stupdates_kernel_real64);
+	  dispatch_to_threads(len,arg, ORD_KERNEL(ord_ib_stupdates_kernel_real64));
 
 	  
 	  for(int i=0; i < qdpNumThreads(); i++) { 
@@ -0,0 +1,337 @@
+/*! \file
+ *  \brief Chebyshev preconditioned Conjugate-Gradient algorithm for M^dag M
+ */
+
+#include "actions/ferm/invert/invcg2_cheby_prec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Chroma
+{
+
+  namespace
+  {
+    //! Number of eigenvalues of the tridiagonal matrix below x (Sturm sequence)
+    int sturmCount(const std::vector<double>& alpha, const std::vector<double>& beta, double x)
+    {
+      int count = 0;
+      double q = 1;
+      for(int i=0; i < alpha.size(); ++i)
+      {
+	q = alpha[i] - x - ((i > 0) ? beta[i-1]*beta[i-1]/q : 0.0);
+	if (q == 0.0) q = 1.0e-300;
+	if (q < 0.0) ++count;
+      }
+      return count;
+    }
+
+
+    //! Eigenvalue k (counted from below) of the tridiagonal matrix by bisection
+    double tridiagEigenvalue(const std::vector<double>& alpha, const std::vector<double>& beta, int k)
+    {
+      const int n = alpha.size();
+
+      // Gershgorin interval
+      double lo = alpha[0], hi = alpha[0];
+      for(int i=0; i < n; ++i)
+      {
+	double rad = ((i > 0) ? std::fabs(beta[i-1]) : 0.0) + ((i < n-1) ? std::fabs(beta[i]) : 0.0);
+	lo = std::min(lo, alpha[i] - rad);
+	hi = std::max(hi, alpha[i] + rad);
+      }
+
+      for(int iter=0; iter < 100; ++iter)
+      {
+	double mid = 0.5*(lo + hi);
+	if (sturmCount(alpha, beta, mid) > k)
+	  hi = mid;
+	else
+	  lo = mid;
+      }
+
+      return 0.5*(lo + hi);
+    }
+
+
+    //! Lanczos estimate of the spectral bounds
+    template<typename T, typename RT>
+    void lanczosBounds_a(const LinearOperator<T>& M,
+			 const T& chi,
+			 int n_lanczos,
+			 Real& lambda_min, Real& lambda_max)
+    {
+      START_CODE();
+
+      const Subset& s = M.subset();
+
+      T v, v_old, w, mp;
+      v_old[s] = zero;
+
+      Double chi_norm = sqrt(norm2(chi, s));
+      if (toBool(chi_norm == zero))
+      {
+	QDPIO::cerr << __func__ << ": zero starting vector" << std::endl;
+	QDP_abort(1);
+      }
+      RT inv_norm = Double(1) / chi_norm;
+      v[s] = inv_norm * chi;
+
+      std::vector<double> alpha, beta;
+      double beta_old = 0;
+
+      for(int j=0; j < n_lanczos; ++j)
+      {
+	//  w = M^dag M v - alpha v - beta v_old
+	M(mp, v, PLUS);
+	M(w, mp, MINUS);
+
+	double a = toDouble(norm2(mp, s));
+	alpha.push_back(a);
+
+	w[s] -= RT(a)*v + RT(beta_old)*v_old;
+
+	double b = toDouble(sqrt(norm2(w, s)));
+
+	// Invariant subspace, the tridiagonal matrix is exact
+	if (j == n_lanczos-1 || b <= 1.0e-12*a)
+	  break;
+
+	beta.push_back(b);
+	v_old[s] = v;
+	v[s] = RT(1.0/b) * w;
+	beta_old = b;
+      }
+
+      lambda_min = tridiagEigenvalue(alpha, beta, 0);
+      lambda_max = tridiagEigenvalue(alpha, beta, alpha.size()-1);
+
+      QDPIO::cout << "LanczosBounds: " << alpha.size() << " steps,  lambda_min = " << lambda_min
+		  << "  lambda_max = " << lambda_max << std::endl;
+
+      END_CODE();
+    }
+
+
+    //! Coefficients of the Chebyshev semi-iteration
+    struct ChebyCoeffs
+    {
+      ChebyCoeffs(double lmin, double lmax, int order)
+      {
+	double theta = 0.5*(lmax + lmin);
+	double delta = 0.5*(lmax - lmin);
+	double sigma = theta / delta;
+	double rho   = 1.0 / sigma;
+
+	inv_theta = 1.0 / theta;
+	c1.resize(order);
+	c2.resize(order);
+	for(int k=1; k < order; ++k)
+	{
+	  double rho_new = 1.0 / (2.0*sigma - rho);
+	  c1[k] = rho_new * rho;
+	  c2[k] = 2.0 * rho_new / delta;
+	  rho = rho_new;
+	}
+      }
+
+      double inv_theta;
+      std::vector<double> c1, c2;
+    };
+
+
+    //! Apply the Chebyshev preconditioner  x = p(A) v
+    /*!
+     * The steps of the semi-iteration for A x = v from x = 0. The vectors
+     * r, d, mp and mmp are work space.
+     */
+    template<typename T, typename RT>
+    void chebyPrec(const LinearOperator<T>& M, const ChebyCoeffs& cf,
+		   T& x, const T& v,
+		   T& r, T& d, T& mp, T& mmp,
+		   FlopCounter& flopcount)
+    {
+      const Subset& s = M.subset();
+      const int order = cf.c1.size();
+
+      d[s] = RT(cf.inv_theta) * v;
+      x[s] = d;
+      r[s] = v;
+      flopcount.addSiteFlops(2*Nc*Ns, s);
+
+      for(int k=1; k < order; ++k)
+      {
+	//  r -= A d
+	M(mp, d, PLUS);
+	M(mmp, mp, MINUS);
+	flopcount.addFlops(2*M.nFlops());
+
+	r[s] -= mmp;
+
+	//  d = c1 d + c2 r,  x += d
+	d[s] = RT(cf.c1[k]) * d + RT(cf.c2[k]) * r;
+	x[s] += d;
+	flopcount.addSiteFlops(12*Nc*Ns, s);
+      }
+    }
+
+
+    //! Chebyshev preconditioned CG
+    template<typename T, typename RT>
+    SystemSolverResults_t
+    InvCG2ChebyPrec_a(const LinearOperator<T>& M,
+		      const T& chi,
+		      T& psi,
+		      const Real& lambda_min, const Real& lambda_max, int order,
+		      const Real& RsdCG,
+		      int MaxCG)
+    {
+      START_CODE();
+
+      const Subset& s = M.subset();
+
+      SystemSolverResults_t res;
+
+      if (order < 1 || toBool(lambda_min <= zero) || toBool(lambda_max <= lambda_min))
+      {
+	QDPIO::cerr << __func__ << ": invalid Chebyshev order = " << order
+		    << " or interval [" << lambda_min << ", " << lambda_max << "]" << std::endl;
+	QDP_abort(1);
+      }
+
+      ChebyCoeffs cf(toDouble(lambda_min), toDouble(lambda_max), order);
+
+      T mp, mmp, p, r, z;
+      T cr, cd;       // work space of the preconditioner
+
+      QDPIO::cout << "InvCG2ChebyPrec: starting, order = " << order << std::endl;
+      FlopCounter flopcount;
+      flopcount.reset();
+      StopWatch swatch;
+      swatch.reset();
+      swatch.start();
+
+      Double chi_sq = norm2(chi, s);
+      Double rsd_sq = (RsdCG * RsdCG) * chi_sq;
+      flopcount.addSiteFlops(4*Nc*Ns, s);
+
+      //  r = chi - A psi
+      M(mp, psi, PLUS);
+      M(mmp, mp, MINUS);
+      flopcount.addFlops(2*M.nFlops());
+      r[s] = chi - mmp;
+      flopcount.addSiteFlops(2*Nc*Ns, s);
+
+      //  z = p(A) r,  p = z
+      chebyPrec<T,RT>(M, cf, z, r, cr, cd, mp, mmp, flopcount);
+      p[s] = z;
+
+      //  <r,z> and |r|^2 in one global sum
+      DComplex rz_rr = sum(cmplx(localInnerProductReal(r,z), localNorm2(r)), s);
+      Double rz = real(rz_rr);
+      Double cp = imag(rz_rr);
+      flopcount.addSiteFlops(8*Nc*Ns, s);
+
+      int k = 0;
+      while (toBool(cp > rsd_sq) && k < MaxCG)
+      {
+	++k;
+
+	//  a = <r,z> / <p, A p>,  <p, A p> = |M p|^2
+	M(mp, p, PLUS);
+	Double d = norm2(mp, s);
+	M(mmp, mp, MINUS);
+	flopcount.addFlops(2*M.nFlops());
+	flopcount.addSiteFlops(4*Nc*Ns, s);
+
+	RT a = rz / d;
+
+	psi[s] += a * p;
+	r[s] -= a * mmp;
+	flopcount.addSiteFlops(8*Nc*Ns, s);
+
+	chebyPrec<T,RT>(M, cf, z, r, cr, cd, mp, mmp, flopcount);
+
+	Double rz_old = rz;
+	rz_rr = sum(cmplx(localInnerProductReal(r,z), localNorm2(r)), s);
+	rz = real(rz_rr);
+	cp = imag(rz_rr);
+	flopcount.addSiteFlops(8*Nc*Ns, s);
+
+	//  p = z + b p
+	RT b = rz / rz_old;
+	p[s] = z + b * p;
+	flopcount.addSiteFlops(4*Nc*Ns, s);
+      }
+
+      // Actual residual
+      M(mp, psi, PLUS);
+      M(mmp, mp, MINUS);
+      res.n_count = k;
+      res.resid   = sqrt(norm2(chi - mmp, s));
+
+      swatch.stop();
+      flopcount.report("invcg2_cheby_prec", swatch.getTimeInSeconds());
+
+      if (toBool(cp > rsd_sq))
+      {
+	QDPIO::cerr << "Nonconvergence Warning" << std::endl;
+	QDPIO::cerr << "too many CG iterations: count =" << res.n_count << " rsd^2= " << cp << std::endl;
+      }
+
+      QDPIO::cout << "InvCG2ChebyPrec: " << res.n_count << " iterations, "
+		  << res.n_count*(2*order) << " applications of M, "
+		  << 2*res.n_count+2 << " global sums" << std::endl;
+
+      END_CODE();
+
+      return res;
+    }
+  }
+
+
+  // Single precision
+  SystemSolverResults_t
+  InvCG2ChebyPrec(const LinearOperator<LatticeFermionF>& M,
+		  const LatticeFermionF& chi,
+		  LatticeFermionF& psi,
+		  const Real& lambda_min, const Real& lambda_max, int order,
+		  const Real& RsdCG,
+		  int MaxCG)
+  {
+    return InvCG2ChebyPrec_a<LatticeFermionF,RealF>(M, chi, psi, lambda_min, lambda_max, order, RsdCG, MaxCG);
+  }
+
+  // Double precision
+  SystemSolverResults_t
+  InvCG2ChebyPrec(const LinearOperator<LatticeFermionD>& M,
+		  const LatticeFermionD& chi,
+		  LatticeFermionD& psi,
+		  const Real& lambda_min, const Real& lambda_max, int order,
+		  const Real& RsdCG,
+		  int MaxCG)
+  {
+    return InvCG2ChebyPrec_a<LatticeFermionD,RealD>(M, chi, psi, lambda_min, lambda_max, order, RsdCG, MaxCG);
+  }
+
+
+  // Lanczos bounds, single precision
+  void lanczosBoundsMdagM(const LinearOperator<LatticeFermionF>& M,
+			  const LatticeFermionF& chi,
+			  int n_lanczos,
+			  Real& lambda_min, Real& lambda_max)
+  {
+    lanczosBounds_a<LatticeFermionF,RealF>(M, chi, n_lanczos, lambda_min, lambda_max);
+  }
+
+  // Lanczos bounds, double precision
+  void lanczosBoundsMdagM(const LinearOperator<LatticeFermionD>& M,
+			  const LatticeFermionD& chi,
+			  int n_lanczos,
+			  Real& lambda_min, Real& lambda_max)
+  {
+    lanczosBounds_a<LatticeFermionD,RealD>(M, chi, n_lanczos, lambda_min, lambda_max);
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,99 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Chebyshev preconditioned Conjugate-Gradient algorithm for M^dag M
+ */
+
+#ifndef __invcg2_cheby_prec__
+#define __invcg2_cheby_prec__
+
+#include "linearop.h"
+#include "syssolver.h"
+
+namespace Chroma
+{
+
+  //! Chebyshev preconditioned Conjugate-Gradient (CGNE) algorithm
+  /*! \ingroup invert
+   *
+   * Solves  Chi = A . Psi  with  A = M^dag . M  by CG preconditioned with
+   * the polynomial  p(A) ~ A^{-1}  of  ChebyOrder  steps of the Chebyshev
+   * semi-iterative method on the interval [lambda_min, lambda_max]:
+   *
+   *   p(A) = (1 - T_n((l_max + l_min - 2A)/(l_max - l_min)) / T_n(s)) / A,
+   *   s    = (l_max + l_min)/(l_max - l_min)
+   *
+   * The residual polynomial lies in (0,1) on (0, l_max], so p(A) is positive
+   * definite also when l_min overestimates the lowest eigenvalue, as it does
+   * when taken from Lanczos.
+   *
+   * The Chebyshev steps need no inner products. Each CG iteration does
+   * 2 ChebyOrder applications of M and two global sums, the second one
+   * fusing <r,z> and |r|^2 into one reduction, so the number of global
+   * sums falls with the number of iterations, roughly by the order.
+   *
+   * Arguments:
+   *
+   *  \param M           Linear Operator    	         (Read)
+   *  \param chi         Source	                 (Read)
+   *  \param psi         Solution    	    	         (Modify)
+   *  \param lambda_min  Lower bound of the spectrum     (Read)
+   *  \param lambda_max  Upper bound of the spectrum     (Read)
+   *  \param order       Number of Chebyshev steps       (Read)
+   *  \param RsdCG       CG residual accuracy            (Read)
+   *  \param MaxCG       Maximum CG iterations           (Read)
+   *
+   * @{
+   */
+
+  // Single precision
+  SystemSolverResults_t
+  InvCG2ChebyPrec(const LinearOperator<LatticeFermionF>& M,
+		  const LatticeFermionF& chi,
+		  LatticeFermionF& psi,
+		  const Real& lambda_min, const Real& lambda_max, int order,
+		  const Real& RsdCG,
+		  int MaxCG);
+
+  // Double precision
+  SystemSolverResults_t
+  InvCG2ChebyPrec(const LinearOperator<LatticeFermionD>& M,
+		  const LatticeFermionD& chi,
+		  LatticeFermionD& psi,
+		  const Real& lambda_min, const Real& lambda_max, int order,
+		  const Real& RsdCG,
+		  int MaxCG);
+
+  /*! @} */  // end of group invert
+
+
+  //! Lanczos estimate of the spectral bounds of M^dag M
+  /*! \ingroup invert
+   *
+   * Runs  n_lanczos  steps of Lanczos, without reorthogonalisation, from the
+   * source and returns the extreme eigenvalues of the tridiagonal matrix.
+   * The upper bound converges in a few steps; the lower one is an upper
+   * bound of the lowest eigenvalue.
+   *
+   *  \param M           Linear Operator    	         (Read)
+   *  \param chi         Starting vector                 (Read)
+   *  \param n_lanczos   Number of Lanczos steps         (Read)
+   *  \param lambda_min  Lower bound of the spectrum     (Write)
+   *  \param lambda_max  Upper bound of the spectrum     (Write)
+   *
+   * @{
+   */
+  void lanczosBoundsMdagM(const LinearOperator<LatticeFermionF>& M,
+			  const LatticeFermionF& chi,
+			  int n_lanczos,
+			  Real& lambda_min, Real& lambda_max);
+
+  void lanczosBoundsMdagM(const LinearOperator<LatticeFermionD>& M,
+			  const LatticeFermionD& chi,
+			  int n_lanczos,
+			  Real& lambda_min, Real& lambda_max);
+
+  /*! @} */  // end of group invert
+
+}  // end namespace Chroma
+
+#endif
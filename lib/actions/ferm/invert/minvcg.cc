@@ -62,6 +62,7 @@ namespace Chroma
    *  d   	       < p[k], A.p[k] >
    *  Ap  	       Temporary for  M.p
 
+   *  MinCG       Minimum number of CG iterations done
    *  MaxCG       Maximum number of CG iterations allowed
 
    * Subroutines:
@@ -74,6 +75,7 @@ namespace Chroma
 		multi1d<T>& psi,
 		const multi1d<Real>& shifts, 
 		const multi1d<Real>& RsdCG, 
+		int MinCG,
 		int MaxCG,
 		int& n_count)
   {
@@ -222,7 +224,7 @@ namespace Chroma
       convsP[s] = false;
     }
 
-    bool convP = toBool( c < rsd_sq[isz] );
+    bool convP = toBool( c < rsd_sq[isz] ) && (MinCG <= 0);
 
 #if 0 
     QDPIO::cout << "MInvCG: k = 0  r = " << sqrt(c) << std::endl;
@@ -334,7 +336,7 @@ namespace Chroma
 		      << css << " rsd_sq["<<s<<"] = " << rsd_sq[s] << std::endl;
 #endif 
 
-	  convsP[s] = toBool( css < rsd_sq[s] );
+	  convsP[s] = toBool( css < rsd_sq[s] ) && (k >= MinCG);
 
 #if 0
      
@@ -412,7 +414,7 @@ namespace Chroma
 	      int MaxCG,
 	      int &n_count)
   {
-    MInvCG_a(M, chi, psi, shifts, RsdCG, MaxCG, n_count);
+    MInvCG_a(M, chi, psi, shifts, RsdCG, 0, MaxCG, n_count);
   }
 
 
@@ -428,7 +430,36 @@ namespace Chroma
 	      int MaxCG,
 	      int &n_count)
   {
-    MInvCG_a(M, chi, psi, shifts, RsdCG, MaxCG, n_count);
+    MInvCG_a(M, chi, psi, shifts, RsdCG, 0, MaxCG, n_count);
+  }
+
+
+  /*! \ingroup invert */
+  template<>
+  void MInvCG(const LinearOperator<LatticeStaggeredFermion>& M,
+	      const LatticeStaggeredFermion& chi, 
+	      multi1d<LatticeStaggeredFermion>& psi, 
+	      const multi1d<Real>& shifts,
+	      const multi1d<Real>& RsdCG, 
+	      int MaxCG,
+	      int &n_count)
+  {
+    MInvCG_a(M, chi, psi, shifts, RsdCG, 0, MaxCG, n_count);
+  }
+
+
+  /*! \ingroup invert */
+  template<>
+  void MInvCG(const LinearOperator<LatticeStaggeredFermion>& M,
+	      const LatticeStaggeredFermion& chi, 
+	      multi1d<LatticeStaggeredFermion>& psi, 
+	      const multi1d<Real>& shifts,
+	      const multi1d<Real>& RsdCG, 
+	      int MinCG,
+	      int MaxCG,
+	      int &n_count)
+  {
+    MInvCG_a(M, chi, psi, shifts, RsdCG, MinCG, MaxCG, n_count);
   }
 
 }  // end namespace Chroma
@@ -32,6 +32,18 @@ namespace Chroma
 	      int MaxCG,
 	      int &n_count);
 
+  //! Multishift CG that does at least MinCG iterations
+  /*! \ingroup invert */
+  template<typename T>
+  void MInvCG(const LinearOperator<T>& A, 
+	      const T& chi, 
+	      multi1d<T>& psi,
+	      const multi1d<Real>& shifts, 
+	      const multi1d<Real>& RsdCG,
+	      int MinCG,
+	      int MaxCG,
+	      int &n_count);
+
 }  // end namespace Chroma
 
 
@@ -0,0 +1,347 @@
+/*! \file
+ *  \brief Multishift Conjugate-Gradient algorithm for a block of sources
+ */
+
+#include "linearop.h"
+#include "actions/ferm/invert/minvcg2_block.h"
+
+#include <vector>
+
+namespace Chroma
+{
+
+  namespace
+  {
+    //! Apply the operator to the active vectors of a block
+    template<typename T>
+    void activeApply(const LinearOperator<T>& M,
+		     multi1d<T>& chi, const multi1d<T>& psi,
+		     const std::vector<int>& active,
+		     enum PlusMinus isign)
+    {
+      if (active.size() == psi.size())
+	M.applyMultiRHS(chi, psi, isign);
+      else
+	for(int j=0; j < active.size(); ++j)
+	  M(chi[active[j]], psi[active[j]], isign);
+    }
+
+
+    //! Norms of the active vectors of a block, two of them per global sum
+    template<typename T>
+    void activeNorm2(multi1d<Double>& n2,
+		     const multi1d<T>& x,
+		     const std::vector<int>& active,
+		     const Subset& sub)
+    {
+      for(int j=0; j < active.size(); j += 2)
+      {
+	if (j+1 < active.size())
+	{
+	  DComplex nn = sum(cmplx(localNorm2(x[active[j]]), localNorm2(x[active[j+1]])), sub);
+	  n2[active[j]]   = real(nn);
+	  n2[active[j+1]] = imag(nn);
+	}
+	else
+	{
+	  n2[active[j]] = norm2(x[active[j]], sub);
+	}
+      }
+    }
+  }
+
+
+  //! Multishift Conjugate-Gradient algorithm for a block of sources
+  /*! \ingroup invert
+   *
+   * The recurrences are those of MInvCG2 (Jegerlehner, hep-lat/9708029),
+   * run for every source. See minvcg2.cc for the algorithm.
+   */
+  template<typename T, typename R>
+  void MInvCG2Block_a(const LinearOperator<T>& M,
+		      const multi1d<T>& chi,
+		      multi1d< multi1d<T> >& psi,
+		      const multi1d<R>& shifts,
+		      const multi1d<R>& RsdCG,
+		      int MaxCG,
+		      multi1d<int>& n_count)
+  {
+    START_CODE();
+
+    const Subset& sub = M.subset();
+
+    if (shifts.size() != RsdCG.size())
+    {
+      QDPIO::cerr << "MInvCG2Block: number of shifts and residuals must match" << std::endl;
+      QDP_abort(1);
+    }
+
+    const int n_shift = shifts.size();
+    const int n_src = chi.size();
+
+    if (n_shift == 0 || n_src == 0)
+    {
+      QDPIO::cerr << "MInvCG2Block: need at least 1 shift and 1 source: shifts.size() = "
+		  << n_shift << "  chi.size() = " << n_src << std::endl;
+      QDP_abort(1);
+    }
+
+    /* Now find the smallest mass */
+    int isz = 0;
+    for(int findit=1; findit < n_shift; ++findit) {
+      if ( toBool( shifts[findit] < shifts[isz])  ) {
+	isz = findit;
+      }
+    }
+
+    psi.resize(n_src);
+    n_count.resize(n_src);
+
+    FlopCounter flopcount;
+    flopcount.reset();
+    StopWatch swatch;
+    swatch.reset();
+    swatch.start();
+
+    int n, s, j;
+
+    // Psi := 0
+    for(n = 0; n < n_src; ++n) {
+      if( psi[n].size() <  n_shift ) {
+	psi[n].resize(n_shift);
+      }
+      for(s = 0; s < n_shift; ++s) {
+	psi[n][s][sub] = zero;
+      }
+      n_count[n] = 0;
+    }
+
+    multi1d<Double> cp(n_src);
+    std::vector<int> all(n_src);
+    for(n = 0; n < n_src; ++n) {
+      all[n] = n;
+    }
+    activeNorm2(cp, chi, all, sub);                     flopcount.addSiteFlops(4*Nc*Ns*n_src,sub);
+
+    // Sources of zero norm have a zero solution
+    std::vector<int> active;
+    for(n = 0; n < n_src; ++n) {
+      if ( toBool( sqrt(cp[n]) >= fuzz ) ) {
+	active.push_back(n);
+      }
+    }
+
+    multi1d<Double> rsdcg_sq(n_shift);
+    for(s = 0; s < n_shift; ++s)  {
+      rsdcg_sq[s] = RsdCG[s] * RsdCG[s];  // RsdCG^2
+    }
+
+    multi2d<Double> rsd_sq(n_src, n_shift);
+    for(n = 0; n < n_src; ++n) {
+      for(s = 0; s < n_shift; ++s)  {
+	rsd_sq[n][s] = Real(cp[n]) * rsdcg_sq[s]; // || chi ||^2 RsdCG^2
+      }
+    }
+
+    // r[0] := p[0] := Chi
+    multi1d<T> r(n_src), p_0(n_src);
+    multi1d< multi1d<T> > p(n_src);
+    for(j = 0; j < active.size(); ++j) {
+      n = active[j];
+      r[n][sub] = chi[n];
+      p_0[n][sub] = chi[n];
+      p[n].resize(n_shift);
+      for(s = 0; s < n_shift; ++s) {
+	p[n][s][sub] = chi[n];
+      }
+    }
+
+    //  b[0] := - | r[0] |**2 / < p[0], Ap[0] > ;
+    multi1d<T> Mp(n_src), MMp(n_src);
+    multi1d<Double> d(n_src);
+
+    activeApply(M, Mp, p_0, active, PLUS);                flopcount.addFlops(M.nFlops()*active.size());
+    activeNorm2(d, Mp, active, sub);                      flopcount.addSiteFlops(4*Nc*Ns*active.size(),sub);
+    activeApply(M, MMp, Mp, active, MINUS);               flopcount.addFlops(M.nFlops()*active.size());
+
+    multi1d<Double> a(n_src), b(n_src), bp(n_src), c(n_src);
+    multi2d<Double> bs(n_src, n_shift);
+    multi3d<Double> z(n_src, 2, n_shift);
+    multi2d<bool> convsP(n_src, n_shift);
+    int iz = 1;
+
+    for(j = 0; j < active.size(); ++j) {
+      n = active[j];
+
+      b[n] = -cp[n]/d[n];
+
+      //  r[1] += b[0] A . p[0];
+      R b_r = b[n];
+      r[n][sub] += b_r*MMp[n];                            flopcount.addSiteFlops(4*Nc*Ns,sub);
+
+      /* Compute the shifted bs and z */
+      for(s = 0; s < n_shift; ++s) {
+	z[n][1-iz][s] = Double(1);
+	z[n][iz][s] = Double(1) / (Double(1) - Double(shifts[s])*b[n]);
+	bs[n][s] = b[n] * z[n][iz][s];
+	convsP[n][s] = false;
+      }
+
+      //  Psi[1] -= b[0] p[0] = - b[0] chi;
+      for(s = 0; s < n_shift; ++s) {
+	R bs_r = bs[n][s];
+	psi[n][s][sub] = - bs_r*chi[n];                  flopcount.addSiteFlops(2*Nc*Ns,sub);
+      }
+    }
+
+    //  c = |r[1]|^2
+    activeNorm2(c, r, active, sub);                       flopcount.addSiteFlops(4*Nc*Ns*active.size(),sub);
+
+    // Drop the converged sources
+    std::vector<int> remaining;
+    for(j = 0; j < active.size(); ++j) {
+      n = active[j];
+      if ( ! toBool( c[n] < rsd_sq[n][isz] ) ) {
+	remaining.push_back(n);
+      }
+    }
+    active.swap(remaining);
+
+    Double z0, z1, as;
+    int k;
+
+    for(k = 1; k <= MaxCG && active.size() > 0; ++k)
+    {
+      for(j = 0; j < active.size(); ++j) {
+	n = active[j];
+
+	//  a[k+1] := |r[k]|**2 / |r[k-1]|**2 ;
+	a[n] = c[n]/cp[n];
+
+	//  p[k+1] := r[k+1] + a[k+1] p[k];
+	R a_r = a[n];
+	p_0[n][sub] = r[n] + a_r*p_0[n];                  flopcount.addSiteFlops(4*Nc*Ns,sub);
+
+	//  ps[k+1] := zs[k+1] r[k+1] + a[k+1] ps[k];
+	for(s = 0; s < n_shift; ++s) {
+	  if( ! convsP[n][s] ) {
+	    as = a[n] * z[n][iz][s]*bs[n][s] / (z[n][1-iz][s]*b[n]);
+	    R zizs = z[n][iz][s];
+	    R as_r = as;
+	    p[n][s][sub] = zizs*r[n] + as_r*p[n][s];     flopcount.addSiteFlops(6*Nc*Ns,sub);
+	  }
+	}
+
+	//  cp  =  | r[k] |**2
+	cp[n] = c[n];
+      }
+
+      //  d = < M p, M p >,  MMp = M^dag M p  for the whole block
+      activeApply(M, Mp, p_0, active, PLUS);              flopcount.addFlops(M.nFlops()*active.size());
+      activeNorm2(d, Mp, active, sub);                    flopcount.addSiteFlops(4*Nc*Ns*active.size(),sub);
+      activeApply(M, MMp, Mp, active, MINUS);             flopcount.addFlops(M.nFlops()*active.size());
+
+      for(j = 0; j < active.size(); ++j) {
+	n = active[j];
+
+	bp[n] = b[n];
+	b[n] = -cp[n]/d[n];
+
+	//  r[k+1] += b[k] A . p[k] ;
+	R b_r = b[n];
+	r[n][sub] += b_r*MMp[n];                          flopcount.addSiteFlops(4*Nc*Ns,sub);
+      }
+
+      //  c  =  | r[k] |**2
+      activeNorm2(c, r, active, sub);                     flopcount.addSiteFlops(4*Nc*Ns*active.size(),sub);
+
+      // Compute the shifted bs and z
+      iz = 1 - iz;
+      remaining.clear();
+
+      for(j = 0; j < active.size(); ++j) {
+	n = active[j];
+
+	for(s = 0; s < n_shift; s++) {
+	  if ( ! convsP[n][s] ) {
+	    z0 = z[n][1-iz][s];
+	    z1 = z[n][iz][s];
+	    z[n][iz][s] = z0*z1*bp[n];
+	    z[n][iz][s] /= b[n]*a[n]*(z1-z0) + z1*bp[n]*(Double(1) - shifts[s]*b[n]);
+	    bs[n][s] = b[n]*z[n][iz][s]/z0;
+	  }
+	}
+
+	//  Psi[k+1] -= b[k] p[k] ;
+	for(s = 0; s < n_shift; ++s) {
+	  if ( ! convsP[n][s] ) {
+	    R bs_r = bs[n][s];
+	    psi[n][s][sub] -= bs_r*p[n][s];               flopcount.addSiteFlops(2*Nc*Ns,sub);
+	  }
+	}
+
+	// IF |r[k+1]| <= RsdCG |chi| THEN RETURN;
+	bool convP = true;
+	for(s = 0; s < n_shift; s++) {
+	  if ( ! convsP[n][s] ) {
+	    // Check norm of shifted residuals
+	    Double css = c[n] * z[n][iz][s]* z[n][iz][s];
+	    convsP[n][s] = toBool( css < rsd_sq[n][s] );
+	  }
+	  convP &= convsP[n][s];
+	}
+
+	n_count[n] = k;
+
+	if (! convP) {
+	  remaining.push_back(n);
+	}
+      }
+
+      active.swap(remaining);
+    }
+
+    swatch.stop();
+
+    QDPIO::cout << "MInvCG2Block: " << n_src << " sources, iterations =";
+    for(n = 0; n < n_src; ++n) {
+      QDPIO::cout << " " << n_count[n];
+    }
+    QDPIO::cout << std::endl;
+    flopcount.report("minvcg2block", swatch.getTimeInSeconds());
+
+    if (active.size() > 0) {
+      QDP_error_exit("too many CG iterationns: %d\n", MaxCG);
+    }
+
+    END_CODE();
+  }
+
+
+
+  /*! \ingroup invert */
+  void MInvCG2Block(const LinearOperator<LatticeFermionF>& M,
+		    const multi1d<LatticeFermionF>& chi,
+		    multi1d< multi1d<LatticeFermionF> >& psi,
+		    const multi1d<RealF>& shifts,
+		    const multi1d<RealF>& RsdCG,
+		    int MaxCG,
+		    multi1d<int>& n_count)
+  {
+    MInvCG2Block_a(M, chi, psi, shifts, RsdCG, MaxCG, n_count);
+  }
+
+
+  /*! \ingroup invert */
+  void MInvCG2Block(const LinearOperator<LatticeFermionD>& M,
+		    const multi1d<LatticeFermionD>& chi,
+		    multi1d< multi1d<LatticeFermionD> >& psi,
+		    const multi1d<RealD>& shifts,
+		    const multi1d<RealD>& RsdCG,
+		    int MaxCG,
+		    multi1d<int>& n_count)
+  {
+    MInvCG2Block_a(M, chi, psi, shifts, RsdCG, MaxCG, n_count);
+  }
+
+}  // end namespace Chroma
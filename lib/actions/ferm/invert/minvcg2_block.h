@@ -0,0 +1,61 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Multishift Conjugate-Gradient algorithm for a block of sources
+ */
+
+#ifndef MINVCG2_BLOCK_INCLUDE
+#define MINVCG2_BLOCK_INCLUDE
+
+#include "linearop.h"
+
+namespace Chroma
+{
+
+  //! Multishift Conjugate-Gradient algorithm for a block of sources
+  /*! \ingroup invert
+   *
+   * Solves  (M^dag M + shifts[i]) psi[n][i] = chi[n]  for all sources n and
+   * shifts i. Each source runs its own multishift CG (as MInvCG2), but the
+   * sources move in lockstep: the operator is applied to all directions at
+   * once through  LinearOperator::applyMultiRHS, and the norms of two
+   * sources share one global sum.
+   *
+   * A source drops out of the block once all its shifts have converged.
+   *
+   * The solutions and search directions of all sources are held at once,
+   * 2 n_src x n_shift fermions plus 4 per source.
+   *
+   * Arguments:
+   *
+   *  \param M        Linear operator                  (Read)
+   *  \param chi      Sources                          (Read)
+   *  \param psi      Solutions, psi[n][i]             (Write)
+   *  \param shifts   Shifts of form  M^dag M + shift  (Read)
+   *  \param RsdCG    Residual accuracy of each shift  (Read)
+   *  \param MaxCG    Maximum number of iterations     (Read)
+   *  \param n_count  Iterations of each source        (Write)
+   *
+   * @{
+   */
+  void MInvCG2Block(const LinearOperator<LatticeFermionF>& M,
+		    const multi1d<LatticeFermionF>& chi,
+		    multi1d< multi1d<LatticeFermionF> >& psi,
+		    const multi1d<RealF>& shifts,
+		    const multi1d<RealF>& RsdCG,
+		    int MaxCG,
+		    multi1d<int>& n_count);
+
+  void MInvCG2Block(const LinearOperator<LatticeFermionD>& M,
+		    const multi1d<LatticeFermionD>& chi,
+		    multi1d< multi1d<LatticeFermionD> >& psi,
+		    const multi1d<RealD>& shifts,
+		    const multi1d<RealD>& RsdCG,
+		    int MaxCG,
+		    multi1d<int>& n_count);
+
+  /*! @} */  // end of group invert
+
+}  // end namespace Chroma
+
+
+#endif
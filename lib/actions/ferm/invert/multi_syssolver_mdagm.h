@@ -17,6 +17,29 @@ namespace Chroma
   template<typename T>
   struct MdagMMultiSystemSolver : virtual public MultiSystemSolver<T>
   {
+    //! Solve for a block of sources with the same shifts
+    /*!
+     * Default implementation solves for one source after the other.
+     * Solvers that can share the operator applications among the
+     * sources override this.
+     *
+     * \param psi      solutions, psi[n][i] for source n and shift i ( Modify )
+     * \param shifts   shifts ( Read )
+     * \param chi      sources ( Read )
+     * \return syssolver results of each source
+     */
+    virtual multi1d<SystemSolverResults_t> solveMultiRHS(multi1d< multi1d<T> >& psi,
+							  const multi1d<Real>& shifts,
+							  const multi1d<T>& chi) const
+    {
+      multi1d<SystemSolverResults_t> res(chi.size());
+      psi.resize(chi.size());
+
+      for(int n=0; n < chi.size(); ++n)
+	res[n] = (*this)(psi[n], shifts, chi[n]);
+
+      return res;
+    }
   };
 
   //! SystemSolver disambiguator
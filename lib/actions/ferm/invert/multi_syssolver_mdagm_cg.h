@@ -13,6 +13,7 @@
 #include "actions/ferm/invert/multi_syssolver_cg_params.h"
 #include "actions/ferm/invert/minvcg.h"
 #include "actions/ferm/invert/minvcg2.h"
+#include "actions/ferm/invert/minvcg2_block.h"
 #include "init/chroma_init.h"
 
 namespace Chroma
@@ -59,20 +60,7 @@ namespace Chroma
       {
 	START_CODE();
 
-	multi1d<Real> RsdCG(shifts.size());
-	if (invParam.RsdCG.size() == 1)
-	{
-	  RsdCG = invParam.RsdCG[0];
-	}
-	else if (invParam.RsdCG.size() == RsdCG.size())
-	{
-	  RsdCG = invParam.RsdCG;
-	}
-	else
-	{
-	  QDPIO::cerr << "MdagMMultiSysSolverCG: shifts incompatible" << std::endl;
-	  QDP_abort(1);
-	}
+	multi1d<Real> RsdCG(residuals(shifts));
 
 	SystemSolverResults_t res;
   	MInvCG2(*A, chi, psi, shifts, RsdCG, invParam.MaxCG, res.n_count);
@@ -103,10 +91,62 @@ namespace Chroma
       }
 
 
+    //! Solve for a block of sources with the same shifts
+    /*!
+     * The sources are solved in lockstep, so the operator is applied to
+     * all of them at once.
+     *
+     * \param psi      solutions ( Modify )
+     * \param shifts   shifts ( Read )
+     * \param chi      sources ( Read )
+     * \return syssolver results of each source
+     */
+    multi1d<SystemSolverResults_t> solveMultiRHS(multi1d< multi1d<T> >& psi,
+						  const multi1d<Real>& shifts,
+						  const multi1d<T>& chi) const
+      {
+	START_CODE();
+
+	multi1d<Real> RsdCG(residuals(shifts));
+
+	multi1d<int> n_count;
+	MInvCG2Block(*A, chi, psi, shifts, RsdCG, invParam.MaxCG, n_count);
+
+	multi1d<SystemSolverResults_t> res(chi.size());
+	for(int n=0; n < chi.size(); ++n)
+	  res[n].n_count = n_count[n];
+
+	END_CODE();
+
+	return res;
+      }
+
+
   private:
     // Hide default constructor
     MdagMMultiSysSolverCG() {}
 
+    //! Residual of each shift
+    multi1d<Real> residuals(const multi1d<Real>& shifts) const
+      {
+	multi1d<Real> RsdCG(shifts.size());
+	if (invParam.RsdCG.size() == 1)
+	{
+	  RsdCG = invParam.RsdCG[0];
+	}
+	else if (invParam.RsdCG.size() == RsdCG.size())
+	{
+	  RsdCG = invParam.RsdCG;
+	}
+	else
+	{
+	  QDPIO::cerr << "MdagMMultiSysSolverCG: shifts incompatible" << std::endl;
+	  QDP_abort(1);
+	}
+
+	return RsdCG;
+      }
+
     Handle< LinearOperator<T> > A;
     MultiSysSolverCGParams invParam;
   };
@@ -0,0 +1,29 @@
+// Vector body of ord_cxmayf_kernel, compiled once per instruction set.
+// Included by ord_cxmayf_kernel.h inside the AVX2 and AVX512 namespaces.
+
+inline
+void ord_cxmayf_kernel(int lo, int hi, int my_id, ord_cxmayf_arg* arg)
+{
+  typedef Simd<REAL32> S;
+
+  int atom = arg->atom;
+  int low = atom*lo;
+  int len = atom*(hi-lo);
+
+  REAL32* x_ptr = &(arg->x_ptr[low]);
+  REAL32* y_ptr = &(arg->y_ptr[low]);
+
+  S::V a_re = S::set1(arg->a_re);
+  S::V a_im = S::setIm(arg->a_im);
+
+  for(int count = 0; count < len; count += S::W) { 
+    int n = len - count;
+
+    S::V x = S::load(&x_ptr[count], n);
+    S::V y = S::load(&y_ptr[count], n);
+
+    // x = x - a*y
+    x = S::nmadd(a_im, S::swap(y), S::nmadd(a_re, y, x));
+    S::store(&x_ptr[count], x, n);
+  }
+}
@@ -0,0 +1,52 @@
+// Vector body of the ord_ib_rxupdate kernels, compiled once per instruction set.
+// Included by ord_ib_rxupdate_kernel.h inside the AVX2 and AVX512 namespaces.
+
+template<typename T>
+inline
+void ord_ib_rxupdate_kernel_simd(int lo, int hi, int my_id, ib_rxupdate_arg<T>* a)
+{
+  typedef Simd<T> S;
+  typedef typename S::V V;
+
+  int atom = a->atom;
+  int low = atom*lo;
+  int len = atom*(hi-lo);
+
+  T* s_ptr = &(a->s_ptr[low]);
+  T* t_ptr = &(a->t_ptr[low]);
+  T* z_ptr = &(a->z_ptr[low]);
+  T* r_ptr = &(a->r_ptr[low]);
+  T* x_ptr = &(a->x_ptr[low]);
+
+  V om_re = S::set1(a->omega_re);
+  V om_im = S::setIm(a->omega_im);
+
+  for(int count = 0; count < len; count += S::W) { 
+    int n = len - count;
+
+    V s = S::load(&s_ptr[count], n);
+    V t = S::load(&t_ptr[count], n);
+    V z = S::load(&z_ptr[count], n);
+    V x = S::load(&x_ptr[count], n);
+
+    // r = s - omega*t
+    V r = S::nmadd(om_im, S::swap(t), S::nmadd(om_re, t, s));
+    S::store(&r_ptr[count], r, n);
+
+    // x += omega*s + z
+    x = S::madd(om_im, S::swap(s), S::madd(om_re, s, S::add(x, z)));
+    S::store(&x_ptr[count], x, n);
+  }
+}
+
+inline
+void ord_ib_rxupdate_kernel_real32(int lo, int hi, int my_id, ib_rxupdate_arg<REAL32>* a)
+{
+  ord_ib_rxupdate_kernel_simd<REAL32>(lo, hi, my_id, a);
+}
+
+inline
+void ord_ib_rxupdate_kernel_real64(int lo, int hi, int my_id, ib_rxupdate_arg<REAL64>* a)
+{
+  ord_ib_rxupdate_kernel_simd<REAL64>(lo, hi, my_id, a);
+}
@@ -0,0 +1,87 @@
+// Vector body of the ord_ib_stupdates kernels, compiled once per instruction set.
+// Included by ord_ib_stupdates_reduces.h inside the AVX2 and AVX512 namespaces.
+
+template<typename T>
+inline
+void ord_ib_stupdates_kernel_simd(int lo, int hi, int my_id, ib_stupdate_arg<T>* a)
+{
+  typedef Simd<T> S;
+  typedef typename S::V V;
+  typedef typename S::Acc Acc;
+
+  int atom = a->atom;
+  int low = atom*lo;
+  int len = atom*(hi-lo);
+
+  T* r_ptr  = &(a->r[low]);
+  T* u_ptr  = &(a->u[low]);
+  T* v_ptr  = &(a->v[low]);
+  T* q_ptr  = &(a->q[low]);
+  T* r0_ptr = &(a->r0[low]);
+  T* f0_ptr = &(a->f0[low]);
+  T* s_ptr  = &(a->s[low]);
+  T* t_ptr  = &(a->t[low]);
+  REAL64* norm_array = &(a->norm_space[12*my_id]);
+
+  V a_re = S::set1(a->a_r);
+  V a_im = S::setIm(a->a_i);
+
+  Acc phi_re   = S::zero(), phi_im   = S::zero();
+  Acc gamma_re = S::zero(), gamma_im = S::zero();
+  Acc pi_re    = S::zero(), pi_im    = S::zero();
+  Acc eta_re   = S::zero(), eta_im   = S::zero();
+  Acc theta_re = S::zero(), theta_im = S::zero();
+  Acc kappa    = S::zero();
+  Acc rnorm    = S::zero();
+
+  for(int count = 0; count < len; count += S::W) { 
+    int n = len - count;
+
+    V r  = S::load(&r_ptr[count], n);
+    V u  = S::load(&u_ptr[count], n);
+    V v  = S::load(&v_ptr[count], n);
+    V q  = S::load(&q_ptr[count], n);
+    V r0 = S::load(&r0_ptr[count], n);
+    V f0 = S::load(&f0_ptr[count], n);
+
+    // s = r - alpha*v,  t = u - alpha*q
+    V s = S::nmadd(a_im, S::swap(v), S::nmadd(a_re, v, r));
+    V t = S::nmadd(a_im, S::swap(q), S::nmadd(a_re, q, u));
+    S::store(&s_ptr[count], s, n);
+    S::store(&t_ptr[count], t, n);
+
+    S::accDot(phi_re, phi_im, r0, s);         // phi   = (r0,s)
+    S::accDot(gamma_re, gamma_im, f0, s);     // gamma = (f0,s)
+    S::accDot(pi_re, pi_im, r0, q);           // pi    = (r0,q)
+    S::accDot(eta_re, eta_im, f0, t);         // eta   = (f0,t)
+    S::accDot(theta_re, theta_im, t, s);      // theta = (t,s)
+    S::accNorm(kappa, t);                     // kappa = || t ||^2
+    S::accNorm(rnorm, r);                     // rnorm = || r ||^2
+  }
+
+  // Caller zeroed norm_space
+  norm_array[0]  += S::reduce(phi_re);
+  norm_array[1]  += S::reduceIm(phi_im);
+  norm_array[2]  += S::reduce(gamma_re);
+  norm_array[3]  += S::reduceIm(gamma_im);
+  norm_array[4]  += S::reduce(pi_re);
+  norm_array[5]  += S::reduceIm(pi_im);
+  norm_array[6]  += S::reduce(eta_re);
+  norm_array[7]  += S::reduceIm(eta_im);
+  norm_array[8]  += S::reduce(theta_re);
+  norm_array[9]  += S::reduceIm(theta_im);
+  norm_array[10] += S::reduce(kappa);
+  norm_array[11] += S::reduce(rnorm);
+}
+
+inline
+void ord_ib_stupdates_kernel_real32(int lo, int hi, int my_id, ib_stupdate_arg<REAL32>* a)
+{
+  ord_ib_stupdates_kernel_simd<REAL32>(lo, hi, my_id, a);
+}
+
+inline
+void ord_ib_stupdates_kernel_real64(int lo, int hi, int my_id, ib_stupdate_arg<REAL64>* a)
+{
+  ord_ib_stupdates_kernel_simd<REAL64>(lo, hi, my_id, a);
+}
@@ -0,0 +1,64 @@
+// Vector body of the ord_ib_zvupdates kernels, compiled once per instruction set.
+// Included by ord_ib_zvupdates_kernel.h inside the AVX2 and AVX512 namespaces.
+
+template<typename T>
+inline
+void ord_ib_zvupdates_kernel_simd(int lo, int hi, int my_id, ib_zvupdates_arg<T>* a)
+{
+  typedef Simd<T> S;
+  typedef typename S::V V;
+
+  int atom = a->atom;
+  int low = atom*lo;
+  int len = atom*(hi-lo);
+
+  T* r_ptr = &(a->r_ptr[low]);
+  T* z_ptr = &(a->z_ptr[low]);
+  T* v_ptr = &(a->v_ptr[low]);
+  T* u_ptr = &(a->u_ptr[low]);
+  T* q_ptr = &(a->q_ptr[low]);
+
+  V a_re = S::set1(a->alpha_re);
+  V a_im = S::setIm(a->alpha_im);
+  V arb_re = S::set1(a->alpha_rat_beta_re);
+  V arb_im = S::setIm(a->alpha_rat_beta_im);
+  V ad_re = S::set1(a->alpha_delta_re);
+  V ad_im = S::setIm(a->alpha_delta_im);
+  V b_re = S::set1(a->beta_re);
+  V b_im = S::setIm(a->beta_im);
+  V d_re = S::set1(a->delta_re);
+  V d_im = S::setIm(a->delta_im);
+
+  for(int count = 0; count < len; count += S::W) { 
+    int n = len - count;
+
+    V r = S::load(&r_ptr[count], n);
+    V z = S::load(&z_ptr[count], n);
+    V v = S::load(&v_ptr[count], n);
+    V u = S::load(&u_ptr[count], n);
+    V q = S::load(&q_ptr[count], n);
+
+    // z = (alpha_n/alpha_n-1)*beta z + alpha*r - alpha*delta*v
+    V zn = S::madd(arb_im, S::swap(z), S::mul(arb_re, z));
+    zn = S::madd(a_im, S::swap(r), S::madd(a_re, r, zn));
+    zn = S::nmadd(ad_im, S::swap(v), S::nmadd(ad_re, v, zn));
+    S::store(&z_ptr[count], zn, n);
+
+    // v = u + beta*v - delta*q
+    V vn = S::madd(b_im, S::swap(v), S::madd(b_re, v, u));
+    vn = S::nmadd(d_im, S::swap(q), S::nmadd(d_re, q, vn));
+    S::store(&v_ptr[count], vn, n);
+  }
+}
+
+inline
+void ord_ib_zvupdates_kernel_real32(int lo, int hi, int my_id, ib_zvupdates_arg<REAL32>* a)
+{
+  ord_ib_zvupdates_kernel_simd<REAL32>(lo, hi, my_id, a);
+}
+
+inline
+void ord_ib_zvupdates_kernel_real64(int lo, int hi, int my_id, ib_zvupdates_arg<REAL64>* a)
+{
+  ord_ib_zvupdates_kernel_simd<REAL64>(lo, hi, my_id, a);
+}
@@ -0,0 +1,350 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Runtime selected AVX2 and AVX-512 variants of the ord_* BiCGStab kernels
+ *
+ *  The ord_*_kernel.h headers choose the baseline (SSE or generic) kernels
+ *  at compile time. On x86-64 with GCC or clang this header additionally
+ *  provides the vector traits used to compile every kernel a second and
+ *  third time for AVX2+FMA and AVX-512, in the namespaces AVX2 and AVX512.
+ *  Only those functions are compiled for the wider instruction sets, so the
+ *  library still runs on any x86-64 machine: ORD_KERNEL(name) picks the
+ *  variant for the instruction set chosen at run time from CPUID.
+ */
+
+#ifndef ORD_KERNELS_SIMD_H
+#define ORD_KERNELS_SIMD_H
+
+#include "chromabase.h"
+
+#if defined(__x86_64__) && defined(__GNUC__) && (defined(__clang__) || (__GNUC__ >= 7))
+#define CHROMA_ORD_KERNELS_SIMD
+#endif
+
+#ifdef CHROMA_ORD_KERNELS_SIMD
+#include <immintrin.h>
+
+#if defined(__clang__)
+#define ORD_SIMD_AVX2_BEGIN   _Pragma("clang attribute push (__attribute__((target(\"avx2,fma\"))), apply_to = function)")
+#define ORD_SIMD_AVX512_BEGIN _Pragma("clang attribute push (__attribute__((target(\"avx512f,avx2,fma\"))), apply_to = function)")
+#define ORD_SIMD_END          _Pragma("clang attribute pop")
+#else
+#define ORD_SIMD_AVX2_BEGIN   _Pragma("GCC push_options") _Pragma("GCC target(\"avx2,fma\")")
+#define ORD_SIMD_AVX512_BEGIN _Pragma("GCC push_options") _Pragma("GCC target(\"avx512f,avx2,fma\")")
+#define ORD_SIMD_END          _Pragma("GCC pop_options")
+#endif
+
+#endif
+
+
+namespace Chroma
+{
+  namespace BiCGStabKernels
+  {
+    //! Instruction sets of the ord_* kernels
+    enum KernelISA
+    {
+      KERNEL_ISA_BASE = 0,   /*!< the compile time SSE or generic kernels */
+      KERNEL_ISA_AVX2,       /*!< AVX2 + FMA */
+      KERNEL_ISA_AVX512      /*!< AVX-512F */
+    };
+
+    //! The instruction set used by the kernels
+    KernelISA getKernelISA();
+
+    //! The widest instruction set supported by this build and this CPU
+    KernelISA getMaxKernelISA();
+
+    //! Override the instruction set, e.g. for benchmarking. Clamped to getMaxKernelISA()
+    void setKernelISA(KernelISA isa);
+
+    //! Name of an instruction set
+    std::string kernelISAName(KernelISA isa);
+
+
+    //! Pick the kernel variant of the selected instruction set
+    template<typename Arg>
+    inline
+    void (*selectKernel(void (*base)(int, int, int, Arg*),
+			void (*avx2)(int, int, int, Arg*),
+			void (*avx512)(int, int, int, Arg*)))(int, int, int, Arg*)
+    {
+      switch (getKernelISA())
+      {
+      case KERNEL_ISA_AVX512:
+	return avx512;
+      case KERNEL_ISA_AVX2:
+	return avx2;
+      default:
+	return base;
+      }
+    }
+
+
+#ifdef CHROMA_ORD_KERNELS_SIMD
+
+#define ORD_KERNEL(name) selectKernel(name, AVX2::name, AVX512::name)
+
+    /*
+     * Vector traits. Simd<T>::V holds W reals, i.e. W/2 interleaved complex
+     * numbers. Reductions are accumulated in double precision (Simd<T>::Acc)
+     * also for single precision fields, as the SSE kernels do. Loads and
+     * stores take the number of reals left so the tail of a thread's range
+     * is handled with masks.
+     */
+
+    ORD_SIMD_AVX2_BEGIN
+    namespace AVX2
+    {
+      template<typename T> struct Simd;
+
+      template<>
+      struct Simd<REAL64>
+      {
+	typedef __m256d V;
+	typedef __m256d Acc;
+	enum { W = 4 };
+
+	static inline V mask(int n)
+	{
+	  return _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_set1_epi64x(n), _mm256_setr_epi64x(0,1,2,3)));
+	}
+
+	static inline V load(const REAL64* p, int n)
+	{
+	  return (n >= W) ? _mm256_loadu_pd(p) : _mm256_maskload_pd(p, _mm256_castpd_si256(mask(n)));
+	}
+
+	static inline void store(REAL64* p, V x, int n)
+	{
+	  if (n >= W)
+	    _mm256_storeu_pd(p, x);
+	  else
+	    _mm256_maskstore_pd(p, _mm256_castpd_si256(mask(n)), x);
+	}
+
+	static inline V set1(REAL64 a) {return _mm256_set1_pd(a);}
+
+	//! (-a, a, -a, a): the imaginary part of a complex scalar acting on swapped pairs
+	static inline V setIm(REAL64 a) {return _mm256_setr_pd(-a, a, -a, a);}
+
+	static inline V add(V a, V b) {return _mm256_add_pd(a, b);}
+	static inline V sub(V a, V b) {return _mm256_sub_pd(a, b);}
+	static inline V mul(V a, V b) {return _mm256_mul_pd(a, b);}
+	static inline V madd(V a, V b, V c) {return _mm256_fmadd_pd(a, b, c);}
+	static inline V nmadd(V a, V b, V c) {return _mm256_fnmadd_pd(a, b, c);}
+
+	//! Swap real and imaginary parts
+	static inline V swap(V a) {return _mm256_permute_pd(a, 0x5);}
+
+	static inline Acc zero() {return _mm256_setzero_pd();}
+
+	static inline void accNorm(Acc& acc, V x) {acc = _mm256_fmadd_pd(x, x, acc);}
+
+	//! Accumulate conj(x)*y. The imaginary part is folded in reduceIm
+	static inline void accDot(Acc& re, Acc& im, V x, V y)
+	{
+	  re = _mm256_fmadd_pd(x, y, re);
+	  im = _mm256_fmadd_pd(x, swap(y), im);
+	}
+
+	static inline REAL64 reduce(Acc a)
+	{
+	  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+	  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+	}
+
+	static inline REAL64 reduceIm(Acc a)
+	{
+	  return reduce(_mm256_mul_pd(a, _mm256_setr_pd(1, -1, 1, -1)));
+	}
+      };
+
+
+      template<>
+      struct Simd<REAL32>
+      {
+	typedef __m256  V;
+	typedef __m256d Acc;
+	enum { W = 8 };
+
+	static inline __m256i mask(int n)
+	{
+	  return _mm256_cmpgt_epi32(_mm256_set1_epi32(n), _mm256_setr_epi32(0,1,2,3,4,5,6,7));
+	}
+
+	static inline V load(const REAL32* p, int n)
+	{
+	  return (n >= W) ? _mm256_loadu_ps(p) : _mm256_maskload_ps(p, mask(n));
+	}
+
+	static inline void store(REAL32* p, V x, int n)
+	{
+	  if (n >= W)
+	    _mm256_storeu_ps(p, x);
+	  else
+	    _mm256_maskstore_ps(p, mask(n), x);
+	}
+
+	static inline V set1(REAL32 a) {return _mm256_set1_ps(a);}
+	static inline V setIm(REAL32 a) {return _mm256_setr_ps(-a, a, -a, a, -a, a, -a, a);}
+
+	static inline V add(V a, V b) {return _mm256_add_ps(a, b);}
+	static inline V sub(V a, V b) {return _mm256_sub_ps(a, b);}
+	static inline V mul(V a, V b) {return _mm256_mul_ps(a, b);}
+	static inline V madd(V a, V b, V c) {return _mm256_fmadd_ps(a, b, c);}
+	static inline V nmadd(V a, V b, V c) {return _mm256_fnmadd_ps(a, b, c);}
+	static inline V swap(V a) {return _mm256_permute_ps(a, 0xb1);}
+
+	static inline __m256d lo(V a) {return _mm256_cvtps_pd(_mm256_castps256_ps128(a));}
+	static inline __m256d hi(V a) {return _mm256_cvtps_pd(_mm256_extractf128_ps(a, 1));}
+
+	static inline Acc zero() {return _mm256_setzero_pd();}
+
+	static inline void accNorm(Acc& acc, V x)
+	{
+	  Simd<REAL64>::accNorm(acc, lo(x));
+	  Simd<REAL64>::accNorm(acc, hi(x));
+	}
+
+	static inline void accDot(Acc& re, Acc& im, V x, V y)
+	{
+	  Simd<REAL64>::accDot(re, im, lo(x), lo(y));
+	  Simd<REAL64>::accDot(re, im, hi(x), hi(y));
+	}
+
+	static inline REAL64 reduce(Acc a) {return Simd<REAL64>::reduce(a);}
+	static inline REAL64 reduceIm(Acc a) {return Simd<REAL64>::reduceIm(a);}
+      };
+
+    } // namespace AVX2
+    ORD_SIMD_END
+
+
+    ORD_SIMD_AVX512_BEGIN
+    namespace AVX512
+    {
+      template<typename T> struct Simd;
+
+      template<>
+      struct Simd<REAL64>
+      {
+	typedef __m512d V;
+	typedef __m512d Acc;
+	enum { W = 8 };
+
+	static inline __mmask8 mask(int n) {return (__mmask8)((1u << n) - 1u);}
+
+	static inline V load(const REAL64* p, int n)
+	{
+	  return (n >= W) ? _mm512_loadu_pd(p) : _mm512_maskz_loadu_pd(mask(n), p);
+	}
+
+	static inline void store(REAL64* p, V x, int n)
+	{
+	  if (n >= W)
+	    _mm512_storeu_pd(p, x);
+	  else
+	    _mm512_mask_storeu_pd(p, mask(n), x);
+	}
+
+	static inline V set1(REAL64 a) {return _mm512_set1_pd(a);}
+	static inline V setIm(REAL64 a) {return _mm512_set_pd(a, -a, a, -a, a, -a, a, -a);}
+
+	static inline V add(V a, V b) {return _mm512_add_pd(a, b);}
+	static inline V sub(V a, V b) {return _mm512_sub_pd(a, b);}
+	static inline V mul(V a, V b) {return _mm512_mul_pd(a, b);}
+	static inline V madd(V a, V b, V c) {return _mm512_fmadd_pd(a, b, c);}
+	static inline V nmadd(V a, V b, V c) {return _mm512_fnmadd_pd(a, b, c);}
+	static inline V swap(V a) {return _mm512_permute_pd(a, 0x55);}
+
+	static inline Acc zero() {return _mm512_setzero_pd();}
+
+	static inline void accNorm(Acc& acc, V x) {acc = _mm512_fmadd_pd(x, x, acc);}
+
+	static inline void accDot(Acc& re, Acc& im, V x, V y)
+	{
+	  re = _mm512_fmadd_pd(x, y, re);
+	  im = _mm512_fmadd_pd(x, swap(y), im);
+	}
+
+	static inline REAL64 reduce(Acc a) {return _mm512_reduce_add_pd(a);}
+
+	static inline REAL64 reduceIm(Acc a)
+	{
+	  return _mm512_reduce_add_pd(_mm512_mul_pd(a, _mm512_set_pd(-1, 1, -1, 1, -1, 1, -1, 1)));
+	}
+      };
+
+
+      template<>
+      struct Simd<REAL32>
+      {
+	typedef __m512  V;
+	typedef __m512d Acc;
+	enum { W = 16 };
+
+	static inline __mmask16 mask(int n) {return (__mmask16)((1u << n) - 1u);}
+
+	static inline V load(const REAL32* p, int n)
+	{
+	  return (n >= W) ? _mm512_loadu_ps(p) : _mm512_maskz_loadu_ps(mask(n), p);
+	}
+
+	static inline void store(REAL32* p, V x, int n)
+	{
+	  if (n >= W)
+	    _mm512_storeu_ps(p, x);
+	  else
+	    _mm512_mask_storeu_ps(p, mask(n), x);
+	}
+
+	static inline V set1(REAL32 a) {return _mm512_set1_ps(a);}
+	static inline V setIm(REAL32 a)
+	{
+	  return _mm512_set_ps(a, -a, a, -a, a, -a, a, -a, a, -a, a, -a, a, -a, a, -a);
+	}
+
+	static inline V add(V a, V b) {return _mm512_add_ps(a, b);}
+	static inline V sub(V a, V b) {return _mm512_sub_ps(a, b);}
+	static inline V mul(V a, V b) {return _mm512_mul_ps(a, b);}
+	static inline V madd(V a, V b, V c) {return _mm512_fmadd_ps(a, b, c);}
+	static inline V nmadd(V a, V b, V c) {return _mm512_fnmadd_ps(a, b, c);}
+	static inline V swap(V a) {return _mm512_permute_ps(a, 0xb1);}
+
+	static inline __m512d lo(V a) {return _mm512_cvtps_pd(_mm512_castps512_ps256(a));}
+	static inline __m512d hi(V a)
+	{
+	  return _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a), 1)));
+	}
+
+	static inline Acc zero() {return _mm512_setzero_pd();}
+
+	static inline void accNorm(Acc& acc, V x)
+	{
+	  Simd<REAL64>::accNorm(acc, lo(x));
+	  Simd<REAL64>::accNorm(acc, hi(x));
+	}
+
+	static inline void accDot(Acc& re, Acc& im, V x, V y)
+	{
+	  Simd<REAL64>::accDot(re, im, lo(x), lo(y));
+	  Simd<REAL64>::accDot(re, im, hi(x), hi(y));
+	}
+
+	static inline REAL64 reduce(Acc a) {return Simd<REAL64>::reduce(a);}
+	static inline REAL64 reduceIm(Acc a) {return Simd<REAL64>::reduceIm(a);}
+      };
+
+    } // namespace AVX512
+    ORD_SIMD_END
+
+#else
+
+#define ORD_KERNEL(name) (name)
+
+#endif
+
+  } // namespace BiCGStabKernels
+} // namespace Chroma
+
+#endif
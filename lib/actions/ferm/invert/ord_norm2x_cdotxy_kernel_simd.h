@@ -0,0 +1,33 @@
+// Vector body of ord_norm2x_cdotxy_kernel, compiled once per instruction set.
+// Included by ord_norm2x_cdotxy_kernel.h inside the AVX2 and AVX512 namespaces.
+
+inline
+void ord_norm2x_cdotxy_kernel(int lo, int hi, int my_id, ord_norm2x_cdotxy_arg* a)
+{
+  typedef Simd<REAL32> S;
+
+  int atom = a->atom;
+  int low = atom*lo;
+  int len = atom*(hi-lo);
+
+  REAL32* x_ptr = &(a->x_ptr[low]);
+  REAL32* y_ptr = &(a->y_ptr[low]);
+
+  S::Acc norm = S::zero();
+  S::Acc dot_re = S::zero();
+  S::Acc dot_im = S::zero();
+
+  for(int count = 0; count < len; count += S::W) { 
+    int n = len - count;
+
+    S::V x = S::load(&x_ptr[count], n);
+    S::V y = S::load(&y_ptr[count], n);
+
+    S::accNorm(norm, x);
+    S::accDot(dot_re, dot_im, x, y);
+  }
+
+  a->norm_space[3*my_id]   = S::reduce(norm);
+  a->norm_space[3*my_id+1] = S::reduce(dot_re);
+  a->norm_space[3*my_id+2] = S::reduceIm(dot_im);
+}
@@ -10,4 +10,18 @@
 #include "ord_xmay_normx_cdotzx_kernel_generic.h"
 #endif
 
+#ifdef CHROMA_ORD_KERNELS_SIMD
+ORD_SIMD_AVX2_BEGIN
+namespace AVX2 {
+#include "ord_xmay_normx_cdotzx_kernel_simd.h"
+}
+ORD_SIMD_END
+
+ORD_SIMD_AVX512_BEGIN
+namespace AVX512 {
+#include "ord_xmay_normx_cdotzx_kernel_simd.h"
+}
+ORD_SIMD_END
+#endif
+
 #endif
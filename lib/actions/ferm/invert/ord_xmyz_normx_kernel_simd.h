@@ -0,0 +1,30 @@
+// Vector body of ord_xymz_normx_kernel, compiled once per instruction set.
+// Included by ord_xmyz_normx_kernel.h inside the AVX2 and AVX512 namespaces.
+
+inline
+void ord_xymz_normx_kernel(int lo, int hi, int my_id, ord_xymz_normx_arg* a)
+{
+  typedef Simd<REAL64> S;
+
+  int atom = a->atom;
+  int low = atom*lo;
+  int len = atom*(hi-lo);
+
+  REAL64* x_ptr = &(a->x_ptr[low]);
+  REAL64* y_ptr = &(a->y_ptr[low]);
+  REAL64* z_ptr = &(a->z_ptr[low]);
+
+  S::Acc norm = S::zero();
+
+  for(int count = 0; count < len; count += S::W) { 
+    int n = len - count;
+
+    // x = y - z
+    S::V x = S::sub(S::load(&y_ptr[count], n), S::load(&z_ptr[count], n));
+    S::store(&x_ptr[count], x, n);
+
+    S::accNorm(norm, x);
+  }
+
+  a->norm_ptr[my_id] = S::reduce(norm);
+}
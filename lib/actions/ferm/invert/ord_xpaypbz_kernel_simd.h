@@ -0,0 +1,34 @@
+// Vector body of ord_xpaypbz_kernel, compiled once per instruction set.
+// Included by ord_xpaypbz_kernel.h inside the AVX2 and AVX512 namespaces.
+
+inline
+void ord_xpaypbz_kernel(int lo, int hi, int my_id, ord_xpaypbz_arg* a)
+{
+  typedef Simd<REAL32> S;
+
+  int atom = a->atom;
+  int low = atom*lo;
+  int len = atom*(hi-lo);
+
+  REAL32* x_ptr = &(a->x_ptr[low]);
+  REAL32* y_ptr = &(a->y_ptr[low]);
+  REAL32* z_ptr = &(a->z_ptr[low]);
+
+  S::V a_re = S::set1(a->a_re);
+  S::V a_im = S::setIm(a->a_im);
+  S::V b_re = S::set1(a->b_re);
+  S::V b_im = S::setIm(a->b_im);
+
+  for(int count = 0; count < len; count += S::W) { 
+    int n = len - count;
+
+    S::V x = S::load(&x_ptr[count], n);
+    S::V y = S::load(&y_ptr[count], n);
+    S::V z = S::load(&z_ptr[count], n);
+
+    // x = x + a*y + b*z
+    x = S::madd(a_im, S::swap(y), S::madd(a_re, y, x));
+    x = S::madd(b_im, S::swap(z), S::madd(b_re, z, x));
+    S::store(&x_ptr[count], x, n);
+  }
+}
@@ -0,0 +1,36 @@
+// Vector body of ord_yxpaymabz_kernel, compiled once per instruction set.
+// Included by ord_yxpaymabz_kernel.h inside the AVX2 and AVX512 namespaces.
+
+inline
+void ord_yxpaymabz_kernel(int lo, int hi, int my_id, ord_yxpaymabz_arg* a)
+{
+  typedef Simd<REAL32> S;
+
+  int atom = a->atom;
+  int low = atom*lo;
+  int len = atom*(hi-lo);
+
+  REAL32* x_ptr = &(a->x_ptr[low]);
+  REAL32* y_ptr = &(a->y_ptr[low]);
+  REAL32* z_ptr = &(a->z_ptr[low]);
+
+  S::V a_re = S::set1(a->a_re);
+  S::V a_im = S::setIm(a->a_im);
+  S::V b_re = S::set1(a->b_re);
+  S::V b_im = S::setIm(a->b_im);
+
+  for(int count = 0; count < len; count += S::W) { 
+    int n = len - count;
+
+    S::V x = S::load(&x_ptr[count], n);
+    S::V y = S::load(&y_ptr[count], n);
+    S::V z = S::load(&z_ptr[count], n);
+
+    // tmp = y - b*z
+    S::V tmp = S::nmadd(b_im, S::swap(z), S::nmadd(b_re, z, y));
+
+    // y = x + a*tmp
+    y = S::madd(a_im, S::swap(tmp), S::madd(a_re, tmp, x));
+    S::store(&y_ptr[count], y, n);
+  }
+}
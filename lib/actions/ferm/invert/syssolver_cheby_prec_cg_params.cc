@@ -0,0 +1,78 @@
+/*! \file
+ *  \brief Params of the Chebyshev preconditioned CG inverter
+ */
+
+#include "actions/ferm/invert/syssolver_cheby_prec_cg_params.h"
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, SysSolverChebyPrecCGParams& param)
+  {
+    SysSolverChebyPrecCGParams tmp;
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "RsdCG", tmp.RsdCG);
+    read(paramtop, "MaxCG", tmp.MaxCG);
+
+    if( paramtop.count("ChebyOrder") > 0 )
+      read(paramtop, "ChebyOrder", tmp.ChebyOrder);
+
+    if( paramtop.count("LanczosIter") > 0 )
+      read(paramtop, "LanczosIter", tmp.LanczosIter);
+
+    if( paramtop.count("LambdaMin") > 0 )
+      read(paramtop, "LambdaMin", tmp.LambdaMin);
+
+    if( paramtop.count("LambdaMax") > 0 )
+      read(paramtop, "LambdaMax", tmp.LambdaMax);
+
+    if( paramtop.count("LambdaMaxFactor") > 0 )
+      read(paramtop, "LambdaMaxFactor", tmp.LambdaMaxFactor);
+
+    if (tmp.ChebyOrder < 1 || tmp.LanczosIter < 2)
+    {
+      QDPIO::cerr << __func__ << ": need ChebyOrder >= 1 and LanczosIter >= 2" << std::endl;
+      QDP_abort(1);
+    }
+
+    param = tmp;
+  }
+
+  // Writer parameters
+  void write(XMLWriter& xml, const std::string& path, const SysSolverChebyPrecCGParams& param)
+  {
+    push(xml, path);
+
+    write(xml, "invType", "CHEBY_PREC_CG_INVERTER");
+    write(xml, "RsdCG", param.RsdCG);
+    write(xml, "MaxCG", param.MaxCG);
+    write(xml, "ChebyOrder", param.ChebyOrder);
+    write(xml, "LanczosIter", param.LanczosIter);
+    write(xml, "LambdaMin", param.LambdaMin);
+    write(xml, "LambdaMax", param.LambdaMax);
+    write(xml, "LambdaMaxFactor", param.LambdaMaxFactor);
+
+    pop(xml);
+  }
+
+  //! Default constructor
+  SysSolverChebyPrecCGParams::SysSolverChebyPrecCGParams()
+  {
+    RsdCG = zero;
+    MaxCG = 0;
+    ChebyOrder = 8;
+    LanczosIter = 20;
+    LambdaMin = zero;
+    LambdaMax = zero;
+    LambdaMaxFactor = 1.05;
+  }
+
+  //! Read parameters
+  SysSolverChebyPrecCGParams::SysSolverChebyPrecCGParams(XMLReader& xml, const std::string& path)
+  {
+    read(xml, path, *this);
+  }
+
+}
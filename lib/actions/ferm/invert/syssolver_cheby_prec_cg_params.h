@@ -0,0 +1,43 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Params of the Chebyshev preconditioned CG inverter
+ */
+
+#ifndef __syssolver_cheby_prec_cg_params_h__
+#define __syssolver_cheby_prec_cg_params_h__
+
+#include "chromabase.h"
+
+
+namespace Chroma
+{
+
+  //! Params for the Chebyshev preconditioned CG inverter
+  /*! \ingroup invert */
+  struct SysSolverChebyPrecCGParams
+  {
+    SysSolverChebyPrecCGParams();
+    SysSolverChebyPrecCGParams(XMLReader& in, const std::string& path);
+
+    Real          RsdCG;           /*!< CG residual */
+    int           MaxCG;           /*!< Maximum CG iterations */
+
+    int           ChebyOrder;      /*!< Chebyshev steps per preconditioner application */
+    int           LanczosIter;     /*!< Lanczos steps of the spectral bound estimate */
+    Real          LambdaMin;       /*!< Lower spectral bound, estimated if not positive */
+    Real          LambdaMax;       /*!< Upper spectral bound, estimated if not positive */
+    Real          LambdaMaxFactor; /*!< Safety factor on the estimated upper bound */
+  };
+
+
+  // Reader/writers
+  /*! \ingroup invert */
+  void read(XMLReader& xml, const std::string& path, SysSolverChebyPrecCGParams& param);
+
+  /*! \ingroup invert */
+  void write(XMLWriter& xml, const std::string& path, const SysSolverChebyPrecCGParams& param);
+
+} // End namespace
+
+#endif
+
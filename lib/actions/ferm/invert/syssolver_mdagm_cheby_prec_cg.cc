@@ -0,0 +1,71 @@
+/*! \file
+ *  \brief Solve a MdagM*psi=chi linear system by Chebyshev preconditioned CG
+ */
+
+#include "actions/ferm/invert/syssolver_mdagm_factory.h"
+#include "actions/ferm/invert/syssolver_mdagm_aggregate.h"
+
+#include "actions/ferm/invert/syssolver_mdagm_cheby_prec_cg.h"
+
+namespace Chroma
+{
+
+  //! Chebyshev preconditioned CG system solver namespace
+  namespace MdagMSysSolverChebyPrecCGEnv
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      //! Name to be used
+      const std::string name("CHEBY_PREC_CG_INVERTER");
+
+      //! Local registration flag
+      bool registered = false;
+    }
+
+
+    //! Callback function
+    MdagMSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state, 
+
+						  Handle< LinearOperator<LatticeFermion> > A)
+    {
+      return new MdagMSysSolverChebyPrecCG<LatticeFermion>(A, SysSolverChebyPrecCGParams(xml_in, path));
+    }
+
+    //! Callback function
+    MdagMSystemSolver<LatticeFermionF>* createFermF(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermionF, multi1d<LatticeColorMatrixF>, multi1d<LatticeColorMatrixF> > > state, 
+
+						  Handle< LinearOperator<LatticeFermionF> > A)
+    {
+      return new MdagMSysSolverChebyPrecCG<LatticeFermionF>(A, SysSolverChebyPrecCGParams(xml_in, path));
+    }
+
+    //! Callback function
+    MdagMSystemSolver<LatticeFermionD>* createFermD(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermionD, multi1d<LatticeColorMatrixD>, multi1d<LatticeColorMatrixD> > > state, 
+
+						  Handle< LinearOperator<LatticeFermionD> > A)
+    {
+      return new MdagMSysSolverChebyPrecCG<LatticeFermionD>(A, SysSolverChebyPrecCGParams(xml_in, path));
+    }
+
+    //! Register all the factories
+    bool registerAll() 
+    {
+      bool success = true; 
+      if (! registered)
+      {
+	success &= Chroma::TheMdagMFermSystemSolverFactory::Instance().registerObject(name, createFerm);
+	success &= Chroma::TheMdagMFermFSystemSolverFactory::Instance().registerObject(name, createFermF);
+	success &= Chroma::TheMdagMFermDSystemSolverFactory::Instance().registerObject(name, createFermD);
+	registered = true;
+      }
+      return success;
+    }
+  }
+}
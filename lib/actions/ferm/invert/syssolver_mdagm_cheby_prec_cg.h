@@ -0,0 +1,141 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a MdagM*psi=chi linear system by Chebyshev preconditioned CG
+ */
+
+#ifndef __syssolver_mdagm_cheby_prec_cg_h__
+#define __syssolver_mdagm_cheby_prec_cg_h__
+
+#include "handle.h"
+#include "syssolver.h"
+#include "linearop.h"
+#include "lmdagm.h"
+#include "actions/ferm/invert/syssolver_mdagm.h"
+#include "actions/ferm/invert/syssolver_cheby_prec_cg_params.h"
+#include "actions/ferm/invert/invcg2_cheby_prec.h"
+
+
+namespace Chroma
+{
+
+  //! Chebyshev preconditioned CG system solver namespace
+  namespace MdagMSysSolverChebyPrecCGEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M^dag M system by Chebyshev preconditioned CG
+  /*! \ingroup invert
+   *
+   * Bounds of the spectrum of M^dag M that are not given in the parameters
+   * are estimated with a few Lanczos steps from the first source, and kept
+   * for the later solves with the same solver.
+   */
+  template<typename T>
+  class MdagMSysSolverChebyPrecCG : public MdagMSystemSolver<T>
+  {
+  public:
+    //! Constructor
+    /*!
+     * \param M_        Linear operator ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    MdagMSysSolverChebyPrecCG(Handle< LinearOperator<T> > A_,
+			      const SysSolverChebyPrecCGParams& invParam_) : 
+      A(A_), invParam(invParam_), lambda_min(invParam_.LambdaMin), lambda_max(invParam_.LambdaMax)
+      {}
+
+    //! Destructor is automatic
+    ~MdagMSysSolverChebyPrecCG() {}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const
+      {
+	START_CODE();
+	StopWatch swatch;
+	swatch.reset(); swatch.start();
+
+	SystemSolverResults_t res;
+
+	if (toBool(norm2(chi, A->subset()) == zero))
+	{
+	  psi[A->subset()] = zero;
+	  END_CODE();
+	  return res;
+	}
+
+	if (toBool(lambda_min <= zero) || toBool(lambda_max <= zero))
+	{
+	  Real lmin, lmax;
+	  lanczosBoundsMdagM(*A, chi, invParam.LanczosIter, lmin, lmax);
+
+	  if (toBool(lambda_min <= zero))
+	    lambda_min = lmin;
+	  if (toBool(lambda_max <= zero))
+	    lambda_max = invParam.LambdaMaxFactor * lmax;
+	}
+
+	res = InvCG2ChebyPrec(*A, chi, psi, lambda_min, lambda_max, invParam.ChebyOrder,
+			      invParam.RsdCG, invParam.MaxCG);
+
+	swatch.stop();
+	QDPIO::cout << "CHEBY_PREC_CG_SOLVER: " << res.n_count 
+		    << " iterations. Rsd = " << res.resid 
+		    << " Relative Rsd = " << res.resid/sqrt(norm2(chi,A->subset())) << std::endl;
+	QDPIO::cout << "CHEBY_PREC_CG_SOLVER_TIME: " << swatch.getTimeInSeconds() << " sec" << std::endl;
+
+	END_CODE();
+
+	return res;
+      }
+
+
+    //! Solve the linear system starting with a chrono guess 
+    /*! 
+     * \param psi solution (Write)
+     * \param chi source   (Read)
+     * \param predictor   a chronological predictor (Read)
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator()(T& psi, const T& chi, 
+				     AbsChronologicalPredictor4D<T>& predictor) const 
+    {
+      START_CODE();
+
+      {
+	Handle< LinearOperator<T> > MdagM( new MdagMLinOp<T>(A) );
+	predictor(psi, (*MdagM), chi);
+      }
+
+      SystemSolverResults_t res=(*this)(psi,chi);
+
+      predictor.newVector(psi);
+      END_CODE();
+      return res;
+    }
+
+  private:
+    // Hide default constructor
+    MdagMSysSolverChebyPrecCG() {}
+
+    Handle< LinearOperator<T> > A;
+    SysSolverChebyPrecCGParams invParam;
+    mutable Real lambda_min;
+    mutable Real lambda_max;
+  };
+
+
+} // End namespace
+
+#endif 
+
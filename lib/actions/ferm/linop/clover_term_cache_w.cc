@@ -0,0 +1,169 @@
+/*! \file
+ *  \brief Cache of clover terms shared by the clover linops
+ */
+
+#include "actions/ferm/linop/clover_term_cache_w.h"
+
+namespace Chroma
+{
+
+  namespace
+  {
+    //! The key of the params
+    /*!
+     * The write of CloverFermActParams leaves out the anisotropy, so
+     * all fields are written here.
+     */
+    std::string paramKey(const CloverFermActParams& param)
+    {
+      XMLBufferWriter xml;
+      push(xml, "CloverParams");
+
+      write(xml, "Mass", param.Mass);
+      write(xml, "u0", param.u0);
+      write(xml, "clovCoeffR", param.clovCoeffR);
+      write(xml, "clovCoeffT", param.clovCoeffT);
+      write(xml, "AnisoParam", param.anisoParam);
+
+      write(xml, "max_norm_usedP", param.max_norm_usedP);
+      if (param.max_norm_usedP)
+	write(xml, "MaxNorm", param.max_norm);
+
+      write(xml, "sub_zero_usedP", param.sub_zero_usedP);
+      if (param.sub_zero_usedP)
+	write(xml, "SubZero", param.sub_zero);
+
+      write(xml, "twisted_m_usedP", param.twisted_m_usedP);
+      if (param.twisted_m_usedP)
+	write(xml, "TwistedM", param.twisted_m);
+
+      pop(xml);
+      return xml.str();
+    }
+  }
+
+
+  // Fingerprint of the links
+  multi1d<DComplex> CloverTermCache::fingerprint(const multi1d<LatticeColorMatrix>& u)
+  {
+    if (! weightsP)
+    {
+      // Draw the weights from a fixed seed and put the RNG back
+      QDP::Seed saved;
+      RNG::savern(saved);
+
+      QDP::Seed fixed;
+      fixed = 20011;
+      RNG::setrn(fixed);
+
+      gaussian(weight);
+      gaussian(proj);
+
+      RNG::setrn(saved);
+      weightsP = true;
+    }
+
+    multi1d<DComplex> fp(u.size());
+    for(int mu=0; mu < u.size(); ++mu)
+      fp[mu] = sum(weight * trace(proj * u[mu]));
+
+    return fp;
+  }
+
+
+  // Set the number of entries kept
+  void CloverTermCache::setMaxEntries(int n)
+  {
+    max_entries = (n > 0) ? n : 0;
+
+    while (int(entries.size()) > max_entries)
+      entries.pop_back();
+  }
+
+
+  // Clover term and its even-even inverse for the links of fs
+  void CloverTermCache::get(Handle<CloverTerm>& clov, Handle<CloverTerm>& invclov,
+			    Handle< FermState<T,P,Q> > fs,
+			    const CloverFermActParams& param)
+  {
+    START_CODE();
+
+    if (max_entries == 0)
+    {
+      clov = new CloverTerm;
+      clov->create(fs, param);
+
+      invclov = new CloverTerm;
+      invclov->create(fs, param, *clov);  // make a copy
+      invclov->choles(0);  // invert the cb=0 part
+
+      END_CODE();
+      return;
+    }
+
+    // The key
+    std::string param_xml = paramKey(param);
+    multi1d<DComplex> fp = fingerprint(fs->getLinks());
+
+    // Look it up
+    for(std::list<Entry>::iterator e = entries.begin(); e != entries.end(); ++e)
+    {
+      if (e->param_xml != param_xml || e->fingerprint.size() != fp.size())
+	continue;
+
+      bool match = true;
+      for(int mu=0; mu < fp.size(); ++mu)
+	match &= toBool(e->fingerprint[mu] == fp[mu]);
+
+      if (! match)
+	continue;
+
+      ++hits;
+      clov = e->clov;
+      invclov = e->invclov;
+
+      // Move to the front
+      entries.splice(entries.begin(), entries, e);
+
+      END_CODE();
+      return;
+    }
+
+    // Missed, build it
+    ++misses;
+
+    Entry entry;
+    entry.param_xml = param_xml;
+    entry.fingerprint = fp;
+
+    entry.clov = new CloverTerm;
+    entry.clov->create(fs, param);
+
+    entry.invclov = new CloverTerm;
+    entry.invclov->create(fs, param, *entry.clov);  // make a copy
+    entry.invclov->choles(0);  // invert the cb=0 part
+
+    clov = entry.clov;
+    invclov = entry.invclov;
+
+    // The links of the old entry with these params are superseded
+    for(std::list<Entry>::iterator e = entries.begin(); e != entries.end(); ++e)
+    {
+      if (e->param_xml == param_xml)
+      {
+	entries.erase(e);
+	break;
+      }
+    }
+
+    entries.push_front(entry);
+    while (int(entries.size()) > max_entries)
+      entries.pop_back();
+
+    QDPIO::cout << "CloverTermCache: built a clover term, hits = " << hits
+		<< "  misses = " << misses << std::endl;
+
+    END_CODE();
+  }
+
+} // End Namespace Chroma
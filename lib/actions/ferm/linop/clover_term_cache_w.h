@@ -0,0 +1,116 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Cache of clover terms shared by the clover linops
+ */
+
+#ifndef __clover_term_cache_w_h__
+#define __clover_term_cache_w_h__
+
+#include "chromabase.h"
+#include "singleton.h"
+#include "handle.h"
+#include "state.h"
+#include "actions/ferm/fermacts/clover_fermact_params_w.h"
+#include "actions/ferm/linop/clover_term_w.h"
+
+#include <list>
+
+namespace Chroma
+{
+
+  //! Clover terms shared by all linops built on the same links
+  /*!
+   * \ingroup linop
+   *
+   * In an HMC step several monomials, often on different integrator
+   * levels, build a clover linop on the same (possibly smeared) gauge
+   * field, each computing the field strength, the clover term and the
+   * Cholesky inverse of its even-even block again. This cache keeps
+   * the clover term A and the term with the even-even block inverted
+   * for the last few link fields and params, so only the first linop
+   * on a gauge field builds them.
+   *
+   * An entry belongs to the links of the FermState, recognised by a
+   * fingerprint, and to all fields of the CloverFermActParams including
+   * the anisotropy. The fingerprint of direction mu is
+   * sum_x w(x) tr(R U_mu(x))  with fixed random complex site weights w
+   * and a fixed random colour matrix R, so e.g. links that only differ
+   * by a gauge transformation, a permutation of sites or a boundary
+   * phase do not collide. The weights are drawn once from a fixed seed,
+   * leaving the state of the RNG untouched. Monomials with their own
+   * FermState on the same links still share the terms. New links, e.g.
+   * after a leapQ or a rejected trajectory, miss, and their entry
+   * replaces the one of the same params on the superseded links, so one
+   * entry is kept per param set. The least recently used param set is
+   * dropped once more than  max_entries  are held. The HMC sets this
+   * with  CloverTermCacheEntries  in its MCControl.
+   *
+   * The cached terms are shared, not copied, so users must only call
+   * their const methods.
+   */
+  class CloverTermCache
+  {
+  public:
+    // Typedefs to save typing
+    typedef LatticeFermion               T;
+    typedef multi1d<LatticeColorMatrix>  P;
+    typedef multi1d<LatticeColorMatrix>  Q;
+
+    //! Constructor
+    CloverTermCache() : max_entries(4), hits(0), misses(0), weightsP(false) {}
+
+    //! Clover term and its even-even inverse for the links of fs
+    /*!
+     * \param clov     clover term                                (Write)
+     * \param invclov  clover term with the cb=0 part inverted    (Write)
+     * \param fs       fermion state                              (Read)
+     * \param param    clover params                              (Read)
+     */
+    void get(Handle<CloverTerm>& clov, Handle<CloverTerm>& invclov,
+	     Handle< FermState<T,P,Q> > fs,
+	     const CloverFermActParams& param);
+
+    //! Set the number of entries (param sets) kept. 0 disables caching
+    void setMaxEntries(int n);
+
+    //! Number of entries held
+    int size() const {return entries.size();}
+
+    //! Drop all entries
+    void clear() {entries.clear();}
+
+  private:
+    //! Fingerprint of the links
+    multi1d<DComplex> fingerprint(const multi1d<LatticeColorMatrix>& u);
+
+    //! An entry of the cache
+    struct Entry
+    {
+      std::string         param_xml;    /*!< serialised params */
+      multi1d<DComplex>   fingerprint;  /*!< weighted traces of the links */
+      Handle<CloverTerm>  clov;
+      Handle<CloverTerm>  invclov;
+    };
+
+    int              max_entries;
+    unsigned long    hits;
+    unsigned long    misses;
+    std::list<Entry> entries;   /*!< most recently used first */
+
+    bool             weightsP;  /*!< are the fingerprint weights drawn */
+    LatticeComplex   weight;    /*!< site weights of the fingerprint */
+    ColorMatrix      proj;      /*!< colour projection of the fingerprint */
+  };
+
+
+  //! The one clover term cache
+  /*! \ingroup linop */
+  typedef SingletonHolder<CloverTermCache,
+			  QDP::CreateUsingNew,
+			  QDP::NoDestroy,
+			  QDP::SingleThreaded> TheCloverTermCache;
+
+} // End Namespace Chroma
+
+
+#endif
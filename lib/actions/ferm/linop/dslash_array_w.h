@@ -35,6 +35,13 @@ namespace Chroma {
 typedef PABWilsonDslashArray WilsonDslashArray;
 }  // end namespace Chroma
 
+#elif defined BUILD_OVERLAP_WILSON_DSLASH
+// The QDP dslash with the halo exchange overlapped with the interior sites
+# include "lwldslash_array_overlap_w.h"
+namespace Chroma {
+typedef QDPWilsonDslashArrayOverlap WilsonDslashArray;
+}  // end namespace Chroma
+
 #else
 
 // Bottom line, if no optimised Dslash-s exist then the naive QDP Dslash
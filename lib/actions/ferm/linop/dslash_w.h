@@ -100,6 +100,17 @@ namespace Chroma {
 #endif
 
 
+}  // end namespace Chroma
+
+#elif defined BUILD_OVERLAP_WILSON_DSLASH
+// The QDP dslash with the halo exchange overlapped with the interior sites
+# include "lwldslash_overlap_w.h"
+namespace Chroma {
+
+  typedef QDPWilsonDslashOverlap WilsonDslash;
+  typedef QDPWilsonDslashOverlapF WilsonDslashF;
+  typedef QDPWilsonDslashOverlapD WilsonDslashD;
+
 }  // end namespace Chroma
 
 #else
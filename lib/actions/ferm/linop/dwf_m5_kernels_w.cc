@@ -0,0 +1,329 @@
+/*! \file
+ *  \brief Fused fifth dimension kernels of the domain-wall like operators
+ */
+
+#include "actions/ferm/linop/dwf_m5_kernels_w.h"
+
+namespace Chroma
+{
+  namespace DWFM5Kernels
+  {
+    namespace
+    {
+      //! Reals in one spinor and in one chiral half of it
+      const int spinor_len = Nc*Ns*2;
+      const int half_len   = Nc*(Ns/2)*2;
+
+      //! Bytes of source plus result kept in cache by one site block
+      const size_t block_bytes = 128*1024;
+
+      //! Number of 4D sites in one block
+      int blockSites(int N5)
+      {
+	int n = block_bytes / (2*N5*spinor_len*sizeof(REAL));
+	return (n > 0) ? n : 1;
+      }
+
+      //! Offsets of the chiral halves
+      /*!
+       * The forward half couples to s-1 and is the P_+ (upper) half for PLUS,
+       * the backward half couples to s+1.
+       */
+      void chiralOffsets(enum PlusMinus isign, int& f, int& k)
+      {
+	f = (isign == PLUS) ? 0 : half_len;
+	k = half_len - f;
+      }
+
+      //! Base pointers of the s slices
+      void slicePointers(multi1d<REAL*>& p, multi1d<LatticeFermion>& v)
+      {
+	p.resize(v.size());
+	for(int s=0; s < v.size(); ++s)
+	  p[s] = (REAL*)&(v[s].elem(0).elem(0).elem(0).real());
+      }
+
+      void slicePointers(multi1d<const REAL*>& p, const multi1d<LatticeFermion>& v)
+      {
+	p.resize(v.size());
+	for(int s=0; s < v.size(); ++s)
+	  p[s] = (const REAL*)&(v[s].elem(0).elem(0).elem(0).real());
+      }
+
+
+      //! Arguments of the M5 site loop
+      struct M5Args
+      {
+	multi1d<REAL*>        chi;
+	multi1d<const REAL*>  psi;
+	multi1d<const REAL*>  y;      /*!< subtracted vector, empty if none */
+	REAL diag;
+	REAL hop;
+	REAL wall;                    /*!< -m_q hop */
+	int  f;
+	int  k;
+	int  cb;
+      };
+
+
+      //! chi = M5 psi (- y) on the sites [lo,hi) of the checkerboard
+      void m5SiteLoop(int lo, int hi, int myId, M5Args* a)
+      {
+	const multi1d<int>& tab = rb[a->cb].siteTable();
+	const int N5 = a->psi.size();
+	const int nb = blockSites(N5);
+	const int f = a->f;
+	const int k = a->k;
+	const REAL diag = a->diag;
+	const bool sub = (a->y.size() > 0);
+
+	for(int b=lo; b < hi; b += nb)
+	{
+	  int e = (b+nb < hi) ? b+nb : hi;
+
+	  for(int s=0; s < N5; ++s)
+	  {
+	    REAL* c        = a->chi[s];
+	    const REAL* p  = a->psi[s];
+	    const REAL* pm = a->psi[(s == 0) ? N5-1 : s-1];
+	    const REAL* pp = a->psi[(s == N5-1) ? 0 : s+1];
+	    const REAL cm  = (s == 0) ? a->wall : a->hop;
+	    const REAL cp  = (s == N5-1) ? a->wall : a->hop;
+
+	    for(int ssite=b; ssite < e; ++ssite)
+	    {
+	      const int off = spinor_len*tab[ssite];
+
+	      for(int i=0; i < half_len; ++i)
+	      {
+		c[off+f+i] = diag*p[off+f+i] - cm*pm[off+f+i];
+		c[off+k+i] = diag*p[off+k+i] - cp*pp[off+k+i];
+	      }
+
+	      if (sub)
+	      {
+		const REAL* y = a->y[s];
+		for(int i=0; i < spinor_len; ++i)
+		  c[off+i] -= y[off+i];
+	      }
+	    }
+	  }
+	}
+      }
+
+
+      //! Arguments of the M5 inverse site loop
+      struct M5InvArgs
+      {
+	multi1d<REAL*>        chi;
+	multi1d<const REAL*>  psi;
+	multi1d<REAL>         lcorner;  /*!< m_q invD a r^(s+1), corner row of the backward half */
+	multi1d<REAL>         rcorner;  /*!< m_q r^(s+1), Rm correction of the forward half */
+	REAL a;
+	REAL r;
+	REAL invDa;
+	REAL invDr;
+	int  f;
+	int  k;
+	int  cb;
+      };
+
+
+      //! chi = M5^{-1} psi on the sites [lo,hi) of the checkerboard
+      void m5InvSiteLoop(int lo, int hi, int myId, M5InvArgs* arg)
+      {
+	const multi1d<int>& tab = rb[arg->cb].siteTable();
+	const int N5 = arg->psi.size();
+	const int nb = blockSites(N5);
+	const int f = arg->f;
+	const int k = arg->k;
+	const REAL a = arg->a;
+	const REAL r = arg->r;
+
+	REAL* cl = arg->chi[N5-1];
+
+	for(int b=lo; b < hi; b += nb)
+	{
+	  int e = (b+nb < hi) ? b+nb : hi;
+
+	  // Forward sweep: L^{-1} on the forward half, the corner row on the
+	  // backward half accumulated into the last slice
+	  for(int s=0; s < N5-1; ++s)
+	  {
+	    REAL* c        = arg->chi[s];
+	    const REAL* p  = arg->psi[s];
+	    const REAL ls  = arg->lcorner[s];
+
+	    if (s == 0)
+	    {
+	      const REAL* pl = arg->psi[N5-1];
+
+	      for(int ssite=b; ssite < e; ++ssite)
+	      {
+		const int off = spinor_len*tab[ssite];
+
+		for(int i=0; i < half_len; ++i)
+		{
+		  c[off+f+i]  = a*p[off+f+i];
+		  c[off+k+i]  = a*p[off+k+i];
+		  cl[off+k+i] = arg->invDa*pl[off+k+i] - ls*p[off+k+i];
+		}
+	      }
+	    }
+	    else
+	    {
+	      const REAL* cm = arg->chi[s-1];
+
+	      for(int ssite=b; ssite < e; ++ssite)
+	      {
+		const int off = spinor_len*tab[ssite];
+
+		for(int i=0; i < half_len; ++i)
+		{
+		  c[off+f+i]   = a*p[off+f+i] + r*cm[off+f+i];
+		  c[off+k+i]   = a*p[off+k+i];
+		  cl[off+k+i] -= ls*p[off+k+i];
+		}
+	      }
+	    }
+	  }
+
+	  // Last slice of the forward half
+	  {
+	    const REAL* cm = arg->chi[N5-2];
+	    const REAL* pl = arg->psi[N5-1];
+
+	    for(int ssite=b; ssite < e; ++ssite)
+	    {
+	      const int off = spinor_len*tab[ssite];
+
+	      for(int i=0; i < half_len; ++i)
+		cl[off+f+i] = arg->invDa*pl[off+f+i] + arg->invDr*cm[off+f+i];
+	    }
+	  }
+
+	  // Backward sweep: U^{-1} on the backward half, Rm^{-1} on the forward half
+	  for(int s=N5-2; s >= 0; --s)
+	  {
+	    REAL* c        = arg->chi[s];
+	    const REAL* cp = arg->chi[s+1];
+	    const REAL rs  = arg->rcorner[s];
+
+	    for(int ssite=b; ssite < e; ++ssite)
+	    {
+	      const int off = spinor_len*tab[ssite];
+
+	      for(int i=0; i < half_len; ++i)
+	      {
+		c[off+f+i] -= rs*cl[off+f+i];
+		c[off+k+i] += r*cp[off+k+i];
+	      }
+	    }
+	  }
+	}
+      }
+
+
+      //! Common part of applyM5 and applyM5MinusY
+      void applyM5Impl(multi1d<LatticeFermion>& chi,
+		       const multi1d<LatticeFermion>& psi,
+		       const multi1d<LatticeFermion>* y,
+		       const Real& diag, const Real& hop, const Real& m_q,
+		       enum PlusMinus isign, int cb)
+      {
+	const int N5 = psi.size();
+	if (chi.size() != N5) chi.resize(N5);
+
+	M5Args args;
+	slicePointers(args.chi, chi);
+	slicePointers(args.psi, psi);
+	if (y != 0)
+	  slicePointers(args.y, *y);
+
+	args.diag = toDouble(diag);
+	args.hop  = toDouble(hop);
+	args.wall = -toDouble(m_q*hop);
+	chiralOffsets(isign, args.f, args.k);
+	args.cb = cb;
+
+	dispatch_to_threads(rb[cb].numSiteTable(), args, m5SiteLoop);
+      }
+    }
+
+
+    // Apply the diagonal block
+    void applyM5(multi1d<LatticeFermion>& chi,
+		 const multi1d<LatticeFermion>& psi,
+		 const Real& diag, const Real& hop, const Real& m_q,
+		 enum PlusMinus isign, int cb)
+    {
+      START_CODE();
+
+      applyM5Impl(chi, psi, 0, diag, hop, m_q, isign, cb);
+
+      END_CODE();
+    }
+
+
+    // Apply the diagonal block and subtract a vector
+    void applyM5MinusY(multi1d<LatticeFermion>& chi,
+		       const multi1d<LatticeFermion>& psi,
+		       const multi1d<LatticeFermion>& y,
+		       const Real& diag, const Real& hop, const Real& m_q,
+		       enum PlusMinus isign, int cb)
+    {
+      START_CODE();
+
+      applyM5Impl(chi, psi, &y, diag, hop, m_q, isign, cb);
+
+      END_CODE();
+    }
+
+
+    // Apply the inverse of the diagonal block
+    void applyM5Inv(multi1d<LatticeFermion>& chi,
+		    const multi1d<LatticeFermion>& psi,
+		    const Real& a, const Real& r, const Real& invD, const Real& m_q,
+		    enum PlusMinus isign, int cb)
+    {
+      START_CODE();
+
+      const int N5 = psi.size();
+      if (chi.size() != N5) chi.resize(N5);
+
+      if (N5 < 2)
+      {
+	QDPIO::cerr << __func__ << ": need N5 >= 2, got N5=" << N5 << std::endl;
+	QDP_abort(1);
+      }
+
+      M5InvArgs args;
+      slicePointers(args.chi, chi);
+      slicePointers(args.psi, psi);
+
+      args.lcorner.resize(N5);
+      args.rcorner.resize(N5);
+      Real lfact = m_q*invD*a*r;
+      Real rfact = m_q*r;
+      for(int s=0; s < N5; ++s)
+      {
+	args.lcorner[s] = toDouble(lfact);
+	args.rcorner[s] = toDouble(rfact);
+	lfact *= r;
+	rfact *= r;
+      }
+
+      args.a     = toDouble(a);
+      args.r     = toDouble(r);
+      args.invDa = toDouble(invD*a);
+      args.invDr = toDouble(invD*r);
+      chiralOffsets(isign, args.f, args.k);
+      args.cb = cb;
+
+      dispatch_to_threads(rb[cb].numSiteTable(), args, m5InvSiteLoop);
+
+      END_CODE();
+    }
+  }
+
+} // End Namespace Chroma
@@ -0,0 +1,93 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Fused fifth dimension kernels of the domain-wall like operators
+ */
+
+#ifndef __dwf_m5_kernels_w_h__
+#define __dwf_m5_kernels_w_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+  //! Fused fifth dimension kernels of the domain-wall like operators
+  /*!
+   * \ingroup linop
+   *
+   * The checkerboard diagonal block of the 4D even-odd preconditioned
+   * domain-wall (and NEF) operator only couples the N5 spinors of one 4D
+   * site. In the DeGrand-Rossi basis the chiral projectors select the upper
+   * (P_+) and lower (P_-) two spin components, so the block is two bidiagonal
+   * N5 x N5 matrices with a corner element, one for each chirality.
+   *
+   * The kernels below apply the block and its inverse for all s at once on
+   * blocks of 4D sites, small enough for the N5 spinors of the block to stay
+   * in cache. Each kernel reads its source and writes its result once,
+   * instead of sweeping the full 5D vectors once per term and per s.
+   */
+  namespace DWFM5Kernels
+  {
+    //! Apply the diagonal block
+    /*!
+     *  chi[s] = diag psi[s] - hop (P_+ psi[s-1] + P_- psi[s+1])
+     *
+     * with the mass term  -m_q  in place of the hopping at the walls.
+     * For isign = MINUS the projectors are swapped.
+     *
+     * \param chi     result                           (Write)
+     * \param psi     source                           (Read)
+     * \param diag    diagonal coefficient             (Read)
+     * \param hop     hopping coefficient              (Read)
+     * \param m_q     quark mass                       (Read)
+     * \param isign   Flag ( PLUS | MINUS )            (Read)
+     * \param cb      checkerboard ( 0 | 1 )           (Read)
+     */
+    void applyM5(multi1d<LatticeFermion>& chi,
+		 const multi1d<LatticeFermion>& psi,
+		 const Real& diag, const Real& hop, const Real& m_q,
+		 enum PlusMinus isign, int cb);
+
+    //! Apply the diagonal block and subtract a vector:  chi = M5 psi - y
+    /*!
+     * \param chi     result                           (Write)
+     * \param psi     source                           (Read)
+     * \param y       subtracted vector                (Read)
+     * \param diag    diagonal coefficient             (Read)
+     * \param hop     hopping coefficient              (Read)
+     * \param m_q     quark mass                       (Read)
+     * \param isign   Flag ( PLUS | MINUS )            (Read)
+     * \param cb      checkerboard ( 0 | 1 )           (Read)
+     */
+    void applyM5MinusY(multi1d<LatticeFermion>& chi,
+		       const multi1d<LatticeFermion>& psi,
+		       const multi1d<LatticeFermion>& y,
+		       const Real& diag, const Real& hop, const Real& m_q,
+		       enum PlusMinus isign, int cb);
+
+    //! Apply the inverse of the diagonal block
+    /*!
+     * The inverse of  M5 = (1/a) (1 - r P_+ S_- - r P_- S_+)  with the mass
+     * term at the walls, in the LDU form of the array operators: the forward
+     * elimination of L, the corner row of D^{-1} and the back substitution of
+     * U are done in one sweep in s per site block, followed by the Rm
+     * correction from the last slice.
+     *
+     * \param chi     result                           (Write)
+     * \param psi     source                           (Read)
+     * \param a       diagonal scale of the inverse    (Read)
+     * \param r       hopping ratio                    (Read)
+     * \param invD    1/(1 + m_q r^N5) type factor     (Read)
+     * \param m_q     quark mass                       (Read)
+     * \param isign   Flag ( PLUS | MINUS )            (Read)
+     * \param cb      checkerboard ( 0 | 1 )           (Read)
+     */
+    void applyM5Inv(multi1d<LatticeFermion>& chi,
+		    const multi1d<LatticeFermion>& psi,
+		    const Real& a, const Real& r, const Real& invD, const Real& m_q,
+		    enum PlusMinus isign, int cb);
+  }
+
+} // End Namespace Chroma
+
+
+#endif
@@ -11,6 +11,7 @@
 #include "eoprec_logdet_linop.h"
 #include "actions/ferm/fermacts/clover_fermact_params_w.h"
 #include "actions/ferm/linop/dslash_w.h"
+#include "actions/ferm/linop/lwldslash_compressed_w.h"
 #include "actions/ferm/linop/clover_term_w.h"
 
 
@@ -44,21 +45,39 @@ namespace Chroma
 				const CloverFermActParams& param_)
       {create(fs,param_);}
 
+    //! Full constructor with compressed links in the dslash
+    EvenOddPrecDumbCloverFLinOp(Handle< FermState<LatticeFermionF,P,Q> > fs,
+				const CloverFermActParams& param_,
+				const WilsonGaugeCompressionParams& comp_)
+      {create(fs,param_,comp_);}
+
     //! Destructor is automatic
     ~EvenOddPrecDumbCloverFLinOp() {}
 
     //! Return the fermion BC object for this linear operator
-    const FermBC<LatticeFermionF,P,Q>& getFermBC() const {return D.getFermBC();}
+    const FermBC<LatticeFermionF,P,Q>& getFermBC() const {return D->getFermBC();}
 
     //! Creation routine
     void create(Handle< FermState<LatticeFermionF,P,Q> > fs,
 		const CloverFermActParams& param_) {
+      create(fs, param_, WilsonGaugeCompressionParams());
+    }
+
+    //! Creation routine with compressed links in the dslash
+    /*! No compression (reconstruct 18 in single precision) uses the usual WilsonDslashF */
+    void create(Handle< FermState<LatticeFermionF,P,Q> > fs,
+		const CloverFermActParams& param_,
+		const WilsonGaugeCompressionParams& comp_) {
 
       param = param_;
       clov.create(fs, param);
       invclov.create(fs,param,clov);  // make a copy
       invclov.choles(0);  // invert the cb=0 part
-      D.create(fs, param.anisoParam);
+
+      if (comp_.reconstruct == 18 && ! comp_.half_precP)
+	D = new WilsonDslashF(fs, param.anisoParam);
+      else
+	D = new QDPWilsonDslashCompressedF(fs, param.anisoParam, comp_);
       
     }
 
@@ -74,11 +93,11 @@ namespace Chroma
       Real mquarter = -0.25;
       
       //  tmp1_o  =  D_oe   A^(-1)_ee  D_eo  psi_o
-      D.apply(tmp1, psi, isign, 0);
+      D->apply(tmp1, psi, isign, 0);
       
       invclov.apply(tmp2, tmp1, isign, 0);
       
-      D.apply(tmp1, tmp2, isign, 1);
+      D->apply(tmp1, tmp2, isign, 1);
       
       //  chi_o  =  A_oo  psi_o  -  tmp1_o
       clov.apply(chi, psi, isign, 1);
@@ -106,7 +125,7 @@ namespace Chroma
     //! Return flops performed by the operator()
     unsigned long nFlops() const 
     {
-      unsigned long cbsite_flops = 2*D.nFlops()+2*clov.nFlops()+4*Nc*Ns;
+      unsigned long cbsite_flops = 2*D->nFlops()+2*clov.nFlops()+4*Nc*Ns;
       if(  param.twisted_m_usedP ) { 
 	cbsite_flops += 4*Nc*Ns; // a + mu*b : a = chi, b = g_5 I psi
       }
@@ -120,7 +139,7 @@ namespace Chroma
 
   private:
     CloverFermActParams param;
-    WilsonDslashF D;
+    Handle< WilsonDslashBase<T,P,Q> > D;
     CloverTermF   clov;
     CloverTermF   invclov;  // uggh, only needed for evenEvenLinOp
   };
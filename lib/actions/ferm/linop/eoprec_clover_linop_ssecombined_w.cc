@@ -24,10 +24,8 @@ namespace Chroma
 
     param = param_;
 
-    clov.create(fs, param);
- 
-    invclov.create(fs,param,clov);  // make a copy
-    invclov.choles(0);  // invert the cb=0 part
+    // Shared with the other linops on the same links
+    TheCloverTermCache::Instance().get(clov, invclov, fs, param);
 
     D.create(fs, param.anisoParam);
 
@@ -46,7 +44,7 @@ namespace Chroma
     START_CODE();
 
     swatch.reset(); swatch.start();
-    clov.apply(chi, psi, isign, 1);
+    clov->apply(chi, psi, isign, 1);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
 
@@ -63,7 +61,7 @@ namespace Chroma
 
     // Nuke for testing
     swatch.reset(); swatch.start();
-    clov.apply(chi, psi, isign, 0);
+    clov->apply(chi, psi, isign, 0);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
     
@@ -78,7 +76,7 @@ namespace Chroma
     START_CODE();
 
     swatch.reset(); swatch.start();
-    invclov.apply(chi, psi, isign, 0);
+    invclov->apply(chi, psi, isign, 0);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
     
@@ -153,14 +151,14 @@ namespace Chroma
     sse_su3dslash_prepost_receives();
 
     //  chi_o  =  A_oo  psi_o  -  tmp1_o
-    clov.apply(chi, psi, isign, 1);
+    clov->apply(chi, psi, isign, 1);
   
     //  tmp1_o  =  D_oe   A^(-1)_ee  D_eo  psi_o
     D.apply(tmp1, psi, isign, 0);
 
     // Prepost receives for Dslash
     sse_su3dslash_prepost_receives();
-    invclov.apply(tmp2, tmp1, isign, 0);
+    invclov->apply(tmp2, tmp1, isign, 0);
     D.apply(tmp1, tmp2, isign, 1);
 
     //  chi_o  =  A_oo  psi_o  -  tmp1_o
@@ -179,7 +177,7 @@ namespace Chroma
     START_CODE();
     
     swatch.reset(); swatch.start();
-    clov.deriv(ds_u, chi, psi, isign, 0);
+    clov->deriv(ds_u, chi, psi, isign, 0);
     swatch.stop();
     clov_deriv_time  += swatch.getTimeInSeconds();
 
@@ -194,7 +192,7 @@ namespace Chroma
     START_CODE();
 
     // Testing Odd Odd Term - get nothing from even even term
-    invclov.derivTrLn(ds_u, isign, 0);
+    invclov->derivTrLn(ds_u, isign, 0);
     
     END_CODE();
   }
@@ -240,7 +238,7 @@ namespace Chroma
     START_CODE();
 
     swatch.reset(); swatch.start();
-    clov.deriv(ds_u, chi, psi, isign, 1);
+    clov->deriv(ds_u, chi, psi, isign, 1);
     swatch.stop();
     clov_deriv_time += swatch.getTimeInSeconds();
     
@@ -251,13 +249,13 @@ namespace Chroma
   //! Return flops performed by the operator()
   unsigned long EvenOddPrecCloverLinOp::nFlops() const
   {
-    unsigned long cbsite_flops = 2*D.nFlops()+2*clov.nFlops()+4*Nc*Ns;
+    unsigned long cbsite_flops = 2*D.nFlops()+2*clov->nFlops()+4*Nc*Ns;
     return cbsite_flops*(Layout::sitesOnNode()/2);
   }
 
   //! Get the log det of the even even part
   // BUt for now, return zero for testing.
   Double EvenOddPrecCloverLinOp::logDetEvenEvenLinOp(void) const  {
-    return invclov.cholesDet(0);
+    return invclov->cholesDet(0);
   }
 } // End Namespace Chroma
@@ -24,10 +24,8 @@ namespace Chroma
 
     param = param_;
 
-    clov.create(fs, param);
- 
-    invclov.create(fs,param,clov);  // make a copy
-    invclov.choles(0);  // invert the cb=0 part
+    // Shared with the other linops on the same links
+    TheCloverTermCache::Instance().get(clov, invclov, fs, param);
 
     D.create(fs, param.anisoParam);
 
@@ -46,7 +44,7 @@ namespace Chroma
     START_CODE();
 
     swatch.reset(); swatch.start();
-    clov.apply(chi, psi, isign, 1);
+    clov->apply(chi, psi, isign, 1);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
 
@@ -63,7 +61,7 @@ namespace Chroma
 
     // Nuke for testing
     swatch.reset(); swatch.start();
-    clov.apply(chi, psi, isign, 0);
+    clov->apply(chi, psi, isign, 0);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
     
@@ -78,7 +76,7 @@ namespace Chroma
     START_CODE();
 
     swatch.reset(); swatch.start();
-    invclov.apply(chi, psi, isign, 0);
+    invclov->apply(chi, psi, isign, 0);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
     
@@ -156,7 +154,7 @@ namespace Chroma
     D.apply(tmp1, psi, isign, 0);
 
     swatch.reset(); swatch.start();
-    invclov.apply(tmp2, tmp1, isign, 0);
+    invclov->apply(tmp2, tmp1, isign, 0);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
 
@@ -164,7 +162,7 @@ namespace Chroma
 
     //  chi_o  =  A_oo  psi_o  -  tmp1_o
     swatch.reset(); swatch.start();
-    clov.apply(chi, psi, isign, 1);
+    clov->apply(chi, psi, isign, 1);
     swatch.stop();
     clov_apply_time += swatch.getTimeInSeconds();
 
@@ -187,6 +185,63 @@ namespace Chroma
   }
 
 
+  //! Apply the operator onto a block of source vectors
+  /*!
+   * Same as operator() on each vector, but both dslashes go through
+   * the multi-RHS dslash, so the links are read once for all the vectors.
+   * The clover terms are site local and are applied per vector.
+   */
+  void EvenOddPrecCloverLinOp::applyMultiRHS(multi1d<LatticeFermion>& chi, 
+					     const multi1d<LatticeFermion>& psi, 
+					     enum PlusMinus isign) const
+  {
+    START_CODE();
+
+    const int N = psi.size();
+    multi1d<LatticeFermion> tmp1, tmp2(N);
+    Real mquarter = -0.25;
+
+    //  tmp1_o  =  D_oe   A^(-1)_ee  D_eo  psi_o
+    D.applyMultiRHS(tmp1, psi, isign, 0);
+
+    swatch.reset(); swatch.start();
+    for(int i=0; i < N; ++i)
+      invclov->apply(tmp2[i], tmp1[i], isign, 0);
+    swatch.stop();
+    clov_apply_time += swatch.getTimeInSeconds();
+
+    D.applyMultiRHS(tmp1, tmp2, isign, 1);
+
+    //  chi_o  =  A_oo  psi_o  -  tmp1_o
+    chi.resize(N);
+    swatch.reset(); swatch.start();
+    for(int i=0; i < N; ++i)
+      clov->apply(chi[i], psi[i], isign, 1);
+    swatch.stop();
+    clov_apply_time += swatch.getTimeInSeconds();
+
+    for(int i=0; i < N; ++i)
+    {
+      chi[i][rb[1]] += mquarter*tmp1[i];
+
+      // Twisted Term?
+      if( param.twisted_m_usedP ){ 
+	// tmp2 = i mu gamma_5 psi
+	tmp2[i][rb[1]] = (GammaConst<Ns,Ns*Ns-1>() * timesI(psi[i]));
+      
+	if( isign == PLUS ) {
+	  chi[i][rb[1]] += param.twisted_m * tmp2[i];
+	}
+	else {
+	  chi[i][rb[1]] -= param.twisted_m * tmp2[i];
+	}
+      }
+    }
+
+    END_CODE();
+  }
+
+
   //! Apply the even-even block onto a source std::vector
   void 
   EvenOddPrecCloverLinOp::derivEvenEvenLinOp(multi1d<LatticeColorMatrix>& ds_u, 
@@ -196,7 +251,7 @@ namespace Chroma
     START_CODE();
     
     swatch.reset(); swatch.start();
-    clov.deriv(ds_u, chi, psi, isign, 0);
+    clov->deriv(ds_u, chi, psi, isign, 0);
     swatch.stop();
     clov_deriv_time  += swatch.getTimeInSeconds();
 
@@ -212,7 +267,7 @@ namespace Chroma
     START_CODE();
     
     swatch.reset(); swatch.start();
-    clov.derivMultipole(ds_u, chi, psi, isign, 0);
+    clov->derivMultipole(ds_u, chi, psi, isign, 0);
     swatch.stop();
     clov_deriv_time  += swatch.getTimeInSeconds();
 
@@ -227,7 +282,7 @@ namespace Chroma
     START_CODE();
 
     // Testing Odd Odd Term - get nothing from even even term
-    invclov.derivTrLn(ds_u, isign, 0);
+    invclov->derivTrLn(ds_u, isign, 0);
     
     END_CODE();
   }
@@ -263,6 +318,36 @@ namespace Chroma
     END_CODE();
   }
 
+  //! Apply the the even-odd block onto a source std::vector, summed over several vectors
+  void 
+  EvenOddPrecCloverLinOp::derivEvenOddLinOpMP(multi1d<LatticeColorMatrix>& ds_u, 
+					      const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+					      enum PlusMinus isign) const
+  {
+    START_CODE();
+    ds_u.resize(Nd);
+    D.derivMultipole(ds_u, chi, psi, isign, 0);
+    for(int mu=0; mu < Nd; mu++) { 
+      ds_u[mu]  *= Real(-0.5);
+    }
+    END_CODE();
+  }
+ 
+  //! Apply the the odd-even block onto a source std::vector, summed over several vectors
+  void 
+  EvenOddPrecCloverLinOp::derivOddEvenLinOpMP(multi1d<LatticeColorMatrix>& ds_u, 
+					      const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+					      enum PlusMinus isign) const
+  {
+    START_CODE();
+    ds_u.resize(Nd);
+    D.derivMultipole(ds_u, chi, psi, isign, 1);
+    for(int mu=0; mu < Nd; mu++) { 
+      ds_u[mu]  *= Real(-0.5);
+    }
+    END_CODE();
+  }
+
   // Inherit this
   //! Apply the the odd-odd block onto a source std::vector
   void 
@@ -273,7 +358,7 @@ namespace Chroma
     START_CODE();
 
     swatch.reset(); swatch.start();
-    clov.deriv(ds_u, chi, psi, isign, 1);
+    clov->deriv(ds_u, chi, psi, isign, 1);
     swatch.stop();
     clov_deriv_time += swatch.getTimeInSeconds();
     
@@ -288,7 +373,7 @@ namespace Chroma
     START_CODE();
     
     swatch.reset(); swatch.start();
-    clov.derivMultipole(ds_u, chi, psi, isign, 1);
+    clov->derivMultipole(ds_u, chi, psi, isign, 1);
     swatch.stop();
     clov_deriv_time  += swatch.getTimeInSeconds();
 
@@ -298,7 +383,7 @@ namespace Chroma
   //! Return flops performed by the operator()
   unsigned long EvenOddPrecCloverLinOp::nFlops() const
   {
-    unsigned long cbsite_flops = 2*D.nFlops()+2*clov.nFlops()+4*Nc*Ns;
+    unsigned long cbsite_flops = 2*D.nFlops()+2*clov->nFlops()+4*Nc*Ns;
     if(  param.twisted_m_usedP ) { 
       cbsite_flops += 4*Nc*Ns; // a + mu*b : a = chi, b = g_5 I psi
     }
@@ -308,6 +393,6 @@ namespace Chroma
   //! Get the log det of the even even part
   // BUt for now, return zero for testing.
   Double EvenOddPrecCloverLinOp::logDetEvenEvenLinOp(void) const  {
-    return invclov.cholesDet(0);
+    return invclov->cholesDet(0);
   }
 } // End Namespace Chroma
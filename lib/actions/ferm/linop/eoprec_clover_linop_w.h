@@ -12,6 +12,7 @@
 #include "actions/ferm/fermacts/clover_fermact_params_w.h"
 #include "actions/ferm/linop/dslash_w.h"
 #include "actions/ferm/linop/clover_term_w.h"
+#include "actions/ferm/linop/clover_term_cache_w.h"
 
 
 namespace Chroma 
@@ -83,6 +84,10 @@ namespace Chroma
     void operator()(LatticeFermion& chi, const LatticeFermion& psi, 
 		    enum PlusMinus isign) const;
 
+    //! Apply the operator onto a block of source vectors
+    void applyMultiRHS(multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+		       enum PlusMinus isign) const;
+
     //! Apply the even-even block onto a source std::vector
     void derivEvenEvenLinOp(multi1d<LatticeColorMatrix>& ds_u, 
 			    const LatticeFermion& chi, const LatticeFermion& psi, 
@@ -106,6 +111,16 @@ namespace Chroma
 			   const LatticeFermion& chi, const LatticeFermion& psi, 
 			   enum PlusMinus isign) const;
 
+    //! Apply the the even-odd block onto a source std::vector, summed over several vectors
+    void derivEvenOddLinOpMP(multi1d<LatticeColorMatrix>& ds_u, 
+			     const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+			     enum PlusMinus isign) const;
+ 
+    //! Apply the the odd-even block onto a source std::vector, summed over several vectors
+    void derivOddEvenLinOpMP(multi1d<LatticeColorMatrix>& ds_u, 
+			     const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+			     enum PlusMinus isign) const;
+
     //! Apply the the odd-odd block onto a source std::vector
     void derivOddOddLinOp(multi1d<LatticeColorMatrix>& ds_u, 
 			  const LatticeFermion& chi, const LatticeFermion& psi, 
@@ -124,8 +139,8 @@ namespace Chroma
   private:
     CloverFermActParams param;
     WilsonDslash D;
-    CloverTerm   clov;
-    CloverTerm   invclov;  // uggh, only needed for evenEvenLinOp
+    Handle<CloverTerm>   clov;
+    Handle<CloverTerm>   invclov;  // uggh, only needed for evenEvenLinOp
     mutable double clov_apply_time;
     mutable double clov_deriv_time;
     mutable StopWatch swatch;
@@ -3,6 +3,7 @@
  */
 
 #include "actions/ferm/linop/eoprec_dwf_linop_array_w.h"
+#include "actions/ferm/linop/dwf_m5_kernels_w.h"
 using namespace QDP::Hints;
 
 namespace Chroma 
@@ -66,6 +67,10 @@ namespace Chroma
 
     if( chi.size() != N5 ) chi.resize(N5);
 
+#ifndef QDP_IS_QDPJIT
+    // All s slices in one pass over cache sized blocks of sites
+    DWFM5Kernels::applyM5(chi, psi, InvTwoKappa, Real(1), m_q, isign, cb);
+#else
     switch ( isign ) {
     
     case PLUS:
@@ -177,6 +182,7 @@ namespace Chroma
     }
     break ;
     }
+#endif
 
     END_CODE();
   }
@@ -202,6 +208,11 @@ namespace Chroma
 
     if( chi.size() != N5 ) chi.resize(N5);
 
+#ifndef QDP_IS_QDPJIT
+    // The forward and back substitutions for all s in one pass over cache
+    // sized blocks of sites
+    DWFM5Kernels::applyM5Inv(chi, psi, TwoKappa, TwoKappa, invDfactor, m_q, isign, cb);
+#else
     switch ( isign ) {
 
     case PLUS:
@@ -292,6 +303,7 @@ namespace Chroma
     }
     break ;
     }
+#endif
 
     //Done! That was not that bad after all....
     //See, I told you so...
@@ -330,6 +342,42 @@ namespace Chroma
   }
 
 
+  //! Apply the operator onto a source std::vector
+  /*!
+   * The factors -1/2 of the two off diagonal blocks are folded into
+   * the inverse of the even-even block, and the final subtraction into
+   * the odd-odd block, saving three passes over the 5D vectors.
+   */
+  void 
+  EvenOddPrecDWLinOpArray::operator() (multi1d<LatticeFermion>& chi, 
+				       const multi1d<LatticeFermion>& psi, 
+				       enum PlusMinus isign) const
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    multi1d<LatticeFermion>  tmp1(N5);  moveToFastMemoryHint(tmp1);
+    multi1d<LatticeFermion>  tmp2(N5);  moveToFastMemoryHint(tmp2);
+
+    if( chi.size() != N5 ) chi.resize(N5);
+
+    //  tmp1 = D_oe (1/4) A_ee^{-1} D_eo psi
+    D.apply(tmp1, psi, isign, 0);
+    DWFM5Kernels::applyM5Inv(tmp2, tmp1, Real(0.25)*TwoKappa, TwoKappa, invDfactor, m_q, isign, 0);
+    D.apply(tmp1, tmp2, isign, 1);
+
+    //  chi = A_oo psi - tmp1
+    DWFM5Kernels::applyM5MinusY(chi, psi, tmp1, InvTwoKappa, Real(1), m_q, isign, 1);
+
+    getFermBC().modifyF(chi, rb[1]);
+#else
+    EvenOddPrecDWLikeLinOpBaseArray<T,P,Q>::operator()(chi, psi, isign);
+#endif
+
+    END_CODE();
+  }
+
+
   //! Apply the Dminus operator on a lattice fermion. See my notes ;-)
   void 
   EvenOddPrecDWLinOpArray::Dminus(LatticeFermion& chi,
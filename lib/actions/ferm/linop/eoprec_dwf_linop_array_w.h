@@ -95,6 +95,11 @@ namespace Chroma
     }
 
 
+    //! Apply the operator onto a source std::vector
+    void operator() (multi1d<LatticeFermion>& chi, 
+		     const multi1d<LatticeFermion>& psi, 
+		     enum PlusMinus isign) const;
+
     //! Apply the Dminus operator on a lattice fermion.
     void Dminus(LatticeFermion& chi,
 		const LatticeFermion& psi,
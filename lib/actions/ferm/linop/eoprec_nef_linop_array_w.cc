@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/linop/eoprec_nef_linop_array_w.h"
+#include "actions/ferm/linop/dwf_m5_kernels_w.h"
 
 using namespace QDP::Hints;
 
@@ -77,6 +78,10 @@ namespace Chroma
 
     // Real c5Fact(0.5*c5InvTwoKappa) ; // The 0.5 is for the P+ and P-
 
+#ifndef QDP_IS_QDPJIT
+    // All s slices in one pass over cache sized blocks of sites
+    DWFM5Kernels::applyM5(chi, psi, b5InvTwoKappa, c5InvTwoKappa, m_q, isign, cb);
+#else
     Real c5InvTwoKappamf = m_q*c5InvTwoKappa;
     switch ( isign ) {
     
@@ -158,6 +163,7 @@ namespace Chroma
     }
     break ;
     }
+#endif
 
     END_CODE();
   }
@@ -184,7 +190,11 @@ namespace Chroma
  
     if( chi.size() != N5 ) chi.resize(N5);
    
-
+#ifndef QDP_IS_QDPJIT
+    // The forward and back substitutions for all s in one pass over cache
+    // sized blocks of sites
+    DWFM5Kernels::applyM5Inv(chi, psi, b5TwoKappa, TwoKappa, invDfactor, m_q, isign, cb);
+#else
     switch ( isign ) {
 
     case PLUS:
@@ -285,6 +295,7 @@ namespace Chroma
     }
     break ;
     }
+#endif
 
     //Done! That was not that bad after all....
     //See, I told you so...
@@ -319,6 +330,25 @@ namespace Chroma
 
     if( chi.size() != N5 ) chi.resize(N5);
   
+#ifndef QDP_IS_QDPJIT
+    // The s mixing  fb5 + fc5 (P_+ S_- + P_- S_+)  has the form of the
+    // diagonal block, so it is done for all s in one pass: before the
+    // dslash for PLUS and after it for MINUS
+    {
+      multi1d<LatticeFermion> tmp(N5); moveToFastMemoryHint(tmp);
+
+      if (isign == PLUS)
+      {
+	DWFM5Kernels::applyM5(tmp, psi, fb5, -fc5, m_q, isign, 1-cb);
+	D.apply(chi, tmp, isign, cb);
+      }
+      else
+      {
+	D.apply(tmp, psi, isign, cb);
+	DWFM5Kernels::applyM5(chi, tmp, fb5, -fc5, m_q, isign, cb);
+      }
+    }
+#else
     switch ( isign ) 
     {
     case PLUS:
@@ -408,6 +438,7 @@ namespace Chroma
     }
     break ;
     }
+#endif
 
     //Done! That was not that bad after all....
     //See, I told you so...
@@ -416,6 +447,43 @@ namespace Chroma
 
 
 
+  //! Apply the operator onto a source std::vector
+  /*!
+   * The final subtraction is folded into the odd-odd block. Unlike the
+   * Shamir operator the off diagonal blocks also mix the s slices with b5
+   * and c5, so they are not a multiple of the dslash and cannot be folded
+   * into the inverse of the even-even block.
+   */
+  void 
+  EvenOddPrecNEFDWLinOpArray::operator() (multi1d<LatticeFermion>& chi, 
+					  const multi1d<LatticeFermion>& psi, 
+					  enum PlusMinus isign) const
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    multi1d<LatticeFermion>  tmp1(N5);  moveToFastMemoryHint(tmp1);
+    multi1d<LatticeFermion>  tmp2(N5);  moveToFastMemoryHint(tmp2);
+
+    if( chi.size() != N5 ) chi.resize(N5);
+
+    //  tmp1 = D_oe A_ee^{-1} D_eo psi
+    applyOffDiag(tmp1, psi, isign, 0);
+    applyDiagInv(tmp2, tmp1, isign, 0);
+    applyOffDiag(tmp1, tmp2, isign, 1);
+
+    //  chi = A_oo psi - tmp1
+    DWFM5Kernels::applyM5MinusY(chi, psi, tmp1, b5InvTwoKappa, c5InvTwoKappa, m_q, isign, 1);
+
+    getFermBC().modifyF(chi, rb[1]);
+#else
+    EvenOddPrecDWLikeLinOpBaseArray<T,P,Q>::operator()(chi, psi, isign);
+#endif
+
+    END_CODE();
+  }
+
+
   //! Apply the Dminus operator on a lattice fermion. See my notes ;-)
   void 
   EvenOddPrecNEFDWLinOpArray::Dminus(LatticeFermion& chi,
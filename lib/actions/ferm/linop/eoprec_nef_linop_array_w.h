@@ -115,6 +115,11 @@ namespace Chroma
       applyDiagInv(chi, psi, isign, 1);
     }
  
+    //! Apply the operator onto a source std::vector
+    void operator() (multi1d<LatticeFermion>& chi, 
+		     const multi1d<LatticeFermion>& psi, 
+		     enum PlusMinus isign) const;
+
     //! Apply the Dminus operator on a lattice fermion. See my notes ;-)
     void Dminus(LatticeFermion& chi,
 		const LatticeFermion& psi,
@@ -167,6 +167,37 @@ namespace Chroma
   }
 
 
+  //! Apply the operator onto a block of source vectors
+  /*!
+   * Same as operator() on each vector, but both dslashes go through
+   * the multi-RHS dslash, so the links are read once for all the vectors.
+   */
+  void EvenOddPrecWilsonLinOp::applyMultiRHS(multi1d<LatticeFermion>& chi, 
+					     const multi1d<LatticeFermion>& psi, 
+					     enum PlusMinus isign) const
+  {
+    START_CODE();
+
+    multi1d<LatticeFermion> tmp1, tmp2;
+
+    Real mquarterinvfact = -0.25*invfact;
+
+    // tmp1[0] = D_eo psi[1],  tmp2[1] = D_oe tmp1[0]
+    D.applyMultiRHS(tmp1, psi, isign, 0);
+    D.applyMultiRHS(tmp2, tmp1, isign, 1);
+
+    // chi[1] = (Nd + m) - (1/4)*(1/(Nd + m)) D_oe D_eo psi[1]
+    chi.resize(psi.size());
+    for(int i=0; i < psi.size(); ++i)
+    {
+      chi[i][rb[1]] = fact*psi[i] + mquarterinvfact*tmp2[i];
+      getFermBC().modifyF(chi[i], rb[1]);
+    }
+    
+    END_CODE();
+  }
+
+
   //! Derivative of even-odd linop component
   void 
   EvenOddPrecWilsonLinOp::derivEvenOddLinOp(multi1d<LatticeColorMatrix>& ds_u,
@@ -205,19 +236,18 @@ namespace Chroma
     END_CODE();
   }
 
-#if 0
- //! Derivative of even-odd linop component
+  //! Derivative of even-odd linop component summed over several vectors
   void 
   EvenOddPrecWilsonLinOp::derivEvenOddLinOpMP(multi1d<LatticeColorMatrix>& ds_u,
-					      const LatticeFermion& chi, 
-					      const LatticeFermion& psi, 
+					      const multi1d<LatticeFermion>& chi, 
+					      const multi1d<LatticeFermion>& psi, 
 					      enum PlusMinus isign) const
   {
     START_CODE();
 
     ds_u.resize(Nd);
 
-    D.deriv(ds_u, chi, psi, isign, 0);
+    D.derivMultipole(ds_u, chi, psi, isign, 0);
     for(int mu=0; mu < Nd; mu++) {
       ds_u[mu] *=  Real(-0.5);
     }
@@ -226,24 +256,23 @@ namespace Chroma
   }
 
 
-  //! Derivative of odd-even linop component
+  //! Derivative of odd-even linop component summed over several vectors
   void 
   EvenOddPrecWilsonLinOp::derivOddEvenLinOpMP(multi1d<LatticeColorMatrix>& ds_u,
-					      const LatticeFermion& chi, 
-					      const LatticeFermion& psi, 
+					      const multi1d<LatticeFermion>& chi, 
+					      const multi1d<LatticeFermion>& psi, 
 					      enum PlusMinus isign) const
   {
     START_CODE();
 
     ds_u.resize(Nd);
 
-    D.deriv(ds_u, chi, psi, isign, 1);
+    D.derivMultipole(ds_u, chi, psi, isign, 1);
     for(int mu=0; mu < Nd; mu++) { 
       ds_u[mu]  *= Real(-0.5);
     }
     END_CODE();
   }
-#endif
 
   //! Return flops performed by the operator()
   unsigned long EvenOddPrecWilsonLinOp::nFlops() const
@@ -109,6 +109,10 @@ namespace Chroma
     void operator()(LatticeFermion& chi, const LatticeFermion& psi, 
 		    enum PlusMinus isign) const;
 
+    //! Apply the operator onto a block of source vectors
+    void applyMultiRHS(multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+		       enum PlusMinus isign) const;
+
 
     //! Apply the even-even block onto a source std::vector
     void derivEvenEvenLinOp(multi1d<LatticeColorMatrix>& ds_u, 
@@ -131,6 +135,16 @@ namespace Chroma
 			   const LatticeFermion& chi, const LatticeFermion& psi, 
 			   enum PlusMinus isign) const;
 
+    //! Apply the the even-odd block onto a source std::vector, summed over several vectors
+    void derivEvenOddLinOpMP(multi1d<LatticeColorMatrix>& ds_u, 
+			     const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+			     enum PlusMinus isign) const;
+ 
+    //! Apply the the odd-even block onto a source std::vector, summed over several vectors
+    void derivOddEvenLinOpMP(multi1d<LatticeColorMatrix>& ds_u, 
+			     const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+			     enum PlusMinus isign) const;
+
     //! Apply the the odd-odd block onto a source std::vector
     void derivOddOddLinOp(multi1d<LatticeColorMatrix>& ds_u, 
 			  const LatticeFermion& chi, const LatticeFermion& psi, 
@@ -13,6 +13,141 @@
 namespace Chroma 
 { 
 
+  namespace
+  {
+    //! Index of the ordered pair (mu,nu), mu != nu, in [0, Nd*(Nd-1))
+    inline int pairIndex(int mu, int nu)
+    {
+      return (Nd-1)*mu + nu - ((nu > mu) ? 1 : 0);
+    }
+
+
+    //! Staple of the path X in direction rho, attached to a link in direction mu
+    /*!
+     *  s(x) = u_rho(x) X(x+rho) u^dag_rho(x+mu)  +  u^dag_rho(x-rho) X(x-rho) u_rho(x-rho+mu)
+     *
+     *  u_rho_mu = u_rho(x+mu) comes from the table of shifted links, and the
+     *  backward staple is built on site and shifted once.
+     */
+    void staple(LatticeColorMatrix& s,
+		const LatticeColorMatrix& X,
+		const LatticeColorMatrix& u_rho,
+		const LatticeColorMatrix& u_rho_mu,
+		int rho)
+    {
+      LatticeColorMatrix tmp = adj(u_rho) * X * u_rho_mu;
+
+      s  = u_rho * shift(X, FORWARD, rho) * adj(u_rho_mu);
+      s += shift(tmp, BACKWARD, rho);
+    }
+
+
+    //! The fattening engine shared by Asqtad and both HISQ levels
+    /*!
+     * Every path of the Fat7 + Lepage link is a nest of staples, and all
+     * of them only need the links u_nu(x+mu) once shifted along another
+     * direction. These Nd*(Nd-1) links are shifted once into a table, so
+     * each staple costs two shifts instead of four.
+     *
+     * The paths are also shared across directions: the seven-link staples
+     * are linear in the five-link path they dress, so for each link mu and
+     * outer direction sigma the two five-link paths in the plane orthogonal
+     * to (mu,sigma) are summed first and dressed once.
+     */
+    void fat7Engine(const multi1d<LatticeColorMatrix>& u,
+		    multi1d<LatticeColorMatrix>& uf,
+		    const fat7_param& pp)
+    {
+      START_CODE();
+
+      if (Nd != 4)
+      {
+	QDPIO::cerr << __func__ 
+		    << ": Fat7_links (generic) not implemented for this dim, Nd=" << Nd << std::endl;
+	QDP_abort(1);
+      }
+
+      const bool do_lepage = toBool(pp.c_Lepage != Real(0));
+
+      // u_shf[pairIndex(mu,nu)] = u_nu(x+mu)
+      multi1d<LatticeColorMatrix> u_shf(Nd*(Nd-1));
+      for(int mu=0; mu < Nd; ++mu)
+	for(int nu=0; nu < Nd; ++nu)
+	  if (nu != mu)
+	    u_shf[pairIndex(mu,nu)] = shift(u[nu], FORWARD, mu);
+
+      multi1d<LatticeColorMatrix> stap3(Nd);   // three-link staples of mu, indexed by nu
+      multi1d<LatticeColorMatrix> stap5(Nd);   // summed five-link paths of mu, indexed by sigma
+      LatticeColorMatrix fwd;
+      LatticeColorMatrix bwd;
+      LatticeColorMatrix tmp;
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	uf[mu] = pp.c_1l * u[mu];
+
+	// Three-link staples and the Lepage term
+	for(int nu=0; nu < Nd; ++nu) 
+	{
+	  if (nu == mu)
+	    continue;
+
+	  const LatticeColorMatrix& u_nu_mu = u_shf[pairIndex(mu,nu)];
+
+	  fwd = u[nu] * u_shf[pairIndex(nu,mu)] * adj(u_nu_mu);
+	  tmp = adj(u[nu]) * u[mu] * u_nu_mu;
+	  bwd = shift(tmp, BACKWARD, nu);
+
+	  stap3[nu] = fwd + bwd;
+	  uf[mu] += pp.c_3l * stap3[nu];
+
+	  if (do_lepage)
+	  {
+	    tmp = adj(u[nu]) * bwd * u_nu_mu;
+	    uf[mu] += pp.c_Lepage * (u[nu] * shift(fwd, FORWARD, nu) * adj(u_nu_mu)
+				     + shift(tmp, BACKWARD, nu));
+	  }
+
+	  stap5[nu] = zero;
+	}
+
+	// Five-link staples, gathered by the one direction they leave free
+	for(int nu=0; nu < Nd; ++nu) 
+	{
+	  if (nu == mu)
+	    continue;
+
+	  for(int rho=0; rho < Nd; ++rho) 
+	  {
+	    if (rho == mu || rho == nu)
+	      continue;
+
+	    staple(fwd, stap3[nu], u[rho], u_shf[pairIndex(mu,rho)], rho);
+	    uf[mu] += pp.c_5l * fwd;
+
+	    for(int sigma=0; sigma < Nd; ++sigma)
+	      if (sigma != mu && sigma != nu && sigma != rho)
+		stap5[sigma] += fwd;
+	  }
+	}
+
+	// Seven-link staples
+	for(int sigma=0; sigma < Nd; ++sigma)
+	{
+	  if (sigma == mu)
+	    continue;
+
+	  staple(fwd, stap5[sigma], u[sigma], u_shf[pairIndex(mu,sigma)], sigma);
+	  uf[mu] += pp.c_7l * fwd;
+	}
+      }
+
+      END_CODE();
+    }
+
+  } // end anonymous namespace
+
+
   //
   //  u(Nd), probably should check
   //  uf(Nd),
@@ -24,94 +159,15 @@ namespace Chroma
   {
     START_CODE();
   
-    LatticeColorMatrix tmp_0;
-    LatticeColorMatrix tmp_1;
-    LatticeColorMatrix tmp_2;
-    LatticeColorMatrix tmp_3;
-    LatticeColorMatrix tmp_4;
-    Real c_1l;
-    Real c_3l;
-    Real c_5l;
-    Real c_7l;
-    Real c_Lepage;
-    int mu;
-    int nu;
-    int rho;
-    int sigma;
-
-    // SZIN parameters from macros/primitives.mh
-    // probably should be checked
-    //
-    //  enum SZINdir { BACKWARD= 0 ,  FORWARD = 1 }  ;
+    fat7_param pp;
 
-  
-    if (Nd == 4)
-    {
-      c_1l = (Real)(5) / (Real)(8);
-      c_3l = (Real)(-1) / (u0*u0*(Real)(16));
-      c_5l = - c_3l / (u0*u0*(Real)(4));
-      c_7l = - c_5l / (u0*u0*(Real)(6));
-      c_Lepage = c_3l / (u0*u0);
-
-                    
-      for(mu=0; mu < Nd; ++mu)
-      {
-	uf[mu] = u[mu] * c_1l;
-      
-	for(nu=0; nu < Nd; ++nu) 
-	  if(nu != mu)
-	  {
-	    tmp_0 = u[nu] * shift(u[mu], FORWARD, nu); 
-	    tmp_2 = tmp_0 * shift(adj(u[nu]),  FORWARD, mu);
-					
-	    tmp_0 = u[nu] * shift(tmp_2,  FORWARD, nu);
-	    tmp_1 = tmp_0 * shift(adj(u[nu]),  FORWARD, mu);
-
-	    uf[mu] += tmp_1 * c_Lepage;
-
-	    tmp_0 = u[mu] * shift(u[nu] , FORWARD, mu);
-	    tmp_1 = shift(adj(u[nu]),  BACKWARD, nu) * shift(tmp_0, BACKWARD, nu);
-			
-	    tmp_2 += tmp_1;
-	    uf[mu] += tmp_2 * c_3l;
-
-	    tmp_0 = tmp_1 * shift(u[nu], FORWARD, mu);
-	    tmp_1 = shift(adj(u[nu]),  BACKWARD, nu) * shift(tmp_0, BACKWARD, nu);
-			
-	    uf[mu] += tmp_1 * c_Lepage;
-			
-	    for(rho=0; rho < Nd; ++rho) if(rho != mu && rho != nu)
-	    {
-	      tmp_0 = u[rho] * shift(tmp_2, FORWARD, rho);
-	      tmp_3 = tmp_0 * shift(adj(u[rho]), FORWARD, mu);
-
-	      tmp_0 = tmp_2 * shift(u[rho], FORWARD, mu);
-	      tmp_3 += shift(adj(u[rho]), BACKWARD, rho) * shift(tmp_0, BACKWARD, rho);
-			   
-	      uf[mu] += tmp_3 * c_5l;
-
-	      for(sigma=0; sigma < Nd; ++sigma)
-		if(sigma != mu && sigma != nu && sigma != rho)
-		{
-		  tmp_0 = u[sigma] * shift(tmp_3, FORWARD, sigma);
-		  tmp_1 = tmp_0 * shift(adj(u[sigma]), FORWARD, mu);
-
-		  tmp_0 = tmp_3 * shift(u[sigma], FORWARD, mu);
-		  tmp_1 += shift(adj(u[sigma]), BACKWARD, sigma) * shift(tmp_0,  BACKWARD, sigma);
-
-		  uf[mu] += tmp_1 * c_7l;
-			     
-		}	  
-	    }	     
-	  }	   
-      }	     
-    }			    
-    else
-    {
-      QDPIO::cerr << __func__ 
-		  << ": Fat7_links (generic) not implemented for this dim, Nd=" << Nd << std::endl;
-      QDP_abort(1);
-    }
+    pp.c_1l = (Real)(5) / (Real)(8);
+    pp.c_3l = (Real)(-1) / (u0*u0*(Real)(16));
+    pp.c_5l = - pp.c_3l / (u0*u0*(Real)(4));
+    pp.c_7l = - pp.c_5l / (u0*u0*(Real)(6));
+    pp.c_Lepage = pp.c_3l / (u0*u0);
+
+    fat7Engine(u, uf, pp);
   
     END_CODE();
   }
@@ -123,89 +179,11 @@ namespace Chroma
 		  fat7_param & pp)
   {
     START_CODE();
-  
-    LatticeColorMatrix tmp_0;
-    LatticeColorMatrix tmp_1;
-    LatticeColorMatrix tmp_2;
-    LatticeColorMatrix tmp_3;
-    LatticeColorMatrix tmp_4;
-
-    int mu;
-    int nu;
-    int rho;
-    int sigma;
-
-    // SZIN parameters from macros/primitives.mh
-    // probably should be checked
-    //
-    //  enum SZINdir { BACKWARD= 0 ,  FORWARD = 1 }  ;
 
-  
-    if (Nd == 4)
-    {
-                    
-      for(mu=0; mu < Nd; ++mu)
-      {
-	uf[mu] = u[mu] * pp.c_1l;
-      
-	for(nu=0; nu < Nd; ++nu) 
-	  if(nu != mu)
-	  {
-	    tmp_0 = u[nu] * shift(u[mu], FORWARD, nu); 
-	    tmp_2 = tmp_0 * shift(adj(u[nu]),  FORWARD, mu);
-					
-	    tmp_0 = u[nu] * shift(tmp_2,  FORWARD, nu);
-	    tmp_1 = tmp_0 * shift(adj(u[nu]),  FORWARD, mu);
-
-	    uf[mu] += tmp_1 * pp.c_Lepage;
-
-	    tmp_0 = u[mu] * shift(u[nu] , FORWARD, mu);
-	    tmp_1 = shift(adj(u[nu]),  BACKWARD, nu) * shift(tmp_0, BACKWARD, nu);
-			
-	    tmp_2 += tmp_1;
-	    uf[mu] += tmp_2 * pp.c_3l;
-
-	    tmp_0 = tmp_1 * shift(u[nu], FORWARD, mu);
-	    tmp_1 = shift(adj(u[nu]),  BACKWARD, nu) * shift(tmp_0, BACKWARD, nu);
-			
-	    uf[mu] += tmp_1 * pp.c_Lepage;
-			
-	    for(rho=0; rho < Nd; ++rho) if(rho != mu && rho != nu)
-	    {
-	      tmp_0 = u[rho] * shift(tmp_2, FORWARD, rho);
-	      tmp_3 = tmp_0 * shift(adj(u[rho]), FORWARD, mu);
-
-	      tmp_0 = tmp_2 * shift(u[rho], FORWARD, mu);
-	      tmp_3 += shift(adj(u[rho]), BACKWARD, rho) * shift(tmp_0, BACKWARD, rho);
-			   
-	      uf[mu] += tmp_3 * pp.c_5l;
-
-	      for(sigma=0; sigma < Nd; ++sigma)
-		if(sigma != mu && sigma != nu && sigma != rho)
-		{
-		  tmp_0 = u[sigma] * shift(tmp_3, FORWARD, sigma);
-		  tmp_1 = tmp_0 * shift(adj(u[sigma]), FORWARD, mu);
-
-		  tmp_0 = tmp_3 * shift(u[sigma], FORWARD, mu);
-		  tmp_1 += shift(adj(u[sigma]), BACKWARD, sigma) * shift(tmp_0,  BACKWARD, sigma);
-
-		  uf[mu] += tmp_1 * pp.c_7l;
-			     
-		}	  
-	    }	     
-	  }	   
-      }	     
-    }			    
-    else
-    {
-      QDPIO::cerr << __func__ 
-		  << ": Fat7_links (generic) not implemented for this dim, Nd=" << Nd << std::endl;
-      QDP_abort(1);
-    }
+    fat7Engine(u, uf, pp);
 
     END_CODE();
   }
 
 } // End Namespace Chroma
 
-
@@ -11,128 +11,72 @@
 
 namespace Chroma 
 { 
-void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi, 
-			   enum PlusMinus isign) const
-{
-  operator()(chi, psi, isign, RsdCG);
-}
 
-//! Apply the GW operator onto a source std::vector
-/*! \ingroup linop
- *
- * This routine applies the 4D GW operator onto a source
- * std::vector. The coeffiecients for the approximation get 
- * wired into the class by the constructor and should
- * come fromt fermion action.
- *
- * The operator applied is:
- *       D       =    (1/2)[  (1+m) + (1-m)gamma_5 sgn(H_w) ] psi
- * or    D^{dag} =    (1/2)[  (1+m) + (1-m) sgn(H_w) gamma_5 psi
- * 
- * 
- * \param chi     result std::vector                              (Write)  
- * \param psi 	  source std::vector         	             (Read)
- * \param isign   Hermitian Conjugation Flag 
- *                ( PLUS = no dagger| MINUS = dagger )       (Read)
- */
-void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi, 
-			   enum PlusMinus isign, Real epsilon) const
+namespace
 {
-  START_CODE();
-
-  LatticeFermion tmp1, tmp2;
+  //! Real scalars matching the precision of the shifted search vectors
+  template<typename TS> struct ShiftReal;
 
-  // Gamma_5 
-  int G5 = Ns*Ns - 1;
+  template<> struct ShiftReal<LatticeFermionF> { typedef RealF Type_t; };
+  template<> struct ShiftReal<LatticeFermionD> { typedef RealD Type_t; };
 
-  // Mass for shifted system
-  Real mass = Real(1 + m_q) / Real(1 - m_q);
-  
-
-  switch (isign)
+  //! A working precision field in the precision of the shifted vectors
+  template<typename TS>
+  inline const TS& toShift(const LatticeFermion& x, TS& buf)
   {
-  case PLUS:
-    //  Non-Dagger: psi is source and tmp1 
-    //  chi  :=  gamma_5 * (gamma_5 * mass + sgn(H)) * Psi  
-    tmp1 = psi;
-    break;
-
-  case MINUS:
-    // Dagger: apply gamma_5 to source psi to make tmp1 
-    //  chi  :=  (mass + sgn(H) * gamma_5) * Psi  
-    tmp1 = Gamma(G5) * psi;
-    break;
-
-  default:
-    QDP_error_exit("unknown isign value", isign);
+    buf = x;
+    return buf;
   }
 
-
-  chi = zero;
-
-  // Project out eigenvectors of source if desired 
-  // chi  +=  func(lambda) * EigVec * <EigVec, psi>  
-  // Usually "func(.)" is sgn(.); it is precomputed in EigValFunc. 
-  // for all the eigenvalues
-  //
-  //  Also we must bear in mind that if we want the dagger of the 
-  // operator we must use gamma_5 psi instead of psi
-  //
-  // at this stage tmp1 holds either psi or gamma_5 psi as required
-  // so we must project from tmp1
-
-  if (NEig > 0)
+  inline const LatticeFermion& toShift(const LatticeFermion& x, LatticeFermion& buf)
   {
-    Complex cconsts;
-    LatticeFermion tmp3 = tmp1;
-
-    for(int i = 0; i < NEig; ++i)
-    {
-
-      // BUG Should this not be innerProduct(EigVec[i], psi) ???
-      //                     or innerProduct(EigVec[i], g5 psi) ????
-
-      cconsts = innerProduct(EigVec[i], tmp3);
-      tmp1 -= EigVec[i] * cconsts;
-
-      cconsts *= EigValFunc[i];
-      chi += EigVec[i] * cconsts;
-    }
-
-    // tmp3 should go out of scope here and be freed.
+    return x;
   }
 
-  // tmp1 <- H * Projected tmp_1, where tmp1 = psi or gamma_5 psi as needed
-  //      <- gamma_5 * M * tmp1
-  (*M)(tmp2, tmp1, PLUS);
-  tmp1 = Gamma(G5) * tmp2;
-  
- 
+  //! y += x with x in the precision of the shifted vectors
+  template<typename TS>
+  inline void addFromShift(LatticeFermion& y, const TS& x)
+  {
+    LatticeFermion tmp = x;
+    y += tmp;
+  }
 
-  Double c = norm2(tmp1);
-  
-  /* If exactly 0 norm, then solution must be 0 (for pos. def. operator) */
-  if (toBool(c == 0))
+  inline void addFromShift(LatticeFermion& y, const LatticeFermion& x)
   {
-    chi = zero;
-    END_CODE();
-    return;
+    y += x;
   }
+}
 
 
-  
-  // *******************************************************************
-  // Solve  (MdagM + rootQ_n) chi_n = tmp1 where
-  //
-  // tmp1 = H psi or H_gamma_5 psi
-  //
+//! Multi-shift evaluation of the sign function
+/*!
+ * Accumulates  sum_n resP_n (MdagM + rootQ_n)^{-1} b_vec  onto chi.
+ * The search vectors of the shifted systems are stored as TS; the
+ * system with the smallest shift, which drives the iteration, and
+ * all the accumulations are in working precision.
+ *
+ * \param chi     sgn(H) accumulator                          (Modify)
+ * \param b_vec   source H psi or H gamma_5 psi               (Read)
+ * \param c       | b_vec |^2                                 (Read)
+ * \param rsd_sq  target residuum squared                     (Read)
+ * \return number of iterations
+ */
+template<typename TS>
+int lovlapms::multiShift(LatticeFermion& chi, const LatticeFermion& b_vec, 
+			 Double c, const Real& rsd_sq) const
+{
+  typedef typename ShiftReal<TS>::Type_t RS;
+
 #ifdef LOVLAPMS_RSD_CHK
-  LatticeFermion b_vec = tmp1;
-  LatticeFermion x;
+  LatticeFermion x = zero;
 #endif
   LatticeFermion Ap;
   LatticeFermion r;
-  multi1d<LatticeFermion> p(numroot);
+  LatticeFermion p_isz;           // Search vector of the smallest shift
+  LatticeFermion dchi;            // Update of sgn(H)
+  multi1d<TS> p(numroot);         // Search vectors of the other shifts
+  TS r_s;                         // r in the precision of the shifted vectors
+  TS dchi_s;                      // Shifted part of the update of sgn(H)
 
   Real a;              // Alpha for unshifted (isz) system
   Real as;             // alpha for current shifted system
@@ -148,8 +92,6 @@ void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi,
   multi1d<Real> bs(numroot);  // beta for shifted system
   multi2d<Real> z(2,numroot); // zeta for shifted system
 
-  Double chi_sq_new;              // sgn() convergence criterion
-  Double chi_sq_diff;
   multi1d<bool> convsP(numroot);  // convergence mask for shifted system
   bool convP;                     // overall convergence mask
   
@@ -158,51 +100,19 @@ void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi,
 
   int s;                      // Counter for loops over shifts
 
-  // We are solving with 2/(1-mu) D(mu) here so 
-  // I should readjust the residuum by (1-mu)/2
-  Real epsilon_normalise = epsilon*(Real(1)-m_q)/Real(2);
-
-  // Real target for sign function -- from Wuppertal paper
-  Real epsilon_target = epsilon_normalise/(Real(2) + epsilon_normalise);
-
-  // Square it up
-  Real rsdcg_sq = epsilon_target*epsilon_target;   // Target residuum squared
-
-  // Get relative target
-  Real rsd_sq = norm2(psi)*rsdcg_sq;      // Used for relative residue comparisons
-                                          // r_t^2 * || r ||^2
-
-
   // By default, rootQ(isz) is considered the smallest shift 
   int isz = numroot-1;             // isz identifies system with smalles shift
-  
-
-  // chi[0] := mass*psi + c0*H*tmp1 + Eigvecs; 
-  if (isign == PLUS)
-  {
-    //  chi  :=  gamma_5 * (gamma_5 * mass + eps(H)) * Psi 
-    // Final mult by gamma_5 is at end 
-    tmp2 = Gamma(G5) * psi;
-
-    // This will be an axpy
-    chi += tmp2 * mass;
-  }
-  else
-  {
-    // chi  :=  (mass + eps(H) * gamma_5) . Psi  
-    chi += psi * mass;
-  }
-
-  // Multiply in P(0) -- this may well be 0 for type 0 rational approximations
-  chi += tmp1 * constP;
-
 
-  // r[0] := p[0] := tmp1 
-  r = tmp1;
+  // r[0] := p[0] := b_vec 
+  r = b_vec;
+  p_isz = b_vec;
 
   // Initialise search vectors for shifted systems
-  for(s = 0; s < numroot; ++s){
-    p[s] = tmp1;
+  {
+    const TS& b_s = toShift(b_vec, r_s);
+    for(s = 0; s < numroot; ++s)
+      if (s != isz)
+	p[s] = b_s;
   }
 
   // Set convergence masks to false
@@ -231,16 +141,16 @@ void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi,
     // Ap = [  M^dag M + rootQ(isz)  ] p_isz
     
 
-    (*MdagM)(Ap, p[isz], PLUS);
-    Ap += p[isz] * rootQ[isz];
+    (*MdagM)(Ap, p_isz, PLUS);
+    Ap += p_isz * rootQ[isz];
 
     // Project out eigenvectors
     if (k % ReorthFreq == 0) {
-      GramSchm(Ap, EigVec, NEig, all);
+      GramSchmBlock(Ap, EigVec, NEig, all);
     }
 
     //  d =  < p, A.p >
-    d = innerProductReal(p[isz], Ap);                       // 2 Nc Ns  flops 
+    d = innerProductReal(p_isz, Ap);                       // 2 Nc Ns  flops 
     
     bp = b;                        // Store previous unshifted beta
     b = -Real(c/d);                // New unshifted beta
@@ -282,12 +192,12 @@ void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi,
     r += b * Ap;	        // 2 Nc Ns  flops 
 
 #ifdef LOVLAPMS_RSD_CHK
-    x -= b * p[isz];
+    x -= b * p_isz;
 #endif
 
     // Project out eigenvectors 
     if (k % ReorthFreq == 0) {
-      GramSchm (r, EigVec, NEig, all);
+      GramSchmBlock(r, EigVec, NEig, all);
     }
     
     // Work out new iterate for sgn(H).
@@ -303,23 +213,31 @@ void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi,
     // constant in the numerator too.
 
     // smallest shift first
-    Real(rtmp);
-    rtmp = resP[isz] * b;      
-    tmp1 = p[isz] * rtmp;	// 2 Nc Ns  flops 
+    Real rtmp = resP[isz] * b;      
+    dchi = p_isz * rtmp;	// 2 Nc Ns  flops 
 
-    // Now the other shifts. 
+    // Now the other shifts, summed in their own precision. 
     // Converged systems haven' changed, so we only add results
     // from the unconverged systems
+    bool unconvP = false;
     for(s = 0; s < numroot; ++s) {
       if(s != isz  &&  !convsP[s]) {
 
-	rtmp = bs[s] * resP[s];
-	tmp1 += p[s] * rtmp;	// 2 Nc Ns  flops
+	RS rtmp_s = bs[s] * resP[s];
+	if (unconvP)
+	  dchi_s += p[s] * rtmp_s;	// 2 Nc Ns  flops
+	else
+	  dchi_s = p[s] * rtmp_s;
+
+	unconvP = true;
       }
     }
 
+    if (unconvP)
+      addFromShift(dchi, dchi_s);
+
     // Now update the sgn(H) with the above accumulated linear sum
-    chi -= tmp1;                   // 2 Nc Ns  flops
+    chi -= dchi;                   // 2 Nc Ns  flops
 
     // Store in cp the previous value of c
     // cp  =  | r[k] |**2 
@@ -345,22 +263,22 @@ void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi,
     // where the as[]-s are the shifted versions of alpha. 
     // we must first computed these as per Beat's paper hep-lat/9612014
     // eq 2.43 on page 7.
+
+    // Smallest shift 	  
+    // p[k+1] = r[k+1] + a[k+1] p[k]
     // 
+    // k is iteration index
+    p_isz *= a;	        // Nc Ns  flops 
+    p_isz += r;		// Nc Ns  flops 
+
     // As usual we only update the unconverged systems
-    for(s = 0; s < numroot; ++s)
+    if (unconvP)
     {
+      const TS& r_cur = toShift(r, r_s);
 
-      if (s == isz) {
-	// Smallest shift 	  
-	// p[k+1] = r[k+1] + a[k+1] p[k]
-	// 
-	// k is iteration index
-	p[s] *= a;	        // Nc Ns  flops 
-	p[s] += r;		// Nc Ns  flops 
-	
-      }
-      else {
-	if (! convsP[s]) {
+      for(s = 0; s < numroot; ++s)
+      {
+	if (s != isz && ! convsP[s]) {
 	  // Unshifted systems
 	  // First compute shifted alpha
 	  as = a * z[iz][s]*bs[s] / (z[1-iz][s]*b);
@@ -369,19 +287,15 @@ void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi,
 	  //    ps[k+1] := zs[k+1] r[k+1] + as[k+1] ps[k]; 
 	  //
 	  // k is iteration index
-	  p[s] *= as;	        // Nc Ns  flops 
-	  p[s] += r * z[iz][s];	// Nc Ns  flops 
+	  RS as_s = as;
+	  RS z_s = z[iz][s];
+	  p[s] *= as_s;	        // Nc Ns  flops 
+	  p[s] += r_cur * z_s;	// Nc Ns  flops 
 	  
 	}
       }
     }
 
-#if 0
-    // Project out eigenvectors 
-    if (k % ReorthFreq == 0)
-      GramSchm (p, numroot, EigVec, NEig, all);
-#endif
-    
     // Convergence tests start here.
     //
     // These are two steps:
@@ -397,7 +311,6 @@ void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi,
     // to false
     convP = true;                          // Assume convergence and prove
                                            // otherwise
-
     for(s = 0; s < numroot; ++s) {
  
       // Only deal with unconverged systems
@@ -433,48 +346,174 @@ void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi,
       QDPIO::cout << "|| b - (Q_isz + MM)x || = " << norm2check << " accum = " << check_ztmp << std::endl;
     }
 #endif
+  }
 
-    // Now check convergence of the sgn() itself.
-    // It was updated with 
-    //               sum resP(shift) beta(shift) p_shift
-    // and this quantity is still in tmp1.
-    //
-    // So norm tmp1 is like an abolute error in sgn() aka: Delta sgn()
-    //
-    // Here we ensure Delta sgn() < target r^2 || sgn H[k-1] ||
-    //
-    // ie that  the relative error in sgn() is smaller than the target.
-    // sgn H is kept in chi
-    //
-    // Only converge if chi is converged. If vectors converge first, then error
-    
-#if 0   
-    if (k > 0 &&  !convP) {
+  return k;
+}
 
-      // Get target r^2 * || sgn (H) ||^2
-      chi_sq_new = rsd_sq * norm2(chi);
 
-      // Get || Delta sgn()
-      chi_sq_diff = norm2(tmp1);      // the diff of old and new soln
+void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi, 
+			   enum PlusMinus isign) const
+{
+  operator()(chi, psi, isign, RsdCG);
+}
 
-#if 0
-      QDPIO::cout << "Iter " << k << " || delta Sgn() || " << sqrt(chi_sq_diff) << std::endl;
-#endif 
-      // Check convergence
-      bool btmp = toBool(chi_sq_diff < chi_sq_new);
+//! Apply the GW operator onto a source std::vector
+/*! \ingroup linop
+ *
+ * This routine applies the 4D GW operator onto a source
+ * std::vector. The coeffiecients for the approximation get 
+ * wired into the class by the constructor and should
+ * come fromt fermion action.
+ *
+ * The operator applied is:
+ *       D       =    (1/2)[  (1+m) + (1-m)gamma_5 sgn(H_w) ] psi
+ * or    D^{dag} =    (1/2)[  (1+m) + (1-m) sgn(H_w) gamma_5 psi
+ * 
+ * 
+ * \param chi     result std::vector                              (Write)  
+ * \param psi 	  source std::vector         	             (Read)
+ * \param isign   Hermitian Conjugation Flag 
+ *                ( PLUS = no dagger| MINUS = dagger )       (Read)
+ */
+void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi, 
+			   enum PlusMinus isign, Real epsilon) const
+{
+  START_CODE();
 
-      // If we havent converged globally but the vectors have then error
-      if (! btmp && convP) {
-	QDP_error_exit("vectors converged but not final chi");
-      }
-      
-      // cnvP = convP & btmp; 
-      convP = btmp;
+  LatticeFermion tmp1, tmp2;
+
+  // Gamma_5 
+  int G5 = Ns*Ns - 1;
+
+  // Mass for shifted system
+  Real mass = Real(1 + m_q) / Real(1 - m_q);
+  
+
+  switch (isign)
+  {
+  case PLUS:
+    //  Non-Dagger: psi is source and tmp1 
+    //  chi  :=  gamma_5 * (gamma_5 * mass + sgn(H)) * Psi  
+    tmp1 = psi;
+    break;
+
+  case MINUS:
+    // Dagger: apply gamma_5 to source psi to make tmp1 
+    //  chi  :=  (mass + sgn(H) * gamma_5) * Psi  
+    tmp1 = Gamma(G5) * psi;
+    break;
+
+  default:
+    QDP_error_exit("unknown isign value", isign);
+  }
+
+
+  chi = zero;
+
+  // Project out eigenvectors of source if desired 
+  // chi  +=  func(lambda) * EigVec * <EigVec, psi>  
+  // Usually "func(.)" is sgn(.); it is precomputed in EigValFunc. 
+  // for all the eigenvalues
+  //
+  //  Also we must bear in mind that if we want the dagger of the 
+  // operator we must use gamma_5 psi instead of psi
+  //
+  // at this stage tmp1 holds either psi or gamma_5 psi as required
+  // so we must project from tmp1
+
+  if (NEig > 0)
+  {
+    // All the inner products in one sweep and one global sum
+    multi1d<DComplex> ip;
+    blockInnerProduct(ip, EigVec, NEig, tmp1, all);
+
+    Complex cconsts;
+
+    for(int i = 0; i < NEig; ++i)
+    {
+
+      // BUG Should this not be innerProduct(EigVec[i], psi) ???
+      //                     or innerProduct(EigVec[i], g5 psi) ????
+
+      cconsts = ip[i];
+      tmp1 -= EigVec[i] * cconsts;
+
+      cconsts *= EigValFunc[i];
+      chi += EigVec[i] * cconsts;
     }
-    
-#endif
   }
 
+  // tmp1 <- H * Projected tmp_1, where tmp1 = psi or gamma_5 psi as needed
+  //      <- gamma_5 * M * tmp1
+  (*M)(tmp2, tmp1, PLUS);
+  tmp1 = Gamma(G5) * tmp2;
+  
+ 
+
+  Double c = norm2(tmp1);
+  
+  /* If exactly 0 norm, then solution must be 0 (for pos. def. operator) */
+  if (toBool(c == 0))
+  {
+    chi = zero;
+    END_CODE();
+    return;
+  }
+
+
+  
+  // *******************************************************************
+  // Solve  (MdagM + rootQ_n) chi_n = tmp1 where
+  //
+  // tmp1 = H psi or H_gamma_5 psi
+  //
+
+  // We are solving with 2/(1-mu) D(mu) here so 
+  // I should readjust the residuum by (1-mu)/2
+  Real epsilon_normalise = epsilon*(Real(1)-m_q)/Real(2);
+
+  // Real target for sign function -- from Wuppertal paper
+  Real epsilon_target = epsilon_normalise/(Real(2) + epsilon_normalise);
+
+  // Square it up
+  Real rsdcg_sq = epsilon_target*epsilon_target;   // Target residuum squared
+
+  // Get relative target
+  Real rsd_sq = norm2(psi)*rsdcg_sq;      // Used for relative residue comparisons
+                                          // r_t^2 * || r ||^2
+
+  // chi[0] := mass*psi + c0*H*tmp1 + Eigvecs; 
+  if (isign == PLUS)
+  {
+    //  chi  :=  gamma_5 * (gamma_5 * mass + eps(H)) * Psi 
+    // Final mult by gamma_5 is at end 
+    tmp2 = Gamma(G5) * psi;
+
+    // This will be an axpy
+    chi += tmp2 * mass;
+  }
+  else
+  {
+    // chi  :=  (mass + eps(H) * gamma_5) . Psi  
+    chi += psi * mass;
+  }
+
+  // Multiply in P(0) -- this may well be 0 for type 0 rational approximations
+  chi += tmp1 * constP;
+
+  // The shifted search vectors only enter sgn(H) through the accumulated
+  // updates. For loose targets (e.g. from relaxed outer solvers) they are
+  // stored in single precision, halving their memory traffic for many
+  // poles. Only the storage is mixed: M^dag M is applied in double
+  // precision to the search vector of the smallest shift, and its
+  // residual, the projections and sgn(H) itself stay in double precision.
+  int k;
+  if (numroot > 1 && toBool(epsilon_target >= RsdCGSingle))
+    k = multiShift<LatticeFermionF>(chi, tmp1, c, rsd_sq);
+  else
+    k = multiShift<LatticeFermion>(chi, tmp1, c, rsd_sq);
+
   QDPIO::cout << "Overlap Inner Solve (lovlapms): " << k << " iterations " << std::endl;
   // End of MULTI SHIFTERY 
 
@@ -29,6 +29,11 @@ namespace Chroma
    *  NOTE: B is hermitian, so       
    *     (1 + gamma_5 * B)^dag = (1 + B * gamma_5) 
    *                           = gamma_5 * (1 + gamma_5 * B) * gamma_5 
+   *
+   *  For targets at least as loose as RsdCGSingle only the storage of the
+   *  shifted search vectors is single precision. M^dag M is always applied
+   *  in double precision; this is mixed precision storage, not a single
+   *  precision inner solve.
    */
 
   class lovlapms : public UnprecLinearOperator<LatticeFermion, 
@@ -56,6 +61,8 @@ namespace Chroma
      * \param _NEig           number of eigenvalues              (Read)
      * \param _MaxCG          MaxCG inner CG                     (Read)
      * \param _RsdCG          residual for inner CG              (Read)
+     * \param _ReorthFreq     reorthogonalisation frequency      (Read)
+     * \param _RsdCGSingle    targets at least this loose store the shifted vectors in single precision (Read)
      */
     lovlapms(const UnprecWilsonTypeFermAct<T,P,Q>& S_aux,
 	     Handle< FermState<T,P,Q> > state,
@@ -68,11 +75,13 @@ namespace Chroma
 	     const multi1d<LatticeFermion>& _EigVec,
 	     int _MaxCG,
 	     const Real& _RsdCG,
-	     const int _ReorthFreq ) :
+	     const int _ReorthFreq,
+	     const Real& _RsdCGSingle = Real(1.0e-5) ) :
       M(S_aux.linOp(state)), MdagM(S_aux.lMdagM(state)), fbc(state->getFermBC()),
       m_q(_m_q), numroot(_numroot), constP(_constP),
       resP(_resP), rootQ(_rootQ), EigVec(_EigVec), EigValFunc(_EigValFunc),
-      NEig(_NEig), MaxCG(_MaxCG), RsdCG(_RsdCG),  ReorthFreq(_ReorthFreq) {}
+      NEig(_NEig), MaxCG(_MaxCG), RsdCG(_RsdCG),  ReorthFreq(_ReorthFreq),
+      RsdCGSingle(_RsdCGSingle) {}
 
     //! Destructor is automatic
     ~lovlapms() {}
@@ -92,6 +101,11 @@ namespace Chroma
     const FermBC<T,P,Q>& getFermBC() const {return *fbc;}
 
   private:
+    //! Multi-shift evaluation of the sign function with shifted search vectors stored as TS
+    template<typename TS>
+    int multiShift(LatticeFermion& chi, const LatticeFermion& b_vec, 
+		   Double c, const Real& rsd_sq) const;
+
     Handle< DiffLinearOperator<T,P,Q> > M;
     Handle< DiffLinearOperator<T,P,Q> > MdagM;
     Handle< FermBC<T,P,Q> >     fbc;
@@ -108,6 +122,7 @@ namespace Chroma
     int MaxCG;
     const Real RsdCG;
     const int   ReorthFreq;
+    const Real RsdCGSingle;
   };
 
 
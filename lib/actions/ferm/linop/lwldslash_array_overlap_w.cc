@@ -0,0 +1,112 @@
+/*! \file
+ *  \brief Wilson Dslash over arrays with the communications overlapped
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/linop/lwldslash_array_overlap_w.h"
+
+
+namespace Chroma 
+{ 
+
+  //! Creation routine
+  void QDPWilsonDslashArrayOverlap::create(Handle< FermState<T,P,Q> > state, int N5_)
+  {
+    multi1d<Real> cf(Nd);
+    cf = 1.0;
+    create(state, N5_, cf);
+  }
+
+
+  //! Creation routine with anisotropy
+  void QDPWilsonDslashArrayOverlap::create(Handle< FermState<T,P,Q> > state, int N5_,
+					   const AnisoParam_t& anisoParam) 
+  {
+    START_CODE();
+
+    create(state, N5_, makeFermCoeffs(anisoParam));
+
+    END_CODE();
+  }
+
+
+  //! Creation routine
+  void QDPWilsonDslashArrayOverlap::create(Handle< FermState<T,P,Q> > state, int N5_,
+					   const multi1d<Real>& coeffs_)
+  {
+    START_CODE();
+
+    N5 = N5_;
+    coeffs = coeffs_;
+
+    // Save a copy of the fermbc
+    fbc = state->getFermBC();
+
+    // Sanity check
+    if (fbc.operator->() == 0)
+    {
+      QDPIO::cerr << "QDPWilsonDslashArrayOverlap: error: fbc is null" << std::endl;
+      QDP_abort(1);
+    }
+
+    halo5 = new WilsonHaloDslash<T,Q>(state, coeffs, N5);
+    halo4 = new WilsonHaloDslash<T,Q>(state, coeffs, 1);
+
+    END_CODE();
+  }
+
+
+  //! General Wilson-Dirac dslash
+  /*! \ingroup linop
+   * Wilson dslash
+   *
+   * Arguments:
+   *
+   *  \param chi      Result				                (Write)
+   *  \param psi      Pseudofermion field				(Read)
+   *  \param isign    D'^dag or D' ( MINUS | PLUS ) resp.		(Read)
+   *  \param cb	      Checkerboard of OUTPUT std::vector			(Read) 
+   */
+  void 
+  QDPWilsonDslashArrayOverlap::apply (multi1d<LatticeFermion>& chi, 
+				      const multi1d<LatticeFermion>& psi, 
+				      enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    if( chi.size() != N5 ) chi.resize(N5);
+
+    halo5->apply(chi.slice(), psi.slice(), isign, cb);
+
+    for(int n=0; n < N5; ++n)
+      getFermBC().modifyF(chi[n], QDP::rb[cb]);
+
+    END_CODE();
+  }
+
+
+  //! General Wilson-Dirac dslash
+  /*! \ingroup linop
+   * Wilson dslash
+   *
+   * Arguments:
+   *
+   *  \param chi	      Result				                (Write)
+   *  \param psi	      Pseudofermion field				(Read)
+   *  \param isign      D'^dag or D' ( MINUS | PLUS ) resp.		(Read)
+   *  \param cb	      Checkerboard of OUTPUT std::vector			(Read) 
+   */
+  void 
+  QDPWilsonDslashArrayOverlap::apply (LatticeFermion& chi, const LatticeFermion& psi, 
+				      enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    halo4->apply(&chi, &psi, isign, cb);
+
+    getFermBC().modifyF(chi, QDP::rb[cb]);
+
+    END_CODE();
+  }
+
+} // End Namespace Chroma
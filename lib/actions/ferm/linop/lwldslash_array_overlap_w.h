@@ -0,0 +1,120 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Wilson Dslash over arrays with the communications overlapped
+ */
+
+#ifndef __lwldslash_array_overlap_h__
+#define __lwldslash_array_overlap_h__
+
+#include "state.h"
+#include "io/aniso_io.h"
+#include "actions/ferm/linop/lwldslash_base_array_w.h"
+#include "actions/ferm/linop/wilson_halo_w.h"
+
+
+namespace Chroma 
+{ 
+  //! Wilson-Dirac dslash of arrays with the communications overlapped
+  /*!
+   * \ingroup linop
+   *
+   * The same operator as QDPWilsonDslashArrayOpt. The halos of all N5
+   * fields go in one message per hop, sent before the interior sites are
+   * computed. See WilsonHaloDslash.
+   */
+  class QDPWilsonDslashArrayOverlap : public WilsonDslashBaseArray
+  {
+  public:
+    // Typedefs to save typing
+    typedef LatticeFermion               T;
+    typedef multi1d<LatticeColorMatrix>  P;
+    typedef multi1d<LatticeColorMatrix>  Q;
+
+    //! Empty constructor. Must use create later
+    QDPWilsonDslashArrayOverlap() {}
+
+    //! Full constructor
+    QDPWilsonDslashArrayOverlap(Handle< FermState<T,P,Q> > state,
+				int N5_)
+      {create(state,N5_);}
+
+    //! Full constructor
+    QDPWilsonDslashArrayOverlap(Handle< FermState<T,P,Q> > state,
+				int N5_,
+				const AnisoParam_t& aniso_)
+      {create(state,N5_,aniso_);}
+
+    //! Creation routine
+    void create(Handle< FermState<T,P,Q> > state,
+		int N5_);
+
+    //! Creation routine
+    void create(Handle< FermState<T,P,Q> > state,
+		int N5_,
+		const AnisoParam_t& aniso_);
+
+    //! Creation routine
+    void create(Handle< FermState<T,P,Q> > state,
+		int N5_,
+		const multi1d<Real>& coeffs_);
+
+    //! Expected length of array index
+    int size() const {return N5;}
+
+    //! No real need for cleanup here
+    ~QDPWilsonDslashArrayOverlap() {}
+
+    /**
+     * Apply a dslash
+     *
+     * \param chi     result                                      (Write)
+     * \param psi     source                                      (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of OUTPUT std::vector               (Read) 
+     *
+     * \return The output of applying dslash on psi
+     */
+    void apply (multi1d<LatticeFermion>& chi, 
+		const multi1d<LatticeFermion>& psi, 
+		enum PlusMinus isign, int cb) const;
+
+    /**
+     * Apply a dslash
+     *
+     * \param chi     result                                      (Write)
+     * \param psi     source                                      (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of OUTPUT std::vector               (Read) 
+     *
+     * \return The output of applying dslash on psi
+     */
+    void apply (LatticeFermion& chi, 
+		const LatticeFermion& psi, 
+		enum PlusMinus isign, int cb) const;
+     
+    //! Return the fermion BC object for this linear operator
+    const FermBC<T,P,Q>& getFermBC() const {return *fbc;}
+
+    //! Compute, communication and wait times of the last array call
+    const DslashCommTimings& lastTimings() const {return halo5->lastTimings();}
+
+    //! Compute, communication and wait times summed over all array calls
+    const DslashCommTimings& totalTimings() const {return halo5->totalTimings();}
+
+  protected:
+    //! Get the anisotropy parameters
+    const multi1d<Real>& getCoeffs() const {return coeffs;}
+
+  private:
+    int N5;
+    multi1d<Real> coeffs;  /*!< Nd array of coefficients of terms in the action */
+    Handle< FermBC<T,P,Q> > fbc;
+    Handle< WilsonHaloDslash<T,Q> > halo5;  /*!< all N5 fields per message */
+    Handle< WilsonHaloDslash<T,Q> > halo4;  /*!< a single field */
+  };
+
+
+} // End Namespace Chroma
+
+
+#endif
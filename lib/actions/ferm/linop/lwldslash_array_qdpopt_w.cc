@@ -76,6 +76,25 @@ namespace Chroma
       QDP_abort(1);
     }
 
+    bool packedP = (Nc == 3 && Nd == 4);
+#ifdef QDP_IS_QDPJIT
+    packedP = false;
+#endif
+
+    if (packedP)
+    {
+      // Packed once per FermState and shared with the other dslashes on
+      // it, and with the 4D dslashes. Uncompressed, the links need not be SU(3)
+      u_packed = ThePackedGaugeCache<WordType<T>::Type_t>::Type_t::Instance().get(state, 18);
+      tmp.resize(2*Nd*N5);
+      u.resize(0);
+
+      END_CODE();
+      return;
+    }
+
+    u_packed = 0;
+
     // Get links
     u = state->getLinks();
 
@@ -109,6 +128,20 @@ namespace Chroma
 
     if( chi.size() != N5 ) chi.resize(N5);
 
+#ifndef QDP_IS_QDPJIT
+    if (u_packed.operator->() != 0)
+    {
+      // One pass over the packed links for all N5 fields
+      packedWilsonDslash(chi.slice(), psi.slice(), N5, tmp, *u_packed, coeffs, isign, cb);
+
+      for(int n=0; n < N5; ++n)
+	getFermBC().modifyF(chi[n], QDP::rb[cb]);
+
+      END_CODE();
+      return;
+    }
+#endif
+
     for(int n=0; n < N5; ++n)
       apply(chi[n], psi[n], isign, cb);
 
@@ -133,6 +166,18 @@ namespace Chroma
 			       enum PlusMinus isign, int cb) const
   {
     START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    if (u_packed.operator->() != 0)
+    {
+      packedWilsonDslash(&chi, &psi, 1, tmp, *u_packed, coeffs, isign, cb);
+      getFermBC().modifyF(chi, QDP::rb[cb]);
+
+      END_CODE();
+      return;
+    }
+#endif
+
 #if (QDP_NC == 2) || (QDP_NC == 3)
     /*     F 
      *   a2  (x)  :=  U  (x) (1 - isign gamma  ) psi(x)
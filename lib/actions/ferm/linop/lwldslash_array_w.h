@@ -8,6 +8,7 @@
 
 #include "state.h"
 #include "actions/ferm/linop/lwldslash_base_array_w.h"
+#include "actions/ferm/linop/packed_gauge_w.h"
 
 
 namespace Chroma 
@@ -40,6 +41,11 @@ namespace Chroma
    *	             ---
    *	             mu=0
    *
+   * For Nc = 3 and Nd = 4 the links are kept in a PackedGaugeField shared
+   * with the 4D dslashes on the same FermState, and all the fields are
+   * done by one packedWilsonDslash, which reads the links of a site once
+   * for all of them. Otherwise, and with QDP-JIT, the QDP expressions are
+   * used one field at a time.
    */
 
   class QDPWilsonDslashArray : public WilsonDslashBaseArray
@@ -122,8 +128,10 @@ namespace Chroma
   private:
     int N5;
     multi1d<Real> coeffs;  /*!< Nd array of coefficients of terms in the action */
-    multi1d<LatticeColorMatrix> u;  // fold in anisotropy
+    multi1d<LatticeColorMatrix> u;  // fold in anisotropy, without packed links
     Handle< FermBC<T,P,Q> > fbc;
+    Handle< PackedGaugeField<WordType<T>::Type_t> > u_packed;  /*!< packed links, null if not used */
+    mutable multi1d<LatticeHalfFermion> tmp;  /*!< hops of apply */
   };
 
 
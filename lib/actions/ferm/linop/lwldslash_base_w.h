@@ -76,6 +76,56 @@ namespace Chroma
 		       const T& chi, const T& psi, 
 		       enum PlusMinus isign, int cb) const ;
 
+    //! Take deriv of D summed over several pairs of vectors
+    /*!
+     * \param chi     left vectors                                (Read)
+     * \param psi     right vectors                               (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     *
+     * \return Computes   \f$\sum_i \chi_i^\dag * \dot(D} * \psi_i\f$
+     */
+    virtual void derivMultipole(P& ds_u, 
+				const multi1d<T>& chi, const multi1d<T>& psi, 
+				enum PlusMinus isign) const;
+
+    //! Take deriv of D summed over several pairs of vectors
+    /*!
+     * The spin traced outer products of all the pairs are accumulated
+     * per direction before the anisotropy weight and the boundary
+     * conditions are applied, and the half spinors are shifted instead
+     * of the full ones, so the cost per pair is one half spinor halo
+     * exchange and one outer product per direction.
+     *
+     * \param chi     left vectors on cb                          (Read)
+     * \param psi     right vectors on 1-cb                       (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of chi vectors                 (Read)
+     *
+     * \return Computes   \f$\sum_i \chi_i^\dag * \dot(D} * \psi_i\f$
+     */
+    virtual void derivMultipole(P& ds_u, 
+				const multi1d<T>& chi, const multi1d<T>& psi, 
+				enum PlusMinus isign, int cb) const;
+
+    //! Apply the dslash onto a block of vectors
+    /*!
+     * Default implementation applies the dslash to one vector after the
+     * other. Dslashes that can share the gauge field among the vectors
+     * override this.
+     *
+     * \param chi     results                                     (Write)
+     * \param psi     sources                                     (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of OUTPUT vectors              (Read)
+     */
+    virtual void applyMultiRHS(multi1d<T>& chi, const multi1d<T>& psi, 
+			       enum PlusMinus isign, int cb) const
+    {
+      chi.resize(psi.size());
+      for(int i=0; i < psi.size(); ++i)
+	this->apply(chi[i], psi[i], isign, cb);
+    }
+
     //! Return flops performed by the operator()
     unsigned long nFlops() const;
 
@@ -227,6 +277,135 @@ namespace Chroma
   }
 
 
+  //! Spin project a vector for the derivative in direction mu
+  /*!
+   * Minus projectors for PLUS, plus projectors for MINUS, as in deriv
+   */
+  template<typename T, typename H>
+  void wilsonDerivSpinProject(H& h, const T& psi, int mu, enum PlusMinus isign, const Subset& s)
+  {
+    if (isign == PLUS)
+    {
+      switch(mu) 
+      { 
+      case 0: h[s] = spinProjectDir0Minus(psi); break;
+      case 1: h[s] = spinProjectDir1Minus(psi); break;
+      case 2: h[s] = spinProjectDir2Minus(psi); break;
+      case 3: h[s] = spinProjectDir3Minus(psi); break;
+      default: QDP_error_exit("unknown direction");
+      }
+    }
+    else
+    {
+      switch(mu) 
+      { 
+      case 0: h[s] = spinProjectDir0Plus(psi); break;
+      case 1: h[s] = spinProjectDir1Plus(psi); break;
+      case 2: h[s] = spinProjectDir2Plus(psi); break;
+      case 3: h[s] = spinProjectDir3Plus(psi); break;
+      default: QDP_error_exit("unknown direction");
+      }
+    }
+  }
+
+
+  //! Spin reconstruct a projected vector for the derivative in direction mu
+  template<typename T, typename H>
+  void wilsonDerivSpinReconstruct(T& psi, const H& h, int mu, enum PlusMinus isign, const Subset& s)
+  {
+    if (isign == PLUS)
+    {
+      switch(mu) 
+      { 
+      case 0: psi[s] = spinReconstructDir0Minus(h); break;
+      case 1: psi[s] = spinReconstructDir1Minus(h); break;
+      case 2: psi[s] = spinReconstructDir2Minus(h); break;
+      case 3: psi[s] = spinReconstructDir3Minus(h); break;
+      default: QDP_error_exit("unknown direction");
+      }
+    }
+    else
+    {
+      switch(mu) 
+      { 
+      case 0: psi[s] = spinReconstructDir0Plus(h); break;
+      case 1: psi[s] = spinReconstructDir1Plus(h); break;
+      case 2: psi[s] = spinReconstructDir2Plus(h); break;
+      case 3: psi[s] = spinReconstructDir3Plus(h); break;
+      default: QDP_error_exit("unknown direction");
+      }
+    }
+  }
+
+
+  //! Take deriv of D summed over several pairs of vectors
+  template<typename T, typename P, typename Q>
+  void
+  WilsonDslashBase<T,P,Q>::derivMultipole(P& ds_u,
+					  const multi1d<T>& chi, const multi1d<T>& psi, 
+					  enum PlusMinus isign) const
+  {
+    START_CODE();
+
+    ds_u.resize(Nd);
+
+    P ds_tmp; 
+    derivMultipole(ds_u, chi, psi, isign, 0);
+    derivMultipole(ds_tmp, chi, psi, isign, 1);
+    ds_u += ds_tmp;
+
+    END_CODE();
+  }
+
+
+  //! Take deriv of D summed over several pairs of vectors
+  template<typename T, typename P, typename Q>
+  void 
+  WilsonDslashBase<T,P,Q>::derivMultipole(P& ds_u,
+					  const multi1d<T>& chi, const multi1d<T>& psi, 
+					  enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    if (chi.size() != psi.size())
+    {
+      QDPIO::cerr << __func__ << ": chi and psi differ in size" << std::endl;
+      QDP_abort(1);
+    }
+
+    ds_u.resize(Nd);
+
+    const multi1d<Real>& anisoWeights = getCoeffs();
+
+    typename HalfFermionType<T>::Type_t tmp_h, tmp_h_shift;
+    T temp_ferm;
+
+    // Sum of the outer products, one direction at a time
+    P temp_mat;
+    temp_mat.resize(1);
+
+    for(int mu = 0; mu < Nd; ++mu) 
+    {
+      temp_mat[0][rb[cb]] = zero;
+
+      for(int i=0; i < psi.size(); ++i)
+      {
+	wilsonDerivSpinProject(tmp_h, psi[i], mu, isign, rb[1-cb]);
+	tmp_h_shift[rb[cb]] = shift(tmp_h, FORWARD, mu);
+	wilsonDerivSpinReconstruct(temp_ferm, tmp_h_shift, mu, isign, rb[cb]);
+
+	temp_mat[0][rb[cb]] += traceSpin(outerProduct(temp_ferm,chi[i]));
+      }
+
+      ds_u[mu][rb[cb]] = anisoWeights[mu] * temp_mat[0];
+      ds_u[mu][rb[1-cb]] = zero;    
+    }
+    (*this).getFermBC().zero(ds_u);
+
+    END_CODE();
+  }
+
+
   //! Return flops performed by the operator()
   template<typename T, typename P, typename Q>
   unsigned long 
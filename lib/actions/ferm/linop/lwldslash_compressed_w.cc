@@ -0,0 +1,222 @@
+/*! \file
+ *  \brief Single precision Wilson dslash on compressed links
+ */
+
+#include "actions/ferm/linop/lwldslash_compressed_w.h"
+
+namespace Chroma
+{
+
+  // Default: no compression
+  WilsonGaugeCompressionParams::WilsonGaugeCompressionParams()
+  {
+    reconstruct = 18;
+    half_precP = false;
+  }
+
+  // Read params
+  WilsonGaugeCompressionParams::WilsonGaugeCompressionParams(XMLReader& xml, const std::string& path)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "Reconstruct", reconstruct);
+
+    half_precP = false;
+    if (paramtop.count("HalfPrecLinks") != 0)
+      read(paramtop, "HalfPrecLinks", half_precP);
+
+    if (reconstruct != 18 && reconstruct != 12 && reconstruct != 8)
+    {
+      QDPIO::cerr << __func__ << ": Reconstruct must be 18, 12 or 8, found " << reconstruct << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+  //! Read params
+  void read(XMLReader& xml, const std::string& path, WilsonGaugeCompressionParams& param)
+  {
+    WilsonGaugeCompressionParams tmp(xml, path);
+    param = tmp;
+  }
+
+  //! Write params
+  void write(XMLWriter& xml, const std::string& path, const WilsonGaugeCompressionParams& param)
+  {
+    push(xml, path);
+
+    write(xml, "Reconstruct", param.reconstruct);
+    write(xml, "HalfPrecLinks", param.half_precP);
+
+    pop(xml);
+  }
+
+
+#ifdef QDP_IS_QDPJIT
+  namespace
+  {
+    //! h = (1 -/+ gamma_mu) psi  on the subset
+    void spinProject(LatticeHalfFermionF& h, const LatticeFermionF& psi,
+		     int mu, bool plusP, const Subset& s)
+    {
+      switch (mu)
+      {
+      case 0:
+	if (plusP) h[s] = spinProjectDir0Plus(psi); else h[s] = spinProjectDir0Minus(psi);
+	break;
+      case 1:
+	if (plusP) h[s] = spinProjectDir1Plus(psi); else h[s] = spinProjectDir1Minus(psi);
+	break;
+      case 2:
+	if (plusP) h[s] = spinProjectDir2Plus(psi); else h[s] = spinProjectDir2Minus(psi);
+	break;
+      case 3:
+	if (plusP) h[s] = spinProjectDir3Plus(psi); else h[s] = spinProjectDir3Minus(psi);
+	break;
+      default:
+	QDPIO::cerr << "QDPWilsonDslashCompressedF: unsupported direction " << mu << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+    //! chi += reconstruction of h  on the subset
+    void spinReconstructAdd(LatticeFermionF& chi, const LatticeHalfFermionF& h,
+			    int mu, bool plusP, const Subset& s)
+    {
+      switch (mu)
+      {
+      case 0:
+	if (plusP) chi[s] += spinReconstructDir0Plus(h); else chi[s] += spinReconstructDir0Minus(h);
+	break;
+      case 1:
+	if (plusP) chi[s] += spinReconstructDir1Plus(h); else chi[s] += spinReconstructDir1Minus(h);
+	break;
+      case 2:
+	if (plusP) chi[s] += spinReconstructDir2Plus(h); else chi[s] += spinReconstructDir2Minus(h);
+	break;
+      case 3:
+	if (plusP) chi[s] += spinReconstructDir3Plus(h); else chi[s] += spinReconstructDir3Minus(h);
+	break;
+      default:
+	QDPIO::cerr << "QDPWilsonDslashCompressedF: unsupported direction " << mu << std::endl;
+	QDP_abort(1);
+      }
+    }
+  }
+#endif
+
+
+  //! Full constructor with anisotropy
+  QDPWilsonDslashCompressedF::QDPWilsonDslashCompressedF(Handle< FermState<T,P,Q> > state,
+							 const AnisoParam_t& aniso_,
+							 const WilsonGaugeCompressionParams& comp_)
+  {
+    create(state, aniso_, comp_);
+  }
+
+
+  //! Creation routine with anisotropy
+  void QDPWilsonDslashCompressedF::create(Handle< FermState<T,P,Q> > state,
+					  const AnisoParam_t& aniso_,
+					  const WilsonGaugeCompressionParams& comp_)
+  {
+    START_CODE();
+
+    if (Nc != 3 || Nd != 4)
+    {
+      QDPIO::cerr << "QDPWilsonDslashCompressedF: only implemented for Nc=3 and Nd=4" << std::endl;
+      QDP_abort(1);
+    }
+
+    comp = comp_;
+
+    // The coefficients are applied in the link multiply
+    coeffs = makeFermCoeffs(aniso_);
+
+    // Save a copy of the fermbc
+    fbc = state->getFermBC();
+
+    // Sanity check
+    if (fbc.operator->() == 0)
+    {
+      QDPIO::cerr << "QDPWilsonDslashCompressedF: error: fbc is null" << std::endl;
+      QDP_abort(1);
+    }
+
+    // Temporaries of apply, one per hop
+    tmp.resize(2*Nd);
+
+#ifndef QDP_IS_QDPJIT
+    // Packed once per FermState and shared with the other dslashes on it
+    if (comp.half_precP)
+      u_half = ThePackedGaugeCacheH::Instance().get(state, comp.reconstruct);
+    else
+      u_single = ThePackedGaugeCacheF::Instance().get(state, comp.reconstruct);
+#else
+    // No site loops here, the links are used uncompressed
+    u_full.resize(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      u_full[mu] = (state->getLinks())[mu];
+      u_full[mu] *= coeffs[mu];
+    }
+#endif
+
+    END_CODE();
+  }
+
+
+  //! General Wilson-Dirac dslash
+  /*! \ingroup linop
+   * Wilson dslash
+   *
+   * Arguments:
+   *
+   *  \param chi	      Result				                (Write)
+   *  \param psi	      Pseudofermion field				(Read)
+   *  \param isign      D'^dag or D' ( MINUS | PLUS ) resp.		(Read)
+   *  \param cb	      Checkerboard of OUTPUT std::vector			(Read)
+   */
+  void QDPWilsonDslashCompressedF::apply (T& chi, const T& psi,
+					  enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    // The link multiplies and reconstructions in one pass over the packed links
+    if (comp.half_precP)
+      packedWilsonDslash(&chi, &psi, 1, tmp, *u_half, coeffs, isign, cb);
+    else
+      packedWilsonDslash(&chi, &psi, 1, tmp, *u_single, coeffs, isign, cb);
+#else
+    // Undaggered: forward hops use the minus projectors
+    const bool fwd_plusP = (isign == MINUS);
+
+    LatticeHalfFermionF h;
+
+    chi[rb[cb]] = zero;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      /*     F
+       *   a2  (x)  :=  U  (x) (1 - isign gamma  ) psi(x+mu)
+       *     mu          mu                    mu
+       */
+      spinProject(h, psi, mu, fwd_plusP, rb[1-cb]);
+      tmp[0][rb[cb]] = u_full[mu] * shift(h, FORWARD, mu);
+      spinReconstructAdd(chi, tmp[0], mu, fwd_plusP, rb[cb]);
+
+      /*     B           +
+       *   a2  (x)  :=  U  (x-mu) (1 + isign gamma  ) psi(x-mu)
+       *     mu          mu                       mu
+       */
+      spinProject(h, psi, mu, !fwd_plusP, rb[1-cb]);
+      tmp[0][rb[cb]] = shift(adj(u_full[mu]) * h, BACKWARD, mu);
+      spinReconstructAdd(chi, tmp[0], mu, !fwd_plusP, rb[cb]);
+    }
+#endif
+
+    getFermBC().modifyF(chi, QDP::rb[cb]);
+
+    END_CODE();
+  }
+
+} // End Namespace Chroma
@@ -0,0 +1,123 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Single precision Wilson dslash on compressed links
+ */
+
+#ifndef __lwldslash_compressed_w_h__
+#define __lwldslash_compressed_w_h__
+
+#include "state.h"
+#include "io/aniso_io.h"
+#include "actions/ferm/linop/lwldslash_base_w.h"
+#include "actions/ferm/linop/packed_gauge_w.h"
+
+
+namespace Chroma
+{
+  //! Params of the link compression of the single precision dslash
+  /*! \ingroup linop */
+  struct WilsonGaugeCompressionParams
+  {
+    WilsonGaugeCompressionParams();
+    WilsonGaugeCompressionParams(XMLReader& xml, const std::string& path);
+
+    int   reconstruct;   /*!< reals kept per link: 18 (no compression), 12 or 8 */
+    bool  half_precP;    /*!< keep the compressed links as 16 bit fixed point */
+  };
+
+  //! Read the compression params
+  void read(XMLReader& xml, const std::string& path, WilsonGaugeCompressionParams& param);
+
+  //! Write the compression params
+  void write(XMLWriter& xml, const std::string& path, const WilsonGaugeCompressionParams& param);
+
+
+  //! Single precision Wilson-Dirac dslash on compressed links
+  /*!
+   * \ingroup linop
+   *
+   * Same operator as QDPWilsonDslashF, but the links are held in
+   * a compressed form and rebuilt in registers when they are used,
+   * which cuts the memory traffic of the gauge field, the largest
+   * part of the traffic of a single precision dslash.
+   *
+   * With  reconstruct = 12  the first two rows of each link are kept and
+   * the third row is  conj(row0 x row1). With  reconstruct = 8  only
+   * a2, a3, b1 and the phases of a1 and c1 are kept and the rest is
+   * rebuilt from unitarity. That rebuild divides by  1 - |a1|^2, so it
+   * is ill-conditioned as |a1| -> 1: a unit (cold) gauge field, or one
+   * close to it, cannot be kept in 8 numbers and the pack check aborts.
+   * Use  reconstruct = 12  for those. With  half_precP  these numbers are kept as
+   * 16 bit fixed point, which is exact enough for the inner solve of a
+   * reliable update or Richardson solver. Each link also keeps its sign,
+   * so antiperiodic boundaries folded into the links are allowed.
+   *
+   * The links must be SU(3) up to that sign. This is checked when the
+   * links are packed, so e.g. unprojected smeared links are caught.
+   * The links are kept in a PackedGaugeField, shared through
+   * ThePackedGaugeCacheF (H for half) with other dslashes on the same
+   * FermState. The half spinors are moved with the usual QDP shifts, and
+   * the hops are then multiplied by their links and reconstructed into
+   * the result in one threaded site loop (packedWilsonDslash) that reads
+   * the block of links of each site once. With QDP-JIT the links are not
+   * compressed and the QDP expressions are used.
+   *
+   * The mixed precision clover solvers do not use this dslash, until
+   * t_lwldslash shows it is faster than QDPWilsonDslashF on the target.
+   */
+  class QDPWilsonDslashCompressedF : public WilsonDslashBase<LatticeFermionF,
+							     multi1d<LatticeColorMatrixF>,
+							     multi1d<LatticeColorMatrixF> >
+  {
+  public:
+    // Typedefs to save typing
+    typedef LatticeFermionF               T;
+    typedef multi1d<LatticeColorMatrixF>  P;
+    typedef multi1d<LatticeColorMatrixF>  Q;
+
+    //! Full constructor with anisotropy
+    QDPWilsonDslashCompressedF(Handle< FermState<T,P,Q> > state,
+			       const AnisoParam_t& aniso_,
+			       const WilsonGaugeCompressionParams& comp_);
+
+    //! Creation routine with anisotropy
+    void create(Handle< FermState<T,P,Q> > state,
+		const AnisoParam_t& aniso_,
+		const WilsonGaugeCompressionParams& comp_);
+
+    //! No real need for cleanup here
+    ~QDPWilsonDslashCompressedF() {}
+
+    /**
+     * Apply a dslash
+     *
+     * \param chi     result                                      (Write)
+     * \param psi     source                                      (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of OUTPUT std::vector               (Read)
+     *
+     * \return The output of applying dslash on psi
+     */
+    void apply (T& chi, const T& psi, enum PlusMinus isign, int cb) const;
+
+    //! Return the fermion BC object for this linear operator
+    const FermBC<T,P,Q>& getFermBC() const {return *fbc;}
+
+  protected:
+    //! Get the anisotropy parameters
+    const multi1d<Real>& getCoeffs() const {return coeffs;}
+
+  private:
+    multi1d<Real> coeffs;  /*!< Nd array of coefficients of terms in the action */
+    Handle< FermBC<T,P,Q> >  fbc;
+    WilsonGaugeCompressionParams comp;
+    Handle< PackedGaugeField<float> > u_single;  /*!< packed links */
+    Handle< PackedGaugeField<short> > u_half;    /*!< packed links as fixed point */
+    multi1d<LatticeColorMatrixF> u_full;         /*!< links times coeffs, QDP-JIT only */
+    mutable multi1d<LatticeHalfFermionF> tmp;    /*!< hops of apply */
+  };
+
+} // End Namespace Chroma
+
+
+#endif
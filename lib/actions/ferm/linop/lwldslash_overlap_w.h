@@ -0,0 +1,185 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Wilson Dslash with the communications overlapped
+ */
+
+#ifndef __lwldslash_overlap_h__
+#define __lwldslash_overlap_h__
+
+#include "state.h"
+#include "io/aniso_io.h"
+#include "actions/ferm/linop/lwldslash_base_w.h"
+#include "actions/ferm/linop/wilson_halo_w.h"
+
+
+namespace Chroma
+{
+  //! Wilson-Dirac dslash with the communications overlapped
+  /*!
+   * \ingroup linop
+   *
+   * The same operator as QDPWilsonDslashT, but instead of one shift per
+   * hop, which completes its halo exchange before anything is computed,
+   * the halos of all directions are sent first and the interior sites
+   * are computed while the messages are in flight. See WilsonHaloDslash.
+   *
+   * The time spent computing, sending and waiting is kept per call and
+   * summed over all calls, and the sums are printed when the dslash is
+   * destroyed.
+   */
+  template<typename T, typename P, typename Q>
+  class QDPWilsonDslashOverlapT : public WilsonDslashBase<T, P, Q>
+  {
+  public:
+
+    //! Empty constructor. Must use create later
+    QDPWilsonDslashOverlapT() {}
+
+    //! Full constructor
+    QDPWilsonDslashOverlapT(Handle< FermState<T,P,Q> > state)
+      {create(state);}
+
+    //! Full constructor with anisotropy
+    QDPWilsonDslashOverlapT(Handle< FermState<T,P,Q> > state,
+			    const AnisoParam_t& aniso_)
+      {create(state, aniso_);}
+
+    //! Full constructor with general coefficients
+    QDPWilsonDslashOverlapT(Handle< FermState<T,P,Q> > state,
+			    const multi1d<Real>& coeffs_)
+      {create(state, coeffs_);}
+
+    //! Creation routine
+    void create(Handle< FermState<T,P,Q> > state);
+
+    //! Creation routine with anisotropy
+    void create(Handle< FermState<T,P,Q> > state,
+		const AnisoParam_t& aniso_);
+
+    //! Full constructor with general coefficients
+    void create(Handle< FermState<T,P,Q> > state,
+		const multi1d<Real>& coeffs_);
+
+    //! No real need for cleanup here
+    ~QDPWilsonDslashOverlapT() {}
+
+    /**
+     * Apply a dslash
+     *
+     * \param chi     result                                      (Write)
+     * \param psi     source                                      (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of OUTPUT std::vector               (Read)
+     *
+     * \return The output of applying dslash on psi
+     */
+    void apply (T& chi, const T& psi, enum PlusMinus isign, int cb) const;
+
+    //! Return the fermion BC object for this linear operator
+    const FermBC<T,P,Q>& getFermBC() const {return *fbc;}
+
+    //! Compute, communication and wait times of the last call
+    const DslashCommTimings& lastTimings() const {return halo->lastTimings();}
+
+    //! Compute, communication and wait times summed over all calls
+    const DslashCommTimings& totalTimings() const {return halo->totalTimings();}
+
+  protected:
+    //! Get the anisotropy parameters
+    const multi1d<Real>& getCoeffs() const {return coeffs;}
+
+  private:
+    multi1d<Real> coeffs;  /*!< Nd array of coefficients of terms in the action */
+    Handle< FermBC<T,P,Q> >  fbc;
+    Handle< WilsonHaloDslash<T,Q> >  halo;  /*!< holds the packed links */
+  };
+
+
+  //! Creation routine
+  template<typename T, typename P, typename Q>
+  void QDPWilsonDslashOverlapT<T,P,Q>::create(Handle< FermState<T,P,Q> > state)
+  {
+    multi1d<Real> cf(Nd);
+    cf = 1.0;
+    create(state, cf);
+  }
+
+  //! Creation routine with anisotropy
+  template<typename T, typename P, typename Q>
+  void QDPWilsonDslashOverlapT<T,P,Q>::create(Handle< FermState<T,P,Q> > state,
+					      const AnisoParam_t& anisoParam)
+  {
+    START_CODE();
+
+    create(state, makeFermCoeffs(anisoParam));
+
+    END_CODE();
+  }
+
+  //! Full constructor with general coefficients
+  template<typename T, typename P, typename Q>
+  void QDPWilsonDslashOverlapT<T,P,Q>::create(Handle< FermState<T,P,Q> > state,
+					      const multi1d<Real>& coeffs_)
+  {
+    START_CODE();
+
+    coeffs = coeffs_;
+
+    // Save a copy of the fermbc
+    fbc = state->getFermBC();
+
+    // Sanity check
+    if (fbc.operator->() == 0)
+    {
+      QDPIO::cerr << "QDPWilsonDslashOverlap: error: fbc is null" << std::endl;
+      QDP_abort(1);
+    }
+
+    halo = new WilsonHaloDslash<T,Q>(state, coeffs, 1);
+
+    END_CODE();
+  }
+
+
+  //! General Wilson-Dirac dslash
+  /*! \ingroup linop
+   * Wilson dslash
+   *
+   * Arguments:
+   *
+   *  \param chi	      Result				                (Write)
+   *  \param psi	      Pseudofermion field				(Read)
+   *  \param isign      D'^dag or D' ( MINUS | PLUS ) resp.		(Read)
+   *  \param cb	      Checkerboard of OUTPUT std::vector			(Read)
+   */
+  template<typename T, typename P, typename Q>
+  void
+  QDPWilsonDslashOverlapT<T,P,Q>::apply (T& chi, const T& psi,
+					 enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    halo->apply(&chi, &psi, isign, cb);
+
+    getFermBC().modifyF(chi, QDP::rb[cb]);
+
+    END_CODE();
+  }
+
+
+  typedef QDPWilsonDslashOverlapT<LatticeFermion,
+				  multi1d<LatticeColorMatrix>,
+				  multi1d<LatticeColorMatrix> > QDPWilsonDslashOverlap;
+
+  typedef QDPWilsonDslashOverlapT<LatticeFermionF,
+				  multi1d<LatticeColorMatrixF>,
+				  multi1d<LatticeColorMatrixF> > QDPWilsonDslashOverlapF;
+
+  typedef QDPWilsonDslashOverlapT<LatticeFermionD,
+				  multi1d<LatticeColorMatrixD>,
+				  multi1d<LatticeColorMatrixD> > QDPWilsonDslashOverlapD;
+
+} // End Namespace Chroma
+
+
+#endif
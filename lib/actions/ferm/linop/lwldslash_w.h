@@ -9,6 +9,7 @@
 #include "state.h"
 #include "io/aniso_io.h"
 #include "actions/ferm/linop/lwldslash_base_w.h"
+#include "actions/ferm/linop/packed_gauge_w.h"
 
 
 namespace Chroma 
@@ -41,6 +42,11 @@ namespace Chroma
    *	             ---
    *	             mu=0
    *
+   * For Nc = 3 and Nd = 4 the links are kept in a PackedGaugeField,
+   * shared through ThePackedGaugeCache with the other dslashes on the same
+   * FermState, and the hops are done by packedWilsonDslash. Otherwise,
+   * and with QDP-JIT, the links are kept times the coefficients and the
+   * QDP expressions are used.
    */
 
   template<typename T, typename P, typename Q> 
@@ -88,6 +94,23 @@ namespace Chroma
      */
     void apply (T& chi, const T& psi, enum PlusMinus isign, int cb) const;
 
+#ifndef QDP_IS_QDPJIT
+    //! Apply the dslash onto a block of vectors
+    /*!
+     * The half spinors of all the vectors are moved with the usual QDP
+     * shifts, and each link is then read once per site and multiplied
+     * onto the half spinors of all the vectors in a threaded site loop.
+     * With packed links that loop also reconstructs the results.
+     *
+     * \param chi     results                                     (Write)
+     * \param psi     sources                                     (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of OUTPUT vectors              (Read)
+     */
+    void applyMultiRHS(multi1d<T>& chi, const multi1d<T>& psi, 
+		       enum PlusMinus isign, int cb) const;
+#endif
+
     //! Return the fermion BC object for this linear operator
     const FermBC<T,P,Q>& getFermBC() const {return *fbc;}
 
@@ -96,9 +119,14 @@ namespace Chroma
     const multi1d<Real>& getCoeffs() const {return coeffs;}
 
   private:
+    typedef typename HalfFermionType<T>::Type_t H;
+    typedef typename WordType<T>::Type_t        W;
+
     multi1d<Real> coeffs;  /*!< Nd array of coefficients of terms in the action */
     Handle< FermBC<T,P,Q> >  fbc;
-    Q  u;
+    Q  u;                                /*!< links times coeffs, without packed links */
+    Handle< PackedGaugeField<W> > u_packed;  /*!< packed links, null if not used */
+    mutable multi1d<H> tmp;              /*!< hops of apply */
   };
 
   //! General Wilson-Dirac dslash
@@ -197,17 +225,34 @@ namespace Chroma
       QDP_abort(1);
     }
 
-    u.resize(Nd);
+    bool packedP = (Nc == 3 && Nd == 4);
+#ifdef QDP_IS_QDPJIT
+    packedP = false;
+#endif
 
-    // Fold in anisotropy
-    for(int mu=0; mu < u.size(); ++mu) {
-      u[mu] = (state->getLinks())[mu];
+    if (packedP)
+    {
+      // Packed once per FermState and shared with the other dslashes on it.
+      // Uncompressed, the links need not be SU(3)
+      u_packed = ThePackedGaugeCache<W>::Type_t::Instance().get(state, 18);
+      tmp.resize(2*Nd);
+      u.resize(0);
     }
-  
-    // Rescale the u fields by the anisotropy
-    for(int mu=0; mu < u.size(); ++mu)
+    else
     {
-      u[mu] *= coeffs[mu];
+      u_packed = 0;
+      u.resize(Nd);
+
+      // Fold in anisotropy
+      for(int mu=0; mu < u.size(); ++mu) {
+	u[mu] = (state->getLinks())[mu];
+      }
+  
+      // Rescale the u fields by the anisotropy
+      for(int mu=0; mu < u.size(); ++mu)
+      {
+	u[mu] *= coeffs[mu];
+      }
     }
   }
 
@@ -229,6 +274,18 @@ namespace Chroma
 			  enum PlusMinus isign, int cb) const
   {
     START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    if (u_packed.operator->() != 0)
+    {
+      packedWilsonDslash(&chi, &psi, 1, tmp, *u_packed, coeffs, isign, cb);
+      getFermBC().modifyF(chi, QDP::rb[cb]);
+
+      END_CODE();
+      return;
+    }
+#endif
+
 #if (QDP_NC == 2) || (QDP_NC == 3)
     /*     F 
      *   a2  (x)  :=  U  (x) (1 - isign gamma  ) psi(x)
@@ -302,6 +359,118 @@ namespace Chroma
     END_CODE();
   }
 
+#ifndef QDP_IS_QDPJIT
+  namespace QDPWilsonDslashEnv
+  {
+    //! Arguments of the link multiply site loop
+    template<typename H, typename U>
+    struct MultLinkArgs
+    {
+      multi1d<H>&  h;
+      const U&     u;
+      bool         adjP;
+      const int*   tab;
+    };
+
+    //! h[i] = U(x) h[i]  or  U(x)^dag h[i]  for all i over the sites [lo,hi) of a subset
+    template<typename H, typename U>
+    void multLinkSiteLoop(int lo, int hi, int myId, MultLinkArgs<H,U>* a)
+    {
+      typename U::Subtype_t link;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->tab[j];
+
+	// One read of the link for all the vectors
+	if (a->adjP)
+	  link = adj(a->u.elem(site));
+	else
+	  link = a->u.elem(site);
+
+	for(int i=0; i < a->h.size(); ++i)
+	  a->h[i].elem(site) = link * a->h[i].elem(site);
+      }
+    }
+
+    //! h[i] = U(x) h[i]  or  U(x)^dag h[i]  for all i on the subset
+    template<typename H, typename U>
+    void multLink(multi1d<H>& h, const U& u, bool adjP, const Subset& s)
+    {
+      MultLinkArgs<H,U> args = {h, u, adjP, s.siteTable().slice()};
+      dispatch_to_threads(s.numSiteTable(), args, multLinkSiteLoop<H,U>);
+    }
+  }
+
+
+  //! Apply the dslash onto a block of vectors
+  template<typename T, typename P, typename Q>
+  void 
+  QDPWilsonDslashT<T,P,Q>::applyMultiRHS(multi1d<T>& chi, const multi1d<T>& psi, 
+					 enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    const int N = psi.size();
+    chi.resize(N);
+
+    if (u_packed.operator->() != 0)
+    {
+      // One pass over the packed links for all the vectors
+      multi1d<H> h(2*Nd*N);
+      packedWilsonDslash(chi.slice(), psi.slice(), N, h, *u_packed, coeffs, isign, cb);
+
+      for(int i=0; i < N; ++i)
+	getFermBC().modifyF(chi[i], QDP::rb[cb]);
+
+      END_CODE();
+      return;
+    }
+
+    // The forward hop projects as the derivative does for isign,
+    // the backward hop as for the opposite sign
+    const enum PlusMinus misign = (isign == PLUS) ? MINUS : PLUS;
+
+    multi1d<H> fwd(N), bwd(N);
+    H tmp_h;
+    T tmp;
+
+    for(int i=0; i < N; ++i)
+      chi[i][rb[cb]] = zero;
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      for(int i=0; i < N; ++i)
+      {
+	wilsonDerivSpinProject(tmp_h, psi[i], mu, isign, rb[1-cb]);
+	fwd[i][rb[cb]] = shift(tmp_h, FORWARD, mu);
+
+	wilsonDerivSpinProject(bwd[i], psi[i], mu, misign, rb[1-cb]);
+      }
+
+      // U_mu(x) on the output sites, U_mu(x)^dag on the input sites before the shift
+      QDPWilsonDslashEnv::multLink(fwd, u[mu], false, rb[cb]);
+      QDPWilsonDslashEnv::multLink(bwd, u[mu], true, rb[1-cb]);
+
+      for(int i=0; i < N; ++i)
+      {
+	wilsonDerivSpinReconstruct(tmp, fwd[i], mu, isign, rb[cb]);
+	chi[i][rb[cb]] += tmp;
+
+	tmp_h[rb[cb]] = shift(bwd[i], BACKWARD, mu);
+	wilsonDerivSpinReconstruct(tmp, tmp_h, mu, misign, rb[cb]);
+	chi[i][rb[cb]] += tmp;
+      }
+    }
+
+    for(int i=0; i < N; ++i)
+      getFermBC().modifyF(chi[i], QDP::rb[cb]);
+
+    END_CODE();
+  }
+#endif
+
+
   typedef QDPWilsonDslashT<LatticeFermion,
 			   multi1d<LatticeColorMatrix>,
 			   multi1d<LatticeColorMatrix> > QDPWilsonDslash;
@@ -0,0 +1,642 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Gauge links packed per checkerboard for the dslash site loops
+ */
+
+#ifndef __packed_gauge_w_h__
+#define __packed_gauge_w_h__
+
+#include "chromabase.h"
+#include "singleton.h"
+#include "handle.h"
+#include "state.h"
+#include "actions/ferm/linop/lwldslash_base_w.h"
+
+#include <complex>
+#include <cmath>
+#include <algorithm>
+#include <list>
+
+namespace Chroma
+{
+
+  //! Real type the links are rebuilt in and link type packed, for each storage type
+  /*! \ingroup linop */
+  template<typename W> struct PackedGaugeTraits {};
+
+  template<> struct PackedGaugeTraits<float>
+  {
+    typedef float  Real_t;
+    typedef LatticeColorMatrixF  Link_t;
+  };
+
+  template<> struct PackedGaugeTraits<double>
+  {
+    typedef double Real_t;
+    typedef LatticeColorMatrixD  Link_t;
+  };
+
+  //! 16 bit fixed point
+  template<> struct PackedGaugeTraits<short>
+  {
+    typedef float  Real_t;
+    typedef LatticeColorMatrixF  Link_t;
+  };
+
+
+  namespace PackedGaugeEnv
+  {
+    //! Storage of one number
+    inline void encode(float& w, float x) {w = x;}
+    inline void encode(double& w, double x) {w = x;}
+    inline float decode(float w) {return w;}
+    inline double decode(double w) {return w;}
+
+    //! Storage of one number in [-1,1] as 16 bit fixed point
+    inline void encode(short& w, float x)
+    {
+      if (x > 1) x = 1;
+      if (x < -1) x = -1;
+      w = short(std::floor(32767*x + 0.5f));
+    }
+    inline float decode(short w) {return float(w) * (1.0f/32767);}
+
+    template<typename W>
+    inline std::complex<typename PackedGaugeTraits<W>::Real_t> decodeCmplx(const W* w)
+    {
+      return std::complex<typename PackedGaugeTraits<W>::Real_t>(decode(w[0]), decode(w[1]));
+    }
+
+    template<typename W, typename R>
+    inline void encodeCmplx(W* w, const std::complex<R>& z) {encode(w[0], z.real()); encode(w[1], z.imag());}
+
+
+    //! Keep the SU(3) matrix m in  reconstruct  numbers
+    template<typename W, typename R>
+    void packLink(W* w, const std::complex<R> m[3][3], int reconstruct)
+    {
+      const R pi = 3.14159265358979323846;
+
+      switch (reconstruct)
+      {
+      case 18:
+	for(int i=0; i < 3; ++i)
+	  for(int j=0; j < 3; ++j)
+	    encodeCmplx(w + 2*(3*i+j), m[i][j]);
+	break;
+
+      case 12:
+	for(int i=0; i < 2; ++i)
+	  for(int j=0; j < 3; ++j)
+	    encodeCmplx(w + 2*(3*i+j), m[i][j]);
+	break;
+
+      case 8:
+	encodeCmplx(w,   m[0][1]);
+	encodeCmplx(w+2, m[0][2]);
+	encodeCmplx(w+4, m[1][0]);
+	encode(w[6], std::arg(m[0][0]) / pi);
+	encode(w[7], std::arg(m[2][0]) / pi);
+	break;
+      }
+    }
+
+
+    //! Rebuild the link, including its sign
+    template<typename W>
+    inline void unpackLink(std::complex<typename PackedGaugeTraits<W>::Real_t> m[3][3],
+			   const W* w, int reconstruct)
+    {
+      typedef typename PackedGaugeTraits<W>::Real_t R;
+      typedef std::complex<R> Cmplx;
+      const R pi = 3.14159265358979323846;
+
+      switch (reconstruct)
+      {
+      case 18:
+	for(int i=0; i < 3; ++i)
+	  for(int j=0; j < 3; ++j)
+	    m[i][j] = decodeCmplx(w + 2*(3*i+j));
+	break;
+
+      case 12:
+	for(int i=0; i < 2; ++i)
+	  for(int j=0; j < 3; ++j)
+	    m[i][j] = decodeCmplx(w + 2*(3*i+j));
+
+	// row2 = conj(row0 x row1)
+	m[2][0] = std::conj(m[0][1]*m[1][2] - m[0][2]*m[1][1]);
+	m[2][1] = std::conj(m[0][2]*m[1][0] - m[0][0]*m[1][2]);
+	m[2][2] = std::conj(m[0][0]*m[1][1] - m[0][1]*m[1][0]);
+	break;
+
+      case 8:
+      {
+	Cmplx a2 = decodeCmplx(w);
+	Cmplx a3 = decodeCmplx(w+2);
+	Cmplx b1 = decodeCmplx(w+4);
+
+	// Unit rows and columns fix the moduli of a1 and c1
+	R n23 = std::norm(a2) + std::norm(a3);
+	R a1_abs = std::sqrt(std::max(R(1) - n23, R(0)));
+	R c1_abs = std::sqrt(std::max(n23 - std::norm(b1), R(0)));
+
+	Cmplx a1 = std::polar(a1_abs, pi*decode(w[6]));
+	Cmplx c1 = std::polar(c1_abs, pi*decode(w[7]));
+
+	// Orthogonality fixes the rest
+	R r = 1 / n23;
+
+	m[0][0] = a1;  m[0][1] = a2;  m[0][2] = a3;
+	m[1][0] = b1;
+	m[1][1] = -r * (std::conj(a1)*a2*b1 + std::conj(a3)*std::conj(c1));
+	m[1][2] =  r * (std::conj(a2)*std::conj(c1) - std::conj(a1)*a3*b1);
+	m[2][0] = c1;
+	m[2][1] =  r * (std::conj(a3)*std::conj(b1) - std::conj(a1)*a2*c1);
+	m[2][2] = -r * (std::conj(a1)*a3*c1 + std::conj(a2)*std::conj(b1));
+      }
+      break;
+      }
+
+      // The sign is kept after the numbers
+      if (decode(w[reconstruct]) < 0)
+	for(int i=0; i < 3; ++i)
+	  for(int j=0; j < 3; ++j)
+	    m[i][j] = -m[i][j];
+    }
+  }
+
+
+  //! Gauge links packed per checkerboard for the dslash site loops
+  /*!
+   * \ingroup linop
+   *
+   * The links in  multi1d<LatticeColorMatrix>  are a separate field per
+   * direction in site order, so the eight links a dslash reads for one
+   * output site are spread over eight arrays and both checkerboards.
+   * Here the links needed by the output sites of one checkerboard are
+   * kept together: for the j-th site x of  rb[cb].siteTable()  the block
+   *
+   *    U_0(x), U_0(x-0), U_1(x), U_1(x-1), ..., U_3(x), U_3(x-3)
+   *
+   * so a dslash reads one contiguous block per site and never touches
+   * the links of the other checkerboard. The backward links are shifted
+   * here, once, so the backward hop multiplies by  U^dag  at x after the
+   * half spinor is moved.
+   *
+   * Each link is kept in  reconstruct  numbers of type W (18; 12, the first
+   * two rows; or 8, see QDPWilsonDslashCompressedF, which is restricted to
+   * links with |U_00| bounded away from 1) and its sign, so
+   * antiperiodic boundaries folded into the links survive the compression.
+   * With W = short the numbers are 16 bit fixed point. The links are taken
+   * as they come from the FermState, without anisotropy coefficients, so
+   * compressed links must be SU(3) up to the sign; this is checked.
+   *
+   * The QDP Wilson dslashes (QDPWilsonDslashT, the 5D QDPWilsonDslashArray
+   * and QDPWilsonDslashArrayOpt, so also the DWF operators built on them),
+   * QDPWilsonDslashCompressedF and the dslashes with overlapped
+   * communications (WilsonHaloDslash) use this layout, through
+   * packedWilsonDslash or their own site loops. The SSE and other
+   * hand-written dslashes keep their own link layouts, and the staggered
+   * dslashes, which hop by one and three sites, do not use it.
+   *
+   * Not available with QDP-JIT, which has no raw site access.
+   */
+  template<typename W>
+  class PackedGaugeField
+  {
+  public:
+    typedef typename PackedGaugeTraits<W>::Real_t R;
+
+    //! Pack the links
+    template<typename U>
+    PackedGaugeField(const multi1d<U>& u, int reconstruct_);
+
+    //! Numbers per link
+    int reconstruct() const {return recon;}
+
+    //! Stored numbers per link, with the sign
+    int linkSize() const {return nlink;}
+
+    //! Links of the output sites of checkerboard cb
+    const W* links(int cb) const {return block[cb].slice();}
+
+    //! Position of each site in the site table of its checkerboard
+    const int* position() const {return pos.slice();}
+
+    //! First number of link mu, forward or backward, of the j-th site of a checkerboard
+    int offset(int j, int mu, bool fwdP) const {return ((j*Nd + mu)*2 + (fwdP ? 0 : 1))*nlink;}
+
+  private:
+    int recon;
+    int nlink;
+    multi1d<W>   block[2];
+    multi1d<int> pos;
+  };
+
+
+  // Pack the links
+  template<typename W>
+  template<typename U>
+  PackedGaugeField<W>::PackedGaugeField(const multi1d<U>& u, int reconstruct_) :
+    recon(reconstruct_), nlink(reconstruct_ + 1)
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    using namespace PackedGaugeEnv;
+
+    if (Nc != 3 || Nd != 4)
+    {
+      QDPIO::cerr << "PackedGaugeField: only implemented for Nc=3 and Nd=4" << std::endl;
+      QDP_abort(1);
+    }
+
+    if (recon != 18 && recon != 12 && recon != 8)
+    {
+      QDPIO::cerr << "PackedGaugeField: reconstruct must be 18, 12 or 8, found " << recon << std::endl;
+      QDP_abort(1);
+    }
+
+    pos.resize(Layout::sitesOnNode());
+    for(int cb=0; cb < 2; ++cb)
+    {
+      const int* tab = rb[cb].siteTable().slice();
+      for(int j=0; j < rb[cb].numSiteTable(); ++j)
+	pos[tab[j]] = j;
+
+      block[cb].resize(rb[cb].numSiteTable() * 2*Nd * nlink);
+    }
+
+    // The compression is only exact for SU(3) links. The 8 number form
+    // divides by  1 - |a1|^2, so it loses precision as |a1| -> 1 and
+    // fails outright for a unit (cold) gauge field
+    const bool halfP = (sizeof(W) == 2);
+    double tol = 0;
+    if (recon != 18)
+      tol = (recon == 8) ? (halfP ? 5.0e-2 : 1.0e-3) : (halfP ? 1.0e-3 : 1.0e-4);
+
+    double nbad = 0;
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      // The backward links are shifted once, here
+      U u_bwd = shift(u[mu], BACKWARD, mu);
+
+      for(int f=0; f < 2; ++f)
+      {
+	const U& v = (f == 0) ? u[mu] : u_bwd;
+
+	for(int cb=0; cb < 2; ++cb)
+	{
+	  const int* tab = rb[cb].siteTable().slice();
+
+	  for(int j=0; j < rb[cb].numSiteTable(); ++j)
+	  {
+	    int site = tab[j];
+
+	    std::complex<double> m[3][3];
+	    for(int i=0; i < 3; ++i)
+	      for(int k=0; k < 3; ++k)
+		m[i][k] = std::complex<double>(v.elem(site).elem().elem(i,k).real(),
+					       v.elem(site).elem().elem(i,k).imag());
+
+	    // Boundary conditions may have flipped the sign, det = -1
+	    std::complex<double> det = m[0][0]*(m[1][1]*m[2][2] - m[1][2]*m[2][1])
+	      - m[0][1]*(m[1][0]*m[2][2] - m[1][2]*m[2][0])
+	      + m[0][2]*(m[1][0]*m[2][1] - m[1][1]*m[2][0]);
+
+	    double sign = (det.real() < 0) ? -1 : 1;
+
+	    std::complex<R> ms[3][3];
+	    for(int i=0; i < 3; ++i)
+	      for(int k=0; k < 3; ++k)
+		ms[i][k] = std::complex<R>(sign * m[i][k]);
+
+	    W* w = block[cb].slice() + offset(j, mu, f == 0);
+	    packLink(w, ms, recon);
+	    encode(w[recon], R(sign));
+
+	    // Check the link survives
+	    if (recon != 18)
+	    {
+	      std::complex<R> mr[3][3];
+	      unpackLink(mr, w, recon);
+
+	      double dev = 0;
+	      for(int i=0; i < 3; ++i)
+		for(int k=0; k < 3; ++k)
+		  dev += std::norm(std::complex<double>(mr[i][k]) - m[i][k]);
+
+	      if (! (std::sqrt(dev) <= tol))
+		nbad += 1;
+	    }
+	  }
+	}
+      }
+    }
+
+    QDPInternal::globalSumArray(&nbad, 1);
+    if (nbad > 0)
+    {
+      QDPIO::cerr << "PackedGaugeField: " << nbad << " links do not survive the compression to "
+		  << recon << " numbers. Are they SU(3)?";
+      if (recon == 8)
+	QDPIO::cerr << " With 8 numbers links close to the unit matrix are not allowed, use 12";
+      QDPIO::cerr << std::endl;
+      QDP_abort(1);
+    }
+#else
+    QDPIO::cerr << "PackedGaugeField: not available with QDP-JIT" << std::endl;
+    QDP_abort(1);
+#endif
+
+    END_CODE();
+  }
+
+
+#ifndef QDP_IS_QDPJIT
+  namespace PackedGaugeEnv
+  {
+    //! chi += reconstruction of the hop h in direction mu, at one site
+    template<typename S, typename HS>
+    inline void spinReconstructAddSite(S& chi, const HS& h, int mu, bool plusP)
+    {
+      switch (mu)
+      {
+      case 0:
+	if (plusP) chi += spinReconstructDir0Plus(h); else chi += spinReconstructDir0Minus(h);
+	break;
+      case 1:
+	if (plusP) chi += spinReconstructDir1Plus(h); else chi += spinReconstructDir1Minus(h);
+	break;
+      case 2:
+	if (plusP) chi += spinReconstructDir2Plus(h); else chi += spinReconstructDir2Minus(h);
+	break;
+      case 3:
+	if (plusP) chi += spinReconstructDir3Plus(h); else chi += spinReconstructDir3Minus(h);
+	break;
+      }
+    }
+
+    //! Arguments of the hop site loop
+    template<typename T, typename H, typename W>
+    struct HopsArgs
+    {
+      T*                          chi;
+      const H*                    h;    /*!< 2 Nd moved projections per field */
+      int                         n;
+      const PackedGaugeField<W>&  u;
+      int                         cb;
+      const typename PackedGaugeTraits<W>::Real_t* coeff;
+      bool                        fwd_plusP;
+      const int*                  tab;
+    };
+
+    //! chi[i](x) = sum over the hops of the reconstructed  coeff U h,  over [lo,hi) of rb[cb]
+    /*!
+     * U is U_mu(x) for h[2mu] and U_mu(x-mu)^dag for h[2mu+1]. The block
+     * of links of a site is read once, in order, for all the fields, and
+     * each product is reconstructed into chi as soon as it is made.
+     */
+    template<typename T, typename H, typename W>
+    void hopsSiteLoop(int lo, int hi, int myId, HopsArgs<T,H,W>* a)
+    {
+      typedef std::complex<typename PackedGaugeTraits<W>::Real_t> Cmplx;
+
+      const W* links = a->u.links(a->cb);
+      const int reconstruct = a->u.reconstruct();
+      typename H::Subtype_t g;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->tab[j];
+
+	for(int i=0; i < a->n; ++i)
+	  zero_rep(a->chi[i].elem(site));
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  for(int f=0; f < 2; ++f)
+	  {
+	    const bool fwdP = (f == 0);
+
+	    Cmplx m[3][3];
+	    unpackLink(m, links + a->u.offset(j, mu, fwdP), reconstruct);
+
+	    for(int i=0; i < a->n; ++i)
+	    {
+	      const H& h = a->h[2*Nd*i + 2*mu + f];
+
+	      for(int s=0; s < 2; ++s)
+	      {
+		Cmplx x[3];
+		for(int c=0; c < 3; ++c)
+		  x[c] = Cmplx(h.elem(site).elem(s).elem(c).real(),
+			       h.elem(site).elem(s).elem(c).imag());
+
+		for(int c=0; c < 3; ++c)
+		{
+		  Cmplx y = (fwdP)
+		    ? m[c][0]*x[0] + m[c][1]*x[1] + m[c][2]*x[2]
+		    : std::conj(m[0][c])*x[0] + std::conj(m[1][c])*x[1] + std::conj(m[2][c])*x[2];
+
+		  g.elem(s).elem(c).real() = a->coeff[mu] * y.real();
+		  g.elem(s).elem(c).imag() = a->coeff[mu] * y.imag();
+		}
+	      }
+
+	      spinReconstructAddSite(a->chi[i].elem(site), g, mu, (fwdP) ? a->fwd_plusP : ! a->fwd_plusP);
+	    }
+	  }
+	}
+      }
+    }
+  }
+
+
+  //! Wilson dslash of n fields on packed links
+  /*!
+   * \ingroup linop
+   *
+   * The projections of each field are moved with the usual QDP shifts
+   * into h, which must hold 2 Nd n half spinors, and the link multiplies
+   * and reconstructions of all hops and fields are then done in one
+   * threaded site loop over the output checkerboard. The fermion BCs are
+   * left to the caller.
+   *
+   * \param chi     result, n fields                            (Write)
+   * \param psi     source, n fields                            (Read)
+   * \param n       number of fields                            (Read)
+   * \param h       temporaries, 2 Nd n half spinors             (Write)
+   * \param u       packed links                                (Read)
+   * \param coeffs  Nd anisotropy coefficients                  (Read)
+   * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+   * \param cb      Checkerboard of OUTPUT std::vector               (Read)
+   */
+  template<typename T, typename H, typename W>
+  void packedWilsonDslash(T* chi, const T* psi, int n, multi1d<H>& h,
+			  const PackedGaugeField<W>& u, const multi1d<Real>& coeffs,
+			  enum PlusMinus isign, int cb)
+  {
+    START_CODE();
+
+    typename PackedGaugeTraits<W>::Real_t coeff[Nd];
+    for(int mu=0; mu < Nd; ++mu)
+      coeff[mu] = toDouble(coeffs[mu]);
+
+    // The forward hop projects as the derivative does for isign,
+    // the backward hop as for the opposite sign
+    const enum PlusMinus misign = (isign == PLUS) ? MINUS : PLUS;
+    H tmp_h;
+
+    for(int i=0; i < n; ++i)
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	wilsonDerivSpinProject(tmp_h, psi[i], mu, isign, rb[1-cb]);
+	h[2*Nd*i + 2*mu][rb[cb]] = shift(tmp_h, FORWARD, mu);
+
+	wilsonDerivSpinProject(tmp_h, psi[i], mu, misign, rb[1-cb]);
+	h[2*Nd*i + 2*mu+1][rb[cb]] = shift(tmp_h, BACKWARD, mu);
+      }
+
+    PackedGaugeEnv::HopsArgs<T,H,W> args = {chi, h.slice(), n, u, cb, coeff, (isign == MINUS),
+					    rb[cb].siteTable().slice()};
+    dispatch_to_threads(rb[cb].numSiteTable(), args, PackedGaugeEnv::hopsSiteLoop<T,H,W>);
+
+    END_CODE();
+  }
+#endif
+
+
+  //! Packed links shared by all dslashes on the same FermState
+  /*!
+   * \ingroup linop
+   *
+   * Packing is a pass over all links and a shift per direction, so every
+   * dslash created from the same FermState shares one packed field. An
+   * entry is keyed on the identity of the FermState, whose links do not
+   * change once it is made, and the number of reals per link. The entry
+   * holds the FermState, so it cannot be freed and its address reused
+   * while the entry lives, and the entries whose FermState has no other
+   * owner left are released on the next get. At most  max_entries  are
+   * held, the least recently used is dropped first.
+   */
+  template<typename W>
+  class PackedGaugeCache
+  {
+  public:
+    // Typedefs to save typing
+    typedef multi1d<typename PackedGaugeTraits<W>::Link_t>  Q;
+
+    //! Constructor
+    PackedGaugeCache() : max_entries(4) {}
+
+    //! Packed links of the FermState
+    template<typename T>
+    Handle< PackedGaugeField<W> > get(Handle< FermState<T,Q,Q> > state, int reconstruct);
+
+    //! Set the number of entries kept. 0 disables caching
+    void setMaxEntries(int n)
+    {
+      max_entries = (n > 0) ? n : 0;
+      while (int(entries.size()) > max_entries)
+	entries.pop_back();
+    }
+
+    //! Drop the entries whose FermState is gone
+    void prune()
+    {
+      typename std::list<Entry>::iterator e = entries.begin();
+      while (e != entries.end())
+      {
+	if (e->state.unique())
+	  e = entries.erase(e);
+	else
+	  ++e;
+      }
+    }
+
+    //! Drop all entries
+    void clear() {entries.clear();}
+
+  private:
+    //! An entry of the cache
+    struct Entry
+    {
+      Handle< ConnectState<Q,Q> >    state;
+      int                            reconstruct;
+      Handle< PackedGaugeField<W> >  packed;
+    };
+
+    int              max_entries;
+    std::list<Entry> entries;   /*!< most recently used first */
+  };
+
+
+  // Packed links of the FermState
+  template<typename W>
+  template<typename T>
+  Handle< PackedGaugeField<W> > PackedGaugeCache<W>::get(Handle< FermState<T,Q,Q> > state_,
+							 int reconstruct)
+  {
+    START_CODE();
+
+    if (max_entries == 0)
+    {
+      END_CODE();
+      return new PackedGaugeField<W>(state_->getLinks(), reconstruct);
+    }
+
+    prune();
+
+    Handle< ConnectState<Q,Q> > state(state_);
+
+    for(typename std::list<Entry>::iterator e = entries.begin(); e != entries.end(); ++e)
+    {
+      if (e->state.operator->() != state.operator->() || e->reconstruct != reconstruct)
+	continue;
+
+      // Move to the front
+      entries.splice(entries.begin(), entries, e);
+
+      END_CODE();
+      return entries.front().packed;
+    }
+
+    Entry entry;
+    entry.state = state;
+    entry.reconstruct = reconstruct;
+    entry.packed = new PackedGaugeField<W>(state->getLinks(), reconstruct);
+
+    entries.push_front(entry);
+    while (int(entries.size()) > max_entries)
+      entries.pop_back();
+
+    END_CODE();
+
+    return entry.packed;
+  }
+
+
+  //! The packed link cache of storage type W
+  /*! \ingroup linop */
+  template<typename W>
+  struct ThePackedGaugeCache
+  {
+    typedef SingletonHolder<PackedGaugeCache<W>,
+			    QDP::CreateUsingNew,
+			    QDP::NoDestroy,
+			    QDP::SingleThreaded> Type_t;
+  };
+
+  /*! \ingroup linop */
+  typedef ThePackedGaugeCache<float>::Type_t   ThePackedGaugeCacheF;
+  /*! \ingroup linop */
+  typedef ThePackedGaugeCache<double>::Type_t  ThePackedGaugeCacheD;
+  /*! \ingroup linop */
+  typedef ThePackedGaugeCache<short>::Type_t   ThePackedGaugeCacheH;
+
+} // End Namespace Chroma
+
+#endif
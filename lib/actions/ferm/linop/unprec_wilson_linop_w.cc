@@ -105,6 +105,25 @@ namespace Chroma
   }
 
 
+  //! Derivative of unpreconditioned Wilson dM/dU summed over several vectors
+  void 
+  UnprecWilsonLinOp::derivMultipole(multi1d<LatticeColorMatrix>& ds_u,
+				    const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+				    enum PlusMinus isign) const
+  {
+    START_CODE();
+
+    // This does both parities
+    D.derivMultipole(ds_u, chi, psi, isign);
+
+    // Factor from the -1/2 in front of the dslash
+    for(int mu = 0; mu < Nd; ++mu)
+      ds_u[mu] *= Real(-0.5);
+
+    END_CODE();
+  }
+
+
   //! Return flops performed by the operator()
   unsigned long UnprecWilsonLinOp::nFlops() const
   {
@@ -81,6 +81,11 @@ namespace Chroma
 	       const LatticeFermion& chi, const LatticeFermion& psi, 
 	       enum PlusMinus isign) const;
 
+    //! Derivative of unpreconditioned Wilson dM/dU summed over several vectors
+    void derivMultipole(multi1d<LatticeColorMatrix>& ds_u, 
+			const multi1d<LatticeFermion>& chi, const multi1d<LatticeFermion>& psi, 
+			enum PlusMinus isign) const;
+
     //! Return flops performed by the operator()
     unsigned long nFlops() const;
 
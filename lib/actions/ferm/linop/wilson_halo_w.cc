@@ -0,0 +1,141 @@
+/*! \file
+ *  \brief Halo exchange of the Wilson dslash overlapped with the interior sites
+ */
+
+#include "actions/ferm/linop/wilson_halo_w.h"
+
+#include <vector>
+#include <algorithm>
+
+namespace Chroma
+{
+
+  namespace
+  {
+    //! Neighbour of a site, across the periodic lattice
+    multi1d<int> neighbourCoord(const multi1d<int>& coord, int mu, bool fwdP)
+    {
+      const multi1d<int>& latt = Layout::lattSize();
+
+      multi1d<int> nb = coord;
+      nb[mu] = (coord[mu] + (fwdP ? 1 : -1) + latt[mu]) % latt[mu];
+      return nb;
+    }
+
+    //! Checkerboard of a site
+    int siteCB(const multi1d<int>& coord)
+    {
+      int sum = 0;
+      for(int mu=0; mu < coord.size(); ++mu)
+	sum += coord[mu];
+      return sum & 1;
+    }
+
+    //! Function object splitting each checkerboard into interior and face sites
+    class HaloSplitFunc : public SetFunc
+    {
+    public:
+      int operator() (const multi1d<int>& coordinate) const
+      {
+	const int node = Layout::nodeNumber(coordinate);
+
+	int face = 0;
+	for(int mu=0; mu < Nd; ++mu)
+	  for(int f=0; f < 2; ++f)
+	    if (Layout::nodeNumber(neighbourCoord(coordinate, mu, f == 0)) != node)
+	      face = 1;
+
+	return 2*siteCB(coordinate) + face;
+      }
+
+      int numSubsets() const {return 4;}
+    };
+  }
+
+
+  // Build the tables for the current layout
+  WilsonHaloMaps::WilsonHaloMaps()
+  {
+    START_CODE();
+
+    if (Nd != 4)
+    {
+      QDPIO::cerr << "WilsonHaloMaps: only implemented for Nd=4" << std::endl;
+      QDP_abort(1);
+    }
+
+    split.make(HaloSplitFunc());
+
+    const int node = Layout::nodeNumber();
+    const int nsites = Layout::sitesOnNode();
+
+    comm.resize(Nd);
+    comm = false;
+
+    nbr.resize(2*Nd);
+    send_node.resize(2*Nd);
+    recv_node.resize(2*Nd);
+    send_node = node;
+    recv_node = node;
+
+    recv_count.resize(4*Nd);
+    recv_count = 0;
+
+    // Send lists keyed by the site index on the receiving node
+    std::vector< std::vector< std::pair<int,int> > > send(4*Nd);
+
+    for(int mu=0; mu < Nd; ++mu)
+      for(int f=0; f < 2; ++f)
+	nbr[hop(mu, f == 0)].resize(nsites);
+
+    for(int site=0; site < nsites; ++site)
+    {
+      multi1d<int> coord = Layout::siteCoords(node, site);
+      const int cb = siteCB(coord);
+
+      for(int mu=0; mu < Nd; ++mu)
+	for(int f=0; f < 2; ++f)
+	{
+	  const bool fwdP = (f == 0);
+	  multi1d<int> nb = neighbourCoord(coord, mu, fwdP);
+	  const int nb_node = Layout::nodeNumber(nb);
+
+	  if (nb_node == node)
+	  {
+	    nbr[hop(mu,fwdP)][site] = Layout::linearSiteIndex(nb);
+	    continue;
+	  }
+
+	  comm[mu] = true;
+
+	  // This site reads the next slot of the hop
+	  nbr[hop(mu,fwdP)][site] = -1 - recv_count[cbHop(cb,mu,fwdP)]++;
+	  recv_node[hop(mu,fwdP)] = nb_node;
+
+	  // and nb reads this site in the opposite hop
+	  send[cbHop(1-cb,mu,!fwdP)].push_back(std::make_pair(Layout::linearSiteIndex(nb), site));
+	  send_node[hop(mu,!fwdP)] = nb_node;
+	}
+    }
+
+    // The receiver numbers its slots in the order of its sites
+    send_sites.resize(4*Nd);
+    for(int i=0; i < 4*Nd; ++i)
+    {
+      std::sort(send[i].begin(), send[i].end());
+
+      send_sites[i].resize(send[i].size());
+      for(int k=0; k < int(send[i].size()); ++k)
+	send_sites[i][k] = send[i][k].second;
+
+      if (send_sites[i].size() != recv_count[i])
+      {
+	QDPIO::cerr << "WilsonHaloMaps: the layout is not a regular grid of nodes" << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+    END_CODE();
+  }
+
+} // End Namespace Chroma
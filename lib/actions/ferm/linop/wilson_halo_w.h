@@ -0,0 +1,677 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Halo exchange of the Wilson dslash overlapped with the interior sites
+ */
+
+#ifndef __wilson_halo_w_h__
+#define __wilson_halo_w_h__
+
+#include "chromabase.h"
+#include "singleton.h"
+#include "state.h"
+#include "actions/ferm/linop/lwldslash_base_w.h"
+#include "actions/ferm/linop/packed_gauge_w.h"
+
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+#include "qmp.h"
+#endif
+
+#include <cstring>
+#include <complex>
+
+
+namespace Chroma
+{
+
+  //! Time spent in the parts of a dslash with overlapped communications
+  /*! \ingroup linop */
+  struct DslashCommTimings
+  {
+    DslashCommTimings() : calls(0), compute(0), comm(0), wait(0) {}
+
+    unsigned long calls;
+    double compute;   /*!< projections, link multiplies, interior and face sites */
+    double comm;      /*!< packing the halos and posting the messages */
+    double wait;      /*!< waiting for the messages after the interior sites */
+  };
+
+
+  //! Site tables of the nearest neighbour halo exchange
+  /*!
+   * \ingroup linop
+   *
+   * Splits each checkerboard into the face sites, which have a
+   * neighbour on another node, and the interior sites, which do not, and
+   * lists for every hop where the neighbour comes from: a local site, or a
+   * slot in the receive buffer of that hop. The send lists are ordered so
+   * the neighbouring node finds each site in the slot it expects. Only
+   * depends on the layout, so there is one instance.
+   *
+   * A hop is labelled by (cb, mu, fwdP): the checkerboard of the output
+   * site x on the receiving node and whether psi(x+mu) or psi(x-mu) is
+   * needed. Data of a forward hop is sent to the -mu neighbour.
+   */
+  class WilsonHaloMaps
+  {
+  public:
+    //! Build the tables for the current layout
+    WilsonHaloMaps();
+
+    //! Sites of checkerboard cb with all neighbours on this node
+    const Subset& interior(int cb) const {return split[2*cb];}
+
+    //! Sites of checkerboard cb with a neighbour on another node
+    const Subset& face(int cb) const {return split[2*cb+1];}
+
+    //! Is direction mu split over nodes?
+    bool commP(int mu) const {return comm[mu];}
+
+    //! Neighbour of each site: local site >= 0, or -1-slot in the receive buffer
+    const multi1d<int>& neighbours(int mu, bool fwdP) const {return nbr[hop(mu,fwdP)];}
+
+    //! Local sites sent for the hop, in the order of the slots on the receiver
+    const multi1d<int>& sendSites(int cb, int mu, bool fwdP) const {return send_sites[cbHop(cb,mu,fwdP)];}
+
+    //! Number of slots in the receive buffer of the hop
+    int recvCount(int cb, int mu, bool fwdP) const {return recv_count[cbHop(cb,mu,fwdP)];}
+
+    //! Node the data of the hop is sent to
+    int sendNode(int mu, bool fwdP) const {return send_node[hop(mu,fwdP)];}
+
+    //! Node the data of the hop is received from
+    int recvNode(int mu, bool fwdP) const {return recv_node[hop(mu,fwdP)];}
+
+  private:
+    int hop(int mu, bool fwdP) const {return 2*mu + (fwdP ? 0 : 1);}
+    int cbHop(int cb, int mu, bool fwdP) const {return 2*Nd*cb + hop(mu,fwdP);}
+
+    Set                      split;
+    multi1d<bool>            comm;
+    multi1d< multi1d<int> >  nbr;
+    multi1d< multi1d<int> >  send_sites;
+    multi1d<int>             recv_count;
+    multi1d<int>             send_node;
+    multi1d<int>             recv_node;
+  };
+
+
+  //! The one set of halo tables
+  /*! \ingroup linop */
+  typedef SingletonHolder<WilsonHaloMaps,
+			  QDP::CreateUsingNew,
+			  QDP::NoDestroy,
+			  QDP::SingleThreaded> TheWilsonHaloMaps;
+
+
+  //! Wilson dslash of n fields with the halo exchange overlapped
+  /*!
+   * \ingroup linop
+   *
+   * The half spinors of the face sites are projected first and sent,
+   * then the half spinors of the remaining sites and the output on the
+   * interior sites are computed while the messages are in flight. The
+   * face output is done after the wait. All n fields go in the same
+   * messages, so a 5D dslash sends 8 messages per call, not 8*N5.
+   *
+   * Both hops are multiplied by their link on the output site, as the
+   * neighbour is gathered, from a PackedGaugeField shared through
+   * ThePackedGaugeCache with the other dslashes on the same FermState.
+   *
+   * The 8n+8 half spinor temporaries are kept with the object. The
+   * fermion BCs are left to the caller. The compute, communication and
+   * wait times summed over all calls are printed, as seen by the primary
+   * node, when the object is destroyed.
+   *
+   * With QDP-JIT there are no site loops: the links are kept unpacked and
+   * the hops are done with the usual QDP shifts, without the overlap.
+   */
+  template<typename T, typename Q>
+  class WilsonHaloDslash
+  {
+  public:
+    typedef typename HalfFermionType<T>::Type_t H;
+    typedef typename WordType<T>::Type_t        W;
+
+    //! Packed links of the state and coefficients, for n fields per call
+    WilsonHaloDslash(Handle< FermState<T,Q,Q> > state, const multi1d<Real>& coeffs_, int n_);
+
+    //! Print the times and free the messages
+    ~WilsonHaloDslash();
+
+    //! chi[s] = D' psi[s] on checkerboard cb, s = 0 .. n-1
+    void apply(T* chi, const T* psi, enum PlusMinus isign, int cb) const;
+
+    //! Times of the last call
+    const DslashCommTimings& lastTimings() const {return last;}
+
+    //! Times summed over all calls
+    const DslashCommTimings& totalTimings() const {return total;}
+
+  private:
+    // Hide copies, the messages point into the buffers
+    WilsonHaloDslash(const WilsonHaloDslash&);
+    void operator=(const WilsonHaloDslash&);
+
+    int bufIndex(int cb, int mu, bool fwdP) const {return 2*Nd*cb + 2*mu + (fwdP ? 0 : 1);}
+
+    //! hf = forward, hb = backward projection of psi on the subset
+    void project(H& hf, H& hb, const T& psi, int mu, enum PlusMinus isign, const Subset& s) const;
+
+    //! g(x) = coeff U_mu(x) h(x+mu)  or  coeff U_mu(x-mu)^dag h(x-mu)  on the subset
+    /*! h is taken from the receive buffer when off node */
+    void gather(H& g, const H& h, int field, int mu, bool fwdP, int cb, const Subset& s) const;
+
+    //! chi = sum of the reconstructed hops on the subset
+    void reconstruct(T& chi, const multi1d<H>& gf, const multi1d<H>& gb,
+		     enum PlusMinus isign, const Subset& s) const;
+
+    //! Pack the face half spinors and post the messages
+    void startComms(const multi1d< multi1d<H> >& hf, const multi1d< multi1d<H> >& hb, int cb) const;
+
+    //! Wait for the messages of checkerboard cb
+    void waitComms(int cb) const;
+
+  private:
+    const WilsonHaloMaps& maps;
+    Handle< PackedGaugeField<W> > u;
+    multi1d<W> coeffs;
+    int    n;
+    int    site_bytes;
+
+#ifdef QDP_IS_QDPJIT
+    Q u_full;   /*!< links times coeffs */
+#endif
+
+    mutable multi1d< multi1d<H> > hf;   /*!< forward projections, per direction and field */
+    mutable multi1d< multi1d<H> > hb;   /*!< backward projections, per direction and field */
+    mutable multi1d<H> gf;              /*!< forward hops of one field */
+    mutable multi1d<H> gb;              /*!< backward hops of one field */
+
+    mutable multi1d< multi1d<char> > send_buf;
+    mutable multi1d< multi1d<char> > recv_buf;
+
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+    multi1d<QMP_msgmem_t>    send_mem;
+    multi1d<QMP_msgmem_t>    recv_mem;
+    multi1d<QMP_msghandle_t> mh;
+#endif
+
+    mutable DslashCommTimings last;
+    mutable DslashCommTimings total;
+  };
+
+
+#ifndef QDP_IS_QDPJIT
+  namespace WilsonHaloDslashEnv
+  {
+    //! Arguments of the pack site loop
+    template<typename H>
+    struct PackArgs
+    {
+      const multi1d<H>& h;
+      const int*        sites;
+      int               count;
+      int               site_bytes;
+      char*             buf;
+    };
+
+    //! Copy the half spinors of the send list [lo,hi) into the buffer
+    template<typename H>
+    void packSiteLoop(int lo, int hi, int myId, PackArgs<H>* a)
+    {
+      for(int s=0; s < a->h.size(); ++s)
+	for(int k=lo; k < hi; ++k)
+	  std::memcpy(a->buf + (s*a->count + k)*a->site_bytes,
+		      &(a->h[s].elem(a->sites[k])), a->site_bytes);
+    }
+
+    //! Arguments of the gather site loop
+    template<typename H, typename W>
+    struct GatherArgs
+    {
+      H&          g;
+      const H&    h;
+      const int*  nbr;
+      const char* buf;   /*!< receive buffer of this field */
+      int         site_bytes;
+      const PackedGaugeField<W>& u;
+      int         cb;
+      int         mu;
+      bool        fwdP;
+      W           coeff;
+      const int*  tab;
+    };
+
+    //! g(x) = coeff U h(nbr(x)), or the slot of the receive buffer, over [lo,hi) of the site table
+    /*! U is U_mu(x), or U_mu(x-mu)^dag for the backward hop */
+    template<typename H, typename W>
+    void gatherSiteLoop(int lo, int hi, int myId, GatherArgs<H,W>* a)
+    {
+      typedef std::complex<typename PackedGaugeTraits<W>::Real_t> Cmplx;
+
+      const W* links = a->u.links(a->cb);
+      const int* pos = a->u.position();
+      const int reconstruct = a->u.reconstruct();
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->tab[j];
+	int k = a->nbr[site];
+
+	if (k >= 0)
+	  a->g.elem(site) = a->h.elem(k);
+	else
+	  std::memcpy(&(a->g.elem(site)), a->buf + (-1-k)*a->site_bytes, a->site_bytes);
+
+	Cmplx m[3][3];
+	PackedGaugeEnv::unpackLink(m, links + a->u.offset(pos[site], a->mu, a->fwdP), reconstruct);
+
+	for(int s=0; s < 2; ++s)
+	{
+	  Cmplx x[3];
+	  for(int c=0; c < 3; ++c)
+	    x[c] = Cmplx(a->g.elem(site).elem(s).elem(c).real(),
+			 a->g.elem(site).elem(s).elem(c).imag());
+
+	  for(int c=0; c < 3; ++c)
+	  {
+	    Cmplx y = (a->fwdP)
+	      ? m[c][0]*x[0] + m[c][1]*x[1] + m[c][2]*x[2]
+	      : std::conj(m[0][c])*x[0] + std::conj(m[1][c])*x[1] + std::conj(m[2][c])*x[2];
+
+	    a->g.elem(site).elem(s).elem(c).real() = a->coeff * y.real();
+	    a->g.elem(site).elem(s).elem(c).imag() = a->coeff * y.imag();
+	  }
+	}
+      }
+    }
+  }
+#endif
+
+
+  // Packed links of the state and coefficients, for n fields per call
+  template<typename T, typename Q>
+  WilsonHaloDslash<T,Q>::WilsonHaloDslash(Handle< FermState<T,Q,Q> > state,
+					  const multi1d<Real>& coeffs_, int n_) :
+    maps(TheWilsonHaloMaps::Instance()), n(n_)
+  {
+    START_CODE();
+
+    // Anisotropy is applied as the links are multiplied
+    coeffs.resize(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+      coeffs[mu] = W(toDouble(coeffs_[mu]));
+
+    // Temporaries of apply
+    hf.resize(Nd);
+    hb.resize(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      hf[mu].resize(n);
+      hb[mu].resize(n);
+    }
+    gf.resize(Nd);
+    gb.resize(Nd);
+
+#ifndef QDP_IS_QDPJIT
+    // Uncompressed, the links need not be SU(3)
+    u = ThePackedGaugeCache<W>::Type_t::Instance().get(state, 18);
+
+    {
+      H tmp;
+      site_bytes = sizeof(tmp.elem(0));
+    }
+
+    send_buf.resize(4*Nd);
+    recv_buf.resize(4*Nd);
+
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+    send_mem.resize(4*Nd);
+    recv_mem.resize(4*Nd);
+    mh.resize(4*Nd);
+#endif
+
+    for(int cb=0; cb < 2; ++cb)
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	if (! maps.commP(mu))
+	  continue;
+
+	for(int f=0; f < 2; ++f)
+	{
+	  const bool fwdP = (f == 0);
+	  const int i = bufIndex(cb, mu, fwdP);
+
+	  send_buf[i].resize(n * maps.sendSites(cb, mu, fwdP).size() * site_bytes);
+	  recv_buf[i].resize(n * maps.recvCount(cb, mu, fwdP) * site_bytes);
+
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+	  recv_mem[i] = QMP_declare_msgmem(recv_buf[i].slice(), recv_buf[i].size());
+	  send_mem[i] = QMP_declare_msgmem(send_buf[i].slice(), send_buf[i].size());
+
+	  QMP_msghandle_t mh_a[2];
+	  mh_a[0] = QMP_declare_receive_from(recv_mem[i], maps.recvNode(mu, fwdP), 0);
+	  mh_a[1] = QMP_declare_send_to(send_mem[i], maps.sendNode(mu, fwdP), 0);
+	  mh[i] = QMP_declare_multiple(mh_a, 2);
+
+	  if (mh[i] == (QMP_msghandle_t)NULL)
+	  {
+	    QDPIO::cerr << "WilsonHaloDslash: failed to declare the messages of direction " << mu << std::endl;
+	    QDP_abort(1);
+	  }
+#endif
+	}
+      }
+#else
+    site_bytes = 0;
+
+    u_full.resize(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      u_full[mu] = (state->getLinks())[mu];
+      u_full[mu] *= coeffs_[mu];
+    }
+#endif
+
+    END_CODE();
+  }
+
+
+  // Print the times and free the messages
+  template<typename T, typename Q>
+  WilsonHaloDslash<T,Q>::~WilsonHaloDslash()
+  {
+    if (total.calls > 0)
+      QDPIO::cout << "WilsonHaloDslash: " << n << " fields, " << total.calls << " calls: "
+		  << "compute = " << total.compute << " secs  comm = " << total.comm
+		  << " secs  wait = " << total.wait << " secs" << std::endl;
+
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+#ifndef QDP_IS_QDPJIT
+    for(int cb=0; cb < 2; ++cb)
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	if (! maps.commP(mu))
+	  continue;
+
+	for(int f=0; f < 2; ++f)
+	{
+	  const int i = bufIndex(cb, mu, f == 0);
+
+	  QMP_free_msghandle(mh[i]);
+	  QMP_free_msgmem(send_mem[i]);
+	  QMP_free_msgmem(recv_mem[i]);
+	}
+      }
+#endif
+#endif
+  }
+
+
+  // Forward and backward projections on the subset
+  template<typename T, typename Q>
+  void WilsonHaloDslash<T,Q>::project(H& hf, H& hb, const T& psi, int mu,
+				      enum PlusMinus isign, const Subset& s) const
+  {
+    // Undaggered: forward hops use the minus projectors
+    switch (isign)
+    {
+    case PLUS:
+      switch (mu)
+      {
+      case 0:
+	hf[s] = spinProjectDir0Minus(psi);
+	hb[s] = spinProjectDir0Plus(psi);
+	break;
+      case 1:
+	hf[s] = spinProjectDir1Minus(psi);
+	hb[s] = spinProjectDir1Plus(psi);
+	break;
+      case 2:
+	hf[s] = spinProjectDir2Minus(psi);
+	hb[s] = spinProjectDir2Plus(psi);
+	break;
+      case 3:
+	hf[s] = spinProjectDir3Minus(psi);
+	hb[s] = spinProjectDir3Plus(psi);
+	break;
+      }
+      break;
+
+    case MINUS:
+      switch (mu)
+      {
+      case 0:
+	hf[s] = spinProjectDir0Plus(psi);
+	hb[s] = spinProjectDir0Minus(psi);
+	break;
+      case 1:
+	hf[s] = spinProjectDir1Plus(psi);
+	hb[s] = spinProjectDir1Minus(psi);
+	break;
+      case 2:
+	hf[s] = spinProjectDir2Plus(psi);
+	hb[s] = spinProjectDir2Minus(psi);
+	break;
+      case 3:
+	hf[s] = spinProjectDir3Plus(psi);
+	hb[s] = spinProjectDir3Minus(psi);
+	break;
+      }
+      break;
+    }
+  }
+
+
+  // Neighbours times links on the subset
+  template<typename T, typename Q>
+  void WilsonHaloDslash<T,Q>::gather(H& g, const H& h, int field, int mu, bool fwdP,
+				     int cb, const Subset& s) const
+  {
+#ifndef QDP_IS_QDPJIT
+    const int i = bufIndex(cb, mu, fwdP);
+    const char* buf = (recv_buf[i].size() > 0)
+      ? recv_buf[i].slice() + field * maps.recvCount(cb, mu, fwdP) * site_bytes
+      : 0;
+
+    WilsonHaloDslashEnv::GatherArgs<H,W> args = {g, h, maps.neighbours(mu, fwdP).slice(),
+						 buf, site_bytes, *u, cb, mu, fwdP, coeffs[mu],
+						 s.siteTable().slice()};
+    dispatch_to_threads(s.numSiteTable(), args, WilsonHaloDslashEnv::gatherSiteLoop<H,W>);
+#endif
+  }
+
+
+  // Sum of the hops on the subset
+  template<typename T, typename Q>
+  void WilsonHaloDslash<T,Q>::reconstruct(T& chi, const multi1d<H>& gf, const multi1d<H>& gb,
+					  enum PlusMinus isign, const Subset& s) const
+  {
+    switch (isign)
+    {
+    case PLUS:
+      chi[s] = spinReconstructDir0Minus(gf[0]) + spinReconstructDir0Plus(gb[0])
+	+ spinReconstructDir1Minus(gf[1]) + spinReconstructDir1Plus(gb[1])
+	+ spinReconstructDir2Minus(gf[2]) + spinReconstructDir2Plus(gb[2])
+	+ spinReconstructDir3Minus(gf[3]) + spinReconstructDir3Plus(gb[3]);
+      break;
+
+    case MINUS:
+      chi[s] = spinReconstructDir0Plus(gf[0]) + spinReconstructDir0Minus(gb[0])
+	+ spinReconstructDir1Plus(gf[1]) + spinReconstructDir1Minus(gb[1])
+	+ spinReconstructDir2Plus(gf[2]) + spinReconstructDir2Minus(gb[2])
+	+ spinReconstructDir3Plus(gf[3]) + spinReconstructDir3Minus(gb[3]);
+      break;
+    }
+  }
+
+
+  // Pack and post.
+  /* Forward then backward for each direction, on every node. With two
+   * nodes in a direction both hops go to the same node, and the messages
+   * are matched in the order they are posted. */
+  template<typename T, typename Q>
+  void WilsonHaloDslash<T,Q>::startComms(const multi1d< multi1d<H> >& hf,
+					 const multi1d< multi1d<H> >& hb, int cb) const
+  {
+#ifndef QDP_IS_QDPJIT
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (! maps.commP(mu))
+	continue;
+
+      for(int f=0; f < 2; ++f)
+      {
+	const bool fwdP = (f == 0);
+	const int i = bufIndex(cb, mu, fwdP);
+	const multi1d<int>& sites = maps.sendSites(cb, mu, fwdP);
+
+	WilsonHaloDslashEnv::PackArgs<H> args = {(fwdP ? hf[mu] : hb[mu]), sites.slice(), sites.size(),
+						 site_bytes, send_buf[i].slice()};
+	dispatch_to_threads(sites.size(), args, WilsonHaloDslashEnv::packSiteLoop<H>);
+
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+	QMP_status_t err;
+	if ((err = QMP_start(mh[i])) != QMP_SUCCESS)
+	{
+	  QDPIO::cerr << "WilsonHaloDslash: " << QMP_error_string(err) << std::endl;
+	  QDP_abort(1);
+	}
+#endif
+      }
+    }
+#endif
+  }
+
+
+  // Wait for the messages
+  template<typename T, typename Q>
+  void WilsonHaloDslash<T,Q>::waitComms(int cb) const
+  {
+#if (defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)) && ! defined(QDP_IS_QDPJIT)
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (! maps.commP(mu))
+	continue;
+
+      for(int f=0; f < 2; ++f)
+      {
+	QMP_status_t err;
+	if ((err = QMP_wait(mh[bufIndex(cb, mu, f == 0)])) != QMP_SUCCESS)
+	{
+	  QDPIO::cerr << "WilsonHaloDslash: " << QMP_error_string(err) << std::endl;
+	  QDP_abort(1);
+	}
+      }
+    }
+#endif
+  }
+
+
+  //! Wilson dslash of n fields
+  /*!
+   * \param chi     result, n fields                            (Write)
+   * \param psi     source, n fields                            (Read)
+   * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+   * \param cb      Checkerboard of OUTPUT std::vector               (Read)
+   */
+  template<typename T, typename Q>
+  void WilsonHaloDslash<T,Q>::apply(T* chi, const T* psi, enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    const int ocb = 1 - cb;
+    StopWatch swatch;
+    DslashCommTimings t;
+    t.calls = 1;
+
+#ifndef QDP_IS_QDPJIT
+    // Face half spinors of the split directions first
+    swatch.reset();
+    swatch.start();
+    for(int mu=0; mu < Nd; ++mu)
+      if (maps.commP(mu))
+	for(int s=0; s < n; ++s)
+	  project(hf[mu][s], hb[mu][s], psi[s], mu, isign, maps.face(ocb));
+    swatch.stop();
+    t.compute += swatch.getTimeInSeconds();
+
+    swatch.reset();
+    swatch.start();
+    startComms(hf, hb, cb);
+    swatch.stop();
+    t.comm += swatch.getTimeInSeconds();
+
+    // The rest while the messages are in flight
+    swatch.reset();
+    swatch.start();
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      const Subset& s_rest = (maps.commP(mu)) ? maps.interior(ocb) : rb[ocb];
+      for(int s=0; s < n; ++s)
+	project(hf[mu][s], hb[mu][s], psi[s], mu, isign, s_rest);
+    }
+
+    for(int s=0; s < n; ++s)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	gather(gf[mu], hf[mu][s], s, mu, true, cb, maps.interior(cb));
+	gather(gb[mu], hb[mu][s], s, mu, false, cb, maps.interior(cb));
+      }
+      reconstruct(chi[s], gf, gb, isign, maps.interior(cb));
+    }
+    swatch.stop();
+    t.compute += swatch.getTimeInSeconds();
+
+    swatch.reset();
+    swatch.start();
+    waitComms(cb);
+    swatch.stop();
+    t.wait += swatch.getTimeInSeconds();
+
+    // The face sites
+    swatch.reset();
+    swatch.start();
+    for(int s=0; s < n; ++s)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	gather(gf[mu], hf[mu][s], s, mu, true, cb, maps.face(cb));
+	gather(gb[mu], hb[mu][s], s, mu, false, cb, maps.face(cb));
+      }
+      reconstruct(chi[s], gf, gb, isign, maps.face(cb));
+    }
+    swatch.stop();
+    t.compute += swatch.getTimeInSeconds();
+#else
+    // No overlap, the shifts do the communications
+    swatch.reset();
+    swatch.start();
+    for(int s=0; s < n; ++s)
+    {
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	project(hf[mu][0], hb[mu][0], psi[s], mu, isign, rb[ocb]);
+	gf[mu][rb[cb]] = u_full[mu] * shift(hf[mu][0], FORWARD, mu);
+	gb[mu][rb[cb]] = shift(adj(u_full[mu]) * hb[mu][0], BACKWARD, mu);
+      }
+      reconstruct(chi[s], gf, gb, isign, rb[cb]);
+    }
+    swatch.stop();
+    t.compute += swatch.getTimeInSeconds();
+#endif
+
+    last = t;
+    total.calls   += t.calls;
+    total.compute += t.compute;
+    total.comm    += t.comm;
+    total.wait    += t.wait;
+
+    END_CODE();
+  }
+
+} // End Namespace Chroma
+
+
+#endif
@@ -0,0 +1,166 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Multi-mass propagator solver for an even-odd staggered fermion operator
+ *
+ *  Solve for the propagators of several quark masses with one multishift CG
+ */
+
+#ifndef PREC_STAGGERED_MULTI_QPROP_H
+#define PREC_STAGGERED_MULTI_QPROP_H
+
+#include "stagtype_fermact_s.h"
+#include "actions/ferm/invert/minvcg.h"
+#include "actions/ferm/invert/syssolver_cg_params.h"
+
+
+namespace Chroma
+{
+  //! Multi-mass propagator of a generic even-odd staggered fermion operator
+  /*! \ingroup qprop
+   *
+   * On the even sites the normal operator of a staggered fermion of mass m is
+   *
+   *   A(m) = M_ee M_ee^dag + M_eo M_eo^dag = 4 m^2 - D_eo D_oe
+   *
+   * so the operators of all masses differ from the one of the action by a
+   * constant shift 4 (m^2 - m_0^2) and are inverted together by MInvCG.
+   * The even-odd source  2 m chi_e + D_eo^dag chi_o  depends on the mass, so
+   * its two pieces are solved separately and combined per mass,
+   *
+   *   psi_e(m) = 2 m A(m)^{-1} chi_e + A(m)^{-1} D_eo^dag chi_o
+   *
+   * which costs at most two multishift solves for any number of masses
+   * (one when either piece of the source vanishes, e.g. for point sources).
+   * The odd sites are then reconstructed for each mass,
+   *
+   *   psi_o(m) = (1/2m) (chi_o - D_oe psi_e(m))
+   *
+   * MinCG and MaxCG of the inverter params bound each multishift solve,
+   * and a solve that reaches MaxCG is an error as in the single mass case.
+   */
+  template<typename T, typename P, typename Q>
+  class EvenOddFermActMultiQprop
+  {
+  public:
+    //! Constructor
+    /*!
+     * \param S_        even-odd staggered action; its mass sets the base operator ( Read )
+     * \param state     gauge field state ( Read )
+     * \param masses_   quark masses to solve for ( Read )
+     * \param invParam_ inverter parameters ( Read )
+     */
+    EvenOddFermActMultiQprop(const EvenOddStaggeredTypeFermAct<T,P,Q>& S_,
+			     Handle< FermState<T,P,Q> > state,
+			     const multi1d<Real>& masses_,
+			     const SysSolverCGParams& invParam_) :
+      M(S_.linOp(state)), A(S_.lMdagM(state)),
+      Mass(S_.getQuarkMass()), masses(masses_), invParam(invParam_) {}
+
+    //! Destructor is automatic
+    ~EvenOddFermActMultiQprop() {}
+
+    //! Number of masses
+    int size() const {return masses.size();}
+
+    //! Solve the linear systems of all masses
+    /*!
+     * \param psi      quark propagators, one per mass ( Write )
+     * \param chi      source ( Read )
+     * \return total number of CG iterations and the largest true residual
+     */
+    SystemSolverResults_t operator() (multi1d<T>& psi, const T& chi) const
+    {
+      START_CODE();
+
+      const int n_mass = masses.size();
+      SystemSolverResults_t res;
+
+      psi.resize(n_mass);
+
+      // Shifts relative to the base operator, one residual for all masses
+      multi1d<Real> shifts(n_mass);
+      multi1d<Real> RsdCG(n_mass);
+      for(int i=0; i < n_mass; ++i)
+      {
+	shifts[i] = Real(4)*(masses[i]*masses[i] - Mass*Mass);
+	RsdCG[i] = invParam.RsdCG;
+      }
+
+      // The mass independent pieces of the source:  chi_e  and  w_e = M_eo^{dag} chi_o
+      T chi_e, w;
+      chi_e = w = zero;
+      chi_e[rb[0]] = chi;
+      M->evenOddLinOp(w, chi, MINUS);
+
+      // y_e = A(m)^{-1} chi_e,  z_e = A(m)^{-1} w_e
+      multi1d<T> y, z;
+      int n_count;
+
+      if (toBool(norm2(chi_e, rb[0]) != 0))
+      {
+	MInvCG(*A, chi_e, y, shifts, RsdCG, invParam.MinCG, invParam.MaxCG, n_count);
+	res.n_count += n_count;
+
+	if (n_count == invParam.MaxCG)
+	  QDP_error_exit("no convergence in the inverter", n_count);
+      }
+
+      if (toBool(norm2(w, rb[0]) != 0))
+      {
+	MInvCG(*A, w, z, shifts, RsdCG, invParam.MinCG, invParam.MaxCG, n_count);
+	res.n_count += n_count;
+
+	if (n_count == invParam.MaxCG)
+	  QDP_error_exit("no convergence in the inverter", n_count);
+      }
+
+      for(int i=0; i < n_mass; ++i)
+      {
+	// psi_e = 2m y_e + z_e
+	psi[i] = zero;
+	if (y.size() > 0)
+	  psi[i][rb[0]] = Real(2)*masses[i]*y[i];
+	if (z.size() > 0)
+	  psi[i][rb[0]] += z[i];
+
+	// psi_o = (1/2m) chi_o - (1/2m) D_oe psi_e
+	Real invm = Real(1)/(2*masses[i]);
+	T tmp1;
+	M->oddEvenLinOp(tmp1, psi[i], PLUS);
+	psi[i][rb[1]] = invm*(chi - tmp1);
+
+	// Compute residual:  M(m) = M(m_0) + 2 (m - m_0)
+	{
+	  T  r;
+	  (*M)(r, psi[i], PLUS);
+	  r += Real(2)*(masses[i] - Mass)*psi[i];
+	  r -= chi;
+	  Real resid = sqrt(norm2(r));
+	  QDPIO::cout << "eoprec_staggered_multi_qprop:  mass = " << masses[i]
+		      << "  true residual:  " << resid << std::endl;
+
+	  if (toBool(resid > res.resid))
+	    res.resid = resid;
+	}
+      }
+
+      END_CODE();
+
+      return res;
+    }
+
+
+  private:
+    // Hide default constructor
+    EvenOddFermActMultiQprop() {}
+
+    Handle< EvenOddLinearOperator<T,P,Q> > M;
+    Handle< LinearOperator<T> > A;
+    Real Mass;
+    multi1d<Real> masses;
+    SysSolverCGParams invParam;
+  };
+
+}; // End namespace
+
+#endif
@@ -40,6 +40,11 @@ namespace Chroma
     Handle(const Handle& p) : ptr(p.ptr), count(p.count) 
       {++*count;}
 
+    //! Share the object of a compatible handle, e.g. Handle<const T> from Handle<T>
+    template<typename Q>
+    Handle(const Handle<Q>& p) : ptr(p.ptr), count(p.count) 
+      {++*count;}
+
     //! Destructor (delete value if this was the last owner)
     ~Handle() {dispose();}
 
@@ -81,6 +86,9 @@ namespace Chroma
     T& operator*() const {return *ptr;}
     T* operator->() const {return ptr;}
 
+    //! Is this the only owner?
+    bool unique() const {return *count == 1;}
+
   private:
     void dispose() 
       {
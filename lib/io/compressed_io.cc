@@ -0,0 +1,421 @@
+/*! \file
+ *  \brief Compressed storage of propagators and fermions
+ */
+
+#include "io/compressed_io.h"
+
+#ifndef QDP_IS_QDPJIT
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+namespace Chroma
+{
+
+  namespace
+  {
+    //! Largest mantissa
+    const int mant_max = 32767;
+
+    //! Reals in one spinor
+    const int col_len = 2*Ns*Nc;
+
+    //! Integers holding the mantissas of one spinor
+    const int col_words = col_len/2;
+
+    //! Format tag of the record XML
+    const std::string compressed_format = "SCALE_F32_MANTISSA_16";
+
+    //! Version of the format
+    const int compressed_version = 1;
+
+
+    //! Store a single precision scale in an integer
+    int scaleToWord(float scale)
+    {
+      int w;
+      std::memcpy(&w, &scale, sizeof(w));
+      return w;
+    }
+
+    //! Recover the scale of an integer
+    float wordToScale(int w)
+    {
+      float scale;
+      std::memcpy(&scale, &w, sizeof(scale));
+      return scale;
+    }
+
+    //! Mantissa of x with the scale 1/inv_scale
+    int mantissa(REAL x, double inv_scale)
+    {
+      long q = std::lrint(double(x)*inv_scale);
+      if (q > mant_max)  q = mant_max;
+      if (q < -mant_max) q = -mant_max;
+      return int(q);
+    }
+
+
+    //! Compress one spinor
+    /*!
+     * \param x       the col_len reals of the spinor        ( Read )
+     * \param scale   the scale                              ( Write )
+     * \param words   the col_words mantissa pairs           ( Write )
+     */
+    void encodeColumn(const REAL* x, int& scale, int* words)
+    {
+      double xmax = 0;
+      for(int i=0; i < col_len; ++i)
+	xmax = std::max(xmax, std::fabs(double(x[i])));
+
+      float fscale = float(xmax);
+      scale = scaleToWord(fscale);
+
+      double inv_scale = (fscale > 0) ? double(mant_max) / double(fscale) : 0.0;
+
+      for(int i=0; i < col_words; ++i)
+      {
+	unsigned int lo = (unsigned int)(mantissa(x[2*i],   inv_scale)) & 0xffffu;
+	unsigned int hi = (unsigned int)(mantissa(x[2*i+1], inv_scale)) & 0xffffu;
+	words[i] = int(lo | (hi << 16));
+      }
+    }
+
+
+    //! Uncompress one spinor
+    /*!
+     * \param x       the col_len reals of the spinor        ( Write )
+     * \param scale   the scale                              ( Read )
+     * \param words   the col_words mantissa pairs           ( Read )
+     */
+    void decodeColumn(REAL* x, int scale, const int* words)
+    {
+      double fact = double(wordToScale(scale)) / double(mant_max);
+
+      for(int i=0; i < col_words; ++i)
+      {
+	unsigned int w = (unsigned int)(words[i]);
+	x[2*i]   = REAL(fact * double(short(w & 0xffffu)));
+	x[2*i+1] = REAL(fact * double(short(w >> 16)));
+      }
+    }
+
+
+    //! Check the size of a packed object
+    void checkSize(const multi1d<LatticeInteger>& obj, int ncol)
+    {
+      if (obj.size() != ncol*(1 + col_words))
+      {
+	QDPIO::cerr << __func__ << ": compressed object has " << obj.size()
+		    << " components, expected " << ncol*(1 + col_words) << std::endl;
+	QDP_abort(1);
+      }
+    }
+  }
+
+
+  namespace
+  {
+    //! Arguments of the compression site loops
+    template<typename T>
+    struct CompressArgs
+    {
+      const T&                  x;
+      multi1d<LatticeInteger>&  obj;
+    };
+
+    //! Arguments of the decompression site loops
+    template<typename T>
+    struct DecompressArgs
+    {
+      T&                              x;
+      const multi1d<LatticeInteger>&  obj;
+    };
+
+
+    //! Compress the propagator on the sites [lo,hi)
+    void compressPropSiteLoop(int lo, int hi, int myId, CompressArgs<LatticePropagator>* a)
+    {
+      const int ncol = Ns*Nc;
+      REAL x[col_len];
+      int  words[col_words];
+
+      for(int site=lo; site < hi; ++site)
+      {
+	for(int s2=0; s2 < Ns; ++s2)
+	  for(int c2=0; c2 < Nc; ++c2)
+	  {
+	    const int j = c2 + Nc*s2;
+
+	    for(int s1=0; s1 < Ns; ++s1)
+	      for(int c1=0; c1 < Nc; ++c1)
+	      {
+		const int i = 2*(c1 + Nc*s1);
+		x[i]   = a->x.elem(site).elem(s1,s2).elem(c1,c2).real();
+		x[i+1] = a->x.elem(site).elem(s1,s2).elem(c1,c2).imag();
+	      }
+
+	    int scale;
+	    encodeColumn(x, scale, words);
+
+	    a->obj[j].elem(site).elem().elem().elem() = scale;
+	    for(int i=0; i < col_words; ++i)
+	      a->obj[ncol + col_words*j + i].elem(site).elem().elem().elem() = words[i];
+	  }
+      }
+    }
+
+
+    //! Uncompress the propagator on the sites [lo,hi)
+    void decompressPropSiteLoop(int lo, int hi, int myId, DecompressArgs<LatticePropagator>* a)
+    {
+      const int ncol = Ns*Nc;
+      REAL x[col_len];
+      int  words[col_words];
+
+      for(int site=lo; site < hi; ++site)
+      {
+	for(int s2=0; s2 < Ns; ++s2)
+	  for(int c2=0; c2 < Nc; ++c2)
+	  {
+	    const int j = c2 + Nc*s2;
+
+	    for(int i=0; i < col_words; ++i)
+	      words[i] = a->obj[ncol + col_words*j + i].elem(site).elem().elem().elem();
+
+	    decodeColumn(x, a->obj[j].elem(site).elem().elem().elem(), words);
+
+	    for(int s1=0; s1 < Ns; ++s1)
+	      for(int c1=0; c1 < Nc; ++c1)
+	      {
+		const int i = 2*(c1 + Nc*s1);
+		a->x.elem(site).elem(s1,s2).elem(c1,c2).real() = x[i];
+		a->x.elem(site).elem(s1,s2).elem(c1,c2).imag() = x[i+1];
+	      }
+	  }
+      }
+    }
+
+
+    //! Compress the fermion on the sites [lo,hi)
+    void compressFermSiteLoop(int lo, int hi, int myId, CompressArgs<LatticeFermion>* a)
+    {
+      REAL x[col_len];
+      int  words[col_words];
+
+      for(int site=lo; site < hi; ++site)
+      {
+	for(int s1=0; s1 < Ns; ++s1)
+	  for(int c1=0; c1 < Nc; ++c1)
+	  {
+	    const int i = 2*(c1 + Nc*s1);
+	    x[i]   = a->x.elem(site).elem(s1).elem(c1).real();
+	    x[i+1] = a->x.elem(site).elem(s1).elem(c1).imag();
+	  }
+
+	int scale;
+	encodeColumn(x, scale, words);
+
+	a->obj[0].elem(site).elem().elem().elem() = scale;
+	for(int i=0; i < col_words; ++i)
+	  a->obj[1 + i].elem(site).elem().elem().elem() = words[i];
+      }
+    }
+
+
+    //! Uncompress the fermion on the sites [lo,hi)
+    void decompressFermSiteLoop(int lo, int hi, int myId, DecompressArgs<LatticeFermion>* a)
+    {
+      REAL x[col_len];
+      int  words[col_words];
+
+      for(int site=lo; site < hi; ++site)
+      {
+	for(int i=0; i < col_words; ++i)
+	  words[i] = a->obj[1 + i].elem(site).elem().elem().elem();
+
+	decodeColumn(x, a->obj[0].elem(site).elem().elem().elem(), words);
+
+	for(int s1=0; s1 < Ns; ++s1)
+	  for(int c1=0; c1 < Nc; ++c1)
+	  {
+	    const int i = 2*(c1 + Nc*s1);
+	    a->x.elem(site).elem(s1).elem(c1).real() = x[i];
+	    a->x.elem(site).elem(s1).elem(c1).imag() = x[i+1];
+	  }
+      }
+    }
+  }
+
+
+  // Compress a propagator
+  void compress(multi1d<LatticeInteger>& obj, const LatticePropagator& prop)
+  {
+    START_CODE();
+
+    obj.resize(Ns*Nc*(1 + col_words));
+
+    CompressArgs<LatticePropagator> args = {prop, obj};
+    dispatch_to_threads(Layout::sitesOnNode(), args, compressPropSiteLoop);
+
+    END_CODE();
+  }
+
+
+  // Uncompress a propagator
+  void decompress(LatticePropagator& prop, const multi1d<LatticeInteger>& obj)
+  {
+    START_CODE();
+
+    checkSize(obj, Ns*Nc);
+
+    DecompressArgs<LatticePropagator> args = {prop, obj};
+    dispatch_to_threads(Layout::sitesOnNode(), args, decompressPropSiteLoop);
+
+    END_CODE();
+  }
+
+
+  // Compress a fermion
+  void compress(multi1d<LatticeInteger>& obj, const LatticeFermion& psi)
+  {
+    START_CODE();
+
+    obj.resize(1 + col_words);
+
+    CompressArgs<LatticeFermion> args = {psi, obj};
+    dispatch_to_threads(Layout::sitesOnNode(), args, compressFermSiteLoop);
+
+    END_CODE();
+  }
+
+
+  // Uncompress a fermion
+  void decompress(LatticeFermion& psi, const multi1d<LatticeInteger>& obj)
+  {
+    START_CODE();
+
+    checkSize(obj, 1);
+
+    DecompressArgs<LatticeFermion> args = {psi, obj};
+    dispatch_to_threads(Layout::sitesOnNode(), args, decompressFermSiteLoop);
+
+    END_CODE();
+  }
+
+
+  // Number of LatticeIntegers of a compressed object
+  int compressedSize(const std::string& obj_type)
+  {
+    if (obj_type == "LatticePropagator")
+      return Ns*Nc*(1 + col_words);
+    else if (obj_type == "LatticeFermion")
+      return 1 + col_words;
+
+    QDPIO::cerr << __func__ << ": no compressed form of " << obj_type << std::endl;
+    QDP_abort(1);
+    return 0;
+  }
+
+
+  // Record XML of a compressed object
+  void writeCompressedRecordXML(XMLBufferWriter& record_xml, XMLBufferWriter& obj_xml,
+				const std::string& obj_type)
+  {
+    push(record_xml, "CompressedObject");
+    write(record_xml, "format", compressed_format);
+    write(record_xml, "version", compressed_version);
+    write(record_xml, "type", obj_type);
+    write(record_xml, "size", compressedSize(obj_type));
+    write(record_xml, "RecordXML", obj_xml);
+    pop(record_xml);
+  }
+
+
+  // Check the record XML of a compressed object
+  void readCompressedRecordXML(XMLBufferWriter& obj_xml, XMLReader& record_xml,
+			       const std::string& obj_type)
+  {
+    if (record_xml.count("/CompressedObject") == 0)
+    {
+      QDPIO::cerr << __func__ << ": the record is not a compressed object" << std::endl;
+      QDP_abort(1);
+    }
+
+    XMLReader paramtop(record_xml, "/CompressedObject");
+
+    std::string format;
+    int version;
+    std::string type;
+    read(paramtop, "format", format);
+    read(paramtop, "version", version);
+    read(paramtop, "type", type);
+
+    if (format != compressed_format || version != compressed_version)
+    {
+      QDPIO::cerr << __func__ << ": unsupported compression " << format
+		  << " version " << version << ", expected " << compressed_format
+		  << " version " << compressed_version << std::endl;
+      QDP_abort(1);
+    }
+
+    if (type != obj_type)
+    {
+      QDPIO::cerr << __func__ << ": the record holds a compressed " << type
+		  << ", expected " << obj_type << std::endl;
+      QDP_abort(1);
+    }
+
+    if (paramtop.count("size") != 0)
+    {
+      int size;
+      read(paramtop, "size", size);
+
+      if (size != compressedSize(obj_type))
+      {
+	QDPIO::cerr << __func__ << ": the record holds " << size
+		    << " fields, expected " << compressedSize(obj_type) << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+    // The record XML of the uncompressed object, if it had one
+    if (paramtop.count("RecordXML/*") > 0)
+    {
+      XMLReader orig(paramtop, "RecordXML/*");
+      std::ostringstream os;
+      orig.printCurrentContext(os);
+      obj_xml.writeXML(os.str());
+    }
+  }
+
+
+  // Read a compressed record
+  void readCompressed(QDPFileReader& from, XMLBufferWriter& obj_xml,
+		      multi1d<LatticeInteger>& obj, const std::string& obj_type)
+  {
+    START_CODE();
+
+    // The reader takes the number of fields from obj
+    obj.resize(compressedSize(obj_type));
+
+    XMLReader record_xml;
+    read(from, record_xml, obj);
+
+    readCompressedRecordXML(obj_xml, record_xml, obj_type);
+
+    END_CODE();
+  }
+
+
+  // Bytes of a compressed object on the whole lattice
+  size_t compressedBytes(const multi1d<LatticeInteger>& obj)
+  {
+    return size_t(obj.size()) * sizeof(int) * size_t(Layout::vol());
+  }
+
+} // end namespace Chroma
+
+#endif // QDP_IS_QDPJIT
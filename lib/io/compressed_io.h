@@ -0,0 +1,106 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Compressed storage of propagators and fermions
+ */
+
+#ifndef __compressed_io_h__
+#define __compressed_io_h__
+
+#ifndef QDP_IS_QDPJIT
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+
+  /*!
+   * Compressed lattice objects
+   *
+   * \ingroup io
+   *
+   * The spinor of each source spin and color (a column of a propagator, or
+   * a whole fermion) on each site is stored with one single precision
+   * scale, the largest modulus of its components, and one 16 bit signed
+   * mantissa per real component. The relative error per site and column is
+   * below 2^-15 of the largest component, independent of how fast the
+   * propagator falls off with the distance from the source.
+   *
+   * The packed data is a  multi1d<LatticeInteger>  with the Ns*Nc (or 1)
+   * scales first, followed by two mantissas per integer. It is written and
+   * read as one record through QIO, so it supports the same volume formats
+   * and parallel IO as the uncompressed objects. A propagator takes 624
+   * bytes per site, against 1152 in single and 2304 in double precision.
+   *
+   * The record XML names the format, its version, the object type and the
+   * number of LatticeIntegers, and holds the record XML of the uncompressed
+   * object. It is checked before
+   * a record is uncompressed. The site loops read the lattice data
+   * directly, so these objects are not available with QDP-JIT.
+   *
+   * @{
+   */
+
+  //! Compress a propagator
+  void compress(multi1d<LatticeInteger>& obj, const LatticePropagator& prop);
+
+  //! Uncompress a propagator
+  void decompress(LatticePropagator& prop, const multi1d<LatticeInteger>& obj);
+
+  //! Compress a fermion
+  void compress(multi1d<LatticeInteger>& obj, const LatticeFermion& psi);
+
+  //! Uncompress a fermion
+  void decompress(LatticeFermion& psi, const multi1d<LatticeInteger>& obj);
+
+  //! Number of LatticeIntegers of a compressed object of type obj_type
+  /*!
+   * Ns*Nc*(1 + Ns*Nc) for a "LatticePropagator", 1 + Ns*Nc for a
+   * "LatticeFermion". Aborts on any other type.
+   */
+  int compressedSize(const std::string& obj_type);
+
+  //! Bytes of a compressed object on the whole lattice
+  size_t compressedBytes(const multi1d<LatticeInteger>& obj);
+
+  //! Record XML of a compressed object
+  /*!
+   * \param record_xml  record XML to write                       ( Write )
+   * \param obj_xml     record XML of the uncompressed object     ( Read )
+   * \param obj_type    type of the uncompressed object           ( Read )
+   */
+  void writeCompressedRecordXML(XMLBufferWriter& record_xml, XMLBufferWriter& obj_xml,
+				const std::string& obj_type);
+
+  //! Check the record XML of a compressed object
+  /*!
+   * Aborts unless the record holds an object of type obj_type in the
+   * format of this version.
+   *
+   * \param obj_xml     record XML of the uncompressed object     ( Write )
+   * \param record_xml  record XML that was read                  ( Read )
+   * \param obj_type    expected type of the uncompressed object  ( Read )
+   */
+  void readCompressedRecordXML(XMLBufferWriter& obj_xml, XMLReader& record_xml,
+			       const std::string& obj_type);
+
+  //! Read a compressed record
+  /*!
+   * The reader of a  multi1d<LatticeInteger>  takes the number of fields
+   * from the size of obj, so it is sized from obj_type first. The record
+   * XML is checked as in readCompressedRecordXML.
+   *
+   * \param from       open file reader                            ( Modify )
+   * \param obj_xml    record XML of the uncompressed object     ( Write )
+   * \param obj        compressed object                           ( Write )
+   * \param obj_type   expected type of the uncompressed object  ( Read )
+   */
+  void readCompressed(QDPFileReader& from, XMLBufferWriter& obj_xml,
+		      multi1d<LatticeInteger>& obj, const std::string& obj_type);
+
+  /*! @} */  // end of group io
+
+} // end namespace Chroma
+
+#endif // QDP_IS_QDPJIT
+
+#endif
@@ -39,6 +39,20 @@ namespace Chroma
       (*this)(chi,psi,isign);
     }
 
+    //! Apply the operator onto a block of source vectors
+    /*!
+     * Default implementation applies the operator to one vector after the
+     * other. Operators that can share the gauge field among the vectors
+     * can override this.
+     */
+    virtual void applyMultiRHS(multi1d<T>& chi, const multi1d<T>& psi,
+			       enum PlusMinus isign) const
+    {
+      chi.resize(psi.size());
+      for(int i=0; i < psi.size(); ++i)
+	(*this)(chi[i], psi[i], isign);
+    }
+
     //! Return the subset on which the operator acts
     virtual const Subset& subset() const = 0;
 
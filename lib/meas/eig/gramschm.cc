@@ -270,4 +270,116 @@ void GramSchm(LatticeFermion& psi,
   END_CODE();
 }
 
+
+#ifndef QDP_IS_QDPJIT
+namespace
+{
+  //! Arguments of the blocked inner product site loop
+  struct BlockInnerProductArgs
+  {
+    const multi1d<LatticeFermion>& vec;
+    int                            Nvec;
+    const LatticeFermion&          psi;
+    const int*                     tab;
+    REAL64*                        sums;  /*!< 2*Nvec partial sums per thread */
+  };
+
+  //! Local sums of <vec[i], psi> over the sites [lo,hi) of the site table
+  void blockInnerProductSiteLoop(int lo, int hi, int myId, BlockInnerProductArgs* a)
+  {
+    REAL64* sums = a->sums + 2*a->Nvec*myId;
+
+    for(int j=lo; j < hi; ++j)
+    {
+      int site = a->tab[j];
+
+      for(int i=0; i < a->Nvec; ++i)
+      {
+	REAL64 re = 0;
+	REAL64 im = 0;
+
+	for(int s=0; s < Ns; ++s)
+	  for(int c=0; c < Nc; ++c)
+	  {
+	    REAL64 vr = a->vec[i].elem(site).elem(s).elem(c).real();
+	    REAL64 vi = a->vec[i].elem(site).elem(s).elem(c).imag();
+	    REAL64 pr = a->psi.elem(site).elem(s).elem(c).real();
+	    REAL64 pi = a->psi.elem(site).elem(s).elem(c).imag();
+
+	    re += vr*pr + vi*pi;
+	    im += vr*pi - vi*pr;
+	  }
+
+	sums[2*i]   += re;
+	sums[2*i+1] += im;
+      }
+    }
+  }
+}
+#endif
+
+
+//! Blocked inner products
+void blockInnerProduct(multi1d<DComplex>& ip,
+		       const multi1d<LatticeFermion>& vec, 
+		       const int Nvec,
+		       const LatticeFermion& psi,
+		       const Subset& sub)
+{
+  START_CODE();
+
+  ip.resize(Nvec);
+  if (Nvec == 0)
+  {
+    END_CODE();
+    return;
+  }
+
+#ifndef QDP_IS_QDPJIT
+  const int nthr = qdpNumThreads();
+  multi1d<REAL64> sums(2*Nvec*nthr);
+  sums = 0;
+
+  BlockInnerProductArgs args = {vec, Nvec, psi, sub.siteTable().slice(), sums.slice()};
+  dispatch_to_threads(sub.numSiteTable(), args, blockInnerProductSiteLoop);
+
+  // Collect the threads, then one global sum for all vectors
+  for(int t=1; t < nthr; ++t)
+    for(int i=0; i < 2*Nvec; ++i)
+      sums[i] += sums[2*Nvec*t + i];
+
+  QDPInternal::globalSumArray(sums.slice(), 2*Nvec);
+
+  for(int i=0; i < Nvec; ++i)
+    ip[i] = cmplx(Double(sums[2*i]), Double(sums[2*i+1]));
+#else
+  // No host access to the sites: one reduction per vector
+  for(int i=0; i < Nvec; ++i)
+    ip[i] = innerProduct(vec[i], psi, sub);
+#endif
+
+  END_CODE();
+}
+
+
+//! Blocked Gram Schmidt rothogonalisation
+void GramSchmBlock(LatticeFermion& psi, 
+		   const multi1d<LatticeFermion>& vec, 
+		   const int Nvec,
+		   const Subset& sub)
+{
+  START_CODE();
+
+  multi1d<DComplex> ip;
+  blockInnerProduct(ip, vec, Nvec, psi, sub);
+
+  for(int i = 0; i < Nvec; ++i)
+  {
+    Complex xp = ip[i];
+    psi[sub] -= vec[i] * xp;
+  }
+
+  END_CODE();
+}
+
 }  // end namespace Chroma
@@ -123,6 +123,51 @@ void GramSchm(LatticeFermion& psi,
 	      const LatticeFermion& vec,
 	      const Subset& sub);
 
+
+//! Blocked inner products
+/*!
+ * \ingroup eig
+ * 
+ * Computes ip[i] = <vec[i], psi> for the first Nvec vectors of vec.
+ * The local sums of all vectors are done in one threaded sweep over
+ * the sites, so psi is read once, and are reduced across nodes in
+ * a single global sum. With QDP-JIT it falls back to one
+ * innerProduct per vector.
+ *
+ * Arguments:
+ *  \param ip          inner products                  (Write)
+ *  \param vec         vectors                         (Read)
+ *  \param Nvec        no of vectors                   (Read)
+ *  \param psi         field                           (Read)
+ *  \param sub         Subset to use                   (Read) 
+ */
+void blockInnerProduct(multi1d<DComplex>& ip,
+		       const multi1d<LatticeFermion>& vec, 
+		       const int Nvec,
+		       const LatticeFermion& psi,
+		       const Subset& sub);
+
+
+//! Blocked Gram Schmidt rothogonalisation
+/*!
+ * \ingroup eig
+ * 
+ * Orthogonalise single std::vector psi against the first Nvec
+ * orthonormal vectors of vec. All projections are computed from the
+ * original psi with blockInnerProduct (classical Gram-Schmidt), which
+ * for orthonormal vectors agrees with GramSchm up to rounding.
+ *
+ * Arguments:
+ *  \param psi         Pseudofermion field     	       (Modify)
+ *  \param vec         orthonormal subspace wrt orthog  (Read)
+ *  \param Nvec        no of vectors to orthog against (Read)
+ *  \param sub         Subset to use                   (Read) 
+ */
+void GramSchmBlock(LatticeFermion& psi, 
+		   const multi1d<LatticeFermion>& vec, 
+		   const int Nvec,
+		   const Subset& sub);
+
 }  // end namespace Chroma
 
 #endif
@@ -63,9 +63,8 @@ void CVSBuildingBlocks( TextWriter & Out )
 // backward forward trace                                                            //
 //###################################################################################//
 
-void BkwdFrwdTr( const LatticePropagator &             B,
+void BkwdFrwdTr( const LatticePropagator &             BG,
                  const LatticePropagator &             F,
-		 int                                   GammaInsertion,
                  const SftMom &                        Phases,
                  const SftMom &                        PhasesCanonical,
                  multi2d< BinaryFileWriter > &         BinaryWriters,
@@ -149,40 +148,77 @@ void BkwdFrwdTr( const LatticePropagator &             B,
   Timer.stop();
   IOTime += Timer.getTimeInSeconds();
 
+  //#################################################################################//
+  // contract once for all gamma matrices                                            //
+  //#################################################################################//
+
+  // With BG = Gamma(GammaInsertion) * adj(B), every insertion is a spin trace of one
+  // color-traced spin matrix:
+  //   localInnerProduct( B, Gamma(i) * F * Gamma(GammaInsertion) ) = trace( Gamma(i) * traceColor( F * BG ) )
+  Timer.reset();
+  Timer.start();
+
+  LatticeSpinMatrix FBG = traceColor( F * BG );
+
+  Timer.stop();
+  IPCalls += 1;
+  IPTime += Timer.getTimeInSeconds();
+
+  // The momentum projection is linear, so project the spin matrix once and take the
+  // gamma traces on the small time slice sums
+  Timer.reset();
+  Timer.start();
+
+  multi2d< SpinMatrixD > SpinProjections( NumQ, NT );
+
+  for( int q = 0; q < NumQ; q ++ )
+  {
+    multi1d< SpinMatrixD > SpinProjection = sumMulti( Phases[ q ] * FBG, Phases.getSet() );
+
+    for( int t = 0; t < NT; t ++ )
+    {
+      SpinProjections( q, t ) = SpinProjection[ t ];
+    }
+  }
+
+  Timer.stop();
+  FTCalls += 1;
+  FTTime += Timer.getTimeInSeconds();
+
   for( int i = 0; i < Ns * Ns; i ++ )
   {
     Timer.reset();
     Timer.start();
 
-    // assumes any Gamma5 matrices have already been absorbed
-    LatticePropagator GFG = Gamma(i) * F * Gamma( GammaInsertion );
+    multi2d< DComplex > Projections( NumQ, NT );
+
+    for( int q = 0; q < NumQ; q ++ )
+    {
+      for( int t = 0; t < NT; t ++ )
+      {
+        Projections( q, t ) = trace( Gamma(i) * SpinProjections( q, t ) );
+      }
+    }
 
     // There is an overall minus sign from interchanging the initial and final states for baryons.  This
     // might not be present for mesons, so we should think about this carefully.
     // It seems there should be another sign for conjugating the operator, but it appears to be absent.
     // There is a minus sign for all Dirac structures with a gamma_t.  In the current scheme this is all
     // gamma_i with i = 8, ..., 15.  If the gamma basis changes, then this must change.
-    if( ( TimeReverse == true ) & ( i < 8 ) ) GFG *= -1;
+    if( ( TimeReverse == true ) & ( i < 8 ) )
+    {
+      for( int q = 0; q < NumQ; q ++ )
+      {
+        for( int t = 0; t < NT; t ++ )
+        {
+          Projections( q, t ) = -Projections( q, t );
+        }
+      }
+    }
 
     Timer.stop();
     GFGCalls += 1;
     GFGTime += Timer.getTimeInSeconds();
-    Timer.reset();
-    Timer.start();
-
-    LatticeComplex Trace = localInnerProduct( B, GFG );
-
-    Timer.stop();
-    IPCalls += 1;
-    IPTime += Timer.getTimeInSeconds();
-    Timer.reset();
-    Timer.start();
-
-    multi2d< DComplex > Projections = Phases.sft( Trace );
-
-    Timer.stop();
-    FTTime += Timer.getTimeInSeconds();
-    FTCalls += 1;
 
     Timer.reset();
     Timer.start();
@@ -286,10 +322,9 @@ void BkwdFrwdTr( const LatticePropagator &             B,
 // accumulate link operators                                                         //
 //###################################################################################//
 
-void AddLinks( const multi1d< LatticePropagator > &  B,
+void AddLinks( const multi1d< LatticePropagator > &  BG,
                const LatticePropagator &             F,
                const multi1d< LatticeColorMatrix > & U,
-	       const multi1d< int > &                GammaInsertions,
                const SftMom &                        Phases,
 	       const SftMom &                        PhasesCanonical,
                multi1d< unsigned short int > &       LinkDirs,
@@ -319,7 +354,7 @@ void AddLinks( const multi1d< LatticePropagator > &  B,
   }
 
   LatticePropagator F_mu;
-  const int NF = B.size();
+  const int NF = BG.size();
   multi1d< unsigned short int > NextLinkDirs( NLinks + 1 );
   int Link;
 
@@ -359,7 +394,7 @@ void AddLinks( const multi1d< LatticePropagator > &  B,
         // form correlation functions
         for( int f = 0; f < NF; f ++ )
         {
-          BkwdFrwdTr( B[ f ], F_mu, GammaInsertions[ f ], Phases, PhasesCanonical,
+          BkwdFrwdTr( BG[ f ], F_mu, Phases, PhasesCanonical,
 		      BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms,
 		      f, NextLinkDirs, T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag );
         }
@@ -368,7 +403,7 @@ void AddLinks( const multi1d< LatticePropagator > &  B,
       if( DoFurtherPatterns == true )
       {
         // add another link
-        AddLinks( B, F_mu, U, GammaInsertions, 
+        AddLinks( BG, F_mu, U,
 		  Phases, PhasesCanonical,
 		  NextLinkDirs, MaxNLinks, LinkPattern, 1, mu, 
 		  BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms,
@@ -408,7 +443,7 @@ void AddLinks( const multi1d< LatticePropagator > &  B,
         // form correlation functions
         for( int f = 0; f < NF; f ++ )
         {
-          BkwdFrwdTr( B[ f ], F_mu, GammaInsertions[ f ], Phases, PhasesCanonical,
+          BkwdFrwdTr( BG[ f ], F_mu, Phases, PhasesCanonical,
 		      BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms,
 		      f, NextLinkDirs, T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag );
         }
@@ -417,7 +452,7 @@ void AddLinks( const multi1d< LatticePropagator > &  B,
       if( DoFurtherPatterns == true )
       {
         // add another link
-        AddLinks( B, F_mu, U, GammaInsertions, Phases, PhasesCanonical,
+        AddLinks( BG, F_mu, U, Phases, PhasesCanonical,
 		  NextLinkDirs, MaxNLinks, LinkPattern, -1, mu, BinaryWriters, 
 		  GBB_NLinkPatterns, GBB_NMomPerms,
 		  T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag );
@@ -511,9 +546,18 @@ void BuildingBlocks( const multi1d< LatticePropagator > &  B,
   const unsigned short int NLinks = 0;
   multi1d< unsigned short int > LinkDirs( 0 );
 
+  // The backward propagators only ever enter with their gamma insertion, so
+  // absorb it once for all link patterns
+  multi1d< LatticePropagator > BG( NumF );
+
+  for( int f = 0; f < NumF; f ++ )
+  {
+    BG[ f ] = Gamma( GammaInsertions[ f ] ) * adj( B[ f ] );
+  }
+
   for( int f = 0; f < NumF; f ++ )
   {
-    BkwdFrwdTr( B[ f ], F, GammaInsertions[ f ], Phases, PhasesCanonical,
+    BkwdFrwdTr( BG[ f ], F, Phases, PhasesCanonical,
 		BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms, f, LinkDirs, 
 		T1, T2, Tsrc, Tsnk,
 		TimeReverse, ShiftFlag );
@@ -529,7 +573,7 @@ void BuildingBlocks( const multi1d< LatticePropagator > &  B,
 
   QDPIO::cout << __func__ << ": start AddLinks" << std::endl;
 
-  AddLinks( B, F, U, GammaInsertions, 
+  AddLinks( BG, F, U,
 	    Phases, PhasesCanonical,
 	    LinkDirs, MaxNLinks, LinkPattern, 0, -1, 
 	    BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms,
@@ -6,6 +6,8 @@
 #include "util/ft/sftmom.h"
 #include "meas/hadron/npr_vertex_w.h"
 
+#include <cmath>
+
 namespace Chroma 
 {
 
@@ -22,170 +24,342 @@ namespace Chroma
   }
 
 
-  void BkwdFrwd(const LatticePropagator&  B,
-		const LatticePropagator&  F,
-		QDPFileWriter& qio_file,
-		int& GBB_NLinkPatterns,
-		const multi1d< int > & LinkDirs)
+  namespace
   {
-    StopWatch TotalTime;
-    TotalTime.reset();
-    TotalTime.start();
+    //! A gamma matrix as a signed permutation
+    /*!
+     * Every product of gamma matrices has exactly one non-zero element,
+     * a phase of  +-1  or  +-i, in each row.
+     */
+    struct GammaPerm_t
+    {
+      int col[Ns];     /*!< column of the non-zero element of each row */
+      int re[Ns];      /*!< its real part */
+      int im[Ns];      /*!< its imaginary part */
+    };
+
 
-    for( int i = 0; i < Ns * Ns; i ++ )
+    //! Signed permutation tables of the Ns*Ns gamma matrices
+    multi1d<GammaPerm_t> gammaPermTable()
     {
-      XMLBufferWriter record_xml;
-      push(record_xml, "Vertex");
+      multi1d<GammaPerm_t> tab(Ns*Ns);
+      SpinMatrix g_one = 1.0;
 
-      QDPIO::cout << __func__ << ": LinkDirs = " << LinkDirs 
-		  << "  gamma = " << i << std::endl;
+      for(int n=0; n < Ns*Ns; ++n)
+      {
+	SpinMatrix g = Gamma(n) * g_one;
 
-      write(record_xml, "linkDirs", LinkDirs);   // link pattern
-      write(record_xml, "gamma", i);
+	for(int a=0; a < Ns; ++a)
+	{
+	  int nz = 0;
+	  for(int b=0; b < Ns; ++b)
+	  {
+	    Real re = real(peekSpin(g,a,b));
+	    Real im = imag(peekSpin(g,a,b));
+
+	    if (toBool(re != 0) || toBool(im != 0))
+	    {
+	      tab[n].col[a] = b;
+	      tab[n].re[a] = int(std::floor(toDouble(re) + 0.5));
+	      tab[n].im[a] = int(std::floor(toDouble(im) + 0.5));
+	      ++nz;
+	    }
+	  }
+
+	  if (nz != 1)
+	  {
+	    QDPIO::cerr << __func__ << ": gamma " << n << " is not a signed permutation" << std::endl;
+	    QDP_abort(1);
+	  }
+	}
+      }
 
-      // counts number of link patterns
-      GBB_NLinkPatterns++;
+      return tab;
+    }
 
-      // assumes any Gamma5 matrices have already been absorbed
-      int G5 = Ns*Ns-1;
-      
-      // Compute the single site propagator and write it
-      DPropagator prop;
+
+#ifndef QDP_IS_QDPJIT
+    //! Number of reals in the spin blocks of B F
+    const int block_len = 2*(Ns*Nc)*(Ns*Nc);
+    const int all_len   = Ns*Ns*block_len;
+
+    //! Arguments of the vertex site loop
+    struct VertexArgs
+    {
+      const LatticePropagator& B;
+      const LatticePropagator& F;
+      const int*               tab;
+      REAL64*                  sums;   /*!< all_len partial sums per thread */
+    };
+
+    //! Local sums of the spin blocks  K_{al,be} = B[:,al] F[be,:]  over the sites [lo,hi)
+    void vertexSiteLoop(int lo, int hi, int myId, VertexArgs* a)
+    {
+      REAL64* sums = a->sums + all_len*myId;
+
+      for(int j=lo; j < hi; ++j)
       {
-	// assumes any Gamma5 matrices have already been absorbed into B
-	LatticePropagator tmp = B * Gamma(i) * F;
-	// The site's worth of data of interest
-	prop = sum(tmp)/Double(Layout::vol()); // and normalize by the volume
-	//QDPIO::cout<<"  The 1/12*trace is: "<<trace(Gamma(i)*prop)/12.0;
-	//QDPIO::cout<<std::endl ;
+	int site = a->tab[j];
+
+	for(int al=0; al < Ns; ++al)
+	  for(int be=0; be < Ns; ++be)
+	  {
+	    REAL64* k = sums + (al*Ns + be)*block_len;
+
+	    for(int s1=0; s1 < Ns; ++s1)
+	      for(int c1=0; c1 < Nc; ++c1)
+		for(int s2=0; s2 < Ns; ++s2)
+		  for(int c2=0; c2 < Nc; ++c2)
+		  {
+		    REAL64 re = 0;
+		    REAL64 im = 0;
+
+		    for(int c=0; c < Nc; ++c)
+		    {
+		      REAL64 br = a->B.elem(site).elem(s1,al).elem(c1,c).real();
+		      REAL64 bi = a->B.elem(site).elem(s1,al).elem(c1,c).imag();
+		      REAL64 fr = a->F.elem(site).elem(be,s2).elem(c,c2).real();
+		      REAL64 fi = a->F.elem(site).elem(be,s2).elem(c,c2).imag();
+
+		      re += br*fr - bi*fi;
+		      im += br*fi + bi*fr;
+		    }
+
+		    int idx = 2*((c1 + Nc*s1)*Ns*Nc + c2 + Nc*s2);
+		    k[idx]   += re;
+		    k[idx+1] += im;
+		  }
+	  }
       }
-      
-      pop(record_xml);
-
-      write(qio_file, record_xml, prop);
     }
+#endif
+
+
+    //! Volume averaged vertices  sum_x B(x) Gamma(n) F(x) / V  for all n
+    /*!
+     * The 16 spin blocks of  B F  are summed once, with one global sum,
+     * and every gamma matrix picks Ns of them with its phases. With
+     * QDP-JIT each vertex is summed on its own.
+     */
+    void vertexContract(multi1d<DPropagator>& prop,
+			const LatticePropagator& B,
+			const LatticePropagator& F,
+			const multi1d<GammaPerm_t>& gtab)
+    {
+#ifndef QDP_IS_QDPJIT
+      const int nthr = qdpNumThreads();
+      multi1d<REAL64> sums(all_len*nthr);
+      sums = 0;
 
-    TotalTime.stop();
-    QDPIO::cout << __func__ << ": total time = " << TotalTime.getTimeInSeconds() << " seconds" << std::endl;
+      VertexArgs args = {B, F, all.siteTable().slice(), sums.slice()};
+      dispatch_to_threads(all.numSiteTable(), args, vertexSiteLoop);
 
-    return;
-  }
+      for(int t=1; t < nthr; ++t)
+	for(int i=0; i < all_len; ++i)
+	  sums[i] += sums[all_len*t + i];
 
-//###################################################################################//
-// accumulate link operators                                                         //
-//###################################################################################//
+      QDPInternal::globalSumArray(sums.slice(), all_len);
 
-  void AddLinks(const LatticePropagator&  B,
-		const LatticePropagator&  F,
-		const multi1d< LatticeColorMatrix > & U,
-		multi1d< int >&    LinkDirs,
-		const int          MaxNLinks,
-		BBLinkPattern      LinkPattern,
-		const int          PreviousDir,
-		const int          PreviousMu,
-		QDPFileWriter&     qio_file,
-		int&               GBB_NLinkPatterns)
-  {
-    StopWatch Timer;
-    Timer.reset();
-    Timer.start();
+      const REAL64 norm = 1.0 / REAL64(Layout::vol());
 
-    const int NLinks = LinkDirs.size();
+      prop.resize(Ns*Ns);
+      for(int n=0; n < Ns*Ns; ++n)
+      {
+	prop[n] = zero;
 
-    if( NLinks == MaxNLinks )
-    {
-      return;
+	for(int al=0; al < Ns; ++al)
+	{
+	  const REAL64* k = sums.slice() + (al*Ns + gtab[n].col[al])*block_len;
+	  const REAL64 gr = gtab[n].re[al] * norm;
+	  const REAL64 gi = gtab[n].im[al] * norm;
+
+	  for(int s1=0; s1 < Ns; ++s1)
+	    for(int c1=0; c1 < Nc; ++c1)
+	      for(int s2=0; s2 < Ns; ++s2)
+		for(int c2=0; c2 < Nc; ++c2)
+		{
+		  int idx = 2*((c1 + Nc*s1)*Ns*Nc + c2 + Nc*s2);
+		  prop[n].elem().elem(s1,s2).elem(c1,c2).real() += gr*k[idx] - gi*k[idx+1];
+		  prop[n].elem().elem(s1,s2).elem(c1,c2).imag() += gr*k[idx+1] + gi*k[idx];
+		}
+	}
+      }
+#else
+      prop.resize(Ns*Ns);
+      for(int n=0; n < Ns*Ns; ++n)
+      {
+	LatticePropagator tmp = B * Gamma(n) * F;
+	prop[n] = sum(tmp)/Double(Layout::vol());
+      }
+#endif
     }
 
-    LatticePropagator F_mu;
-    multi1d< int > NextLinkDirs( NLinks + 1 );
 
-    for(int Link = 0; Link < NLinks; Link ++)
+    //! Write the vertices of one link pattern for all propagators
+    void BkwdFrwd(const multi1d<LatticePropagator>& B,
+		  const multi1d<LatticePropagator>& F,
+		  const multi1d<GammaPerm_t>& gtab,
+		  const multi1d<QDPFileWriter*>& qio_files,
+		  int& GBB_NLinkPatterns,
+		  const multi1d< int > & LinkDirs)
     {
-      NextLinkDirs[ Link ] = LinkDirs[ Link ];
-    }
+      StopWatch TotalTime;
+      TotalTime.reset();
+      TotalTime.start();
 
-    // add link in forward mu direction
-    for( int mu = 0; mu < Nd; mu ++ )
-    {
-      // skip the double back
-      if( ( PreviousDir != -1 ) || ( PreviousMu != mu ) )
-      {
-	bool DoThisPattern = true;
-	bool DoFurtherPatterns = true;
+      QDPIO::cout << __func__ << ": LinkDirs = " << LinkDirs << std::endl;
 
-	NextLinkDirs[ NLinks ] = mu;
+      // counts number of link patterns
+      GBB_NLinkPatterns++;
 
-	LinkPattern( DoThisPattern, DoFurtherPatterns, NextLinkDirs );
+      for(int m=0; m < F.size(); ++m)
+      {
+	// assumes any Gamma5 matrices have already been absorbed into B
+	multi1d<DPropagator> prop;
+	vertexContract(prop, B[m], F[m], gtab);
 
-	if( DoFurtherPatterns == true )
+	for( int i = 0; i < Ns * Ns; i ++ )
 	{
-	  // accumulate product of link fields
-	  F_mu = shift( adj( U[ mu ] ) * F, BACKWARD, mu );
-	}
+	  XMLBufferWriter record_xml;
+	  push(record_xml, "Vertex");
+	  write(record_xml, "linkDirs", LinkDirs);   // link pattern
+	  write(record_xml, "gamma", i);
+	  pop(record_xml);
 
-	if( DoThisPattern == true )
-	{
-	  BkwdFrwd(B, F_mu, qio_file, GBB_NLinkPatterns, NextLinkDirs);
-	}
-
-	if( DoFurtherPatterns == true )
-	{
-	  // add another link
-	  AddLinks(B, F_mu, U,
-		   NextLinkDirs, MaxNLinks, LinkPattern, 1, mu, 
-		   qio_file, GBB_NLinkPatterns);
+	  write(*qio_files[m], record_xml, prop[i]);
 	}
       }
+
+      TotalTime.stop();
+      QDPIO::cout << __func__ << ": total time = " << TotalTime.getTimeInSeconds() << " seconds" << std::endl;
+
+      return;
     }
 
-    // add link in backward mu direction
-    for( int mu = 0; mu < Nd; mu ++ )
+//###################################################################################//
+// accumulate link operators                                                         //
+//###################################################################################//
+
+    //! Walk the link patterns depth first
+    /*!
+     * The propagators displaced along a path are kept while its extensions
+     * are done, so every path prefix is built once for all momenta.
+     */
+    void AddLinks(const multi1d<LatticePropagator>&  B,
+		  const multi1d<LatticePropagator>&  F,
+		  const multi1d< LatticeColorMatrix > & U,
+		  const multi1d<GammaPerm_t>& gtab,
+		  multi1d< int >&    LinkDirs,
+		  const int          MaxNLinks,
+		  BBLinkPattern      LinkPattern,
+		  const int          PreviousDir,
+		  const int          PreviousMu,
+		  const multi1d<QDPFileWriter*>& qio_files,
+		  int&               GBB_NLinkPatterns)
     {
-      // skip the double back
-      if( ( PreviousDir != 1 ) || ( PreviousMu != mu ) )
-      {
-	bool DoThisPattern = true;
-	bool DoFurtherPatterns = true;
+      StopWatch Timer;
+      Timer.reset();
+      Timer.start();
 
-	NextLinkDirs[ NLinks ] = mu + Nd;
+      const int NLinks = LinkDirs.size();
 
-	LinkPattern( DoThisPattern, DoFurtherPatterns, NextLinkDirs );
+      if( NLinks == MaxNLinks )
+      {
+	return;
+      }
 
-	if( DoFurtherPatterns == true )
-	{
-	  // accumulate product of link fields
-	  F_mu = U[ mu ] * shift( F, FORWARD, mu );
-	}
+      multi1d<LatticePropagator> F_mu(F.size());
+      multi1d< int > NextLinkDirs( NLinks + 1 );
 
-	if( DoThisPattern == true )
+      for(int Link = 0; Link < NLinks; Link ++)
+      {
+	NextLinkDirs[ Link ] = LinkDirs[ Link ];
+      }
+
+      // add link in forward mu direction
+      for( int mu = 0; mu < Nd; mu ++ )
+      {
+	// skip the double back
+	if( ( PreviousDir != -1 ) || ( PreviousMu != mu ) )
 	{
-	  BkwdFrwd(B, F_mu, qio_file, GBB_NLinkPatterns, NextLinkDirs);
+	  bool DoThisPattern = true;
+	  bool DoFurtherPatterns = true;
+
+	  NextLinkDirs[ NLinks ] = mu;
+
+	  LinkPattern( DoThisPattern, DoFurtherPatterns, NextLinkDirs );
+
+	  if( DoThisPattern || DoFurtherPatterns )
+	  {
+	    // accumulate product of link fields
+	    for(int m=0; m < F.size(); ++m)
+	      F_mu[m] = shift( adj( U[ mu ] ) * F[m], BACKWARD, mu );
+	  }
+
+	  if( DoThisPattern == true )
+	  {
+	    BkwdFrwd(B, F_mu, gtab, qio_files, GBB_NLinkPatterns, NextLinkDirs);
+	  }
+
+	  if( DoFurtherPatterns == true )
+	  {
+	    // add another link
+	    AddLinks(B, F_mu, U, gtab,
+		     NextLinkDirs, MaxNLinks, LinkPattern, 1, mu, 
+		     qio_files, GBB_NLinkPatterns);
+	  }
 	}
+      }
 
-	if( DoFurtherPatterns == true )
+      // add link in backward mu direction
+      for( int mu = 0; mu < Nd; mu ++ )
+      {
+	// skip the double back
+	if( ( PreviousDir != 1 ) || ( PreviousMu != mu ) )
 	{
-	  // add another link
-	  AddLinks(B, F_mu, U, 
-		   NextLinkDirs, MaxNLinks, LinkPattern, -1, mu, 
-		   qio_file, GBB_NLinkPatterns);
+	  bool DoThisPattern = true;
+	  bool DoFurtherPatterns = true;
+
+	  NextLinkDirs[ NLinks ] = mu + Nd;
+
+	  LinkPattern( DoThisPattern, DoFurtherPatterns, NextLinkDirs );
+
+	  if( DoThisPattern || DoFurtherPatterns )
+	  {
+	    // accumulate product of link fields
+	    for(int m=0; m < F.size(); ++m)
+	      F_mu[m] = U[ mu ] * shift( F[m], FORWARD, mu );
+	  }
+
+	  if( DoThisPattern == true )
+	  {
+	    BkwdFrwd(B, F_mu, gtab, qio_files, GBB_NLinkPatterns, NextLinkDirs);
+	  }
+
+	  if( DoFurtherPatterns == true )
+	  {
+	    // add another link
+	    AddLinks(B, F_mu, U, gtab,
+		     NextLinkDirs, MaxNLinks, LinkPattern, -1, mu, 
+		     qio_files, GBB_NLinkPatterns);
+	  }
 	}
       }
-    }
 
-    Timer.stop();
-    QDPIO::cout << __func__ << ": total time = " << Timer.getTimeInSeconds() << " seconds" << std::endl;
+      Timer.stop();
+      QDPIO::cout << __func__ << ": total time = " << Timer.getTimeInSeconds() << " seconds" << std::endl;
 
-    return;
+      return;
+    }
   }
 
 
-  //! NPR vertices
-  void NprVertex(const LatticePropagator &             F,
+  //! NPR vertices of several propagators
+  void NprVertex(const multi1d<LatticePropagator> &    F,
 		 const multi1d< LatticeColorMatrix > & U,
 		 const unsigned short int              MaxNLinks,
 		 const BBLinkPattern                   LinkPattern,
-		 QDPFileWriter& qio_file)
+		 const multi1d<QDPFileWriter*>&        qio_files)
   {
     StopWatch TotalTime;
     TotalTime.reset();
@@ -193,27 +367,32 @@ namespace Chroma
 
     StopWatch Timer;
 
-    int GBB_NLinkPatterns;
+    int GBB_NLinkPatterns = 0;
 
-    //#################################################################################//
-    // open building blocks data files                                                 //
-    //#################################################################################//
+    if (qio_files.size() != F.size())
+    {
+      QDPIO::cerr << __func__ << ": need one file per propagator" << std::endl;
+      QDP_abort(1);
+    }
 
-    Timer.reset();
-    Timer.start();
+    const multi1d<GammaPerm_t> gtab = gammaPermTable();
 
     //#################################################################################//
     // calculate building blocks                                                       //
     //#################################################################################//
 
+    Timer.reset();
+    Timer.start();
+
     QDPIO::cout << __func__ << ": start BkwdFrwd" << std::endl;
 
-    const int NLinks = 0;
     multi1d< int > LinkDirs( 0 );
 
-    LatticePropagator B = Gamma(15)*adj(F)*Gamma(15);
-    BkwdFrwd(B, F, qio_file, GBB_NLinkPatterns, LinkDirs);
-    
+    multi1d<LatticePropagator> B(F.size());
+    for(int m=0; m < F.size(); ++m)
+      B[m] = Gamma(15)*adj(F[m])*Gamma(15);
+
+    BkwdFrwd(B, F, gtab, qio_files, GBB_NLinkPatterns, LinkDirs);
 
     Timer.stop();
     QDPIO::cout << __func__ << ": total time for 0 links (single BkwdFrwdTr call) = "
@@ -225,9 +404,9 @@ namespace Chroma
 
     QDPIO::cout << __func__ << ": start AddLinks" << std::endl;
 
-    AddLinks(B, F, U, 
+    AddLinks(B, F, U, gtab,
 	     LinkDirs, MaxNLinks, LinkPattern, 0, -1, 
-	     qio_file, GBB_NLinkPatterns);
+	     qio_files, GBB_NLinkPatterns);
 
     Timer.stop();
     QDPIO::cout << __func__ << ": total time for remaining links (outermost AddLinks call) = "
@@ -242,4 +421,21 @@ namespace Chroma
     return;
   }
 
+
+  //! NPR vertices
+  void NprVertex(const LatticePropagator &             F,
+		 const multi1d< LatticeColorMatrix > & U,
+		 const unsigned short int              MaxNLinks,
+		 const BBLinkPattern                   LinkPattern,
+		 QDPFileWriter& qio_file)
+  {
+    multi1d<LatticePropagator> FF(1);
+    FF[0] = F;
+
+    multi1d<QDPFileWriter*> files(1);
+    files[0] = &qio_file;
+
+    NprVertex(FF, U, MaxNLinks, LinkPattern, files);
+  }
+
 }  // end namespace Chroma
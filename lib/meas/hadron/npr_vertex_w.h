@@ -17,6 +17,19 @@ namespace Chroma
 				bool &                          DoFurtherPatterns,
 				multi1d< int > & LinkPattern);
 
+  //! NPR vertices of several propagators
+  /*! \ingroup hadron
+   *
+   * The propagators, typically momentum sources with different momenta,
+   * share the walk over the link patterns. The vertices of propagator m
+   * are written to qio_files[m].
+   */
+  void NprVertex(const multi1d<LatticePropagator> &    F,
+		 const multi1d< LatticeColorMatrix > & U,
+		 const unsigned short int              MaxNLinks,
+		 const BBLinkPattern                   LinkPattern,
+		 const multi1d<QDPFileWriter*>&        qio_files);
+
   //! NPR vertices
   /*! \ingroup hadron */
   void NprVertex(const LatticePropagator &             F,
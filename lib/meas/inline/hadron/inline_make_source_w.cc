@@ -17,6 +17,7 @@
 #include "meas/inline/make_xml_file.h"
 
 #include "meas/inline/io/named_objmap.h"
+#include "meas/smear/disp_prop_cache.h"
 
 namespace Chroma 
 { 
@@ -208,6 +209,15 @@ namespace Chroma
     //
     LatticePropagator quark_source;
 
+    // Derivative displacements share their paths with every source that
+    // differs only in its displacement. Random sources differ in the seed
+    XMLBufferWriter seed_xml;
+    write(seed_xml, "RNG", ran_seed);
+
+    DispPropCacheSource disp_source(dispPropSourceKey("",
+						      params.named_obj.gauge_id,
+						      params.param.source.xml + seed_xml.str()));
+
     try
     {
       std::istringstream  xml_s(params.param.source.xml);
@@ -88,7 +88,14 @@ namespace Chroma
     }
     
     read(paramtop, "links_max", input.links_max);
-    read(paramtop, "file_name", input.file_name);
+
+    if (paramtop.count("file_names") != 0)
+      read(paramtop, "file_names", input.file_names);
+    else
+    {
+      input.file_names.resize(1);
+      read(paramtop, "file_name", input.file_names[0]);
+    }
   }
 
 
@@ -100,7 +107,10 @@ namespace Chroma
     int version = 1;
     write(xml, "version", version);
     write(xml, "links_max", input.links_max);
-    write(xml, "file_name", input.file_name);    
+    if (input.file_names.size() == 1)
+      write(xml, "file_name", input.file_names[0]);    
+    else
+      write(xml, "file_names", input.file_names);    
     xml << input.cfs.xml;
 
     pop(xml);
@@ -112,7 +122,14 @@ namespace Chroma
     XMLReader inputtop(xml, path);
 
     read(inputtop, "gauge_id", input.gauge_id);
-    read(inputtop, "prop_id", input.prop_id);
+
+    if (inputtop.count("prop_ids") != 0)
+      read(inputtop, "prop_ids", input.prop_ids);
+    else
+    {
+      input.prop_ids.resize(1);
+      read(inputtop, "prop_id", input.prop_ids[0]);
+    }
   }
 
   //! Propagator output
@@ -121,7 +138,10 @@ namespace Chroma
     push(xml, path);
 
     write(xml, "gauge_id", input.gauge_id);
-    write(xml, "prop_id", input.prop_id);
+    if (input.prop_ids.size() == 1)
+      write(xml, "prop_id", input.prop_ids[0]);
+    else
+      write(xml, "prop_ids", input.prop_ids);
 
     pop(xml);
   }
@@ -147,6 +167,14 @@ namespace Chroma
       // Read in the output propagator/source configuration info
       read(paramtop, "NamedObject", named_obj);
 
+      if (named_obj.prop_ids.size() == 0 || named_obj.prop_ids.size() != param.file_names.size())
+      {
+	QDPIO::cerr << __func__ << ": need one output file per propagator, found "
+		    << named_obj.prop_ids.size() << " propagators and " 
+		    << param.file_names.size() << " files" << std::endl;
+	QDP_abort(1);
+      }
+
       // Possible alternate XML file pattern
       if (paramtop.count("xml_file") != 0) 
       {
@@ -309,79 +337,71 @@ namespace Chroma
     MesPlq(XmlOut, "Observables", U);
 
     //#################################################################################//
-    // Read Forward Propagator                                                         //
+    // Read Forward Propagators                                                        //
     //#################################################################################//
 
     SftMom phases_nomom( 0, true, Nd-1 );  // used to check props. Fix to Nd-1 direction.
 
-    LatticePropagator F;
-    ChromaProp_t prop_header;
-    PropSourceConst_t source_header;
-    QDPIO::cout << "Attempt to parse forward propagator" << std::endl;
-    QDPIO::cout << "parsing forward propagator " << params.named_obj.prop_id << " ... " << std::endl << std::flush;
+    const int n_prop = params.named_obj.prop_ids.size();
 
-    try
+    multi1d<LatticePropagator> F(n_prop);
+    multi1d<ChromaProp_t> prop_header(n_prop);
+    multi1d<PropSourceConst_t> source_header(n_prop);
+
+    for(int m=0; m < n_prop; ++m)
     {
-      // Snarf a copy
-      F = TheNamedObjMap::Instance().getData<LatticePropagator>(params.named_obj.prop_id);
-	
-      // Snarf the frwd prop info. This is will throw if the frwd prop id is not there
-      XMLReader PropXML, PropRecordXML;
-      TheNamedObjMap::Instance().get(params.named_obj.prop_id).getFileXML(PropXML);
-      TheNamedObjMap::Instance().get(params.named_obj.prop_id).getRecordXML(PropRecordXML);
+      const std::string& prop_id = params.named_obj.prop_ids[m];
 
-      // Try to invert this record XML into a ChromaProp struct
+      QDPIO::cout << "Attempt to parse forward propagator" << std::endl;
+      QDPIO::cout << "parsing forward propagator " << prop_id << " ... " << std::endl << std::flush;
+
+      try
       {
-	read(PropRecordXML, "/Propagator/ForwardProp", prop_header);
-	read(PropRecordXML, "/Propagator/PropSource", source_header);
+	// Snarf a copy
+	F[m] = TheNamedObjMap::Instance().getData<LatticePropagator>(prop_id);
+	
+	// Snarf the frwd prop info. This is will throw if the frwd prop id is not there
+	XMLReader PropXML, PropRecordXML;
+	TheNamedObjMap::Instance().get(prop_id).getFileXML(PropXML);
+	TheNamedObjMap::Instance().get(prop_id).getRecordXML(PropRecordXML);
+
+	// Try to invert this record XML into a ChromaProp struct
+	{
+	  read(PropRecordXML, "/Propagator/ForwardProp", prop_header[m]);
+	  read(PropRecordXML, "/Propagator/PropSource", source_header[m]);
+	}
+
+	// Sanity check - write out the norm2 of the forward prop in the j_decay direction
+	// Use this for any possible verification
+	{
+	  multi1d<Double> PropCheck = 
+	    sumMulti( localNorm2( F[m] ), phases_nomom.getSet() );
+
+	  QDPIO::cout << "forward propagator check = " << PropCheck[0] << std::endl;
+
+	  // Write out the forward propagator header
+	  push(XmlOut, "ForwardProp");
+	  write(XmlOut, "PropXML", PropXML);
+	  write(XmlOut, "PropRecordXML", PropRecordXML);
+	  write(XmlOut, "PropCheck", PropCheck);
+	  pop(XmlOut);
+	}
       }
-
-      // Sanity check - write out the norm2 of the forward prop in the j_decay direction
-      // Use this for any possible verification
+      catch( std::bad_cast ) 
       {
-	multi1d<Double> PropCheck = 
-	  sumMulti( localNorm2( F ), phases_nomom.getSet() );
-
-	QDPIO::cout << "forward propagator check = " << PropCheck[0] << std::endl;
-
-	// Write out the forward propagator header
-	push(XmlOut, "ForwardProp");
-	write(XmlOut, "PropXML", PropXML);
-	write(XmlOut, "PropRecordXML", PropRecordXML);
-	write(XmlOut, "PropCheck", PropCheck);
-	pop(XmlOut);
+	QDPIO::cerr << InlineNprVertexEnv::name << ": caught dynamic cast error" 
+		    << std::endl;
+	QDP_abort(1);
+      }
+      catch (const std::string& e) 
+      {
+	QDPIO::cerr << InlineNprVertexEnv::name << ": forward prop: error message: " << e 
+		    << std::endl;
+	QDP_abort(1);
       }
     }
-    catch( std::bad_cast ) 
-    {
-      QDPIO::cerr << InlineNprVertexEnv::name << ": caught dynamic cast error" 
-		  << std::endl;
-      QDP_abort(1);
-    }
-    catch (const std::string& e) 
-    {
-      QDPIO::cerr << InlineNprVertexEnv::name << ": forward prop: error message: " << e 
-		  << std::endl;
-      QDP_abort(1);
-    }
-
-    QDPIO::cout << "Forward propagator successfully parsed" << std::endl;
 
-
-    // Get the momentum from the header
-
-    multi1d<int> mom  ;
-    multi1d<int> t_src ;
-    int       t_dir = source_header.j_decay ;
-
-    try{
-      mom = source_header.getMom() ;
-      t_src = source_header.getTSrce() ;
-    }
-    catch (const std::string& e){
-      QDPIO::cerr << InlineNprVertexEnv::name << ": propagator does not have a momentum source or t_src not present: error message: " << e << std::endl;
-      QDP_abort(1);
-    }
+    QDPIO::cout << "Forward propagators successfully parsed" << std::endl;
 
 
     //#################################################################################//
@@ -389,48 +409,72 @@ namespace Chroma
     //#################################################################################//
     QDP::StopWatch swatch;
     swatch.reset();
-    
-    XMLBufferWriter file_xml;
-    push(file_xml, "NprVertex");
-    write(file_xml, "Param", params.param);
-    write(file_xml, "ForwardProp", prop_header);
-    write(file_xml, "PropSource", source_header);
-    write(file_xml, "Config", gauge_xml);
-    pop(file_xml);
 
-    QDPFileWriter qio_file(file_xml, params.param.file_name,QDPIO_SINGLEFILE, 
-			   QDPIO_SERIAL, QDPIO_OPEN); 
+    // One output file per propagator
+    multi1d<QDPFileWriter*> qio_files(n_prop);
 
+    for(int m=0; m < n_prop; ++m)
+    {
+      // Get the momentum from the header
+      multi1d<int> mom  ;
+      multi1d<int> t_src ;
+      int       t_dir = source_header[m].j_decay ;
+
+      try{
+	mom = source_header[m].getMom() ;
+	t_src = source_header[m].getTSrce() ;
+      }
+      catch (const std::string& e){
+	QDPIO::cerr << InlineNprVertexEnv::name << ": propagator does not have a momentum source or t_src not present: error message: " << e << std::endl;
+	QDP_abort(1);
+      }
 
-    //Fourier transform the propagator 
-    QDPIO::cout << "Fourier Transforming propagator" << std::endl;
-    swatch.start();
-    multi1d<int> neg_mom(mom.size());
-    //need the oposit momentum on the sink
-    for(int i(0);i<mom.size();i++)
-      neg_mom[i] = -mom[i] ;
-    DPropagator FTprop(FTpropagator(F,neg_mom,t_src));
-    swatch.stop();
-    XMLBufferWriter prop_xml;
-    push(prop_xml,"QuarkPropagator");
-    write(prop_xml,"mom",mom);
-    write(prop_xml,"origin",t_src);
-    write(prop_xml,"t_dir",t_dir);
-    pop(prop_xml) ;
-    write(qio_file, prop_xml, FTprop);
-
-    QDPIO::cout << "finished Fourier Transforming propagator"
-                << "  time= "
-                << swatch.getTimeInSeconds()
-                << " secs" << std::endl;
+      XMLBufferWriter file_xml;
+      push(file_xml, "NprVertex");
+      write(file_xml, "Param", params.param);
+      write(file_xml, "ForwardProp", prop_header[m]);
+      write(file_xml, "PropSource", source_header[m]);
+      write(file_xml, "Config", gauge_xml);
+      pop(file_xml);
+
+      qio_files[m] = new QDPFileWriter(file_xml, params.param.file_names[m], QDPIO_SINGLEFILE, 
+				       QDPIO_SERIAL, QDPIO_OPEN); 
+
+      //Fourier transform the propagator 
+      QDPIO::cout << "Fourier Transforming propagator" << std::endl;
+      swatch.reset();
+      swatch.start();
+      multi1d<int> neg_mom(mom.size());
+      //need the oposit momentum on the sink
+      for(int i(0);i<mom.size();i++)
+	neg_mom[i] = -mom[i] ;
+      DPropagator FTprop(FTpropagator(F[m],neg_mom,t_src));
+      swatch.stop();
+      XMLBufferWriter prop_xml;
+      push(prop_xml,"QuarkPropagator");
+      write(prop_xml,"mom",mom);
+      write(prop_xml,"origin",t_src);
+      write(prop_xml,"t_dir",t_dir);
+      pop(prop_xml) ;
+      write(*qio_files[m], prop_xml, FTprop);
+
+      QDPIO::cout << "finished Fourier Transforming propagator"
+		  << "  time= "
+		  << swatch.getTimeInSeconds()
+		  << " secs" << std::endl;
+    }
 
     QDPIO::cout << "Calculating building blocks" << std::endl;
     swatch.reset();
     swatch.start();
-    NprVertex(F, U, params.param.links_max, AllLinkPatterns, qio_file);
+    NprVertex(F, U, params.param.links_max, AllLinkPatterns, qio_files);
     swatch.stop();
       
-    close(qio_file);
+    for(int m=0; m < n_prop; ++m)
+    {
+      close(*qio_files[m]);
+      delete qio_files[m];
+    }
 
     QDPIO::cout << "finished calculating NprVertex"
 		<< "  time= "
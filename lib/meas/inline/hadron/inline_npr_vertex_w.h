@@ -22,7 +22,12 @@ namespace Chroma
   }
 
   //! Parameter structure
-  /*! \ingroup inlinehadron */
+  /*! \ingroup inlinehadron
+   *
+   * Either one propagator (prop_id, file_name) or several (prop_ids,
+   * file_names), e.g. momentum sources of different momenta. Several
+   * propagators share one walk over the link patterns.
+   */
   struct InlineNprVertexParams 
   {
     InlineNprVertexParams();
@@ -35,7 +40,7 @@ namespace Chroma
     struct Param_t
     {
       int          links_max;          /*!< maximum number of links */
-      std::string  file_name;          /*!< bb output file name pattern */
+      multi1d<std::string>  file_names;  /*!< output file of each propagator */
       GroupXML_t   cfs;                /*!< Fermion state */
     } param;
 
@@ -43,7 +48,7 @@ namespace Chroma
     struct NamedObject_t
     {
       std::string       gauge_id;        /*!< Input Gauge id */
-      std::string       prop_id;         /*!< Input forward prop */
+      multi1d<std::string>  prop_ids;    /*!< Input forward props, e.g. momentum sources */
     } named_obj;
 
     std::string xml_file;  // Alternate XML file pattern
@@ -14,6 +14,7 @@
 #include "util/info/unique_id.h"
 
 #include "meas/inline/io/named_objmap.h"
+#include "meas/smear/disp_prop_cache.h"
 
 namespace Chroma 
 { 
@@ -215,6 +216,12 @@ namespace Chroma
       //
       // Sink smear the propagator
       //
+      // Derivative displacements share their paths with every sink of this
+      // propagator that differs only in its displacement
+      DispPropCacheSource disp_source(dispPropSourceKey(params.named_obj.prop_id,
+							params.named_obj.gauge_id,
+							params.param.sink.xml));
+
       try
       {
 	QDPIO::cout << "Sink_xml = " << params.param.sink.xml << std::endl;
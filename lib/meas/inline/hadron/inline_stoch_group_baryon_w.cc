@@ -21,6 +21,8 @@
 #include "util/info/proginfo.h"
 #include "meas/inline/make_xml_file.h"
 #include <sstream> 
+#include <vector>
+#include <algorithm>
 
 #include "meas/inline/io/named_objmap.h"
 
@@ -756,6 +758,268 @@ namespace Chroma
     }
 
 
+    //----------------------------------------------------------------------------
+    //! Factorized contraction of three diluted quarks
+    /*!
+     * The operator of a dilution triple (i,j,k) is
+     *
+     *   O_{ijk}(p,t) = sum_{x in t} e^{ipx} eps_{abc} q0_i(x,b) q1_j(x,c) q2_k(x,a)
+     *
+     * For each time slice the site data of all dilutions are packed into
+     * dense arrays. The colour-contracted pair tensor
+     *
+     *   P_{(ij),(x,a)} = eps_{abc} q0_i(x,b) q1_j(x,c)
+     *
+     * is built once per site and the phases are folded into the third quark,
+     *
+     *   R_{(x,a),(kp)} = e^{ipx} q2_k(x,a)
+     *
+     * so that all dilutions and momenta of a time slice are one dense
+     * product O = P R over blocks of sites, followed by a single global sum.
+     * This replaces D^3 lattice-wide singlet and Fourier sweeps, each with
+     * its own global reduction, by D+D+D field reads and cache-resident
+     * small-matrix work. The colour pairing and signs match makeDiquark
+     * and makeColorSinglet.
+     *
+     * With QDP-JIT the site data cannot be read on the host, so the quarks
+     * are kept as fields and each triple is contracted with makeDiquark,
+     * makeColorSinglet and the sft of the time slice instead.
+     */
+    class BaryonContraction
+    {
+    public:
+      //! Constructor
+      /*!
+       * \param phases_       momentum phases and time slices ( Read )
+       * \param time_slices_  time slices to contract ( Read )
+       */
+      BaryonContraction(const SftMom& phases_, 
+			const multi1d<int>& time_slices_) : 
+	phases(phases_), time_slices(time_slices_)
+	{
+	  if (Nc != 3)
+	  {
+	    QDPIO::cerr << __func__ << ": baryon contractions need Nc=3" << std::endl;
+	    QDP_abort(1);
+	  }
+
+	  num_mom = phases.numMom();
+
+	  dil_sizes.resize(N_quarks);
+	  dil_sizes = 0;
+	  quarks.resize(N_quarks);
+
+#ifndef QDP_IS_QDPJIT
+	  // Offsets of the local sites of each time slice in the packed arrays
+	  site_off.resize(time_slices.size()+1);
+	  site_off[0] = 0;
+	  for(int it=0; it < time_slices.size(); ++it)
+	    site_off[it+1] = site_off[it] + phases.getSet()[time_slices[it]].numSiteTable();
+
+	  const int n_sites = site_off[time_slices.size()];
+
+	  // The phases, packed the same way
+	  phase_re.resize(num_mom * n_sites);
+	  phase_im.resize(num_mom * n_sites);
+	  for(int it=0; it < time_slices.size(); ++it)
+	  {
+	    const multi1d<int>& tab = phases.getSet()[time_slices[it]].siteTable();
+
+	    for(int p=0; p < num_mom; ++p)
+	    {
+	      const LatticeComplex& ph = phases[p];
+
+	      for(int s=0; s < tab.size(); ++s)
+	      {
+		int r = p*n_sites + site_off[it] + s;
+		phase_re[r] = ph.elem(tab[s]).elem().elem().real();
+		phase_im[r] = ph.elem(tab[s]).elem().elem().imag();
+	      }
+	    }
+	  }
+#endif
+	}
+
+      //! Set the number of dilutions of the quark in position n
+      void setDilSize(int n, int dil_size)
+      {
+	dil_sizes[n] = dil_size;
+#ifndef QDP_IS_QDPJIT
+	quarks[n].resize(2 * dil_size * site_off[time_slices.size()] * Nc);
+#else
+	quarks[n].resize(dil_size);
+#endif
+      }
+
+      //! Pack dilution d of the quark in position n
+      void setQuark(int n, int d, const multi1d<LatticeComplex>& q)
+      {
+#ifndef QDP_IS_QDPJIT
+	const int n_sites = site_off[time_slices.size()];
+	REAL64* dst = &(quarks[n][2 * d * n_sites * Nc]);
+
+	for(int it=0; it < time_slices.size(); ++it)
+	{
+	  const multi1d<int>& tab = phases.getSet()[time_slices[it]].siteTable();
+
+	  for(int s=0; s < tab.size(); ++s)
+	  {
+	    REAL64* v = dst + 2*Nc*(site_off[it] + s);
+	    for(int a=0; a < Nc; ++a)
+	    {
+	      v[2*a]   = q[a].elem(tab[s]).elem().elem().real();
+	      v[2*a+1] = q[a].elem(tab[s]).elem().elem().imag();
+	    }
+	  }
+	}
+#else
+	quarks[n][d] = q;
+#endif
+      }
+
+      //! Contract the quarks of positions 0, 1 and 2 on time slice time_slices[it]
+      /*!
+       * \param ops  operators, index ((i*D1 + j)*D2 + k)*num_mom + p ( Write )
+       * \param it   index into the time slices ( Read )
+       */
+      void contract(multi1d<DComplex>& ops, int it) const
+      {
+#ifndef QDP_IS_QDPJIT
+	const int n0 = 0;
+	const int n1 = 1;
+	const int n2 = 2;
+	const int n_sites = site_off[time_slices.size()];
+	const int D0 = dil_sizes[n0];
+	const int D1 = dil_sizes[n1];
+	const int D2 = dil_sizes[n2];
+	const int n_row = D0*D1;
+	const int n_col = D2*num_mom;
+
+	// Blocks of sites keep P within a few MB
+	const int max_block = 4*1024*1024 / (16*Nc*n_row);
+	const int block = (max_block > 0) ? max_block : 1;
+
+	std::vector<REAL64> o_re(n_row*n_col, 0.0), o_im(n_row*n_col, 0.0);
+	std::vector<REAL64> p_re, p_im, r_re, r_im;
+
+	for(int s0 = site_off[it]; s0 < site_off[it+1]; s0 += block)
+	{
+	  const int ns = std::min(block, site_off[it+1] - s0);
+	  const int n_l = ns*Nc;
+
+	  // Pair tensor P_{(ij),(s,a)}
+	  p_re.resize(n_row*n_l);
+	  p_im.resize(n_row*n_l);
+	  for(int i=0; i < D0; ++i)
+	    for(int j=0; j < D1; ++j)
+	    {
+	      const REAL64* q0 = &(quarks[n0][2*Nc*(i*n_sites + s0)]);
+	      const REAL64* q1 = &(quarks[n1][2*Nc*(j*n_sites + s0)]);
+	      REAL64* pr = &(p_re[(i*D1 + j)*n_l]);
+	      REAL64* pi = &(p_im[(i*D1 + j)*n_l]);
+
+	      for(int s=0; s < ns; ++s)
+		for(int a=0; a < Nc; ++a)
+		{
+		  const int b = 2*(s*Nc + (a+1)%Nc);
+		  const int c = 2*(s*Nc + (a+2)%Nc);
+		  pr[s*Nc+a] = (q0[b]*q1[c] - q0[b+1]*q1[c+1]) - (q0[c]*q1[b] - q0[c+1]*q1[b+1]);
+		  pi[s*Nc+a] = (q0[b]*q1[c+1] + q0[b+1]*q1[c]) - (q0[c]*q1[b+1] + q0[c+1]*q1[b]);
+		}
+	    }
+
+	  // Phased third quark R_{(s,a),(kp)}
+	  r_re.resize(n_l*n_col);
+	  r_im.resize(n_l*n_col);
+	  for(int k=0; k < D2; ++k)
+	  {
+	    const REAL64* q2 = &(quarks[n2][2*Nc*(k*n_sites + s0)]);
+
+	    for(int s=0; s < ns; ++s)
+	      for(int a=0; a < Nc; ++a)
+		for(int p=0; p < num_mom; ++p)
+		{
+		  const REAL64 er = phase_re[p*n_sites + s0 + s];
+		  const REAL64 ei = phase_im[p*n_sites + s0 + s];
+		  const int l = s*Nc + a;
+		  r_re[l*n_col + k*num_mom + p] = er*q2[2*l] - ei*q2[2*l+1];
+		  r_im[l*n_col + k*num_mom + p] = er*q2[2*l+1] + ei*q2[2*l];
+		}
+	  }
+
+	  // O += P R
+	  for(int row=0; row < n_row; ++row)
+	  {
+	    REAL64* ore = &(o_re[row*n_col]);
+	    REAL64* oim = &(o_im[row*n_col]);
+
+	    for(int l=0; l < n_l; ++l)
+	    {
+	      const REAL64 pr = p_re[row*n_l + l];
+	      const REAL64 pi = p_im[row*n_l + l];
+	      const REAL64* rr = &(r_re[l*n_col]);
+	      const REAL64* ri = &(r_im[l*n_col]);
+
+	      for(int col=0; col < n_col; ++col)
+	      {
+		ore[col] += pr*rr[col] - pi*ri[col];
+		oim[col] += pr*ri[col] + pi*rr[col];
+	      }
+	    }
+	  }
+	}
+
+	// One global sum for the whole time slice
+	QDPInternal::globalSumArray(&(o_re[0]), n_row*n_col);
+	QDPInternal::globalSumArray(&(o_im[0]), n_row*n_col);
+
+	ops.resize(n_row*n_col);
+	for(int m=0; m < n_row*n_col; ++m)
+	  ops[m] = cmplx(Double(o_re[m]), Double(o_im[m]));
+#else
+	const int D0 = dil_sizes[0];
+	const int D1 = dil_sizes[1];
+	const int D2 = dil_sizes[2];
+	const int t = time_slices[it];
+	const Subset& sub = phases.getSet()[t];
+
+	ops.resize(D0*D1*D2*num_mom);
+
+	for(int i=0; i < D0; ++i)
+	  for(int j=0; j < D1; ++j)
+	  {
+	    multi1d<LatticeComplex> diquark(Nc);
+	    makeDiquark(diquark, quarks[0][i], quarks[1][j], sub);
+
+	    for(int k=0; k < D2; ++k)
+	    {
+	      LatticeComplex singlet;
+	      makeColorSinglet(singlet, diquark, quarks[2][k], sub);
+
+	      multi2d<DComplex> sums(phases.sft(singlet, t));
+	      for(int p=0; p < num_mom; ++p)
+		ops[((i*D1 + j)*D2 + k)*num_mom + p] = sums[p][t];
+	    }
+	  }
+#endif
+      }
+
+    private:
+      const SftMom&        phases;
+      multi1d<int>         time_slices;
+      multi1d<int>         dil_sizes;
+      int                  num_mom;
+#ifndef QDP_IS_QDPJIT
+      multi1d<int>         site_off;     /*!< offsets of the time slices in the packed arrays */
+      multi1d< std::vector<REAL64> > quarks;  /*!< (dil, site, colour, re/im) per quark */
+      std::vector<REAL64>  phase_re;     /*!< (mom, site) */
+      std::vector<REAL64>  phase_im;
+#else
+      multi1d< multi1d< multi1d<LatticeComplex> > > quarks;  /*!< (dil, colour) per quark */
+#endif
+    };
+
+
     //! Baryon operator
     struct BaryonOperator_t
     {
@@ -1348,6 +1612,11 @@ namespace Chroma
 	  SmearedDispObjects smrd_disp_srcs(params.param.displacement_length,
 					    diluted_quarks, quarkSmearing, u_smr );
 
+	  // Factorized contractions on the source time slice
+	  multi1d<int> src_slices(1);
+	  src_slices[0] = participating_timeslices[t0];
+	  BaryonContraction src_contract(phases, src_slices);
+
 	  // Creation operator
 	  BaryonOperator_t  creat_oper;
 	  creat_oper.mom2_max    = 0;
@@ -1414,95 +1683,50 @@ namespace Chroma
 		keySmearedDispColorVector[n].t0 = t0;
 	      }
 
-	      for(int i = 0 ; i <  diluted_quarks[n0]->getDilSize(t0) ; ++i)
-	      {
-		for(int j = 0 ; j < diluted_quarks[n1]->getDilSize(t0) ; ++j)	      						
-		{
-
-		  keySmearedDispColorVector[0].dil = i;
-		  keySmearedDispColorVector[1].dil = j;
+	      const int D0 = diluted_quarks[n0]->getDilSize(t0);
+	      const int D1 = diluted_quarks[n1]->getDilSize(t0);
+	      const int D2 = diluted_quarks[n2]->getDilSize(t0);
 
-		  //Form the di-quark to save on recalculating 
-		  multi1d<LatticeComplex> diquark(Nc);
+	      // Pack each dilution of the three quarks once
+	      src_contract.setDilSize(0, D0);
+	      src_contract.setDilSize(1, D1);
+	      src_contract.setDilSize(2, D2);
 
-		  const multi1d<LatticeComplex> &q0 = smrd_disp_srcs.getDispSource(n0, 
-										   keySmearedDispColorVector[0]); 
+	      for(int i = 0 ; i < D0 ; ++i)
+	      {
+		keySmearedDispColorVector[0].dil = i;
+		src_contract.setQuark(0, i, smrd_disp_srcs.getDispSource(n0, keySmearedDispColorVector[0]));
+	      }
 
-		  const multi1d<LatticeComplex> &q1 = smrd_disp_srcs.getDispSource(n1, 
-										   keySmearedDispColorVector[1]);
+	      for(int j = 0 ; j < D1 ; ++j)
+	      {
+		keySmearedDispColorVector[1].dil = j;
+		src_contract.setQuark(1, j, smrd_disp_srcs.getDispSource(n1, keySmearedDispColorVector[1]));
+	      }
 
-		  /*QDPIO::cout<<"q0[0] testval= "<< peekSite(q0[0], orig)
-		    << std::endl; 
+	      for(int k = 0 ; k < D2 ; ++k)
+	      {
+		keySmearedDispColorVector[2].dil = k;
+		src_contract.setQuark(2, k, smrd_disp_srcs.getDispSource(n2, keySmearedDispColorVector[2]));
+	      }
 
-		    QDPIO::cout<<"q1[0] testval= "<< peekSite(q1[0], orig)
-		    << std::endl; 
+	      // Contract all dilution triples and momenta on the source time slice.
+	      // NOTE: the creation operator only lives on a time slice
+	      watch.reset();
+	      watch.start();
 
-		  */
+	      multi1d<DComplex> c_ops;
+	      src_contract.contract(c_ops, 0);
 
-		  watch.reset();
-		  watch.start();
-		  //For the source, restrict this operation to a subset
-		  makeDiquark( diquark, q0 , q1, phases.getSet()[ participating_timeslices[t0] ] ); 
-		  watch.stop();
+	      watch.stop();
 
-		  /*QDPIO::cout<< " Made diquark : time = " << 
-		    watch.getTimeInSeconds() << "secs" << std::endl;
-		  */		
+	      // Unpack into separate momentum and correlator
+	      const int num_mom = phases.numMom();
 
-		  for(int k = 0 ; k < diluted_quarks[n2]->getDilSize(t0) ; ++k)	
+	      for(int i = 0 ; i < D0 ; ++i)
+		for(int j = 0 ; j < D1 ; ++j)
+		  for(int k = 0 ; k < D2 ; ++k)
 		  {
-
-		    keySmearedDispColorVector[2].dil = k;
-
-		    // Contract over color indices with antisym tensor.
-		    // NOTE: the creation operator only lives on a time slice, so restrict
-		    // the operation to that time slice
-
-		    LatticeComplex c_oper;
-
-		    const multi1d<LatticeComplex> &q2 = smrd_disp_srcs.getDispSource(n2, 
-										     keySmearedDispColorVector[2]);
-
-		    /*QDPIO::cout<<"q2[0] testval= "<< peekSite(q2[0], orig)
-		      << std::endl; 
-		    */
-		    watch.reset();
-		    watch.start();
-
-		    makeColorSinglet( c_oper, diquark, q2, phases.getSet()[ 
-					participating_timeslices[t0] ] );
-
-		    watch.stop();
-
-		    /*QDPIO::cout<< "Made Color singlet : time =  " <<  
-		      watch.getTimeInSeconds() << "secs" << std::endl;
-		    */	
-		    /*QDPIO::cout << "testval = " << peekSite(c_oper, orig) 
-		      << std::endl;
-		    */	
-		    // Slow fourier-transform
-		    // We can restrict what the FT routine requires to a subset.
-		    watch.reset();
-		    watch.start();
-
-		    /*
-		      multi2d<DComplex> c_sum(phases.sft(c_oper, 
-		      participating_timeslices[t0] ));
-		    */
-
-		    multi2d<DComplex> c_sum;
-		    int num_mom;
-
-		    c_sum = phases.sft(c_oper, participating_timeslices[t0]);
-		    num_mom = phases.numMom();
-			
-		    watch.stop();
-
-		    /*QDPIO::cout << " Spatial sums completed: time = " << 
-		      watch.getTimeInSeconds() << "secs " << std::endl;
-		    */
-		    // Unpack into separate momentum and correlator
-
 		    cop.dilutions(i,j,k).mom_projs.resize(num_mom);
 
 		    for(int mom_num = 0 ; mom_num < num_mom ; ++mom_num) 
@@ -1512,13 +1736,10 @@ namespace Chroma
 
 		      cop.dilutions(i,j,k).mom_projs[mom_num].op.resize(1);
 
-		      cop.dilutions(i,j,k).mom_projs[mom_num].op[ 0 ] = c_sum[mom_num][ 
-			participating_timeslices[t0] ];
+		      cop.dilutions(i,j,k).mom_projs[mom_num].op[ 0 ] = 
+			c_ops[((i*D1 + j)*D2 + k)*num_mom + mom_num];
 		    }
-
-		  } // end for k
-		} // end for j
-	      } // end for i
+		  }
 	    }//end ord 
 
 	    swiss.stop();
@@ -1646,6 +1867,12 @@ namespace Chroma
 	  SmearedDispObjects smrd_disp_snks(params.param.displacement_length,
 					    diluted_quarks, quarkSmearing, u_smr );
 
+	  // Factorized contractions on all time slices
+	  multi1d<int> snk_slices(phases.numSubsets());
+	  for(int t = 0 ; t < snk_slices.size() ; ++t)
+	    snk_slices[t] = t;
+	  BaryonContraction snk_contract(phases, snk_slices);
+
 
 	  // Annihilation operator
 	  BaryonOperator_t  annih_oper;
@@ -1715,106 +1942,67 @@ namespace Chroma
 		keySmearedDispColorVector[n].t0 = t0;
 	      }
 
-	      for(int i = 0 ; i <  diluted_quarks[n0]->getDilSize(t0) ; ++i)
-	      {
-		for(int j = 0 ; j < diluted_quarks[n1]->getDilSize(t0) ; ++j)	      
-		{
-
-		  keySmearedDispColorVector[0].dil = i;
-		  keySmearedDispColorVector[1].dil = j;
-
-		  //Form the di-quark to save on recalculating 
-		  multi1d<LatticeComplex> diquark(Nc);
-
-		  const multi1d<LatticeComplex> &q0 = smrd_disp_snks.getDispSolution(n0, 
-										     keySmearedDispColorVector[0]); 
-
-		  const multi1d<LatticeComplex> &q1 = smrd_disp_snks.getDispSolution(n1, 
-										     keySmearedDispColorVector[1]);
-
-
-		  //QDPIO::cout<<"q0[0] testval= "<< peekSite(q0[0], orig)
-		  //	<< std::endl; 
+	      const int D0 = diluted_quarks[n0]->getDilSize(t0);
+	      const int D1 = diluted_quarks[n1]->getDilSize(t0);
+	      const int D2 = diluted_quarks[n2]->getDilSize(t0);
 
-		  //QDPIO::cout<<"q1[0] testval= "<< peekSite(q1[0], orig)
-		  //	<< std::endl; 
+	      // Pack each dilution of the three quarks once
+	      snk_contract.setDilSize(0, D0);
+	      snk_contract.setDilSize(1, D1);
+	      snk_contract.setDilSize(2, D2);
 
+	      for(int i = 0 ; i < D0 ; ++i)
+	      {
+		keySmearedDispColorVector[0].dil = i;
+		snk_contract.setQuark(0, i, smrd_disp_snks.getDispSolution(n0, keySmearedDispColorVector[0]));
+	      }
 
-		  watch.reset();
-		  watch.start();
+	      for(int j = 0 ; j < D1 ; ++j)
+	      {
+		keySmearedDispColorVector[1].dil = j;
+		snk_contract.setQuark(1, j, smrd_disp_snks.getDispSolution(n1, keySmearedDispColorVector[1]));
+	      }
 
-		  makeDiquark( diquark, q0 , q1, all ); 
+	      for(int k = 0 ; k < D2 ; ++k)
+	      {
+		keySmearedDispColorVector[2].dil = k;
+		snk_contract.setQuark(2, k, smrd_disp_snks.getDispSolution(n2, keySmearedDispColorVector[2]));
+	      }
 
-		  watch.stop();
-		  /*QDPIO::cout << "Made diquark: time = " << 
-		    watch.getTimeInSeconds() << "secs " << std::endl;
-		  */
+	      const int num_mom = phases.numMom();
+	      const int Lt = phases.numSubsets();
 
-		  for(int k = 0 ; k < diluted_quarks[n2]->getDilSize(t0) ; ++k)	
+	      for(int i = 0 ; i < D0 ; ++i)
+		for(int j = 0 ; j < D1 ; ++j)
+		  for(int k = 0 ; k < D2 ; ++k)
 		  {
-
-		    keySmearedDispColorVector[2].dil = k;
-
-		    // Contract over color indices with antisym tensor.
-		    // There is a potential optimization here - the colorcontract of
-		    // the first two quarks could be pulled outside the innermost dilution
-		    // loop.
-		    // NOTE: the creation operator only lives on a time slice, so restrict
-		    // the operation to that time slice
-
-		    LatticeComplex a_oper;
-
-		    const multi1d<LatticeComplex> &q2 = smrd_disp_snks.getDispSolution(n2, 
-										       keySmearedDispColorVector[2]);
-
-		    //QDPIO::cout<<"q2[0] testval= "<< peekSite(q2[0], orig)
-		    //<< std::endl;
-
-		    watch.reset();
-		    watch.start();
-
-		    makeColorSinglet( a_oper, diquark, q2, all);
-
-		    watch.stop();
-
-		    /*
-		      QDPIO::cout <<	"Made Color Singlet: time = " <<
-		      watch.getTimeInSeconds() << "secs" << std::endl;
-		    */
-		    /*QDPIO::cout << "testval = " << peekSite(a_oper, orig) 
-		      << std::endl;
-		    */
-
-		    watch.reset();
-		    watch.start();
-
-		    // Slow fourier-transform
-		    multi2d<DComplex> a_sum;
-		    int num_mom;
-
-		    a_sum = phases.sft(
-		      a_oper);
-		    num_mom = phases.numMom();
-
-		    watch.stop();
-		    /*
-		      QDPIO::cout << "Spatial Sums completed: time " << 
-		      watch.getTimeInSeconds() << "secs" << std::endl;
-		    */		
-		    // Unpack into separate momentum and correlator
 		    aop.dilutions(i,j,k).mom_projs.resize(num_mom);
 
 		    for(int mom_num = 0 ; mom_num < num_mom ; ++mom_num) 
 		    {
 		      aop.dilutions(i,j,k).mom_projs[mom_num].mom = params.param.moms[mom_num];
+		      aop.dilutions(i,j,k).mom_projs[mom_num].op.resize(Lt);
+		    }
+		  }
 
-		      aop.dilutions(i,j,k).mom_projs[mom_num].op = a_sum[mom_num];
+	      // Contract all dilution triples and momenta one time slice at a time
+	      watch.reset();
+	      watch.start();
 
-		    }
+	      multi1d<DComplex> a_ops;
+	      for(int t = 0 ; t < Lt ; ++t)
+	      {
+		snk_contract.contract(a_ops, t);
+
+		for(int i = 0 ; i < D0 ; ++i)
+		  for(int j = 0 ; j < D1 ; ++j)
+		    for(int k = 0 ; k < D2 ; ++k)
+		      for(int mom_num = 0 ; mom_num < num_mom ; ++mom_num) 
+			aop.dilutions(i,j,k).mom_projs[mom_num].op[t] = 
+			  a_ops[((i*D1 + j)*D2 + k)*num_mom + mom_num];
+	      }
 
-		  } // end for k
-		} // end for j
-	      } // end for i
+	      watch.stop();
 	    }//end ord 
 	    swiss.stop();
 
@@ -13,6 +13,8 @@
 #include "util/info/unique_id.h"
 #include "actions/ferm/fermacts/fermact_factory_s.h"
 #include "actions/ferm/fermacts/fermacts_aggregate_s.h"
+#include "actions/ferm/qprop/eoprec_staggered_multi_qprop.h"
+#include "util/ferm/transf.h"
 #include "meas/inline/make_xml_file.h"
 
 #include "meas/inline/io/named_objmap.h"
@@ -26,7 +28,16 @@ namespace Chroma
     
     read(inputtop, "gauge_id", input.gauge_id);
     read(inputtop, "source_id", input.source_id);
-    read(inputtop, "prop_id", input.prop_id);
+
+    // The multi-mass mode names one propagator per mass
+    if (inputtop.count("prop_ids") != 0)
+    {
+      read(inputtop, "prop_ids", input.prop_ids);
+      if (inputtop.count("prop_id") != 0)
+	read(inputtop, "prop_id", input.prop_id);
+    }
+    else
+      read(inputtop, "prop_id", input.prop_id);
   }
 
   //! Propagator output
@@ -36,7 +47,10 @@ namespace Chroma
 
     write(xml, "gauge_id", input.gauge_id);
     write(xml, "source_id", input.source_id);
-    write(xml, "prop_id", input.prop_id);
+    if (input.prop_ids.size() > 0)
+      write(xml, "prop_ids", input.prop_ids);
+    else
+      write(xml, "prop_id", input.prop_id);
 
     pop(xml);
   }
@@ -54,6 +68,96 @@ namespace Chroma
 
       //! Local registration flag
       bool registered = false;
+
+
+      //! Propagators of several masses from one multishift solve per source colour
+      void multiMassProp(const multi1d<std::string>& prop_ids,
+			 XMLWriter& xml_out,
+			 const LatticeStaggeredPropagator& q_src,
+			 const StaggeredTypeFermAct<LatticeStaggeredFermion,
+			 multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> >& S_f,
+			 Handle< FermState<LatticeStaggeredFermion,
+			 multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state,
+			 const multi1d<Real>& masses,
+			 const GroupXML_t& invParam,
+			 QuarkSpinType quarkSpinType,
+			 int& ncg_had)
+      {
+	typedef LatticeStaggeredFermion      T;
+	typedef multi1d<LatticeColorMatrix>  P;
+	typedef multi1d<LatticeColorMatrix>  Q;
+
+	const EvenOddStaggeredTypeFermAct<T,P,Q>* S_eo = 
+	  dynamic_cast<const EvenOddStaggeredTypeFermAct<T,P,Q>*>(&S_f);
+
+	if (S_eo == 0)
+	{
+	  QDPIO::cerr << __func__ << ": the multi-mass mode needs an even-odd staggered action" << std::endl;
+	  QDP_abort(1);
+	}
+
+	// The masses are solved together by the multishift CG
+	if (invParam.id != "CG_INVERTER")
+	{
+	  QDPIO::cerr << __func__ << ": the multi-mass mode needs invType = CG_INVERTER, found "
+		      << invParam.id << std::endl;
+	  QDP_abort(1);
+	}
+
+	if (quarkSpinType != QUARK_SPIN_TYPE_FULL)
+	{
+	  QDPIO::cerr << __func__ << ": the multi-mass mode only supports quarkSpinType = FULL" << std::endl;
+	  QDP_abort(1);
+	}
+
+	std::istringstream  is(invParam.xml);
+	XMLReader  paramtop(is);
+	SysSolverCGParams cg_params(paramtop, invParam.path);
+
+	EvenOddFermActMultiQprop<T,P,Q> qprop(*S_eo, state, masses, cg_params);
+
+	push(xml_out, "MultiMassQuarkProp");
+	ncg_had = 0;
+
+	for(int color_source = 0; color_source < Nc; ++color_source)
+	{
+	  QDPIO::cout << "multi-mass quarkprop_s:: doing color  : " << color_source << std::endl;
+
+	  LatticeStaggeredFermion chi;
+	  PropToFerm(q_src, chi, color_source);
+
+	  // Normalize the source to avoid overflows or underflows
+	  Real fact = 1.0;
+	  Real nrm = sqrt(norm2(chi));
+	  if (toFloat(nrm) != 0.0)
+	    fact /= nrm;
+
+	  chi *= fact;
+
+	  // All masses at once
+	  multi1d<LatticeStaggeredFermion> psi;
+	  SystemSolverResults_t result = qprop(psi, chi);
+	  ncg_had += result.n_count;
+
+	  push(xml_out,"Qprop");
+	  write(xml_out, "color_source", color_source);
+	  write(xml_out, "n_count", result.n_count);
+	  write(xml_out, "resid", result.resid);
+	  pop(xml_out);
+
+	  // Unnormalize and move the solutions into the propagators
+	  fact = Real(1) / fact;
+	  for(int i=0; i < psi.size(); ++i)
+	  {
+	    psi[i] *= fact;
+	    FermToProp(psi[i], 
+		       TheNamedObjMap::Instance().getData<LatticeStaggeredPropagator>(prop_ids[i]),
+		       color_source);
+	  }
+	}
+
+	pop(xml_out);
+      }
     }
 
     const std::string name = "PROPAGATOR_STAG";
@@ -89,9 +193,19 @@ namespace Chroma
 	// Parameters for source construction
 	read(paramtop, "Param", param);
 
+	// Optional multi-mass mode
+	if (paramtop.count("Masses") != 0)
+	  read(paramtop, "Masses", masses);
+
 	// Read in the output propagator/source configuration info
 	read(paramtop, "NamedObject", named_obj);
 
+	if (masses.size() != named_obj.prop_ids.size())
+	{
+	  QDPIO::cerr << __func__ << ": need one prop_id in prop_ids for each of the Masses" << std::endl;
+	  QDP_abort(1);
+	}
+
 	// Possible alternate XML file pattern
 	if (paramtop.count("xml_file") != 0) 
 	{
@@ -112,6 +226,8 @@ namespace Chroma
       push(xml_out, path);
     
       write(xml_out, "Param", param);
+      if (masses.size() > 0)
+	write(xml_out, "Masses", masses);
       write(xml_out, "NamedObject", named_obj);
 
       pop(xml_out);
@@ -290,9 +406,20 @@ namespace Chroma
       // terminology is that a propagator is a matrix in color
       // and spin space
       //
+      // One propagator, or one per mass in the multi-mass mode
+      multi1d<std::string> prop_ids;
+      if (params.masses.size() > 0)
+	prop_ids = params.named_obj.prop_ids;
+      else
+      {
+	prop_ids.resize(1);
+	prop_ids[0] = params.named_obj.prop_id;
+      }
+
       try
       {
-	TheNamedObjMap::Instance().create<LatticeStaggeredPropagator>(params.named_obj.prop_id);
+	for(int i=0; i < prop_ids.size(); ++i)
+	  TheNamedObjMap::Instance().create<LatticeStaggeredPropagator>(prop_ids[i]);
       }
       catch (std::bad_cast)
       {
@@ -306,9 +433,6 @@ namespace Chroma
 	QDP_abort(1);
       }
 
-      // Cast should be valid now
-      LatticeStaggeredPropagator& quark_propagator = 
-	TheNamedObjMap::Instance().getData<LatticeStaggeredPropagator>(params.named_obj.prop_id);
       int ncg_had = 0;
 
       //
@@ -348,13 +472,32 @@ namespace Chroma
 
 	  QDPIO::cout << "Suitable factory found: compute the quark prop" << std::endl;
 	  swatch.start();
-	  S_f->quarkProp(quark_propagator, 
-			 xml_out, 
-			 quark_prop_source,
-			 state, 
-			 params.param.invParam, 
-			 params.param.quarkSpinType,
-			 ncg_had);
+	  if (params.masses.size() == 0)
+	  {
+	    // Cast should be valid now
+	    LatticeStaggeredPropagator& quark_propagator = 
+	      TheNamedObjMap::Instance().getData<LatticeStaggeredPropagator>(prop_ids[0]);
+
+	    S_f->quarkProp(quark_propagator, 
+			   xml_out, 
+			   quark_prop_source,
+			   state, 
+			   params.param.invParam, 
+			   params.param.quarkSpinType,
+			   ncg_had);
+	  }
+	  else
+	  {
+	    multiMassProp(prop_ids, 
+			  xml_out, 
+			  quark_prop_source, 
+			  *S_f, 
+			  state, 
+			  params.masses, 
+			  params.param.invParam, 
+			  params.param.quarkSpinType,
+			  ncg_had);
+	  }
 	  swatch.stop();
 	  QDPIO::cout << "Propagator computed: time= " 
 		      << swatch.getTimeInSeconds() 
@@ -385,12 +528,20 @@ namespace Chroma
 	// Initialize the slow Fourier transform phases
 	SftMom phases(0, true, Nd-1);
 
-	multi1d<Double> prop_corr = sumMulti(localNorm2(quark_propagator), 
-					     phases.getSet());
+	for(int i=0; i < prop_ids.size(); ++i)
+	{
+	  const LatticeStaggeredPropagator& quark_propagator = 
+	    TheNamedObjMap::Instance().getData<LatticeStaggeredPropagator>(prop_ids[i]);
 
-	push(xml_out, "Prop_correlator");
-	write(xml_out, "prop_corr", prop_corr);
-	pop(xml_out);
+	  multi1d<Double> prop_corr = sumMulti(localNorm2(quark_propagator), 
+					       phases.getSet());
+
+	  push(xml_out, "Prop_correlator");
+	  if (params.masses.size() > 0)
+	    write(xml_out, "Mass", params.masses[i]);
+	  write(xml_out, "prop_corr", prop_corr);
+	  pop(xml_out);
+	}
       }
 
 
@@ -399,35 +550,43 @@ namespace Chroma
       {
 	QDPIO::cout << "Start writing propagator info" << std::endl;
 
-	XMLBufferWriter file_xml;
-	push(file_xml, "propagator");
-	write(file_xml, "id", uniqueId());  // NOTE: new ID form
-	pop(file_xml);
-
-	XMLBufferWriter record_xml;
-	if (make_sourceP)
-	{
-	  XMLReader xml_tmp(source_record_xml, "/MakeSource");
-
-	  push(record_xml, "Propagator");
-	  write(record_xml, "ForwardProp", params.param);
-	  record_xml << xml_tmp;  // write out all the stuff under MakeSource
-	  pop(record_xml);
-	} 
-	else if (seqsourceP)
+	for(int i=0; i < prop_ids.size(); ++i)
 	{
-	  XMLReader xml_tmp(source_record_xml, "/SequentialSource");
-
-	  push(record_xml, "SequentialProp");
-	  write(record_xml, "SeqProp", params.param);
-	  record_xml << xml_tmp;  // write out all the stuff under SequentialSource
-	  pop(record_xml);
+	  XMLBufferWriter file_xml;
+	  push(file_xml, "propagator");
+	  write(file_xml, "id", uniqueId());  // NOTE: new ID form
+	  pop(file_xml);
+
+	  // In the multi-mass mode the mass replaces the one of the action
+	  XMLBufferWriter record_xml;
+	  if (make_sourceP)
+	  {
+	    XMLReader xml_tmp(source_record_xml, "/MakeSource");
+
+	    push(record_xml, "Propagator");
+	    write(record_xml, "ForwardProp", params.param);
+	    if (params.masses.size() > 0)
+	      write(record_xml, "Mass", params.masses[i]);
+	    record_xml << xml_tmp;  // write out all the stuff under MakeSource
+	    pop(record_xml);
+	  } 
+	  else if (seqsourceP)
+	  {
+	    XMLReader xml_tmp(source_record_xml, "/SequentialSource");
+
+	    push(record_xml, "SequentialProp");
+	    write(record_xml, "SeqProp", params.param);
+	    if (params.masses.size() > 0)
+	      write(record_xml, "Mass", params.masses[i]);
+	    record_xml << xml_tmp;  // write out all the stuff under SequentialSource
+	    pop(record_xml);
+	  }
+
+	  // Write the propagator xml info
+	  TheNamedObjMap::Instance().get(prop_ids[i]).setFileXML(file_xml);
+	  TheNamedObjMap::Instance().get(prop_ids[i]).setRecordXML(record_xml);
 	}
 
-	// Write the propagator xml info
-	TheNamedObjMap::Instance().get(params.named_obj.prop_id).setFileXML(file_xml);
-	TheNamedObjMap::Instance().get(params.named_obj.prop_id).setRecordXML(record_xml);
-
 	QDPIO::cout << "Propagator successfully updated" << std::endl;
       }
       catch (std::bad_cast)
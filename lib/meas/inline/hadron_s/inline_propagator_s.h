@@ -31,12 +31,14 @@ namespace Chroma
       unsigned long     frequency;
 
       ChromaProp_t      param;
+      multi1d<Real>     masses;    /*!< optional multi-mass mode: one propagator per mass */
 
       struct NamedObject_t
       {
 	std::string     gauge_id;
 	std::string     source_id;
 	std::string     prop_id;
+	multi1d<std::string> prop_ids;  /*!< propagators of the multi-mass mode */
       } named_obj;
 
       std::string xml_file;  // Alternate XML file pattern
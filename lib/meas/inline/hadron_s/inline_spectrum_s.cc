@@ -1806,6 +1806,9 @@ namespace Chroma {
       QDPIO::cout << "Setting up second inverter for nondegen\n" ;
 
       // create second inverter for different mass
+      // The second action has its own XML and may differ from the first
+      // beyond the mass, so it is not folded into a multishift solve.
+      // Several masses of one action are done by PROPAGATOR_STAG with Masses.
       XMLReader fermact_reader2 ;
       try{
 	std::istringstream is(params.param.fermact2.xml);
@@ -28,5 +28,6 @@
 #include "meas/inline/smear/smear.h"
 
 #include "meas/inline/make_xml_file.h"
+#include "meas/inline/inline_schedule.h"
 
 #endif
@@ -0,0 +1,196 @@
+/*! \file
+ * \brief Named object dependencies of a list of inline measurements
+ */
+
+#include "meas/inline/inline_schedule.h"
+#include "named_obj.h"
+
+#include <cctype>
+#include <map>
+
+namespace Chroma
+{
+  namespace
+  {
+    //! Whitespace separated words of the text (not the tags) of an xml document
+    void textWords(std::set<std::string>& words, const std::string& doc)
+    {
+      bool in_tag = false;
+      std::string word;
+
+      for(std::string::size_type i=0; i < doc.size(); ++i)
+      {
+	char c = doc[i];
+
+	if (c == '<' || c == '>' || isspace(c))
+	{
+	  if (! in_tag && word.size() > 0)
+	    words.insert(word);
+
+	  word.clear();
+
+	  if (c == '<') in_tag = true;
+	  if (c == '>') in_tag = false;
+	}
+	else if (! in_tag)
+	  word += c;
+      }
+
+      if (! in_tag && word.size() > 0)
+	words.insert(word);
+    }
+
+
+    //! Words of the xml at the current context
+    void contextWords(std::set<std::string>& words, XMLReader& xml)
+    {
+      std::ostringstream os;
+      xml.print(os);
+      textWords(words, os.str());
+    }
+  }
+
+
+  // Build the schedule
+  InlineMeasurementSchedule::InlineMeasurementSchedule(XMLReader& xml, const std::string& path)
+  {
+    START_CODE();
+
+    XMLReader list(xml, path);
+    const int N = list.count("elem");
+
+    names.resize(N);
+    deps.resize(N);
+    frees.resize(N);
+    firsts.resize(N);
+
+    // Named objects and all words of each measurement
+    std::vector< std::set<std::string> > ids(N);
+    std::vector< std::set<std::string> > words(N);
+
+    for(int m=0; m < N; ++m)
+    {
+      std::ostringstream elem;
+      elem << "elem[" << (m+1) << "]";
+      XMLReader meas(list, elem.str());
+
+      read(meas, "Name", names[m]);
+      contextWords(words[m], meas);
+
+      if (meas.count("NamedObject") > 0)
+      {
+	XMLReader named_obj(meas, "NamedObject");
+	contextWords(ids[m], named_obj);
+      }
+    }
+
+    // Creator and last user of each named object
+    std::map<std::string, int> creator;
+    std::map<std::string, int> last_user;
+
+    for(int m=0; m < N; ++m)
+    {
+      for(std::set<std::string>::const_iterator id=ids[m].begin(); id != ids[m].end(); ++id)
+      {
+	std::map<std::string, int>::const_iterator prev = last_user.find(*id);
+	if (prev != last_user.end())
+	  deps[m].insert(prev->second);
+	else
+	  creator[*id] = m;
+
+	last_user[*id] = m;
+      }
+    }
+
+    // An object is free once no later measurement mentions it
+    for(std::map<std::string, int>::const_iterator c=creator.begin(); c != creator.end(); ++c)
+    {
+      const std::string& id = c->first;
+
+      int last = c->second;
+      for(int m=N-1; m > c->second; --m)
+      {
+	if (words[m].count(id) > 0)
+	{
+	  last = m;
+	  break;
+	}
+      }
+
+      // Never consumed
+      if (last == c->second)
+	continue;
+
+      frees[last].push_back(id);
+      firsts[c->second].push_back(id);
+    }
+
+    END_CODE();
+  }
+
+
+  // Note which objects measurement m creates
+  void InlineMeasurementSchedule::prepare(int m)
+  {
+    // Objects already there were made outside the list and are kept
+    for(int i=0; i < firsts[m].size(); ++i)
+    {
+      const std::string& id = firsts[m][i];
+
+      if (! TheNamedObjMap::Instance().check(id))
+	owned.insert(id);
+    }
+  }
+
+
+  // Erase the named objects no longer needed once measurement m has run
+  void InlineMeasurementSchedule::release(int m)
+  {
+    for(int i=0; i < frees[m].size(); ++i)
+    {
+      const std::string& id = frees[m][i];
+
+      if (owned.count(id) == 0)
+	continue;
+
+      owned.erase(id);
+
+      if (TheNamedObjMap::Instance().check(id))
+      {
+	QDPIO::cout << "InlineMeasurementSchedule: free " << id << " ("
+		    << TheNamedObjMap::Instance().getMemory(id) << " bytes/node)" << std::endl;
+
+	TheNamedObjMap::Instance().erase(id);
+      }
+    }
+  }
+
+
+  // Print the schedule
+  void InlineMeasurementSchedule::print() const
+  {
+    QDPIO::cout << "Inline measurement schedule:" << std::endl;
+
+    for(int m=0; m < size(); ++m)
+    {
+      QDPIO::cout << "  " << m << ": " << names[m];
+
+      if (deps[m].size() > 0)
+      {
+	QDPIO::cout << "   after";
+	for(std::set<int>::const_iterator d=deps[m].begin(); d != deps[m].end(); ++d)
+	  QDPIO::cout << " " << *d;
+      }
+
+      if (frees[m].size() > 0)
+      {
+	QDPIO::cout << "   frees";
+	for(int i=0; i < frees[m].size(); ++i)
+	  QDPIO::cout << " " << frees[m][i];
+      }
+
+      QDPIO::cout << std::endl;
+    }
+  }
+
+}
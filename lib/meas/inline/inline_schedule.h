@@ -0,0 +1,66 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Named object dependencies of a list of inline measurements
+ */
+
+#ifndef __inline_schedule_h__
+#define __inline_schedule_h__
+
+#include "chromabase.h"
+#include <set>
+#include <vector>
+
+namespace Chroma
+{
+  //! Named object dependencies of a list of inline measurements
+  /*! \ingroup inline
+   *
+   * The schedule is built from the XML of the measurements. The ids in the
+   * NamedObject group of each measurement are its named objects; an object
+   * is created by the first measurement naming it and consumed by the later
+   * ones. A measurement depends on the measurements that created or last
+   * used one of its objects.
+   *
+   * An object created and consumed within the list is freed right after its
+   * last consumer, so that the footprint of a long list stays at what the
+   * running measurement needs. The last consumer is decided on the text of
+   * the whole XML of the remaining measurements, not just their NamedObject
+   * groups, so an object is never freed while a later measurement mentions
+   * its id anywhere. Objects the list never consumes are left alone, and
+   * so are objects that already existed when their first measurement ran,
+   * e.g. the default gauge field; only what the list itself created is
+   * ever erased.
+   */
+  class InlineMeasurementSchedule
+  {
+  public:
+    //! Build the schedule
+    /*!
+     * \param xml     reader of the measurement list        ( Read )
+     * \param path    path of the measurement list          ( Read )
+     */
+    InlineMeasurementSchedule(XMLReader& xml, const std::string& path);
+
+    //! Number of measurements
+    int size() const {return names.size();}
+
+    //! Note which objects measurement m creates; call before it runs
+    void prepare(int m);
+
+    //! Erase the named objects no longer needed once measurement m has run
+    void release(int m);
+
+    //! Print the schedule
+    void print() const;
+
+  private:
+    std::vector<std::string>                names;  /*!< measurement names */
+    std::vector< std::set<int> >            deps;   /*!< dependencies */
+    std::vector< std::vector<std::string> > frees;  /*!< ids to free after each measurement */
+    std::vector< std::vector<std::string> > firsts; /*!< ids of frees first named by each measurement */
+    std::set<std::string>                   owned;  /*!< ids created while running the list */
+  };
+
+}
+
+#endif
@@ -15,6 +15,7 @@
 #include "util/ferm/eigeninfo.h"
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_prop_colorvec.h"
+#include "io/compressed_io.h"
 #include "handle.h"
 #include "actions/ferm/invert/containers.h"
 
@@ -423,6 +424,76 @@ namespace Chroma
 	}
 
 
+#ifndef QDP_IS_QDPJIT
+	//------------------------------------------------------------------------
+	//! Read a propagator with 16 bit mantissas
+	class QIOReadLatPropCompressed : public QIOReadObject
+	{
+	private:
+	  Params params;
+
+	public:
+	  QIOReadLatPropCompressed(const Params& p) : params(p) {}
+
+	  //! Read a propagator
+	  void operator()(QDP_serialparallel_t serpar) {
+	    multi1d<LatticeInteger> obj;
+	    XMLReader file_xml;
+	    XMLBufferWriter obj_record_xml;
+
+	    QDPFileReader to(file_xml,params.file.file_name,serpar);
+	    readCompressed(to, obj_record_xml, obj, "LatticePropagator");
+	    close(to);
+
+	    TheNamedObjMap::Instance().create<LatticePropagator>(params.named_obj.object_id);
+	    decompress(TheNamedObjMap::Instance().getData<LatticePropagator>(params.named_obj.object_id), obj);
+	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setFileXML(file_xml);
+	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setRecordXML(obj_record_xml);
+	  }
+	};
+
+	// Call back
+	QIOReadObject* qioReadLatPropCompressed(const Params& p)
+	{
+	  return new QIOReadLatPropCompressed(p);
+	}
+
+
+	//------------------------------------------------------------------------
+	//! Read a fermion with 16 bit mantissas
+	class QIOReadLatFermCompressed : public QIOReadObject
+	{
+	private:
+	  Params params;
+
+	public:
+	  QIOReadLatFermCompressed(const Params& p) : params(p) {}
+
+	  //! Read a fermion
+	  void operator()(QDP_serialparallel_t serpar) {
+	    multi1d<LatticeInteger> obj;
+	    XMLReader file_xml;
+	    XMLBufferWriter obj_record_xml;
+
+	    QDPFileReader to(file_xml,params.file.file_name,serpar);
+	    readCompressed(to, obj_record_xml, obj, "LatticeFermion");
+	    close(to);
+
+	    TheNamedObjMap::Instance().create<LatticeFermion>(params.named_obj.object_id);
+	    decompress(TheNamedObjMap::Instance().getData<LatticeFermion>(params.named_obj.object_id), obj);
+	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setFileXML(file_xml);
+	    TheNamedObjMap::Instance().get(params.named_obj.object_id).setRecordXML(obj_record_xml);
+	  }
+	};
+
+	// Call back
+	QIOReadObject* qioReadLatFermCompressed(const Params& p)
+	{
+	  return new QIOReadLatFermCompressed(p);
+	}
+#endif
+
+
 #if 0
 	// RGE: FOR SOME REASON, QDP CANNOT CAST A DOUBLE TO FLOATING HERE. NEED TO FIX.
 
@@ -822,6 +893,10 @@ namespace Chroma
 									qioReadLatPropF);
 	  success &= TheQIOReadObjectFactory::Instance().registerObject(std::string("LatticePropagatorD"), 
 									qioReadLatPropD);
+#ifndef QDP_IS_QDPJIT
+	  success &= TheQIOReadObjectFactory::Instance().registerObject(std::string("CompressedLatticePropagator"), 
+									qioReadLatPropCompressed);
+#endif
 
 	  success &= TheQIOReadObjectFactory::Instance().registerObject(std::string("LatticeStaggeredPropagator"),   
 									qioReadStagLatProp);
@@ -835,6 +910,10 @@ namespace Chroma
 	  
 	  success &= TheQIOReadObjectFactory::Instance().registerObject(std::string("LatticeFermion"), 
 									qioReadLatFerm);
+#ifndef QDP_IS_QDPJIT
+	  success &= TheQIOReadObjectFactory::Instance().registerObject(std::string("CompressedLatticeFermion"), 
+									qioReadLatFermCompressed);
+#endif
 
 //      success &= TheQIOReadObjectFactory::Instance().registerObject(std::string("LatticeFermionF"), 
 //								   qioReadLatFermF);
@@ -11,6 +11,7 @@
 #include "util/ferm/eigeninfo.h"
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_prop_colorvec.h"
+#include "io/compressed_io.h"
 #include "handle.h"
 #include "qdp_map_obj_memory.h"
 
@@ -33,15 +34,15 @@ namespace Chroma
 			   const std::string& file, 
 			   QDP_volfmt_t volfmt, QDP_serialparallel_t serpar)
       {
-	LatticePropagator obj;
+	// Same precision: write the object in place, without a copy
+	Handle<const LatticePropagator> obj = TheNamedObjMap::Instance().getView<LatticePropagator>(buffer_id);
 	XMLBufferWriter file_xml, record_xml;
 
-	obj = TheNamedObjMap::Instance().getData<LatticePropagator>(buffer_id);
 	TheNamedObjMap::Instance().get(buffer_id).getFileXML(file_xml);
 	TheNamedObjMap::Instance().get(buffer_id).getRecordXML(record_xml);
     
 	QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
-	write(to,record_xml,obj);
+	write(to,record_xml,*obj);
 	close(to);
       }
 
@@ -88,15 +89,15 @@ namespace Chroma
 			   const std::string& file, 
 			   QDP_volfmt_t volfmt, QDP_serialparallel_t serpar)
       {
-	LatticeFermion obj;
+	// Same precision: write the object in place, without a copy
+	Handle<const LatticeFermion> obj = TheNamedObjMap::Instance().getView<LatticeFermion>(buffer_id);
 	XMLBufferWriter file_xml, record_xml;
 
-	obj = TheNamedObjMap::Instance().getData<LatticeFermion>(buffer_id);
 	TheNamedObjMap::Instance().get(buffer_id).getFileXML(file_xml);
 	TheNamedObjMap::Instance().get(buffer_id).getRecordXML(record_xml);
     
 	QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
-	write(to,record_xml,obj);
+	write(to,record_xml,*obj);
 	close(to);
       }
 
@@ -141,21 +142,94 @@ namespace Chroma
 #endif
 
 
+#ifndef QDP_IS_QDPJIT
+      //------------------------------------------------------------------------
+      //! Print the size and rate of a compressed write
+      /*!
+       * \param bytes       bytes written
+       * \param full_bytes  bytes of the object in double precision
+       * \param secs        time to compress and write
+       */
+      void reportCompressed(size_t bytes, size_t full_bytes, double secs)
+      {
+	QDPIO::cout << "Compressed object: " << bytes << " bytes,  compression ratio vs double= "
+		    << double(full_bytes) / double(bytes)
+		    << ",  vs single= " << double(full_bytes) / double(2*bytes)
+		    << ",  rate= " << ((secs > 0) ? 1.0e-6*double(bytes)/secs : 0.0) << " MB/s"
+		    << std::endl;
+      }
+
+
+      //! Write a propagator with 16 bit mantissas
+      void QIOWriteLatPropCompressed(const std::string& buffer_id,
+				     const std::string& file, 
+				     QDP_volfmt_t volfmt, QDP_serialparallel_t serpar)
+      {
+	multi1d<LatticeInteger> obj;
+	XMLBufferWriter file_xml, record_xml, obj_record_xml;
+	StopWatch swatch;
+	swatch.reset();
+	swatch.start();
+
+	compress(obj, TheNamedObjMap::Instance().getData<LatticePropagator>(buffer_id));
+	TheNamedObjMap::Instance().get(buffer_id).getFileXML(file_xml);
+	TheNamedObjMap::Instance().get(buffer_id).getRecordXML(obj_record_xml);
+	writeCompressedRecordXML(record_xml, obj_record_xml, "LatticePropagator");
+    
+	QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
+	write(to,record_xml,obj);
+	close(to);
+
+	swatch.stop();
+	reportCompressed(compressedBytes(obj), 
+			 size_t(Ns*Ns*Nc*Nc*2)*sizeof(double)*size_t(Layout::vol()),
+			 swatch.getTimeInSeconds());
+      }
+
+
+      //! Write a fermion with 16 bit mantissas
+      void QIOWriteLatFermCompressed(const std::string& buffer_id,
+				     const std::string& file, 
+				     QDP_volfmt_t volfmt, QDP_serialparallel_t serpar)
+      {
+	multi1d<LatticeInteger> obj;
+	XMLBufferWriter file_xml, record_xml, obj_record_xml;
+	StopWatch swatch;
+	swatch.reset();
+	swatch.start();
+
+	compress(obj, TheNamedObjMap::Instance().getData<LatticeFermion>(buffer_id));
+	TheNamedObjMap::Instance().get(buffer_id).getFileXML(file_xml);
+	TheNamedObjMap::Instance().get(buffer_id).getRecordXML(obj_record_xml);
+	writeCompressedRecordXML(record_xml, obj_record_xml, "LatticeFermion");
+    
+	QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
+	write(to,record_xml,obj);
+	close(to);
+
+	swatch.stop();
+	reportCompressed(compressedBytes(obj), 
+			 size_t(Ns*Nc*2)*sizeof(double)*size_t(Layout::vol()),
+			 swatch.getTimeInSeconds());
+      }
+#endif
+
+
       //------------------------------------------------------------------------
       //! Write a propagator
       void QIOWriteLatStagProp(const std::string& buffer_id,
 			       const std::string& file, 
 			       QDP_volfmt_t volfmt, QDP_serialparallel_t serpar)
       {
-	LatticeStaggeredPropagator obj;
+	// Same precision: write the object in place, without a copy
+	Handle<const LatticeStaggeredPropagator> obj = TheNamedObjMap::Instance().getView<LatticeStaggeredPropagator>(buffer_id);
 	XMLBufferWriter file_xml, record_xml;
 
-	obj = TheNamedObjMap::Instance().getData<LatticeStaggeredPropagator>(buffer_id);
 	TheNamedObjMap::Instance().get(buffer_id).getFileXML(file_xml);
 	TheNamedObjMap::Instance().get(buffer_id).getRecordXML(record_xml);
     
 	QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
-	write(to,record_xml,obj);
+	write(to,record_xml,*obj);
 	close(to);
       }
 
@@ -202,15 +276,15 @@ namespace Chroma
 				  const std::string& file, 
 				  QDP_volfmt_t volfmt, QDP_serialparallel_t serpar)
       {
-	multi1d<LatticeColorMatrix> obj;
+	// Same precision: write the object in place, without a copy
+	Handle<const multi1d<LatticeColorMatrix> > obj = TheNamedObjMap::Instance().getView< multi1d<LatticeColorMatrix> >(buffer_id);
 	XMLBufferWriter file_xml, record_xml;
 
-	obj = TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(buffer_id);
 	TheNamedObjMap::Instance().get(buffer_id).getFileXML(file_xml);
 	TheNamedObjMap::Instance().get(buffer_id).getRecordXML(record_xml);
     
 	QDPFileWriter to(file_xml,file,volfmt,serpar,QDPIO_OPEN);
-	write(to,record_xml,obj);
+	write(to,record_xml,*obj);
 	close(to);
       }
 
@@ -515,8 +589,17 @@ namespace Chroma
 	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(std::string("LatticePropagatorD"), 
 								      QIOWriteLatPropD);
 
+#ifndef QDP_IS_QDPJIT
+	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(std::string("CompressedLatticePropagator"), 
+								      QIOWriteLatPropCompressed);
+#endif
+
 	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(std::string("LatticeFermion"), 
 								      QIOWriteLatFerm);
+#ifndef QDP_IS_QDPJIT
+	success &= TheQIOWriteObjFuncMap::Instance().registerFunction(std::string("CompressedLatticeFermion"), 
+								      QIOWriteLatFermCompressed);
+#endif
 //      success &= TheQIOWriteObjFuncMap::Instance().registerFunction(std::string("LatticeFermionF"), 
 //								    QIOWriteLatFermF);
 //      success &= TheQIOWriteObjFuncMap::Instance().registerFunction(std::string("LatticeFermionD"), 
@@ -33,6 +33,26 @@ namespace Chroma
   }
 
 
+  // Reader for checkpoints
+  void read(XMLReader& xml, const std::string& path, InlineLinkSmearEnv::Params::Checkpoint_t& input)
+  {
+    XMLReader inputtop(xml, path);
+    read(inputtop, "num_apply", input.num_apply);
+    read(inputtop, "linksmear_id", input.linksmear_id);
+  }
+
+  // Writer for checkpoints
+  void write(XMLWriter& xml, const std::string& path, const InlineLinkSmearEnv::Params::Checkpoint_t& input)
+  {
+    push(xml, path);
+
+    write(xml, "num_apply", input.num_apply);
+    write(xml, "linksmear_id", input.linksmear_id);
+
+    pop(xml);
+  }
+
+
   namespace InlineLinkSmearEnv 
   { 
     namespace
@@ -45,6 +65,37 @@ namespace Chroma
 
       //! Local registration flag
       bool registered = false;
+
+      //! Store a smeared configuration into a memory object
+      /*! A checkpoint (num_apply > 0) records the number of applications of the smearing */
+      void saveSmearedLinks(const multi1d<LatticeColorMatrix>& u_smr,
+			    XMLBufferWriter& gauge_xml,
+			    const std::string& linksmear_id,
+			    int num_apply = 0)
+      {
+	XMLBufferWriter file_xml, record_xml;
+	push(file_xml, "gauge");
+	write(file_xml, "id", int(0));
+	pop(file_xml);
+
+	if (num_apply > 0)
+	{
+	  push(record_xml, "LinkSmearCheckpoint");
+	  write(record_xml, "num_apply", num_apply);
+	  record_xml << gauge_xml;
+	  pop(record_xml);
+	}
+	else
+	{
+	  record_xml << gauge_xml;
+	}
+
+	// Store the gauge field
+	TheNamedObjMap::Instance().create< multi1d<LatticeColorMatrix> >(linksmear_id);
+	TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(linksmear_id) = u_smr;
+	TheNamedObjMap::Instance().get(linksmear_id).setFileXML(file_xml);
+	TheNamedObjMap::Instance().get(linksmear_id).setRecordXML(record_xml);
+      }
     }
 
     const std::string name = "LINK_SMEAR";
@@ -84,6 +135,36 @@ namespace Chroma
 
 	// Read in the linksmear outfile
 	read(paramtop, "NamedObject", named_obj);
+
+	// Optional intermediate results
+	if (paramtop.count("Checkpoints") == 1)
+	  read(paramtop, "Checkpoints", checkpoints);
+
+	for(int i=0; i < checkpoints.size(); ++i)
+	{
+	  if (checkpoints[i].num_apply < 1)
+	  {
+	    QDPIO::cerr << "Checkpoint num_apply must be positive" << std::endl;
+	    QDP_abort(1);
+	  }
+
+	  if (checkpoints[i].linksmear_id == named_obj.linksmear_id)
+	  {
+	    QDPIO::cerr << "Checkpoint linksmear_id " << checkpoints[i].linksmear_id
+			<< " is the same as the output linksmear_id" << std::endl;
+	    QDP_abort(1);
+	  }
+
+	  for(int j=0; j < i; ++j)
+	  {
+	    if (checkpoints[j].linksmear_id == checkpoints[i].linksmear_id)
+	    {
+	      QDPIO::cerr << "Checkpoint linksmear_id " << checkpoints[i].linksmear_id
+			  << " is used more than once" << std::endl;
+	      QDP_abort(1);
+	    }
+	  }
+	}
       }
       catch(const std::string& e) 
       {
@@ -101,6 +182,8 @@ namespace Chroma
       
       xml << link_smearing.xml;
       write(xml, "NamedObject", named_obj);
+      if (checkpoints.size() > 0)
+	write(xml, "Checkpoints", checkpoints);
 
       pop(xml);
     }
@@ -153,7 +236,32 @@ namespace Chroma
 	  linkSmearing(TheLinkSmearingFactory::Instance().createObject(params.link_smearing.id,
 								       linktop,
 								       params.link_smearing.path));
-	(*linkSmearing)(u_smr);
+
+	// Continue smearing from the last checkpoint instead of starting over
+	int num_apply = 1;
+	for(int i=0; i < params.checkpoints.size(); ++i)
+	  num_apply = std::max(num_apply, params.checkpoints[i].num_apply);
+
+	for(int n=1; n <= num_apply; ++n)
+	{
+	  (*linkSmearing)(u_smr);
+
+	  for(int i=0; i < params.checkpoints.size(); ++i)
+	  {
+	    if (params.checkpoints[i].num_apply != n)
+	      continue;
+
+	    QDPIO::cout << "Store checkpoint after " << n << " applications in "
+			<< params.checkpoints[i].linksmear_id << std::endl;
+
+	    push(xml_out, "Checkpoint");
+	    write(xml_out, "num_apply", n);
+	    MesPlq(xml_out, "Link_observables", u_smr);
+	    pop(xml_out);
+
+	    saveSmearedLinks(u_smr, gauge_xml, params.checkpoints[i].linksmear_id, n);
+	  }
+	}
       }
       catch(const std::string& e) 
       {
@@ -168,19 +276,7 @@ namespace Chroma
       MesPlq(xml_out, "Link_observables", u_smr);
 
       // Now store the configuration to a memory object
-      {
-	XMLBufferWriter file_xml, record_xml;
-	push(file_xml, "gauge");
-	write(file_xml, "id", int(0));
-	pop(file_xml);
-	record_xml << gauge_xml;
-
-	// Store the gauge field
-	TheNamedObjMap::Instance().create< multi1d<LatticeColorMatrix> >(params.named_obj.linksmear_id);
-	TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(params.named_obj.linksmear_id) = u_smr;
-	TheNamedObjMap::Instance().get(params.named_obj.linksmear_id).setFileXML(file_xml);
-	TheNamedObjMap::Instance().get(params.named_obj.linksmear_id).setRecordXML(record_xml);
-      }
+      saveSmearedLinks(u_smr, gauge_xml, params.named_obj.linksmear_id);
 
       pop(xml_out);
 
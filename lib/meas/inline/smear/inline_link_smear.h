@@ -36,6 +36,22 @@ namespace Chroma
 	std::string 	linksmear_id;	     /*!< Output memory object ape config */
 
       } named_obj;
+
+      //! Intermediate result of repeated smearing
+      struct Checkpoint_t
+      {
+	int             num_apply;           /*!< Number of applications of the link smearing */
+	std::string 	linksmear_id;	     /*!< Output memory object of this checkpoint */
+      };
+
+      /*!
+       * Optional list of checkpoints. The whole link smearing (with all
+       * its own smearing steps) is then applied num_apply times, up to the
+       * largest num_apply, storing the intermediate fields on the way, and
+       * the final field goes into linksmear_id. The ids must all differ
+       * from each other and from linksmear_id
+       */
+      multi1d<Checkpoint_t> checkpoints;
       
     };
 
@@ -8,6 +8,7 @@
 #include "meas/smear/quark_displacement_factory.h"
 #include "meas/smear/quark_displacement_aggregate.h"
 #include "meas/smear/displace.h"
+#include "meas/smear/disp_prop_cache.h"
 
 #include "util/ferm/symtensor.h"
 #include "util/ferm/antisymtensor.h"
@@ -78,6 +79,13 @@ namespace Chroma
       }
 
 
+      //! Derivatives go through the displaced propagators shared by all operators
+      DispPropCache& dispCache()
+      {
+	return TheDispPropCache::Instance();
+      }
+
+
 
 
       //-------------------- callback functions ---------------------------------------
@@ -433,7 +441,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv \nabla_i\f$
-      fin = rightNabla(tmp,u,params.deriv_dir,length);
+      fin = dispCache().rightNabla(tmp,u,params.deriv_dir,length);
       tmp = fin;
 
       END_CODE();
@@ -454,7 +462,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv D_i\f$
-      fin = rightD(tmp,u,params.deriv_dir,length);
+      fin = dispCache().rightD(tmp,u,params.deriv_dir,length);
       tmp = fin;
 
       END_CODE();
@@ -475,7 +483,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv B_i\f$
-      fin = rightB(tmp,u,params.deriv_dir,length);
+      fin = dispCache().rightB(tmp,u,params.deriv_dir,length);
       tmp = fin;
 
       END_CODE();
@@ -497,7 +505,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv E_alpha\f$
-      fin = rightE(tmp,u,params.deriv_dir,length);
+      fin = dispCache().rightE(tmp,u,params.deriv_dir,length);
       tmp = fin;
 
       END_CODE();
@@ -519,7 +527,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv Laplacian\f$
-      fin = rightLap(tmp,u,length);
+      fin = dispCache().rightLap(tmp,u,length);
       tmp = fin;
 
       END_CODE();
@@ -544,7 +552,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv \gamma_5\nabla_i\f$
-      fin = Gamma(G5) * rightNabla(tmp,u,params.deriv_dir,length);
+      fin = Gamma(G5) * dispCache().rightNabla(tmp,u,params.deriv_dir,length);
       tmp = fin;
 
       END_CODE();
@@ -565,7 +573,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv \nabla_i\f$
-      fin = rightNabla(tmp,u,params.deriv_dir,length);
+      fin = dispCache().rightNabla(tmp,u,params.deriv_dir,length);
       tmp = fin;
       
       END_CODE();
@@ -586,7 +594,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv \gamma_4 \nabla_i\f$
-      fin = Gamma(1 << 3) * rightNabla(tmp,u,params.deriv_dir,length);
+      fin = Gamma(1 << 3) * dispCache().rightNabla(tmp,u,params.deriv_dir,length);
       tmp = fin;
       
       END_CODE();
@@ -607,7 +615,7 @@ namespace Chroma
 
       // \f$\Gamma_f \equiv \gamma_i\nabla_i\f$
       for(int k=0; k < 3; ++k)
-	fin += Gamma(1 << k) * rightNabla(tmp,u,k,length);
+	fin += Gamma(1 << k) * dispCache().rightNabla(tmp,u,k,length);
       
       tmp = fin;
 
@@ -632,7 +640,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (antiSymTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightNabla(tmp,u,k,length));
+	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightNabla(tmp,u,k,length));
 	}
       
       tmp = fin;
@@ -658,7 +666,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (symTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightNabla(tmp,u,k,length));
+	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightNabla(tmp,u,k,length));
 	}
       
       tmp = fin;
@@ -682,7 +690,7 @@ namespace Chroma
 
       // \f$\Gamma_f \equiv \gamma_5\gamma_i \nabla_i\f$  
       for(int k=0; k < 3; ++k)
-	fin += Gamma(1 << k) * rightNabla(tmp,u,k,length);
+	fin += Gamma(1 << k) * dispCache().rightNabla(tmp,u,k,length);
       
       tmp = Gamma(G5) * fin;
 
@@ -708,7 +716,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (symTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightNabla(tmp,u,k,length));
+	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightNabla(tmp,u,k,length));
 	}
       
       tmp = Gamma(G5) * fin;
@@ -736,7 +744,7 @@ namespace Chroma
 	{
 	  Real e = ETensor3d(params.deriv_dir,j,k);
 	  if (toBool(e != 0.0))
-	    fin += e * (Gamma(1 << j) * rightNabla(tmp,u,k,length));
+	    fin += e * (Gamma(1 << j) * dispCache().rightNabla(tmp,u,k,length));
 	}
       
       tmp = Gamma(G5) * fin;
@@ -763,7 +771,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (antiSymTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightD(tmp,u,k,length));
+	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightD(tmp,u,k,length));
 	}
       
       tmp = Gamma(1 << 3) * (Gamma(G5) * fin);
@@ -785,7 +793,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv \gamma_4 D_i\f$  
-      fin = Gamma(1 << 3) * rightD(tmp,u,params.deriv_dir,length);
+      fin = Gamma(1 << 3) * dispCache().rightD(tmp,u,params.deriv_dir,length);
       
       tmp = fin;
 
@@ -808,7 +816,7 @@ namespace Chroma
 
       // \f$\Gamma_f \equiv \gamma_5\gamma_i D_i\f$  
       for(int k=0; k < 3; ++k)
-	fin += Gamma(1 << k) * rightD(tmp,u,k,length);
+	fin += Gamma(1 << k) * dispCache().rightD(tmp,u,k,length);
       
       tmp = Gamma(G5) * fin;
 
@@ -835,7 +843,7 @@ namespace Chroma
 	{
 	  Real e = ETensor3d(params.deriv_dir,j,k);
 	  if (toBool(e != 0.0))
-	    fin += e * (Gamma(1 << j) * rightD(tmp,u,k,length));
+	    fin += e * (Gamma(1 << j) * dispCache().rightD(tmp,u,k,length));
 	}
       
       tmp = Gamma(G5) * fin;
@@ -862,7 +870,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (symTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightD(tmp,u,k,length));
+	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightD(tmp,u,k,length));
 	}
       
       tmp = Gamma(G5) * fin;
@@ -889,7 +897,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (antiSymTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightD(tmp,u,k,length));
+	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightD(tmp,u,k,length));
 	}
       
       tmp = Gamma(G5) * fin;
@@ -913,7 +921,7 @@ namespace Chroma
 
       // \f$\Gamma_f \equiv \gamma_4\gamma_5 \gamma_i D_i\f$  
       for(int k=0; k < 3; ++k)
-	fin += Gamma(1 << k) * rightD(tmp,u,k,length);
+	fin += Gamma(1 << k) * dispCache().rightD(tmp,u,k,length);
 
       tmp = Gamma(1 << 3) * (Gamma(G5) * fin);
 
@@ -940,7 +948,7 @@ namespace Chroma
 	{
 	  Real e = ETensor3d(params.deriv_dir,j,k);
 	  if (toBool(e != 0.0))
-	    fin += e * (Gamma(1 << j) * rightD(tmp,u,k,length));
+	    fin += e * (Gamma(1 << j) * dispCache().rightD(tmp,u,k,length));
 	}
 
       tmp = Gamma(1 << 3) * (Gamma(G5) * fin);
@@ -967,7 +975,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (symTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightD(tmp,u,k,length));
+	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightD(tmp,u,k,length));
 	}
 
       tmp = Gamma(1 << 3) * (Gamma(G5) * fin);
@@ -994,7 +1002,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (antiSymTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightD(tmp,u,k,length));
+	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightD(tmp,u,k,length));
 	}
 
       tmp = Gamma(1 << 3) * (Gamma(G5) * fin);
@@ -1018,7 +1026,7 @@ namespace Chroma
 
       // \f$\Gamma_f \equiv \gamma_i D_i\f$  
       for(int k=0; k < 3; ++k)
-	fin += Gamma(1 << k) * rightD(tmp,u,k,length);
+	fin += Gamma(1 << k) * dispCache().rightD(tmp,u,k,length);
       
       tmp = fin;
 
@@ -1044,7 +1052,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (symTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightD(tmp,u,k,length));
+	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightD(tmp,u,k,length));
 	}
       
       tmp = fin;
@@ -1071,7 +1079,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (antiSymTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightD(tmp,u,k,length));
+	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightD(tmp,u,k,length));
 	}
       
       tmp = fin;
@@ -1094,7 +1102,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv \gamma_4\gamma_5 D_i\f$  
-      fin = Gamma(1 << 3) * (Gamma(G5) * rightD(tmp,u,params.deriv_dir,length));
+      fin = Gamma(1 << 3) * (Gamma(G5) * dispCache().rightD(tmp,u,params.deriv_dir,length));
       
       tmp = fin;
 
@@ -1116,7 +1124,7 @@ namespace Chroma
       int length = plusMinus(isign) * params.deriv_length;
 
       // \f$\Gamma_f \equiv \gamma_5 B_i\f$  
-      fin = Gamma(G5) * rightB(tmp,u,params.deriv_dir,length);
+      fin = Gamma(G5) * dispCache().rightB(tmp,u,params.deriv_dir,length);
       
       tmp = fin;
 
@@ -1142,7 +1150,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (antiSymTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightB(tmp,u,k,length));
+	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightB(tmp,u,k,length));
 	}
       
       tmp = fin;
@@ -1169,7 +1177,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (symTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightB(tmp,u,k,length));
+	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightB(tmp,u,k,length));
 	}
       
       tmp = fin;
@@ -1193,7 +1201,7 @@ namespace Chroma
 
       // \f$\Gamma_f \equiv \gamma_5 \gamma_i B_i\f$  
       for(int k=0; k < 3; ++k)
-	fin += Gamma(1 << k) * rightB(tmp,u,k,length);
+	fin += Gamma(1 << k) * dispCache().rightB(tmp,u,k,length);
       
       tmp = Gamma(G5) * fin;
 
@@ -1219,7 +1227,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (antiSymTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightB(tmp,u,k,length));
+	    fin += Real(antiSymTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightB(tmp,u,k,length));
 	}
       
       tmp = Gamma(G5) * fin;
@@ -1246,7 +1254,7 @@ namespace Chroma
 	for(int k=0; k < 3; ++k)
 	{
 	  if (symTensor3d(params.deriv_dir,j,k) != 0)
-	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * rightB(tmp,u,k,length));
+	    fin += Real(symTensor3d(params.deriv_dir,j,k)) * (Gamma(1 << j) * dispCache().rightB(tmp,u,k,length));
 	}
       
       tmp = Gamma(G5) * fin;
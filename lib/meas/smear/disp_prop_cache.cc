@@ -0,0 +1,316 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Cache of derivative-displaced propagators
+ */
+
+#include "meas/smear/disp_prop_cache.h"
+#include "meas/smear/displace.h"
+#include "meas/inline/io/named_objmap.h"
+#include "util/ferm/symtensor.h"
+#include "util/ferm/antisymtensor.h"
+
+namespace Chroma
+{
+  // Support for the keys of derivative-displaced propagators
+  bool operator<(const KeyDispProp_t& a, const KeyDispProp_t& b)
+  {
+    multi1d<int> lgaa(1);
+    lgaa[0] = a.length;
+    multi1d<int> lga = concat(lgaa, a.path);
+
+    multi1d<int> lgbb(1);
+    lgbb[0] = b.length;
+    multi1d<int> lgb = concat(lgbb, b.path);
+
+    return (lga < lgb);
+  }
+
+
+  // Key of a displaced propagator
+  std::string dispPropSourceKey(const std::string& obj_id,
+				const std::string& gauge_id,
+				const std::string& xml)
+  {
+    std::ostringstream key;
+
+    if (obj_id.size() > 0)
+      key << obj_id << "#" << TheNamedObjMap::Instance().getSerial(obj_id) << ";";
+
+    key << gauge_id << "#" << TheNamedObjMap::Instance().getSerial(gauge_id) << ";";
+
+    // Drop the displacements
+    const std::string open_tag  = "<Displacement>";
+    const std::string close_tag = "</Displacement>";
+    std::string rest = xml;
+
+    for(std::string::size_type b = rest.find(open_tag); b != std::string::npos; b = rest.find(open_tag, b))
+    {
+      std::string::size_type e = rest.find(close_tag, b);
+      if (e == std::string::npos)
+	break;
+
+      rest.erase(b, e + close_tag.size() - b);
+    }
+
+    key << rest;
+
+    return key.str();
+  }
+
+
+  // Constructor
+  DispPropCache::DispPropCache() : clock(0), builds(0), active(false)
+  {
+    // Default cap: 1 GiB per node
+    max_bytes = size_t(1024)*size_t(1024)*size_t(1024);
+  }
+
+
+  // Set the memory cap
+  void DispPropCache::setMaxMemory(size_t bytes)
+  {
+    max_bytes = bytes;
+
+    while (getMemory() > max_bytes && makeRoom(0)) {}
+  }
+
+
+  // Drop all entries and forget the source
+  void DispPropCache::clear()
+  {
+    disp_map.clear();
+    src_id = "";
+    active = false;
+  }
+
+
+  // Name the source
+  void DispPropCache::setSource(const std::string& id)
+  {
+    if (id != src_id)
+      disp_map.clear();
+
+    src_id = id;
+    active = true;
+  }
+
+
+  // Bytes of one propagator on this node
+  size_t DispPropCache::propBytes() const
+  {
+    return size_t(Ns*Ns*Nc*Nc*2) * sizeof(REAL) * size_t(Layout::sitesOnNode());
+  }
+
+
+  // Evict least recently used entries until one more propagator fits
+  bool DispPropCache::makeRoom(const LatticePropagator* keep)
+  {
+    while ((disp_map.size() + 1) * propBytes() > max_bytes)
+    {
+      std::map<KeyDispProp_t, ValDispProp_t>::iterator lru = disp_map.end();
+
+      for(std::map<KeyDispProp_t, ValDispProp_t>::iterator it = disp_map.begin();
+	  it != disp_map.end(); ++it)
+      {
+	if (&(it->second.prop) == keep)
+	  continue;
+
+	if (lru == disp_map.end() || it->second.last_used < lru->second.last_used)
+	  lru = it;
+      }
+
+      if (lru == disp_map.end())
+	return false;
+
+      disp_map.erase(lru);
+    }
+
+    return true;
+  }
+
+
+  // Find or build the entry of a path
+  const LatticePropagator&
+  DispPropCache::displaceObject(const LatticePropagator& F,
+				const multi1d<LatticeColorMatrix>& u,
+				const KeyDispProp_t& key)
+  {
+    std::map<KeyDispProp_t, ValDispProp_t>::iterator it = disp_map.find(key);
+    if (it != disp_map.end())
+    {
+      it->second.last_used = ++clock;
+      return it->second.prop;
+    }
+
+    // Build from the (cached) prefix of the path
+    int n  = key.path.size();
+    int mu = key.path[n-1];
+    const LatticePropagator* prefix = &F;
+
+    if (n > 1)
+    {
+      KeyDispProp_t prefix_key;
+      prefix_key.length = key.length;
+      prefix_key.path.resize(n-1);
+      for(int i=0; i < n-1; ++i)
+	prefix_key.path[i] = key.path[i];
+
+      prefix = &displaceObject(F, u, prefix_key);
+    }
+
+    ++builds;
+
+    // Over the cap - hand back an uncached result
+    if (! makeRoom(prefix))
+    {
+      scratch = Chroma::rightNabla(*prefix, u, mu, key.length);
+      return scratch;
+    }
+
+    ValDispProp_t& val = disp_map[key];
+    val.prop = Chroma::rightNabla(*prefix, u, mu, key.length);
+    val.last_used = ++clock;
+
+    return val.prop;
+  }
+
+
+  // Return nabla_k nabla_j F
+  const LatticePropagator&
+  DispPropCache::nabla2(const LatticePropagator& F,
+			const multi1d<LatticeColorMatrix>& u,
+			int j, int k, int length)
+  {
+    // Two nablas are even in the sign of the length
+    KeyDispProp_t key;
+    key.length = (length < 0) ? -length : length;
+    key.path.resize(2);
+    key.path[0] = j;
+    key.path[1] = k;
+
+    return displaceObject(F, u, key);
+  }
+
+
+  // Apply first deriv to the right onto source
+  LatticePropagator
+  DispPropCache::rightNabla(const LatticePropagator& F,
+			    const multi1d<LatticeColorMatrix>& u,
+			    int mu, int length)
+  {
+    if (! cachingP())
+      return Chroma::rightNabla(F, u, mu, length);
+
+    // One nabla is odd in the sign of the length
+    KeyDispProp_t key;
+    key.length = (length < 0) ? -length : length;
+    key.path.resize(1);
+    key.path[0] = mu;
+
+    LatticePropagator tmp;
+    if (length < 0)
+      tmp = -displaceObject(F, u, key);
+    else
+      tmp = displaceObject(F, u, key);
+
+    return tmp;
+  }
+
+
+  // Apply "D_i" operator to the right onto source
+  LatticePropagator
+  DispPropCache::rightD(const LatticePropagator& F,
+			const multi1d<LatticeColorMatrix>& u,
+			int mu, int length)
+  {
+    if (! cachingP())
+      return Chroma::rightD(F, u, mu, length);
+
+    LatticePropagator tmp = zero;
+
+    for(int j=0; j < 3; ++j)
+      for(int k=0; k < 3; ++k)
+      {
+	if (symTensor3d(mu,j,k) != 0)
+	  tmp += nabla2(F,u,j,k,length);
+      }
+
+    return tmp;
+  }
+
+
+  // Apply "B_i" operator to the right onto source
+  LatticePropagator
+  DispPropCache::rightB(const LatticePropagator& F,
+			const multi1d<LatticeColorMatrix>& u,
+			int mu, int length)
+  {
+    if (! cachingP())
+      return Chroma::rightB(F, u, mu, length);
+
+    LatticePropagator tmp = zero;
+
+    for(int j=0; j < 3; ++j)
+      for(int k=0; k < 3; ++k)
+      {
+	if (antiSymTensor3d(mu,j,k) != 0)
+	  tmp += Real(antiSymTensor3d(mu,j,k)) * nabla2(F,u,j,k,length);
+      }
+
+    return tmp;
+  }
+
+
+  // Apply "E_i" operator to the right onto source
+  LatticePropagator
+  DispPropCache::rightE(const LatticePropagator& F,
+			const multi1d<LatticeColorMatrix>& u,
+			int mu, int length)
+  {
+    if (! cachingP())
+      return Chroma::rightE(F, u, mu, length);
+
+    LatticePropagator tmp;
+
+    switch (mu)
+    {
+    case 0:
+      tmp  = nabla2(F,u,0,0,length);
+      tmp -= nabla2(F,u,1,1,length);
+      tmp *= Real(1)/Real(sqrt(Real(2)));
+      break;
+
+    case 1:
+      tmp  = nabla2(F,u,0,0,length);
+      tmp += nabla2(F,u,1,1,length);
+      tmp -= Real(2)*nabla2(F,u,2,2,length);
+      tmp *= Real(-1)/Real(sqrt(Real(6)));
+      break;
+
+    default:
+      QDPIO::cerr << __func__ << ": invalid direction for E: mu=" << mu << std::endl;
+      QDP_abort(1);
+    }
+
+    return tmp;
+  }
+
+
+  // Apply "Laplacian" operator to the right onto source
+  LatticePropagator
+  DispPropCache::rightLap(const LatticePropagator& F,
+			  const multi1d<LatticeColorMatrix>& u,
+			  int length)
+  {
+    if (! cachingP())
+      return Chroma::rightLap(F, u, length);
+
+    LatticePropagator tmp = zero;
+
+    for(int i=0; i < 3; ++i)
+      tmp += nabla2(F,u,i,i,length);
+
+    return tmp;
+  }
+
+} // namespace Chroma
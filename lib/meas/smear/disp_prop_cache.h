@@ -0,0 +1,207 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Cache of derivative-displaced propagators
+ */
+
+#ifndef __disp_prop_cache_h__
+#define __disp_prop_cache_h__
+
+#include "chromabase.h"
+#include "singleton.h"
+#include <map>
+
+namespace Chroma
+{
+  /*!
+   * \ingroup smear
+   *
+   * @{
+   */
+  //----------------------------------------------------------------------------
+  //! The key for derivative-displaced propagators
+  struct KeyDispProp_t
+  {
+    int          length;          /*!< Displacement length, made non-negative using the parity in its sign */
+    multi1d<int> path;            /*!< 0-based directions of the right nablas, applied in order */
+  };
+
+
+  //! Support for the keys of derivative-displaced propagators
+  bool operator<(const KeyDispProp_t& a, const KeyDispProp_t& b);
+
+
+  //----------------------------------------------------------------------------
+  //! Derivative-displaced propagators shared by all quark displacements
+  /*!
+   * The derivative displacements (D, B, E, Laplacian and the hybrid
+   * operators built from them) all reduce to the same products of right
+   * nablas acting on one propagator. This cache keeps
+   *
+   *   nabla_{path[n-1]} ... nabla_{path[0]} F
+   *
+   * keyed by path and length, builds each path from its cached prefix,
+   * and is shared by every displacement object through TheDispPropCache.
+   * The cost of a measurement therefore scales with the number of
+   * distinct paths rather than with the number of operators.
+   *
+   * The cached entries belong to one source propagator and gauge field,
+   * named by the measurement with setSource, usually through a
+   * DispPropCacheSource holding the key from dispPropSourceKey while an
+   * inline task runs. A different key flushes the cache, while a later
+   * task with the same key (another operator on the same propagator)
+   * reuses the paths already built. Outside of a task nothing is cached
+   * and each call is the plain displacement. When the stored propagators
+   * exceed the memory cap the least recently used entries are dropped,
+   * and the main program clears the cache after its measurements.
+   */
+  class DispPropCache
+  {
+  public:
+    //! Constructor
+    DispPropCache();
+
+    //! Destructor
+    ~DispPropCache() {}
+
+    //! Set the memory cap in bytes per node. A cap of 0 disables caching
+    void setMaxMemory(size_t bytes);
+
+    //! Current memory cap in bytes per node
+    size_t getMaxMemory() const {return max_bytes;}
+
+    //! Memory used by the cached propagators in bytes per node
+    size_t getMemory() const {return disp_map.size() * propBytes();}
+
+    //! Drop all entries and forget the source
+    void clear();
+
+    //! Name the propagator (and gauge field) all following calls act on
+    /*! A name different from the current one flushes the cache. An empty name turns caching off */
+    void setSource(const std::string& id);
+
+    //! Stop caching until the next setSource, keeping the entries
+    void release() {active = false;}
+
+    //! Name of the current source
+    const std::string& getSource() const {return src_id;}
+
+    //! Number of nablas computed since construction
+    unsigned long getBuilds() const {return builds;}
+
+    //! Apply first deriv to the right onto source
+    LatticePropagator rightNabla(const LatticePropagator& F,
+				 const multi1d<LatticeColorMatrix>& u,
+				 int mu, int length);
+
+    //! Apply "D_i" operator to the right onto source
+    LatticePropagator rightD(const LatticePropagator& F,
+			     const multi1d<LatticeColorMatrix>& u,
+			     int mu, int length);
+
+    //! Apply "B_i" operator to the right onto source
+    LatticePropagator rightB(const LatticePropagator& F,
+			     const multi1d<LatticeColorMatrix>& u,
+			     int mu, int length);
+
+    //! Apply "E_i" operator to the right onto source
+    LatticePropagator rightE(const LatticePropagator& F,
+			     const multi1d<LatticeColorMatrix>& u,
+			     int mu, int length);
+
+    //! Apply "Laplacian" operator to the right onto source
+    LatticePropagator rightLap(const LatticePropagator& F,
+			       const multi1d<LatticeColorMatrix>& u,
+			       int length);
+
+  protected:
+    //! Is there a named source to cache for?
+    bool cachingP() const {return (active && src_id.size() > 0 && max_bytes > 0);}
+
+    //! Return nabla_k nabla_j F. The reference is valid until the next lookup
+    const LatticePropagator& nabla2(const LatticePropagator& F,
+				    const multi1d<LatticeColorMatrix>& u,
+				    int j, int k, int length);
+
+    //! Find or build the entry of a path. The reference is valid until the next lookup
+    const LatticePropagator& displaceObject(const LatticePropagator& F,
+					    const multi1d<LatticeColorMatrix>& u,
+					    const KeyDispProp_t& key);
+
+    //! Evict least recently used entries, except keep, until one more fits
+    bool makeRoom(const LatticePropagator* keep);
+
+    //! Bytes of one propagator on this node
+    size_t propBytes() const;
+
+  private:
+    //! The value of the std::map
+    struct ValDispProp_t
+    {
+      LatticePropagator prop;
+      unsigned long     last_used;
+    };
+
+    size_t        max_bytes;     /*!< memory cap */
+    unsigned long clock;         /*!< LRU counter */
+    unsigned long builds;        /*!< nablas computed */
+    std::string   src_id;        /*!< name of the source, empty if none */
+    bool          active;        /*!< is a task using the source? */
+
+    //! Result of a path that did not fit under the cap
+    LatticePropagator scratch;
+
+    //! Maps of displaced propagators
+    std::map<KeyDispProp_t, ValDispProp_t> disp_map;
+  };
+
+
+  //! The one cache shared by all derivative displacements
+  typedef SingletonHolder<DispPropCache,
+			  QDP::CreateUsingNew,
+			  QDP::NoDestroy,
+			  QDP::SingleThreaded> TheDispPropCache;
+
+
+  //! Key of a displaced propagator for TheDispPropCache
+  /*!
+   * \param obj_id    named object being displaced, or empty if none ( Read )
+   * \param gauge_id  named gauge field ( Read )
+   * \param xml       XML of everything applied before the displacement ( Read )
+   *
+   * The named objects enter with their creation serial, so erasing and
+   * recreating either one changes the key. Every <Displacement> group is
+   * stripped from the XML, so operators differing only in their
+   * displacement share a key.
+   */
+  std::string dispPropSourceKey(const std::string& obj_id,
+				const std::string& gauge_id,
+				const std::string& xml);
+
+
+  //! Name the source of TheDispPropCache for the lifetime of this object
+  /*!
+   * Inline tasks that apply derivative displacements create one of these
+   * with the key of the propagator (or source) being displaced. On
+   * destruction, also when the task throws, caching stops but the entries
+   * stay, so the next task with the same key shares them.
+   */
+  class DispPropCacheSource
+  {
+  public:
+    //! Name the source
+    DispPropCacheSource(const std::string& id) {TheDispPropCache::Instance().setSource(id);}
+
+    //! Stop caching
+    ~DispPropCacheSource() {TheDispPropCache::Instance().release();}
+
+  private:
+    // Hide copies
+    DispPropCacheSource(const DispPropCacheSource&);
+    void operator=(const DispPropCacheSource&);
+  };
+
+  /*! @} */  // end of group smear
+
+} // namespace Chroma
+
+#endif
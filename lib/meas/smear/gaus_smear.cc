@@ -4,7 +4,7 @@
 
 #include "chromabase.h"
 #include "meas/smear/gaus_smear.h"
-#include "actions/boson/operator/klein_gord.h"
+#include "meas/smear/hopping_smear.h"
 
 namespace Chroma 
 {
@@ -25,18 +25,17 @@ namespace Chroma
 		 T& chi, 
 		 const Real& width, int ItrGaus, int j_decay)
   {
-    T psi;
-
     Real ftmp = - (width*width) / Real(4*ItrGaus);
     /* The Klein-Gordon operator is (Lapl + mass_sq), where Lapl = -d^2/dx^2.. */
-    /* We want (1 + ftmp * Lapl ) = (Lapl + 1/ftmp)*ftmp */
-    Real ftmpi = Real(1) / ftmp;
-  
-    for(int n = 0; n < ItrGaus; ++n)
-    {
-      psi = chi * ftmp;
-      klein_gord(u, psi, chi, ftmpi, j_decay);
-    }
+    /* We want (1 + ftmp * Lapl ) = 1 + ftmp*diag - ftmp*H, with the diagonal */
+    /* term of klein_gord */
+    Real diag = (j_decay < Nd) ? Real(2*Nd-2) : Real(2*Nd);
+
+    Real a = Real(1) + ftmp*diag;
+    Real b = -ftmp;
+
+    HoppingSmear hop(u, j_decay);
+    hop.smear(chi, a, b, ItrGaus);
   }
 
 
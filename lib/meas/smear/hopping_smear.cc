@@ -0,0 +1,39 @@
+/*! \file
+ *  \brief Iterated covariant hopping term for quark smearing
+ */
+
+#include "chromabase.h"
+#include "meas/smear/hopping_smear.h"
+
+namespace Chroma
+{
+
+  // Full constructor
+  HoppingSmear::HoppingSmear(const multi1d<LatticeColorMatrix>& u, int no_smear_dir)
+  {
+    START_CODE();
+
+    int num = 0;
+    for(int mu = 0; mu < Nd; ++mu)
+      if (mu != no_smear_dir)
+	++num;
+
+    dirs.resize(num);
+    u_fwd.resize(num);
+    u_bwd.resize(num);
+
+    int i = 0;
+    for(int mu = 0; mu < Nd; ++mu)
+    {
+      if (mu == no_smear_dir) continue;
+
+      dirs[i]  = mu;
+      u_fwd[i] = u[mu];
+      u_bwd[i] = adj(shift(u[mu], BACKWARD, mu));
+      ++i;
+    }
+
+    END_CODE();
+  }
+
+}  // end namespace Chroma
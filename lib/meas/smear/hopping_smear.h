@@ -0,0 +1,130 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Iterated covariant hopping term for quark smearing
+ */
+
+#ifndef __hopping_smear_h__
+#define __hopping_smear_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+
+  //! Iterated covariant hopping term
+  /*!
+   * \ingroup smear
+   *
+   * Applies many iterations of
+   *
+   *   chi  <-  a * chi  +  b * H chi        or     chi  <-  s_0 + b * H chi
+   *
+   * with the hopping term
+   *
+   *   H chi(x) = sum_{mu != no_smear_dir} [ U_mu(x) chi(x+mu) + U^dag_mu(x-mu) chi(x-mu) ]
+   *
+   * which is the kernel of Jacobi and Gaussian (Wuppertal) smearing.
+   *
+   * The backward links U^dag_mu(x-mu) are built once in the constructor,
+   * so every iteration only shifts chi itself. With the usual single
+   * unsmeared direction the whole update is one QDP++ expression: all
+   * halo exchanges of an iteration are posted together and overlap the
+   * interior sites, and each link loaded for a site is applied to every
+   * spin-colour column of a propagator. Two buffers are alternated so no
+   * copies are made between iterations.
+   */
+  class HoppingSmear
+  {
+  public:
+    //! Full constructor
+    /*!
+     * \param u             gauge field ( Read )
+     * \param no_smear_dir  no smearing in this direction ( Read )
+     */
+    HoppingSmear(const multi1d<LatticeColorMatrix>& u, int no_smear_dir);
+
+    //! Number of directions in the hopping term
+    int numDirs() const {return dirs.size();}
+
+    //! chi <- a*chi + b*H chi, iter times
+    template<typename T>
+    void smear(T& chi, const Real& a, const Real& b, int iter) const
+    {
+      iterate(chi, a, b, static_cast<const T*>(0), iter);
+    }
+
+    //! chi <- s_0 + b*H chi, iter times
+    template<typename T>
+    void smearFromSource(T& chi, const T& s_0, const Real& b, int iter) const
+    {
+      iterate(chi, Real(0), b, &s_0, iter);
+    }
+
+  private:
+    //! Hide default constructor
+    HoppingSmear() {}
+
+    //! Ping-pong between chi and a scratch field
+    template<typename T>
+    void iterate(T& chi, const Real& a, const Real& b, const T* s_0, int iter) const
+    {
+      START_CODE();
+
+      if (iter <= 0)
+	return;
+
+      T tmp;
+      T* in  = &chi;
+      T* out = &tmp;
+
+      for(int n = 0; n < iter; ++n)
+      {
+	update(*in, *out, a, b, s_0);
+
+	T* t = in;
+	in  = out;
+	out = t;
+      }
+
+      if (in != &chi)
+	chi = *in;
+
+      END_CODE();
+    }
+
+    //! out = a*in + b*H in  (or s_0 + b*H in) in one pass when possible
+    template<typename T>
+    void update(const T& in, T& out, const Real& a, const Real& b, const T* s_0) const
+    {
+      if (dirs.size() == 3)
+      {
+	if (s_0 != 0)
+	  out = *s_0 + b*(u_fwd[0]*shift(in, FORWARD, dirs[0]) + u_bwd[0]*shift(in, BACKWARD, dirs[0])
+			  + u_fwd[1]*shift(in, FORWARD, dirs[1]) + u_bwd[1]*shift(in, BACKWARD, dirs[1])
+			  + u_fwd[2]*shift(in, FORWARD, dirs[2]) + u_bwd[2]*shift(in, BACKWARD, dirs[2]));
+	else
+	  out = a*in + b*(u_fwd[0]*shift(in, FORWARD, dirs[0]) + u_bwd[0]*shift(in, BACKWARD, dirs[0])
+			  + u_fwd[1]*shift(in, FORWARD, dirs[1]) + u_bwd[1]*shift(in, BACKWARD, dirs[1])
+			  + u_fwd[2]*shift(in, FORWARD, dirs[2]) + u_bwd[2]*shift(in, BACKWARD, dirs[2]));
+      }
+      else
+      {
+	if (s_0 != 0)
+	  out = *s_0;
+	else
+	  out = a*in;
+
+	for(int i = 0; i < dirs.size(); ++i)
+	  out += b*(u_fwd[i]*shift(in, FORWARD, dirs[i]) + u_bwd[i]*shift(in, BACKWARD, dirs[i]));
+      }
+    }
+
+  private:
+    multi1d<int>                dirs;   /*!< smeared directions */
+    multi1d<LatticeColorMatrix> u_fwd;  /*!< U_mu(x) */
+    multi1d<LatticeColorMatrix> u_bwd;  /*!< U^dag_mu(x-mu) */
+  };
+
+}  // end namespace Chroma
+
+#endif
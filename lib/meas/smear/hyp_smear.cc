@@ -9,6 +9,30 @@
 
 namespace Chroma 
 { 
+  namespace
+  {
+    //! Compact index of the link in direction mu decorated in direction nu != mu
+    inline int pairIndex(int mu, int nu)
+    {
+      return (Nd-1)*mu + nu - ((nu > mu) ? 1 : 0);
+    }
+
+    //! Mix the link with its staple sum and project back onto SU(Nc)
+    /*! u_out may be the same object as u_stap */
+    void projectLink(const LatticeColorMatrix& u_mu,
+		     const LatticeColorMatrix& u_stap,
+		     const Real& ftmp1, const Real& ftmp2,
+		     LatticeColorMatrix& u_out,
+		     const Real& BlkAccu, int BlkMax)
+    {
+      LatticeColorMatrix u_tmp = adj(ftmp1*u_mu + ftmp2*u_stap);
+
+      u_out = u_mu;
+      sun_proj(u_tmp, u_out, BlkAccu, BlkMax);
+    }
+  }
+
+
   //! Construct the "hyp-smeared" links of Anna Hasenfratz
   /*!
    * \ingroup smear
@@ -16,6 +40,12 @@ namespace Chroma
    * Construct the "hyp-smeared" links of Anna Hasenfratz, with
    * staple coefficients alpha1, alpha2 and alpha3
    *
+   * The decorated links of each level are built plane by plane: the
+   * two links of a plane share one pair of forward shifted links, so
+   * only two shifted temporaries are live at any time besides the
+   * level 1 and level 2 links themselves, as in the original version.
+   * Products without shifts are single fused (threaded) QDP++ expressions.
+   *
    * Arguments:
    *
    *  \param u		gauge field (Read)
@@ -33,69 +63,65 @@ namespace Chroma
 		 const Real& BlkAccu, int BlkMax)
   {
     multi1d<LatticeColorMatrix> u_lv1(Nd*(Nd-1));
-    multi1d<LatticeColorMatrix> u_lv2(Nd*(Nd-1));
-    LatticeColorMatrix u_tmp;
-    LatticeColorMatrix tmp_1;
+    multi1d<LatticeColorMatrix> u_lv2;
+    multi1d<LatticeColorMatrix> u_stap;
+    LatticeColorMatrix u_mu_fwd;
+    LatticeColorMatrix u_nu_fwd;
+    LatticeColorMatrix stap_mu;
+    LatticeColorMatrix stap_nu;
     Real ftmp1;
     Real ftmp2;
-    int rho;
-    int sigma;
-    int ii;
-    int jj;
-    int kk;
 
     START_CODE();
   
     if (Nd > 4)
       QDP_error_exit("Hyp-smearing only implemented for Nd<=4",Nd);
 
+    u_hyp.resize(Nd);
 
     /*
      * Construct "level 1" smeared links in mu-direction with
-     * staples only in one orthogonal direction, nu
+     * staples only in one orthogonal direction, nu.
+     *
+     * Both links of the (mu,nu) plane are decorated from the same
+     * pair of forward shifted links and projected right away
      */
     ftmp1 = 1.0 - alpha3;
     ftmp2 = alpha3 / 2;
-    ii = -1;
     for(int mu = 0; mu < Nd; ++mu)
     {
-      for(int nu = 0; nu < Nd; ++nu)
+      for(int nu = mu+1; nu < Nd; ++nu)
       {
-	if(nu == mu) continue;
+	u_mu_fwd = shift(u[mu],FORWARD,nu);    // u(x+nu,mu)
+	u_nu_fwd = shift(u[nu],FORWARD,mu);    // u(x+mu,nu)
 
-	ii++;
 	/*
-	 * Forward staple
+	 * Forward + backward staple for the mu-link
 	 *
 	 * u_tmp(x) = u(x,nu)*u(x+nu,mu)*u_dag(x+mu,nu)
+	 *          + u_dag(x-nu,nu)*u(x-nu,mu)*u(x-nu+mu,nu)
 	 */
-	u_tmp = u[nu] * shift(u[mu],FORWARD,nu) * adj(shift(u[nu],FORWARD,mu));
-
-	/*
-	 * Backward staple
-	 *
-	 * u_tmp(x) += u_dag(x-nu,nu)*u(x-nu,mu)*u(x-nu+mu,nu)
-	 */
-	u_tmp += shift(adj(u[nu]) * u[mu] * shift(u[nu],FORWARD,mu),BACKWARD,nu);
+	stap_mu  = u[nu] * u_mu_fwd * adj(u_nu_fwd);
+	stap_mu += shift(adj(u[nu]) * u[mu] * u_nu_fwd,BACKWARD,nu);
 
 	/*
-	 * Unprojected level 1 link
+	 * Forward + backward staple for the nu-link
 	 */
-	tmp_1 = ftmp1*u[mu] + ftmp2*u_tmp;
-	u_tmp = adj(tmp_1);
+	stap_nu  = u[mu] * u_nu_fwd * adj(u_mu_fwd);
+	stap_nu += shift(adj(u[mu]) * u[nu] * u_mu_fwd,BACKWARD,mu);
 
 	/*
-	 * Project onto SU(Nc)
+	 * Project the unprojected level 1 links onto SU(Nc)
 	 */
 	if (Nd == 2)
 	{
-	  u_hyp[mu] = u[mu];
-	  sun_proj(u_tmp, u_hyp[mu], BlkAccu, BlkMax);
+	  projectLink(u[mu], stap_mu, ftmp1, ftmp2, u_hyp[mu], BlkAccu, BlkMax);
+	  projectLink(u[nu], stap_nu, ftmp1, ftmp2, u_hyp[nu], BlkAccu, BlkMax);
 	}
 	else
 	{
-	  u_lv1[ii] = u[mu];
-	  sun_proj(u_tmp, u_lv1[ii], BlkAccu, BlkMax);
+	  projectLink(u[mu], stap_mu, ftmp1, ftmp2, u_lv1[pairIndex(mu,nu)], BlkAccu, BlkMax);
+	  projectLink(u[nu], stap_nu, ftmp1, ftmp2, u_lv1[pairIndex(nu,mu)], BlkAccu, BlkMax);
 	}
       }
     }
@@ -105,54 +131,52 @@ namespace Chroma
       /*
        * Construct hyp-smeared links in mu-direction with
        * "level 1" staples in the orthogonal direction, nu,
-       * and the "level 1" links decorated in the 3-th orthogonal direction
+       * and the "level 1" links decorated in the 3-th orthogonal direction, rho
+       *
+       * The mu- and nu-links share the shifts of the (mu,nu) plane
        */
       ftmp1 = 1.0 - alpha2;
       ftmp2 = alpha2 / 4;
-      for(int mu = 0; mu < Nd; ++mu)
+      u_stap.resize(Nd);
+      u_stap = zero;
+      for(int rho = 0; rho < Nd; ++rho)
       {
-	u_tmp = 0;
-	for(int nu = 0; nu < Nd; ++nu)
+	for(int mu = 0; mu < Nd; ++mu)
 	{
-	  if(nu == mu) continue;
+	  if(mu == rho) continue;
 
-	  /* 3-th orthogonal direction: rho */
-	  for(jj = 0; jj < Nd; ++jj)
+	  for(int nu = mu+1; nu < Nd; ++nu)
 	  {
-	    if(jj != mu && jj != nu) rho = jj;
-	  }
-	  jj = (Nd-1)*mu + rho;
-	  if(rho > mu ) jj--;
-	  kk = (Nd-1)*nu + rho;
-	  if(rho > nu ) kk--;
+	    if(nu == rho) continue;
 
-	  /*
-	   * Forward staple
-	   *
-	   * u_tmp(x) += u_lv1(x,kk)*u_lv1(x+nu,jj)*u_lv1_dag(x+mu,kk)
-	   */
-	  u_tmp += u_lv1[kk] * shift(u_lv1[jj],FORWARD,nu) * adj(shift(u_lv1[kk],FORWARD,mu));
+	    int jj = pairIndex(mu,rho);
+	    int kk = pairIndex(nu,rho);
+	    u_mu_fwd = shift(u_lv1[jj],FORWARD,nu);    // u_lv1(x+nu,jj)
+	    u_nu_fwd = shift(u_lv1[kk],FORWARD,mu);    // u_lv1(x+mu,kk)
 
-	  /*
-	   * Backward staple
-	   *
-	   * u_tmp(x) += u_lv1_dag(x-nu,kk)*u_lv1(x-nu,jj)*u_lv1(x-nu+mu,kk)
-	   */
-	  u_tmp += shift(adj(u_lv1[kk]) * u_lv1[jj] * shift(u_lv1[kk],FORWARD,mu),BACKWARD,nu);
-	}
-
-	/*
-	 * Unprojected hyp-smeared link
-	 */
-	tmp_1 = ftmp1*u[mu] + ftmp2*u_tmp;
-	u_tmp = adj(tmp_1);
+	    /*
+	     * Forward + backward staple for the mu-link
+	     *
+	     * u_tmp(x) += u_lv1(x,kk)*u_lv1(x+nu,jj)*u_lv1_dag(x+mu,kk)
+	     *           + u_lv1_dag(x-nu,kk)*u_lv1(x-nu,jj)*u_lv1(x-nu+mu,kk)
+	     */
+	    u_stap[mu] += u_lv1[kk] * u_mu_fwd * adj(u_nu_fwd);
+	    u_stap[mu] += shift(adj(u_lv1[kk]) * u_lv1[jj] * u_nu_fwd,BACKWARD,nu);
 
-	/*
-	 * Project onto SU(Nc)
-	 */
-	u_hyp[mu] = u[mu];
-	sun_proj(u_tmp, u_hyp[mu], BlkAccu, BlkMax);
+	    /*
+	     * Forward + backward staple for the nu-link
+	     */
+	    u_stap[nu] += u_lv1[jj] * u_nu_fwd * adj(u_mu_fwd);
+	    u_stap[nu] += shift(adj(u_lv1[jj]) * u_lv1[kk] * u_mu_fwd,BACKWARD,mu);
+	  }
+	}
       }
+
+      /*
+       * Project the unprojected hyp-smeared links onto SU(Nc)
+       */
+      for(int mu = 0; mu < Nd; ++mu)
+	projectLink(u[mu], u_stap[mu], ftmp1, ftmp2, u_hyp[mu], BlkAccu, BlkMax);
     }
     else if (Nd == 4)
     {
@@ -160,58 +184,71 @@ namespace Chroma
        * Construct "level 2" smeared links in mu-direction with
        * "level 1" staples not in the orthogonal direction, nu,
        * and the "level 1" links decorated in the 4-th orthogonal direction
+       *
+       * The staple sums are accumulated in u_lv2 itself. For each
+       * decoration direction sigma the mu- and rho-links of the (mu,rho)
+       * plane share one pair of shifted level 1 links
        */
       ftmp1 = 1.0 - alpha2;
       ftmp2 = alpha2 / 4;
-      ii = -1;
-      for(int mu = 0; mu < Nd; ++mu)
+      u_lv2.resize(Nd*(Nd-1));
+      u_lv2 = zero;
+      for(int sigma = 0; sigma < Nd; ++sigma)
       {
-	for(int nu = 0; nu < Nd; ++nu)
+	for(int mu = 0; mu < Nd; ++mu)
 	{
-	  if(nu == mu) continue;
+	  if(mu == sigma) continue;
 
-	  ii++;
-	  u_tmp = 0;
-	  for(rho = 0; rho < Nd; ++rho)
+	  for(int rho = mu+1; rho < Nd; ++rho)
 	  {
-	    if(rho == mu || rho == nu) continue;
+	    if(rho == sigma) continue;
 
-	    /* 4-th orthogonal direction: sigma */
-	    for(jj = 0; jj < Nd; ++jj)
+	    /* the remaining direction nu labels the level 2 links */
+	    int nu = 0;
+	    for(int jj = 0; jj < Nd; ++jj)
 	    {
-	      if(jj != mu && jj != nu && jj != rho) sigma = jj;
+	      if(jj != mu && jj != rho && jj != sigma) nu = jj;
 	    }
-	    jj = (Nd-1)*mu + sigma;
-	    if(sigma > mu ) jj--;
-	    kk = (Nd-1)*rho + sigma;
-	    if(sigma > rho ) kk--;
+
+	    int jj = pairIndex(mu,sigma);
+	    int kk = pairIndex(rho,sigma);
+	    u_mu_fwd = shift(u_lv1[jj],FORWARD,rho);    // u_lv1(x+rho,jj)
+	    u_nu_fwd = shift(u_lv1[kk],FORWARD,mu);     // u_lv1(x+mu,kk)
 
 	    /*
-	     * Forward staple
+	     * Forward + backward staple for the mu-link
 	     *
 	     * u_tmp(x) += u_lv1(x,kk)*u_lv1(x+rho,jj)*u_lv1_dag(x+mu,kk)
+	     *           + u_lv1_dag(x-rho,kk)*u_lv1(x-rho,jj)*u_lv1(x-rho+mu,kk)
 	     */
-	    u_tmp += u_lv1[kk] * shift(u_lv1[jj],FORWARD,rho) * adj(shift(u_lv1[kk],FORWARD,mu));
+	    LatticeColorMatrix& lv2_mu = u_lv2[pairIndex(mu,nu)];
+	    lv2_mu += u_lv1[kk] * u_mu_fwd * adj(u_nu_fwd);
+	    lv2_mu += shift(adj(u_lv1[kk]) * u_lv1[jj] * u_nu_fwd,BACKWARD,rho);
 
 	    /*
-	     * Backward staple
-	     *
-	     * u_tmp(x) += u_lv1_dag(x-rho,kk)*u_lv1(x-rho,jj)*u_lv1(x-rho+mu,kk)
+	     * Forward + backward staple for the rho-link
 	     */
-	    u_tmp += shift(adj(u_lv1[kk]) * u_lv1[jj] * shift(u_lv1[kk],FORWARD,mu),BACKWARD,rho);
+	    LatticeColorMatrix& lv2_rho = u_lv2[pairIndex(rho,nu)];
+	    lv2_rho += u_lv1[jj] * u_nu_fwd * adj(u_mu_fwd);
+	    lv2_rho += shift(adj(u_lv1[jj]) * u_lv1[kk] * u_mu_fwd,BACKWARD,mu);
 	  }
+	}
+      }
 
-	  /*
-	   * Unprojected level 2 link
-	   */
-	  tmp_1 = ftmp1*u[mu] + ftmp2*u_tmp;
-	  u_tmp = adj(tmp_1);
+      // The level 1 links are not needed anymore
+      u_lv1.resize(0);
 
-	  /*
-	   * Project onto SU(Nc)
-	   */
-	  u_lv2[ii] = u[mu];
-	  sun_proj(u_tmp, u_lv2[ii], BlkAccu, BlkMax);
+      /*
+       * Project the unprojected level 2 links onto SU(Nc) in place
+       */
+      for(int mu = 0; mu < Nd; ++mu)
+      {
+	for(int nu = 0; nu < Nd; ++nu)
+	{
+	  if(nu == mu) continue;
+
+	  int ii = pairIndex(mu,nu);
+	  projectLink(u[mu], u_lv2[ii], ftmp1, ftmp2, u_lv2[ii], BlkAccu, BlkMax);
 	}
       }
 
@@ -219,48 +256,45 @@ namespace Chroma
        * Construct hyp-smeared links in mu-direction with
        * "level 2" staples in the orthogonal direction, nu,
        * and the "level 2" links not decorated in the mu and nu directions
+       *
+       * As in level 1, the mu- and nu-links of a plane share the shifts
        */
       ftmp1 = 1.0 - alpha1;
       ftmp2 = alpha1 / 6;
+      u_stap.resize(Nd);
+      u_stap = zero;
       for(int mu = 0; mu < Nd; ++mu)
       {
-	u_tmp = 0;
-	for(int nu = 0; nu < Nd; ++nu)
+	for(int nu = mu+1; nu < Nd; ++nu)
 	{
-	  if(nu == mu) continue;
+	  int jj = pairIndex(mu,nu);
+	  int kk = pairIndex(nu,mu);
 
-	  jj = (Nd-1)*mu + nu;
-	  if(nu > mu ) jj--;
-	  kk = (Nd-1)*nu + mu;
-	  if(mu > nu ) kk--;
+	  u_mu_fwd = shift(u_lv2[jj],FORWARD,nu);    // u_lv2(x+nu,jj)
+	  u_nu_fwd = shift(u_lv2[kk],FORWARD,mu);    // u_lv2(x+mu,kk)
 
 	  /*
-	   * Forward staple
+	   * Forward + backward staple for the mu-link
 	   *
 	   * u_tmp(x) += u_lv2(x,kk)*u_lv2(x+nu,jj)*u_lv2_dag(x+mu,kk)
+	   *           + u_lv2_dag(x-nu,kk)*u_lv2(x-nu,jj)*u_lv2(x-nu+mu,kk)
 	   */
-	  u_tmp += u_lv2[kk] * shift(u_lv2[jj],FORWARD,nu) * adj(shift(u_lv2[kk],FORWARD,mu));
+	  u_stap[mu] += u_lv2[kk] * u_mu_fwd * adj(u_nu_fwd);
+	  u_stap[mu] += shift(adj(u_lv2[kk]) * u_lv2[jj] * u_nu_fwd,BACKWARD,nu);
 
 	  /*
-	   * Backward staple
-	   *
-	   * u_tmp(x) += u_lv2_dag(x-nu,kk)*u_lv2(x-nu,jj)*u_lv2(x-nu+mu,kk)
+	   * Forward + backward staple for the nu-link
 	   */
-	  u_tmp += shift(adj(u_lv2[kk]) * u_lv2[jj] * shift(u_lv2[kk],FORWARD,mu),BACKWARD,nu);
+	  u_stap[nu] += u_lv2[jj] * u_nu_fwd * adj(u_mu_fwd);
+	  u_stap[nu] += shift(adj(u_lv2[jj]) * u_lv2[kk] * u_mu_fwd,BACKWARD,mu);
 	}
-
-	/*
-	 * Unprojected hyp-smeared link
-	 */
-	tmp_1 = ftmp1*u[mu] + ftmp2*u_tmp;
-	u_tmp = adj(tmp_1);
-
-	/*
-	 * Project onto SU(Nc)
-	 */
-	u_hyp[mu] = u[mu];
-	sun_proj(u_tmp, u_hyp[mu], BlkAccu, BlkMax);
       }
+
+      /*
+       * Project the unprojected hyp-smeared links onto SU(Nc)
+       */
+      for(int mu = 0; mu < Nd; ++mu)
+	projectLink(u[mu], u_stap[mu], ftmp1, ftmp2, u_hyp[mu], BlkAccu, BlkMax);
     }
 
     END_CODE();
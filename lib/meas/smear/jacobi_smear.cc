@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "meas/smear/jacobi_smear.h"
+#include "meas/smear/hopping_smear.h"
 
 namespace Chroma 
 {
@@ -24,28 +25,11 @@ namespace Chroma
 		     T& chi, 
 		     const Real& kappa, int iter, int no_smear_dir)
     {
-	T psi;
-	Real norm;
-
-	T s_0,h_smear;
-	s_0 = chi;
-
-	for(int n = 0; n < iter; ++n)
-	    {
-		psi = chi;
-		bool first = true;
-
-		for(int mu = 0; mu < Nd; ++mu )
-		    if( mu != no_smear_dir )
-			{
-			    if (first)
-				h_smear =  u[mu]*shift(psi, FORWARD, mu) + shift(adj(u[mu])*psi, BACKWARD, mu);
-			    else
-				h_smear += u[mu]*shift(psi, FORWARD, mu) + shift(adj(u[mu])*psi, BACKWARD, mu);
-			    first = false;
-			}
-		chi = s_0 + kappa * h_smear;
-	    }
+	T s_0 = chi;
+
+	// chi <- s_0 + kappa * H chi
+	HoppingSmear hop(u, no_smear_dir);
+	hop.smearFromSource(chi, s_0, kappa, iter);
     }
 
 
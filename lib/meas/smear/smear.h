@@ -21,6 +21,7 @@
 #include "hyp_smear3d.h"
 #include "ape_smear.h"
 #include "displacement.h"
+#include "disp_prop_cache.h"
 
 #include "quark_smearing.h"
 #include "quark_source_sink.h"
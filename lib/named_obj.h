@@ -16,10 +16,42 @@
 #include "chromabase.h"
 #include "handle.h"
 #include <map>
+#include <algorithm>
 #include <string>
 
 namespace Chroma
 {
+  //--------------------------------------------------------------------------------------
+  //! Memory of an object on this node
+  /*! @ingroup support
+   *
+   * Lattice objects and arrays of them are counted in full, other types
+   * by their shallow size.
+   */
+  template<typename T>
+  inline size_t namedObjectBytes(const T& d)
+  {
+    return sizeof(T);
+  }
+
+  //! Memory of a lattice object on this node
+  template<typename T>
+  inline size_t namedObjectBytes(const OLattice<T>& d)
+  {
+    return sizeof(T) * size_t(Layout::sitesOnNode());
+  }
+
+  //! Memory of an array on this node
+  template<typename T>
+  inline size_t namedObjectBytes(const multi1d<T>& d)
+  {
+    size_t bytes = sizeof(multi1d<T>);
+    for(int i=0; i < d.size(); ++i)
+      bytes += namedObjectBytes(d[i]);
+    return bytes;
+  }
+
+
   //--------------------------------------------------------------------------------------
   //! Typeinfo Hiding Base Clase
   /*! @ingroup support
@@ -53,6 +85,9 @@ namespace Chroma
     //! Getter
     virtual void getRecordXML(XMLBufferWriter& xml) const = 0;
 
+    //! Memory used by the data on this node
+    virtual size_t bytes() const = 0;
+
     // This is key for cleanup
     virtual ~NamedObjectBase() {}
   };
@@ -139,6 +174,16 @@ namespace Chroma
       return *data;
     }
 
+    //! Shared read-only view of the data, valid even after the object is erased
+    Handle<const T> getView() const {
+      return Handle<const T>(data);
+    }
+
+    //! Memory used by the data on this node
+    size_t bytes() const {
+      return namedObjectBytes(*data) + file_xml.size() + record_xml.size();
+    }
+
   private:
     Handle<T>   data;
     std::string file_xml;
@@ -149,12 +194,20 @@ namespace Chroma
   //--------------------------------------------------------------------------------------
   //! The Map Itself
   /*! @ingroup support
+   *
+   * Lookups (check, get, getData, getView, getMemory) do not modify the
+   * map, so any number of threads may look up objects at the same time
+   * without locking, provided objects are only created and erased from
+   * the master thread between parallel regions. The reference counts of
+   * the views are not atomic, so views should be taken and released on
+   * the master thread as well; threads share the object through a
+   * plain const reference.
    */
   class NamedObjectMap 
   {
   public:
     // Creation: clear the std::map
-    NamedObjectMap() {
+    NamedObjectMap() : peak_bytes(0), next_serial(0) {
       the_map.clear();
     };
 
@@ -198,6 +251,9 @@ namespace Chroma
         error_stream << "NamedObjectMap::create : error creating NamedObject for id= " << id << std::endl;
         throw error_stream.str();
       }
+
+      serials[id] = ++next_serial;
+      updatePeakMemory();
     }
 
     //! Create an entry of arbitrary type, with 1 parameter
@@ -224,6 +280,9 @@ namespace Chroma
         error_stream << "NamedObjectMap::create : error creating NamedObject for id= " << id << std::endl;
         throw error_stream.str();
       }
+
+      serials[id] = ++next_serial;
+      updatePeakMemory();
     }
 
 
@@ -238,6 +297,26 @@ namespace Chroma
     }
   
   
+    //! Serial number of the creation of an id
+    /*!
+     * Every create hands out a new serial, so an id that is erased and
+     * created again gets a different one. Caches of data derived from a
+     * named object can key on the serial to notice the object changed.
+     */
+    unsigned long getSerial(const std::string& id) const
+    {
+      std::map<std::string, unsigned long>::const_iterator iter = serials.find(id);
+      if (iter == serials.end()) 
+      {
+	std::ostringstream error_stream;
+        error_stream << "NamedObjectMap::getSerial : unknown id = " << id << std::endl;
+        throw error_stream.str();
+      }
+
+      return iter->second;
+    }
+  
+  
     //! Delete an item that we no longer neeed
     void erase(const std::string& id) 
     {
@@ -247,11 +326,15 @@ namespace Chroma
       // If found then delete it.
       if( iter != the_map.end() ) 
       { 
+	// The object may have grown since its creation
+	updatePeakMemory();
+
       	// Delete the data.of the record
 	delete iter->second;
 
 	// Delete the record
 	the_map.erase(iter);
+	serials.erase(id);
       }
       else 
       {
@@ -268,7 +351,43 @@ namespace Chroma
     {
       QDPIO::cout << "Available Keys are : " << std::endl;
       for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++) 
-	QDPIO::cout << j->first << std::endl;
+	QDPIO::cout << j->first << "   (" << j->second->bytes() << " bytes/node)" << std::endl;
+
+      QDPIO::cout << "Total memory = " << getMemory() << " bytes/node,  peak = " 
+		  << getPeakMemory() << " bytes/node" << std::endl;
+    }
+
+
+    //! Memory of an object on this node
+    size_t getMemory(const std::string& id) const
+    {
+      return get(id).bytes();
+    }
+
+    //! Memory of all objects on this node
+    size_t getMemory() const
+    {
+      size_t bytes = 0;
+      for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++) 
+	bytes += j->second->bytes();
+      return bytes;
+    }
+
+    //! Largest memory of all objects on this node seen so far
+    /*!
+     * The footprint is sampled at every create, erase and updatePeakMemory
+     * call. Objects are usually filled after their creation, so tasks that
+     * allocate large objects should call updatePeakMemory when done.
+     */
+    size_t getPeakMemory() const
+    {
+      return std::max(peak_bytes, getMemory());
+    }
+
+    //! Sample the current footprint for the peak
+    void updatePeakMemory()
+    {
+      peak_bytes = std::max(peak_bytes, getMemory());
     }
   
   
@@ -319,9 +438,25 @@ namespace Chroma
       return dynamic_cast<NamedObject<T>&>(get(id)).getData();
     }
 
+    //! Look something up and return a shared read-only view of the data
+    /*!
+     * The view avoids copying the object, and keeps it alive when it
+     * is erased from the map while still in use.
+     */
+    template<typename T>
+    Handle<const T> getView(const std::string& id) const 
+    {
+      return dynamic_cast<NamedObject<T>&>(get(id)).getView();
+    }
+
   private:
     typedef std::map<std::string, NamedObjectBase*> MapType_t;
     MapType_t the_map;
+    size_t    peak_bytes;
+
+    //! Creation serials of the ids
+    std::map<std::string, unsigned long> serials;
+    unsigned long next_serial;
   };
 
 }
@@ -19,6 +19,19 @@
 namespace Chroma 
 { 
 
+  //! Energy change and outcome of an HMC trajectory
+  /*! @ingroup hmc */
+  struct HMCTrjStatus
+  {
+    HMCTrjStatus() : DeltaH(zero), AccProb(zero), acceptP(false), WarmUpP(false) {}
+
+    Double DeltaH;     /*!< energy violation of the trajectory */
+    Double AccProb;    /*!< min(1, exp(-DeltaH)) */
+    bool   acceptP;    /*!< passed the accept/reject step */
+    bool   WarmUpP;    /*!< warm up trajectory, no accept/reject step */
+  };
+
+
   //! Abstract HMC trajectory
   /*! @ingroup hmc */
   template<typename P, typename Q>
@@ -169,6 +182,11 @@ namespace Chroma
       QDPIO::cout << "Delta H = " << DeltaH << std::endl;
       QDPIO::cout << "AccProb = " << AccProb << std::endl;
 
+      last_trj.DeltaH  = DeltaH;
+      last_trj.AccProb = AccProb;
+      last_trj.acceptP = true;
+      last_trj.WarmUpP = WarmUpP;
+
       // If we intend to do an accept reject step
       // (ie we are not warming up)
       if( ! WarmUpP ) 
@@ -180,6 +198,8 @@ namespace Chroma
 
 	QDPIO::cout << "AcceptP = " << acceptTestResult << std::endl;
 
+	last_trj.acceptP = acceptTestResult;
+
 	// If rejected restore fields
 	// If accepted no need to do anything
 	if ( ! acceptTestResult ) 
@@ -200,6 +220,16 @@ namespace Chroma
     
       END_CODE();
     }
+
+    //! Energy change and outcome of the last trajectory
+    const HMCTrjStatus& getLastTrajectory(void) const {
+      return last_trj;
+    }
+
+    //! Get at the MD integrator, e.g. to change its steps between trajectories
+    AbsMDIntegrator<P,Q>& getIntegrator(void) {
+      return getMDIntegrator();
+    }
     
   protected:
     // Get at the Exact Hamiltonian
@@ -218,6 +248,9 @@ namespace Chroma
     virtual void reverseCheckMetrics(Double& deltaQ, Double& deltaP,
 				     const AbsFieldState<P,Q>& s, 
 				     const AbsFieldState<P,Q>& s_old) const = 0;
+
+  private:
+    HMCTrjStatus last_trj;
   };
 
 } // end namespace chroma 
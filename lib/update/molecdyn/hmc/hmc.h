@@ -18,5 +18,6 @@
 #include "update/molecdyn/hmc/abs_hmc.h"
 #include "update/molecdyn/hmc/lcm_hmc.h"
 #include "update/molecdyn/hmc/const_lcm_hmc.h"
+#include "update/molecdyn/hmc/hmc_step_control.h"
 
 #endif
@@ -0,0 +1,265 @@
+/*! \file
+ * \brief Adaptive control of the HMC step count
+ */
+
+#include "update/molecdyn/hmc/hmc_step_control.h"
+#include "update/molecdyn/integrator/lcm_integrator_leaps.h"
+#include "io/xmllog_io.h"
+
+#include <cmath>
+
+namespace Chroma
+{
+
+  namespace
+  {
+    //! Mean DeltaH giving the acceptance rate p,  p = erfc(sqrt(<DeltaH>)/2)
+    double targetDeltaH(double p)
+    {
+      // Invert erfc by bisection, erfc falls monotonically
+      double lo = 0, hi = 6;
+      for(int iter=0; iter < 60; ++iter)
+      {
+	double mid = 0.5*(lo + hi);
+	if (erfc(mid) > p)
+	  lo = mid;
+	else
+	  hi = mid;
+      }
+
+      double x = 0.5*(lo + hi);
+      return 4*x*x;
+    }
+  }
+
+
+  // Default params
+  HMCStepControlParams::HMCStepControlParams()
+  {
+    enabledP = false;
+    target_acc_rate = 0.8;
+    interval = 10;
+    min_steps = 1;
+    max_steps = 1000;
+    order = 2;
+    production_adaptP = false;
+    n_steps = 0;
+  }
+
+
+  // Read params
+  HMCStepControlParams::HMCStepControlParams(XMLReader& xml, const std::string& path)
+  {
+    *this = HMCStepControlParams();
+
+    XMLReader paramtop(xml, path);
+
+    enabledP = true;
+    if (paramtop.count("EnabledP") > 0)
+      read(paramtop, "EnabledP", enabledP);
+
+    read(paramtop, "TargetAccRate", target_acc_rate);
+
+    if (paramtop.count("Interval") > 0)
+      read(paramtop, "Interval", interval);
+
+    if (paramtop.count("MinSteps") > 0)
+      read(paramtop, "MinSteps", min_steps);
+
+    if (paramtop.count("MaxSteps") > 0)
+      read(paramtop, "MaxSteps", max_steps);
+
+    if (paramtop.count("IntegratorOrder") > 0)
+      read(paramtop, "IntegratorOrder", order);
+
+    if (paramtop.count("AdaptInProduction") > 0)
+      read(paramtop, "AdaptInProduction", production_adaptP);
+
+    if (paramtop.count("NSteps") > 0)
+      read(paramtop, "NSteps", n_steps);
+
+    if (toBool(target_acc_rate <= zero) || toBool(target_acc_rate >= Real(1))
+	|| interval < 1 || min_steps < 1 || max_steps < min_steps || order < 1)
+    {
+      QDPIO::cerr << "HMCStepControlParams: invalid params" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+
+  // Read params
+  void read(XMLReader& xml, const std::string& path, HMCStepControlParams& p)
+  {
+    HMCStepControlParams tmp(xml, path);
+    p = tmp;
+  }
+
+
+  // Write params
+  void write(XMLWriter& xml, const std::string& path, const HMCStepControlParams& p)
+  {
+    push(xml, path);
+    write(xml, "EnabledP", p.enabledP);
+    write(xml, "TargetAccRate", p.target_acc_rate);
+    write(xml, "Interval", p.interval);
+    write(xml, "MinSteps", p.min_steps);
+    write(xml, "MaxSteps", p.max_steps);
+    write(xml, "IntegratorOrder", p.order);
+    write(xml, "AdaptInProduction", p.production_adaptP);
+    write(xml, "NSteps", p.n_steps);
+    pop(xml);
+  }
+
+
+  // Constructor
+  HMCStepControl::HMCStepControl(const HMCStepControlParams& p,
+				 AbsMDIntegrator<LCM,LCM>& MD_) :
+    params(p), MD(MD_),
+    n_trj(0), sum_dH(0), sum_exp_mdH(0), sum_acc_prob(0), seconds(0),
+    tot_acc_length(0), tot_seconds(0)
+  {
+    // Continue with the step count of a previous run
+    if (params.enabledP && params.n_steps > 0)
+    {
+      QDPIO::cout << "HMCStepControl: setting toplevel n_steps = " << params.n_steps << std::endl;
+      MD.setNSteps(params.n_steps);
+    }
+
+    params.n_steps = MD.getNSteps();
+
+    if (params.enabledP && params.n_steps <= 0)
+    {
+      QDPIO::cerr << "HMCStepControl: the toplevel integrator has no step count" << std::endl;
+      QDP_abort(1);
+    }
+
+    LCMMDIntegratorSteps::theForceNormStatistics::Instance().enable(params.enabledP);
+    LCMMDIntegratorSteps::theForceNormStatistics::Instance().reset();
+  }
+
+
+  // Write the statistics since the last adjustment
+  void HMCStepControl::report(XMLWriter& xml, const Real& traj_length) const
+  {
+    double tau = toDouble(traj_length);
+
+    push(xml, "HMCStepControl");
+    write(xml, "n_steps", params.n_steps);
+    write(xml, "n_trj", n_trj);
+    write(xml, "mean_DeltaH", sum_dH / n_trj);
+    write(xml, "mean_exp_mDeltaH", sum_exp_mdH / n_trj);
+    write(xml, "AccRate", sum_acc_prob / n_trj);
+
+    // Nothing accepted, no cost per accepted length
+    const bool acc_lengthP = (sum_acc_prob * tau > 0);
+    const bool tot_acc_lengthP = (tot_acc_length > 0);
+
+    if (acc_lengthP)
+      write(xml, "seconds_per_acc_unit_length", seconds / (sum_acc_prob * tau));
+    if (tot_acc_lengthP)
+      write(xml, "run_seconds_per_acc_unit_length", tot_seconds / tot_acc_length);
+
+    // Mean force norm per link of each monomial
+    typedef std::map<std::string, LCMMDIntegratorSteps::ForceNormStatistics::Stats> StatsMap;
+    const StatsMap& stats = LCMMDIntegratorSteps::theForceNormStatistics::Instance().getStats();
+
+    push(xml, "ForceNorms");
+    for(StatsMap::const_iterator s=stats.begin(); s != stats.end(); ++s)
+    {
+      push(xml, "elem");
+      write(xml, "monomial_id", s->first);
+      write(xml, "n_force", s->second.count);
+      write(xml, "F_mean", s->second.sum / s->second.count);
+      write(xml, "F_max", s->second.max);
+      pop(xml);
+
+      QDPIO::cout << "HMCStepControl:   " << s->first << "  |F| mean = " << s->second.sum / s->second.count
+		  << "  max = " << s->second.max << std::endl;
+    }
+    pop(xml);
+
+    pop(xml);
+
+    QDPIO::cout << "HMCStepControl: " << n_trj << " trajectories with n_steps = " << params.n_steps
+		<< ":  <DeltaH> = " << sum_dH / n_trj
+		<< "  <exp(-DeltaH)> = " << sum_exp_mdH / n_trj
+		<< "  AccRate = " << sum_acc_prob / n_trj << std::endl;
+    if (acc_lengthP && tot_acc_lengthP)
+      QDPIO::cout << "HMCStepControl: seconds per accepted unit of trajectory length = "
+		  << seconds / (sum_acc_prob * tau)
+		  << "  (whole run " << tot_seconds / tot_acc_length << ")" << std::endl;
+    else
+      QDPIO::cout << "HMCStepControl: no accepted trajectory length yet" << std::endl;
+  }
+
+
+  // Record a trajectory, and adapt the step count if it is time
+  void HMCStepControl::update(const HMCTrjStatus& trj, const Real& traj_length, double secs)
+  {
+    START_CODE();
+
+    // Nothing to record or report unless asked for
+    if (! params.enabledP)
+    {
+      END_CODE();
+      return;
+    }
+
+    double dH = toDouble(trj.DeltaH);
+    double acc_prob = toDouble(trj.AccProb);
+
+    ++n_trj;
+    sum_dH += dH;
+    sum_exp_mdH += exp(-dH);
+    sum_acc_prob += acc_prob;
+    seconds += secs;
+
+    tot_seconds += secs;
+    tot_acc_length += acc_prob * toDouble(traj_length);
+
+    if (n_trj < params.interval)
+    {
+      END_CODE();
+      return;
+    }
+
+    XMLWriter& xml_out = TheXMLOutputWriter::Instance();
+    report(xml_out, traj_length);
+
+    // Only between trajectories, and by default only in the warm up
+    if (trj.WarmUpP || params.production_adaptP)
+    {
+      double target = targetDeltaH(toDouble(params.target_acc_rate));
+
+      // A negative mean is noise, do not shrink by more than half
+      double mean = sum_dH / n_trj;
+      double ratio = (mean > 0) ? pow(mean / target, 1.0/(2*params.order)) : 0.5;
+      ratio = std::max(0.5, std::min(2.0, ratio));
+
+      int n_new = int(ceil(ratio * params.n_steps));
+      n_new = std::max(params.min_steps, std::min(params.max_steps, n_new));
+
+      if (n_new != params.n_steps)
+      {
+	QDPIO::cout << "HMCStepControl: target <DeltaH> = " << target
+		    << ",  n_steps " << params.n_steps << " -> " << n_new << std::endl;
+
+	push(xml_out, "HMCStepControlChange");
+	write(xml_out, "n_steps_old", params.n_steps);
+	write(xml_out, "n_steps_new", n_new);
+	pop(xml_out);
+
+	MD.setNSteps(n_new);
+	params.n_steps = n_new;
+      }
+    }
+
+    // Start the next interval
+    n_trj = 0;
+    sum_dH = sum_exp_mdH = sum_acc_prob = seconds = 0;
+    LCMMDIntegratorSteps::theForceNormStatistics::Instance().reset();
+
+    END_CODE();
+  }
+
+}
@@ -0,0 +1,96 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Adaptive control of the HMC step count
+ */
+
+#ifndef HMC_STEP_CONTROL_H
+#define HMC_STEP_CONTROL_H
+
+#include "chromabase.h"
+#include "handle.h"
+#include "update/molecdyn/hmc/abs_hmc.h"
+#include "update/molecdyn/integrator/abs_integrator.h"
+
+namespace Chroma
+{
+
+  //! Params of the adaptive step control
+  /*! @ingroup hmc */
+  struct HMCStepControlParams
+  {
+    HMCStepControlParams();
+    HMCStepControlParams(XMLReader& xml, const std::string& path);
+
+    bool   enabledP;           /*!< adapt the step count at all */
+    Real   target_acc_rate;    /*!< acceptance rate to aim for */
+    int    interval;           /*!< trajectories between two adjustments */
+    int    min_steps;          /*!< smallest step count of the toplevel integrator */
+    int    max_steps;          /*!< largest step count of the toplevel integrator */
+    int    order;              /*!< order of the integrator, <DeltaH> ~ dt^(2 order) */
+    bool   production_adaptP;  /*!< also adapt after the warm up */
+    int    n_steps;            /*!< current step count, 0 for the one of the integrator */
+  };
+
+  //! Read the step control params
+  /*! @ingroup hmc */
+  void read(XMLReader& xml, const std::string& path, HMCStepControlParams& p);
+
+  //! Write the step control params
+  /*! @ingroup hmc */
+  void write(XMLWriter& xml, const std::string& path, const HMCStepControlParams& p);
+
+
+  //! Adaptive control of the HMC step count
+  /*! @ingroup hmc
+   *
+   * Accumulates the energy violation of the trajectories, and the force
+   * norms of each monomial, and every  interval  trajectories sets the
+   * step count of the toplevel integrator so that the predicted
+   * acceptance rate,  erfc(sqrt(<DeltaH>)/2),  meets the target, with
+   * <DeltaH> scaled as  n_steps^(-2 order).
+   *
+   * The step count is only changed between trajectories, and by default
+   * only in the warm up, so the production Markov chain has fixed
+   * parameters. Every change is logged and kept in the params, so it is
+   * written into the restart file.
+   *
+   * Also reports the cost of the run, as the seconds per accepted unit of
+   * trajectory length.
+   */
+  class HMCStepControl
+  {
+  public:
+    typedef multi1d<LatticeColorMatrix>  LCM;
+
+    //! Constructor, sets the step count of the integrator if one is given
+    HMCStepControl(const HMCStepControlParams& p,
+		   AbsMDIntegrator<LCM,LCM>& MD);
+
+    //! Record a trajectory, and adapt the step count if it is time
+    void update(const HMCTrjStatus& trj, const Real& traj_length, double seconds);
+
+    //! Current params, including the current step count
+    const HMCStepControlParams& getParams(void) const { return params; }
+
+  private:
+    //! Write the statistics since the last adjustment
+    void report(XMLWriter& xml, const Real& traj_length) const;
+
+    HMCStepControlParams       params;
+    AbsMDIntegrator<LCM,LCM>&  MD;
+
+    // Statistics since the last adjustment
+    int     n_trj;          /*!< trajectories */
+    double  sum_dH;         /*!< sum of DeltaH */
+    double  sum_exp_mdH;    /*!< sum of exp(-DeltaH), should average to 1 */
+    double  sum_acc_prob;   /*!< sum of the acceptance probabilities */
+    double  seconds;        /*!< time of the trajectories */
+
+    // Statistics of the whole run
+    double  tot_acc_length; /*!< accepted trajectory length */
+    double  tot_seconds;    /*!< time of the trajectories */
+  };
+
+}
+
+#endif
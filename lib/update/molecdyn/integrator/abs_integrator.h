@@ -36,6 +36,15 @@ namespace Chroma
 
     //! Reset any chronological predictors for the integrator
     virtual void resetPredictors(void) const = 0;
+
+    //! Number of steps of this level, 0 if it has no step count
+    virtual int getNSteps(void) const { return 0; }
+
+    //! Change the number of steps of this level
+    virtual void setNSteps(int n_steps_) {
+      QDPIO::cerr << "setNSteps: this integrator has no step count" << std::endl;
+      QDP_abort(1);
+    }
   };
 
   //! MD component integrator that has a sub integrator (recursive)
@@ -108,6 +117,17 @@ namespace Chroma
     //! Get the trajectory length
     virtual Real getTrajLength(void) const = 0;
 
+    //! Number of steps of the toplevel sub integrator
+    virtual int getNSteps(void) const {
+      return getIntegrator().getNSteps();
+    }
+
+    //! Change the number of steps of the toplevel sub integrator
+    /*! Only to be called between trajectories */
+    virtual void setNSteps(int n_steps_) {
+      getIntegrator().setNSteps(n_steps_);
+    }
+
     //! Copy equivalent fields into MD monomals before integration
     /*! It is up to the toplevel integrator to keep track of which 
         fields it needs to copy internally so that this function doesn't
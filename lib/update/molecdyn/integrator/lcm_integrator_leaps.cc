@@ -10,6 +10,31 @@ namespace Chroma
   namespace LCMMDIntegratorSteps 
   { 
 
+    // Record the force of the monomial id
+    void ForceNormStatistics::add(const std::string& id, const multi1d<LatticeColorMatrix>& F)
+    {
+      Double f2 = norm2(F[0]);
+      for(int mu=1; mu < F.size(); ++mu)
+	f2 += norm2(F[mu]);
+
+      double f = toDouble(sqrt(f2 / Double(F.size()*Layout::vol())));
+
+      std::map<std::string, Stats>::iterator s = stats.find(id);
+      if (s == stats.end())
+      {
+	Stats first = {1, f, f};
+	stats[id] = first;
+      }
+      else
+      {
+	s->second.count += 1;
+	s->second.sum += f;
+	if (f > s->second.max)
+	  s->second.max = f;
+      }
+    }
+
+
     //! LeapP for just a selected list of monomials
     void leapP(const multi1d< IntegratorShared::MonomialPair >& monomials,
 	                                       
@@ -46,6 +71,10 @@ namespace Chroma
 	swatch.reset(); swatch.start();
 	monomials[0].mon->dsdq(dsdQ,s);
 	swatch.stop();
+	if (theForceNormStatistics::Instance().isEnabled())
+	  theForceNormStatistics::Instance().add(monomials[0].id, dsdQ);
+	if (theMDEnergyTrace::Instance().isEnabled())
+	  theMDEnergyTrace::Instance().leapP(monomials[0].id, dt, real_step_size, s.getP(), dsdQ);
 	QDPIO::cout << "FORCE TIME: " << monomials[0].id <<  " : " << swatch.getTimeInSeconds() << std::endl;
 	pop(xml_out); //elem
 	for(int i=1; i < monomials.size(); i++) { 
@@ -54,12 +83,20 @@ namespace Chroma
 	  swatch.reset(); swatch.start();
 	  monomials[i].mon->dsdq(cur_F, s);
 	  swatch.stop();
+	  if (theForceNormStatistics::Instance().isEnabled())
+	    theForceNormStatistics::Instance().add(monomials[i].id, cur_F);
+	  if (theMDEnergyTrace::Instance().isEnabled())
+	    theMDEnergyTrace::Instance().leapP(monomials[i].id, dt, real_step_size, s.getP(), cur_F);
 	  dsdQ += cur_F;
 
 	  QDPIO::cout << "FORCE TIME: " << monomials[i].id << " : " << swatch.getTimeInSeconds() << "\n";
  
 	  pop(xml_out); // elem
 	}
+
+	// The kick as a whole, for the shadow Hamiltonian of the level
+	if (monomials.size() > 1 && theMDEnergyTrace::Instance().isEnabled())
+	  theMDEnergyTrace::Instance().leapP("", dt, real_step_size, s.getP(), dsdQ);
       }
       pop(xml_out); // ForcesByMonomial
       //monitorForces(xml_out, "TotalForcesThisLevel", dsdQ);
@@ -127,6 +164,9 @@ namespace Chroma
 	reunit((s.getQ())[mu], numbad, REUNITARIZE_ERROR);
       }
 
+      if (theMDEnergyTrace::Instance().isEnabled())
+	theMDEnergyTrace::Instance().leapQ(dt);
+
       pop(xml_out);
     
       END_CODE();
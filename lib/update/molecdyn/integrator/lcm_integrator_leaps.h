@@ -10,6 +10,7 @@
 #include "singleton.h"
 #include "update/molecdyn/hamiltonian/abs_hamiltonian.h"
 #include "update/molecdyn/integrator/integrator_shared.h"
+#include "update/molecdyn/integrator/lcm_md_energy_trace.h"
 namespace Chroma 
 {
 
@@ -53,6 +54,40 @@ namespace Chroma
 
     typedef SingletonHolder<  AnisoStepSizeArray > theAnisoStepSizeArray;
 
+
+    //! Running statistics of the force of each monomial
+    /*! Filled by leapP when enabled, for step size control */
+    class ForceNormStatistics {
+    public:
+      //! Sums of the force norms of one monomial
+      struct Stats {
+	int    count;      /*!< number of force evaluations */
+	double sum;        /*!< sum of the norms per link */
+	double max;        /*!< largest norm per link */
+      };
+
+      ForceNormStatistics() : enabledP(false) {}
+
+      inline void enable(bool enabledP_) { enabledP = enabledP_; }
+
+      inline bool isEnabled() const { return enabledP; }
+
+      //! Record the force of the monomial id
+      void add(const std::string& id, const multi1d<LatticeColorMatrix>& F);
+
+      //! Forget all the forces recorded so far
+      inline void reset() { stats.clear(); }
+
+      //! Statistics by monomial id
+      inline const std::map<std::string, Stats>& getStats() const { return stats; }
+
+    private:
+      bool enabledP;
+      std::map<std::string, Stats> stats;
+    };
+
+    typedef SingletonHolder< ForceNormStatistics > theForceNormStatistics;
+
     //! Leap with Q (with all monomials)
     /*! @ingroup integrator */
     void leapQ(const Real& dt, 
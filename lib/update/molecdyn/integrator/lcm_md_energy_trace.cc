@@ -0,0 +1,120 @@
+/*! @file
+ * @brief Per step energy trace of the MD integration
+ */
+
+#include "update/molecdyn/integrator/lcm_md_energy_trace.h"
+
+namespace Chroma
+{
+
+  namespace LCMMDIntegratorSteps
+  {
+
+    // Start tracing into the file
+    void MDEnergyTrace::open(const std::string& file)
+    {
+      close();
+
+      file_base = file;
+      monomial_ids.clear();
+      enabledP = true;
+    }
+
+
+    // Stop tracing
+    void MDEnergyTrace::close()
+    {
+      if (fileP)
+      {
+	bin.close();
+	fileP = false;
+      }
+      enabledP = false;
+    }
+
+
+    // Write one record
+    void MDEnergyTrace::record(int kind, int mon, double dt, double x, double y)
+    {
+      write(bin, kind);
+      write(bin, mon);
+      write(bin, dt);
+      write(bin, x);
+      write(bin, y);
+    }
+
+
+    // Record the start of a trajectory
+    void MDEnergyTrace::beginTrajectory(const multi1d<LatticeColorMatrix>& p, const Real& traj_length)
+    {
+      if (! fileP)
+      {
+	std::ostringstream file;
+	file << file_base << "." << first_traj;
+
+	QDPIO::cout << "MDEnergyTrace: tracing the MD energy into " << file.str() << std::endl;
+
+	bin.open(file.str());
+	writeDesc(bin, "ChromaMDEnergyTrace");
+	write(bin, int(1));  // format version
+	fileP = true;
+      }
+
+      record(TRJ_BEGIN, -1, 0, toDouble(norm2(p)), toDouble(traj_length));
+    }
+
+
+    // Record the end of a trajectory
+    void MDEnergyTrace::endTrajectory(const multi1d<LatticeColorMatrix>& p)
+    {
+      record(TRJ_END, -1, 0, toDouble(norm2(p)), 0);
+      bin.flush();
+    }
+
+
+    // Record the force of a monomial
+    void MDEnergyTrace::leapP(const std::string& id, const Real& dt,
+			      const multi1d<Real>& step_size,
+			      const multi1d<LatticeColorMatrix>& p,
+			      const multi1d<LatticeColorMatrix>& F)
+    {
+      int mon = -1;
+      if (id.size() > 0)
+      {
+	std::map<std::string, int>::const_iterator m = monomial_ids.find(id);
+	if (m == monomial_ids.end())
+	{
+	  mon = monomial_ids.size();
+	  monomial_ids[id] = mon;
+
+	  record(MONOMIAL, mon, 0, 0, 0);
+	  writeDesc(bin, id);
+	}
+	else
+	  mon = m->second;
+      }
+
+      // Both terms in one global sum
+      LatticeReal pf = step_size[0] * localInnerProductReal(p[0], F[0]);
+      LatticeReal ff = step_size[0] * step_size[0] * localNorm2(F[0]);
+      for(int mu=1; mu < Nd; ++mu)
+      {
+	pf += step_size[mu] * localInnerProductReal(p[mu], F[mu]);
+	ff += step_size[mu] * step_size[mu] * localNorm2(F[mu]);
+      }
+
+      DComplex terms = sum(cmplx(pf, ff));
+
+      record(LEAP_P, mon, toDouble(dt), toDouble(real(terms)), toDouble(imag(terms)));
+    }
+
+
+    // Record an update of the gauge field
+    void MDEnergyTrace::leapQ(const Real& dt)
+    {
+      record(LEAP_Q, -1, toDouble(dt), 0, 0);
+    }
+
+  }
+
+}
@@ -0,0 +1,107 @@
+// -*- C++ -*-
+/*! @file
+ * @brief Per step energy trace of the MD integration
+ */
+
+#ifndef LCM_MD_ENERGY_TRACE_H
+#define LCM_MD_ENERGY_TRACE_H
+
+#include "chromabase.h"
+#include "singleton.h"
+
+#include <map>
+
+namespace Chroma
+{
+
+  namespace LCMMDIntegratorSteps
+  {
+    //! Per step energy trace of the MD integration
+    /*! @ingroup integrator
+     *
+     * Records, for every leap of every trajectory, the terms that decide how
+     * the energy moves along the trajectory. Only forces already computed by
+     * leapP are used, at the price of one global sum per monomial and step,
+     * so the integrator can be tuned afterwards from the trace alone.
+     *
+     * The trace is a QDP binary file (big endian), written by the primary
+     * node. After the header, the string "ChromaMDEnergyTrace" and the int
+     * format version, follow records of
+     *
+     *    int kind, int monomial, double dt, double x, double y
+     *
+     * with kind
+     *
+     *    MONOMIAL   the name of monomial (a QDP string) follows the record
+     *    TRJ_BEGIN  x = KE = |P|^2 at the start of a trajectory, y = tau0
+     *    LEAP_P     a force kick. x = sum_mu dt_mu Re <P_mu, F_mu> with P before
+     *               the kick, y = sum_mu dt_mu^2 |F_mu|^2. monomial = -1 for
+     *               the sum of the forces of the kick
+     *    LEAP_Q     a gauge field update with step dt
+     *    TRJ_END    x = KE at the end of the trajectory
+     *
+     * where dt_mu is dt with the anisotropy factor of direction mu.
+     *
+     * A kick changes the kinetic energy by exactly 2x + y. The y of a
+     * monomial is its  {S,{S,T}}  term of the shadow Hamiltonian, and the
+     * change of x from kick to kick estimates  {T,{T,S}},  the other term
+     * of the dt^2 error of the integrator.
+     */
+    class MDEnergyTrace {
+    public:
+      //! Kinds of record
+      enum RecordKind { MONOMIAL = 0, TRJ_BEGIN = 1, LEAP_P = 2, LEAP_Q = 3, TRJ_END = 4 };
+
+      MDEnergyTrace() : enabledP(false), fileP(false), first_traj(0) {}
+
+      //! Start tracing into the file
+      /*!
+       * The trace goes into  file.N,  with N the number of the first
+       * trajectory traced, so a restarted run never overwrites the trace
+       * of an earlier part of the chain. The file is opened with the
+       * first trajectory.
+       */
+      void open(const std::string& file);
+
+      //! Number of the first trajectory traced, for the file name
+      void setFirstTrajectory(unsigned long n) { first_traj = n; }
+
+      //! Stop tracing
+      void close();
+
+      inline bool isEnabled() const { return enabledP; }
+
+      //! Record the start of a trajectory
+      void beginTrajectory(const multi1d<LatticeColorMatrix>& p, const Real& traj_length);
+
+      //! Record the end of a trajectory
+      void endTrajectory(const multi1d<LatticeColorMatrix>& p);
+
+      //! Record the force of the monomial id, before it kicks the momenta p
+      /*! An empty id stands for the sum of the forces of the kick */
+      void leapP(const std::string& id, const Real& dt,
+		 const multi1d<Real>& step_size,
+		 const multi1d<LatticeColorMatrix>& p,
+		 const multi1d<LatticeColorMatrix>& F);
+
+      //! Record an update of the gauge field
+      void leapQ(const Real& dt);
+
+    private:
+      void record(int kind, int mon, double dt, double x, double y);
+
+      bool enabledP;
+      bool fileP;                  /*!< the trace file is open */
+      std::string file_base;       /*!< trace file name before the trajectory number */
+      unsigned long first_traj;    /*!< number of the first trajectory traced */
+      BinaryFileWriter bin;
+      std::map<std::string, int> monomial_ids;
+    };
+
+    typedef SingletonHolder< MDEnergyTrace > theMDEnergyTrace;
+
+  }
+
+}
+
+#endif
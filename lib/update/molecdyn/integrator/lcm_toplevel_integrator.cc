@@ -62,6 +62,12 @@ namespace Chroma {
 	  xi_mom = 1;
 	}
 
+	// Per step energy trace (Optional)
+	energy_trace_file = "";
+	if( paramtop.count("EnergyTraceFile") == 1 ) { 
+	  read(paramtop, "EnergyTraceFile", energy_trace_file);
+	}
+
       }
       catch(const std::string& e) { 
 	QDPIO::cout << "Caught Exception Reading XML: " << e << std::endl;
@@ -92,6 +98,9 @@ namespace Chroma {
       write(xml, "t_dir", p.t_dir);
       write(xml, "xi_mom", p.xi_mom);
     }
+    if( p.energy_trace_file.size() > 0 ) {
+      write(xml, "EnergyTraceFile", p.energy_trace_file);
+    }
     pop(xml);
   }
 
@@ -125,6 +134,28 @@ namespace Chroma {
 	LCMMDIntegratorSteps::theAnisoStepSizeArray::Instance().setAnisoStepSize(p.t_dir, factor);
 
       }
+
+      if ( p.energy_trace_file.size() > 0 ) { 
+	LCMMDIntegratorSteps::theMDEnergyTrace::Instance().open(p.energy_trace_file);
+      }
+  }
+
+  void LCMToplevelIntegrator::operator()(AbsFieldState< multi1d<LatticeColorMatrix>,
+					                multi1d<LatticeColorMatrix> >& s,
+					 const Real& trajLength) const {
+      LCMMDIntegratorSteps::MDEnergyTrace& trace = 
+	LCMMDIntegratorSteps::theMDEnergyTrace::Instance();
+
+      if ( trace.isEnabled() ) { 
+	trace.beginTrajectory(s.getP(), trajLength);
+      }
+
+      AbsMDIntegrator< multi1d<LatticeColorMatrix>, 
+	               multi1d<LatticeColorMatrix> >::operator()(s, trajLength);
+
+      if ( trace.isEnabled() ) { 
+	trace.endTrajectory(s.getP());
+      }
   }
     
   void LCMToplevelIntegrator::copyFields(void) const { 
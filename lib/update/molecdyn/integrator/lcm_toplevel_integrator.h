@@ -34,7 +34,7 @@ namespace Chroma {
     bool anisoP;
     int t_dir;
     Real xi_mom;
-
+    std::string energy_trace_file;   /*!< per step energy trace, file.N for first trajectory N, none if empty */
   };
 
   //! Read the Integrator Params
@@ -58,6 +58,11 @@ namespace Chroma {
     //! Destructor is automagic
     ~LCMToplevelIntegrator() {} 
 
+    //! Do the trajectory, tracing the energy if asked for
+    void operator()(AbsFieldState< multi1d<LatticeColorMatrix>,
+		                   multi1d<LatticeColorMatrix> >& s,
+		    const Real& trajLength) const;
+
     //! Get the length of a trajectory
     Real getTrajLength(void) const { 
       return params.tau0;
@@ -89,6 +89,16 @@ namespace Chroma
       return (*SubIntegrator);
     }
 
+    //! Number of steps of this level
+    int getNSteps(void) const {
+      return n_steps;
+    }
+
+    //! Change the number of steps of this level
+    void setNSteps(int n_steps_) {
+      n_steps = n_steps_;
+    }
+
   protected:
     //! Refresh fields in just this level
     void refreshFieldsThisLevel(AbsFieldState<multi1d<LatticeColorMatrix>,
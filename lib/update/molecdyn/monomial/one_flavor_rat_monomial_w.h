@@ -23,6 +23,11 @@ namespace Chroma
    * Exact 1 flavor fermact monomial using Rational Polynomial. 
    * Preconditioning is not specified yet.
    * Can supply a default dsdq and pseudoferm refresh algorithm
+   *
+   * The multi-shift inversions of all the pseudoferms are done as one
+   * block (MdagMMultiSystemSolver::solveMultiRHS). Its solutions and search
+   * directions take 2 NPF x npoles fermions at once, instead of 2 npoles
+   * when the pseudoferms are inverted one after the other.
    */
   template<typename P, typename Q, typename Phi>
   class OneFlavorRatExactWilsonTypeFermMonomial : public ExactWilsonTypeFermMonomial<P,Q,Phi>
@@ -82,22 +87,24 @@ namespace Chroma
       // Partial Fraction Expansion coeffs for force
       const RemezCoeff_t& fpfe = getFPFE();
 
-      multi1d<Phi> X;
       Phi Y;
 
       P  F_1;
       F.resize(Nd);
       F = zero;
 
+      // The multi-shift inversion of all the pseudoferms at once
+      multi1d< multi1d<Phi> > X_pf;
+      multi1d<SystemSolverResults_t> res = invMdagM->solveMultiRHS(X_pf, fpfe.pole, getPhi());
+
       // Loop over all the pseudoferms
       multi1d<int> n_count(getNPF());
       QDPIO::cout << "num_pf = " << getNPF() << std::endl;
 
       for(int n=0; n < getNPF(); ++n)
       {
-	// The multi-shift inversion
-	SystemSolverResults_t res = (*invMdagM)(X, fpfe.pole, getPhi()[n]);
-	n_count[n] = res.n_count;
+	const multi1d<Phi>& X = X_pf[n];
+	n_count[n] = res[n].n_count;
 
 	// Loop over solns and accumulate force contributions
 
@@ -202,32 +209,41 @@ namespace Chroma
       // Loop over pseudoferms
       getPhi().resize(getNPF());
       multi1d<int> n_count(getNPF());
-      Phi eta;
+      multi1d<Phi> eta(getNPF());
 
       for(int n=0; n < getNPF(); ++n)
       {
 	// Fill the eta field with gaussian noise
-	eta = zero;
-	gaussian(eta, M->subset());
+	eta[n] = zero;
+	gaussian(eta[n], M->subset());
       
 	// Account for fermion BC by modifying the proposed field
-	FA.getFermBC().modifyF(eta);
+	FA.getFermBC().modifyF(eta[n]);
 
 	// Temporary: Move to correct normalisation
-	eta *= sqrt(0.5);
-      
+	eta[n] *= sqrt(0.5);
+      }
+
+#if 1
+      // The multi-shift inversion of all the pseudoferms at once
+      multi1d< multi1d<Phi> > X_pf;
+      multi1d<SystemSolverResults_t> res_pf = invMdagM->solveMultiRHS(X_pf, sipfe.pole, eta);
+#endif
+
+      for(int n=0; n < getNPF(); ++n)
+      {
 	// The multi-shift inversion
 #if 1
-	multi1d<Phi> X;
-	SystemSolverResults_t res = (*invMdagM)(X, sipfe.pole, eta);
+	const multi1d<Phi>& X = X_pf[n];
+	const SystemSolverResults_t& res = res_pf[n];
 #else
-	SystemSolverResults_t res = (*invMdagM)(getPhi()[n], sipfe.norm, sipfe.res,sipfe.pole, eta);
+	SystemSolverResults_t res = (*invMdagM)(getPhi()[n], sipfe.norm, sipfe.res,sipfe.pole, eta[n]);
 #endif
 	n_count[n] = res.n_count;
 
 	// Weight solns to make final PF field
 #if 1
-	getPhi()[n][M->subset()] = sipfe.norm * eta;
+	getPhi()[n][M->subset()] = sipfe.norm * eta[n];
 	for(int i=0; i < X.size(); ++i)
 	  getPhi()[n][M->subset()] += sipfe.res[i] * X[i];
 #endif
@@ -300,7 +316,9 @@ namespace Chroma
       // Compute energy
       // Get X out here via multisolver
 #if 1
-      multi1d<Phi> X;
+      // The multi-shift inversion of all the pseudoferms at once
+      multi1d< multi1d<Phi> > X_pf;
+      multi1d<SystemSolverResults_t> res_pf = invMdagM->solveMultiRHS(X_pf, spfe.pole, getPhi());
 #endif
       // Loop over all the pseudoferms
       multi1d<int> n_count(getNPF());
@@ -313,8 +331,9 @@ namespace Chroma
 	// The multi-shift inversion
 	SystemSolverResults_t res = (*invMdagM)(psi, spfe.norm, spfe.res,spfe.pole, getPhi()[n]);
 #else
-	// The multi-shift inversion
-	SystemSolverResults_t res = (*invMdagM)(X, spfe.pole, getPhi()[n]);
+	// The multi-shift inversion, done above for all the pseudoferms
+	const multi1d<Phi>& X = X_pf[n];
+	const SystemSolverResults_t& res = res_pf[n];
 #endif
 	n_count[n] = res.n_count;
 	LatticeDouble site_S=zero;
@@ -23,6 +23,11 @@ namespace Chroma
    * Exact 1 flavor fermact monomial using Rational Polynomial. 
    * Preconditioning is not specified yet.
    * Can supply a default dsdq and pseudoferm refresh algorithm
+   *
+   * The multi-shift inversions of all the pseudoferms are done as one
+   * block (MdagMMultiSystemSolver::solveMultiRHS). Its solutions and search
+   * directions take 2 NPF x npoles fermions at once, instead of 2 npoles
+   * when the pseudoferms are inverted one after the other.
    */
   template<typename P, typename Q, typename Phi>
   class OneFlavorRatioRatConvExactWilsonTypeFermMonomial : public ExactWilsonTypeFermMonomial<P,Q,Phi>
@@ -91,47 +96,42 @@ namespace Chroma
       // Partial Fraction Expansion coeffs for force
       const RemezCoeff_t& fpfe_num = getNumerFPFE();
 
-      multi1d<Phi> X;
-      Phi Y;
-
-      P  F_1, F_2, F_tmp(Nd);
+      P  F_1;
       F.resize(Nd);
       F = zero;
 
+      // M_dag_den phi = M^{dag}_den \phi - the RHS of each pseudoferm
+      multi1d<Phi> M_dag_den_phi;
+      M_den->applyMultiRHS(M_dag_den_phi, getPhi(), MINUS);
+
+      // The multi-shift inversion of all the pseudoferms at once
+      multi1d< multi1d<Phi> > X_pf;
+      multi1d<SystemSolverResults_t> res = invMdagM_num->solveMultiRHS(X_pf, fpfe_num.pole, M_dag_den_phi);
+
       // Loop over all the pseudoferms
       multi1d<int> n_count(getNPF());
 
       for(int n=0; n < getNPF(); ++n)
       {
-	// M_dag_den phi = M^{dag}_den \phi - the RHS
-	Phi M_dag_den_phi;
-	(*M_den)(M_dag_den_phi, getPhi()[n], MINUS);
+	const multi1d<Phi>& X = X_pf[n];
+	n_count[n] = res[n].n_count;
 
-	// The multi-shift inversion
-	SystemSolverResults_t res = (*invMdagM_num)(X, fpfe_num.pole, M_dag_den_phi);
-	n_count[n] = res.n_count;
-
-	// Loop over solns and accumulate force contributions
-	F_tmp = zero;
+	// Weight the solutions with the residues, and accumulate the
+	// force contributions of all poles in one pass
+	multi1d<Phi> Y(X.size());
 	for(int i=0; i < X.size(); ++i)
 	{
-	  (*M_num)(Y, X[i], PLUS);
-
-	  // The  d(M^dag)*M  term
-	  M_num->deriv(F_1, X[i], Y, MINUS);
-      
-	  // The  M^dag*d(M)  term
-	  M_num->deriv(F_2, Y, X[i], PLUS);
-	  F_1 += F_2;
-
-	  // Reweight each contribution in partial fraction
-	  for(int mu=0; mu < F.size(); mu++)
-	    F_tmp[mu] -= fpfe_num.res[i] * F_1[mu];
+	  (*M_num)(Y[i], X[i], PLUS);
+	  Y[i] *= -fpfe_num.res[i];
 	}
 
-	// Concious choice. Don't monitor forces by pole 
-	// Just accumulate it
-	F += F_tmp;
+	// The  d(M^dag)*M  term
+	M_num->derivMultipole(F_1, X, Y, MINUS);
+	F += F_1;
+
+	// The  M^dag*d(M)  term
+	M_num->derivMultipole(F_1, Y, X, PLUS);
+	F += F_1;
       }
 
       state->deriv(F);
@@ -196,29 +196,33 @@ namespace Chroma
       // Loop over pseudoferms
       getPhi().resize(getNPF());
       multi1d<int> n_count(getNPF());
-      Phi eta;
+      multi1d<Phi> eta(getNPF());
 
       for(int n=0; n < getNPF(); ++n)
       {
 	// Fill the eta field with gaussian noise
-	eta = zero;
-	gaussian(eta, M_num->subset());
+	eta[n] = zero;
+	gaussian(eta[n], M_num->subset());
       
 	// Account for fermion BC by modifying the proposed field
-	FA_num.getFermBC().modifyF(eta);
+	FA_num.getFermBC().modifyF(eta[n]);
 
 	// Temporary: Move to correct normalisation
-	eta *= sqrt(0.5);
+	eta[n] *= sqrt(0.5);
+      }
       
-	// The multi-shift inversion
-	multi1d<Phi> X;
-	SystemSolverResults_t res = (*invMdagM_num)(X, sipfe.pole, eta);
-	n_count[n] = res.n_count;
+      // The multi-shift inversion of all the pseudoferms at once
+      multi1d< multi1d<Phi> > X;
+      multi1d<SystemSolverResults_t> res = invMdagM_num->solveMultiRHS(X, sipfe.pole, eta);
+
+      for(int n=0; n < getNPF(); ++n)
+      {
+	n_count[n] = res[n].n_count;
 
 	// Weight solns to make final PF field
-	getPhi()[n][M_num->subset()] = sipfe.norm * eta;
-	for(int i=0; i < X.size(); ++i)
-	  getPhi()[n][M_num->subset()] += sipfe.res[i] * X[i];
+	getPhi()[n][M_num->subset()] = sipfe.norm * eta[n];
+	for(int i=0; i < X[n].size(); ++i)
+	  getPhi()[n][M_num->subset()] += sipfe.res[i] * X[n][i];
       }
 
       write(xml_out, "n_count", n_count);
@@ -288,8 +292,9 @@ namespace Chroma
       const RemezCoeff_t& spfe = getNumerSPFE();
 
       // Compute energy
-      // Get X out here via multisolver
-      multi1d<Phi> X;
+      // Get X out here via multisolver, all the pseudoferms at once
+      multi1d< multi1d<Phi> > X_pf;
+      multi1d<SystemSolverResults_t> res = invMdagM_num->solveMultiRHS(X_pf, spfe.pole, getPhi());
 
       // Loop over all the pseudoferms
       multi1d<int> n_count(getNPF());
@@ -298,9 +303,8 @@ namespace Chroma
 
       for(int n=0; n < getNPF(); ++n)
       {
-	// The multi-shift inversion
-	SystemSolverResults_t res = (*invMdagM_num)(X, spfe.pole, getPhi()[n]);
-	n_count[n] = res.n_count;
+	const multi1d<Phi>& X = X_pf[n];
+	n_count[n] = res[n].n_count;
 
 	// Weight solns to make final PF field
 	psi[M_num->subset()] = spfe.norm * getPhi()[n];
@@ -273,7 +273,78 @@ namespace Chroma
     END_CODE();
   }
 
+  //! Arguments of the threaded search
+  struct RemezGMP::SearchArgs
+  {
+    RemezGMP*        remez;
+    const bigfloat*  step;
+    bigfloat*        xm;     /*!< positions of the extrema */
+    bigfloat*        ym;     /*!< errors at the extrema */
+  };
+
+
+  // Search the extrema [lo,hi) of the error, one thread each
+  void RemezGMP::searchLoop(int lo, int hi, int myId, SearchArgs* a)
+  {
+    RemezGMP& r = *(a->remez);
+    const int meq = r.neq + 1;
+
+    for(int i=lo; i < hi; ++i)
+    {
+      // The zeros on either side
+      bigfloat xx0 = (i == 0) ? r.apstrt : r.xx[i-1];
+      bigfloat xx1 = (i == meq-1) ? r.apend : r.xx[i];
+
+      r.searchExtremum(i, xx0, xx1, a->step[i], a->xm[i], a->ym[i]);
+    }
+  }
+
+
+  // Search the extremum i of the error between the zeros xx0 and xx1
+  void RemezGMP::searchExtremum(int i, const bigfloat& xx0, const bigfloat& xx1,
+				const bigfloat& step_i, bigfloat& xm, bigfloat& ym)
+  {
+    bigfloat a, q, xn, yn;
+    int emsign, ensign;
+    int steps = 0;
+
+    xm = mm[i];
+    ym = getErr(xm,emsign);
+    q = step_i;
+    xn = xm + q;
+    if (xn < xx0 || xn >= xx1) {	// Cannot skip over adjacent boundaries
+      q = -q;
+      xn = xm;
+      yn = ym;
+      ensign = emsign;
+    } else {
+      yn = getErr(xn,ensign);
+      if (yn < ym) {
+	q = -q;
+	xn = xm;
+	yn = ym;
+	ensign = emsign;
+      }
+    }
+  
+    while(yn >= ym) {		// March until error becomes smaller.
+      if (++steps > 10) break;
+      ym = yn;
+      xm = xn;
+      emsign = ensign;
+      a = xm + q;
+      if (a == xm || a <= xx0 || a >= xx1) break;// Must not skip over the zeros either side.
+      xn = a;
+      yn = getErr(xn,ensign);
+    }
+  }
+
+
   // Search for error maxima and minima
+  /*!
+   * The extrema lie between fixed zeros, so they are searched for
+   * independently, each on its own thread.
+   */
   void RemezGMP::search(multi1d<bigfloat>& step) 
   {
     START_CODE();
@@ -281,8 +352,8 @@ namespace Chroma
     if (step.size() == 0)
       QDP_error_exit("%s: step not allocated", __func__);
 
-    bigfloat a, q, xm, ym, xn, yn, xx0, xx1;
-    int i, j, meq, emsign, ensign, steps;
+    bigfloat q, xm;
+    int i, meq;
 
     meq = neq + 1;
     multi1d<bigfloat> yy(meq);
@@ -290,50 +361,16 @@ namespace Chroma
     bigfloat eclose = 1.0e30;
     bigfloat farther = 0l;
 
-    j = 1;
-    xx0 = apstrt;
+    multi1d<bigfloat> xm_new(meq);
 
-    for (i = 0; i < meq; i++) {
-      steps = 0;
-      xx1 = xx[i]; // Next zero
-      if (i == meq-1) xx1 = apend;
-      xm = mm[i];
-      ym = getErr(xm,emsign);
-      q = step[i];
-      xn = xm + q;
-      if (xn < xx0 || xn >= xx1) {	// Cannot skip over adjacent boundaries
-	q = -q;
-	xn = xm;
-	yn = ym;
-	ensign = emsign;
-      } else {
-	yn = getErr(xn,ensign);
-	if (yn < ym) {
-	  q = -q;
-	  xn = xm;
-	  yn = ym;
-	  ensign = emsign;
-	}
-      }
-  
-      while(yn >= ym) {		// March until error becomes smaller.
-	if (++steps > 10) break;
-	ym = yn;
-	xm = xn;
-	emsign = ensign;
-	a = xm + q;
-	if (a == xm || a <= xx0 || a >= xx1) break;// Must not skip over the zeros either side.
-	xn = a;
-	yn = getErr(xn,ensign);
-      }
+    SearchArgs args = {this, step.slice(), xm_new.slice(), yy.slice()};
+    dispatch_to_threads(meq, args, searchLoop);
 
-      mm[i] = xm;			// Position of maximum
-      yy[i] = ym;			// Value of maximum
-
-      if (eclose > ym) eclose = ym;
-      if (farther < ym) farther = ym;
+    for (i = 0; i < meq; i++) {
+      mm[i] = xm_new[i];		// Position of maximum
 
-      xx0 = xx1; // Walk to next zero.
+      if (eclose > yy[i]) eclose = yy[i];
+      if (farther < yy[i]) farther = yy[i];
     } // end of search loop
 
     q = (farther - eclose);	// Decrease step size if error spread increased
@@ -409,8 +446,7 @@ namespace Chroma
   // from the solution std::vector param
   bigfloat RemezGMP::approx(const bigfloat& x) 
   {
-    START_CODE();
-
+    // No START_CODE here, this runs on the threads of search()
     bigfloat yn, yd;
     int i;
 
@@ -420,8 +456,6 @@ namespace Chroma
     yd = x + param[n+d];	// Highest degree coefficient = 1.0
     for (i = n+d-1; i > n; i--) yd = x * yd  +  param[i];
 
-    END_CODE();
-
     return(yn/yd);
   }
 
@@ -446,8 +480,7 @@ namespace Chroma
   // Calculate function required for the approximation
   bigfloat RemezGMP::func(const bigfloat& x) 
   {
-    START_CODE();
-
+    // No START_CODE here, this runs on the threads of search()
     bigfloat y,dy,f=1l,df;
 
     // initial guess to accelerate convergance
@@ -459,8 +492,6 @@ namespace Chroma
       y -= dy;
     }
 
-    END_CODE();
-
     return pow_bf(y,power_num);
   }
 
@@ -91,6 +91,16 @@ namespace Chroma
     //! Search for error maxima and minima
     void search(multi1d<bigfloat>& step); 
 
+    //! Arguments of the threaded search
+    struct SearchArgs;
+
+    //! Search the extrema [lo,hi) of the error, one thread each
+    static void searchLoop(int lo, int hi, int myId, SearchArgs* a);
+
+    //! Search the extremum i of the error between the zeros xx0 and xx1
+    void searchExtremum(int i, const bigfloat& xx0, const bigfloat& xx1,
+			const bigfloat& step_i, bigfloat& xm, bigfloat& ym);
+
     //! Initialise step sizes
     void stpini(multi1d<bigfloat>& step);
 
@@ -9,6 +9,12 @@
 
 #include "update/molecdyn/monomial/remez.h"
 
+#include <fstream>
+#include <map>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace Chroma 
 { 
 
@@ -54,6 +60,29 @@ namespace Chroma
     }
 
 
+    namespace
+    {
+      //! Abort unless the cache directory exists and is writable, as seen from the primary node
+      void checkCacheDir(const std::string& dir)
+      {
+	bool ok = false;
+	if (Layout::primaryNode())
+	{
+	  struct stat st;
+	  ok = (stat(dir.c_str(), &st) == 0) && S_ISDIR(st.st_mode) 
+	    && (access(dir.c_str(), W_OK | X_OK) == 0);
+	}
+	QDPInternal::broadcast(ok);
+
+	if (! ok)
+	{
+	  QDPIO::cerr << name << ": cacheDir " << dir << " is not a writable directory" << std::endl;
+	  QDP_abort(1);
+	}
+      }
+    }
+
+
     //! Parameters for running code
     Params::Params(XMLReader& xml, const std::string& path)
     {
@@ -69,6 +98,12 @@ namespace Chroma
 	read(paramtop, "digitPrecision", digitPrecision);
       else
 	digitPrecision = 50;
+
+      if (paramtop.count("cacheDir") != 0)
+      {
+	read(paramtop, "cacheDir", cacheDir);
+	checkCacheDir(cacheDir);
+      }
     }
 
 
@@ -84,16 +119,217 @@ namespace Chroma
       write(xml, "upperMax", upperMax);
       write(xml, "degree", degree);
       write(xml, "digitPrecision", digitPrecision);
+
+      if (cacheDir.size() > 0)
+	write(xml, "cacheDir", cacheDir);
       
       pop(xml);
     }
 
 
+    //! Cache of approximations
+    namespace
+    {
+      typedef std::pair<RemezCoeff_t, RemezCoeff_t>  CoeffPair_t;
+
+      //! Approximations computed or read in this job
+      std::map<std::string, CoeffPair_t>  approx_cache;
+
+
+      //! Key of the approximation, also used as its file name
+      std::string cacheKey(const Params& p)
+      {
+	std::ostringstream os;
+	os.precision(17);
+	os << "remez_" << p.numPower << "_" << p.denPower
+	   << "_" << toDouble(p.lowerMin) << "_" << toDouble(p.upperMax)
+	   << "_deg" << p.degree << "_prec" << p.digitPrecision;
+	return os.str();
+      }
+
+
+      //! Full precision text of a list of numbers
+      std::string coeffString(const multi1d<Real>& x)
+      {
+	std::ostringstream os;
+	os.precision(17);
+	for(int i=0; i < x.size(); ++i)
+	  os << (i > 0 ? " " : "") << toDouble(x[i]);
+	return os.str();
+      }
+
+
+      //! Write coefficients
+      void writeCoeff(XMLWriter& xml, const std::string& path, const RemezCoeff_t& c)
+      {
+	multi1d<Real> norm(1);
+	norm[0] = c.norm;
+
+	push(xml, path);
+	write(xml, "norm", coeffString(norm));
+	write(xml, "res", coeffString(c.res));
+	write(xml, "pole", coeffString(c.pole));
+	pop(xml);
+      }
+
+
+      //! Read a list of numbers written by coeffString
+      void readCoeffString(XMLReader& xml, const std::string& path, multi1d<Real>& x)
+      {
+	std::string s;
+	read(xml, path, s);
+
+	std::istringstream is(s);
+	std::vector<double> v;
+	double d;
+	while (is >> d)
+	  v.push_back(d);
+
+	x.resize(v.size());
+	for(int i=0; i < v.size(); ++i)
+	  x[i] = v[i];
+      }
+
+
+      //! Read coefficients
+      void readCoeff(XMLReader& xml, const std::string& path, RemezCoeff_t& c)
+      {
+	XMLReader paramtop(xml, path);
+
+	multi1d<Real> norm;
+	readCoeffString(paramtop, "norm", norm);
+	readCoeffString(paramtop, "res", c.res);
+	readCoeffString(paramtop, "pole", c.pole);
+
+	if (norm.size() != 1 || c.res.size() != c.pole.size())
+	{
+	  QDPIO::cerr << name << ": corrupt cached approximation" << std::endl;
+	  QDP_abort(1);
+	}
+	c.norm = norm[0];
+      }
+
+
+      //! Does the file exist, as seen from the primary node
+      bool fileExists(const std::string& file)
+      {
+	bool exists = false;
+	if (Layout::primaryNode())
+	{
+	  std::ifstream f(file.c_str());
+	  exists = f.good();
+	}
+	QDPInternal::broadcast(exists);
+	return exists;
+      }
+
+
+      //! Look up the approximation in the cache directory
+      bool readCache(const Params& p, const std::string& file, CoeffPair_t& c)
+      {
+	if (! fileExists(file))
+	  return false;
+
+	XMLReader xml(file);
+	XMLReader top(xml, "/RemezRatApprox");
+
+	// The file name is only a hint, check the params
+	Params q;
+	read(top, "numPower", q.numPower);
+	read(top, "denPower", q.denPower);
+	read(top, "lowerMin", q.lowerMin);
+	read(top, "upperMax", q.upperMax);
+	read(top, "degree", q.degree);
+	read(top, "digitPrecision", q.digitPrecision);
+
+	if (cacheKey(p) != cacheKey(q))
+	{
+	  QDPIO::cout << name << ": ignoring " << file << ", params differ" << std::endl;
+	  return false;
+	}
+
+	readCoeff(top, "PFE", c.first);
+	readCoeff(top, "IPFE", c.second);
+
+	return true;
+      }
+
+
+      //! Store the approximation in the cache directory
+      /*!
+       * The file is written under a temporary name and renamed into place,
+       * so a job reading the cache never sees a partly written file.
+       */
+      void writeCache(const Params& p, const std::string& file, const CoeffPair_t& c)
+      {
+	std::ostringstream tmp_os;
+	tmp_os << file << ".tmp." << getpid();
+	const std::string tmp_file = tmp_os.str();
+
+	XMLFileWriter xml(tmp_file);
+	push(xml, "RemezRatApprox");
+	write(xml, "numPower", p.numPower);
+	write(xml, "denPower", p.denPower);
+	write(xml, "lowerMin", p.lowerMin);
+	write(xml, "upperMax", p.upperMax);
+	write(xml, "degree", p.degree);
+	write(xml, "digitPrecision", p.digitPrecision);
+	writeCoeff(xml, "PFE", c.first);
+	writeCoeff(xml, "IPFE", c.second);
+	pop(xml);
+	xml.close();
+
+	bool ok = true;
+	if (Layout::primaryNode())
+	{
+	  ok = (std::rename(tmp_file.c_str(), file.c_str()) == 0);
+	  if (! ok)
+	    std::remove(tmp_file.c_str());
+	}
+	QDPInternal::broadcast(ok);
+
+	if (! ok)
+	  QDPIO::cout << name << ": could not rename " << tmp_file << " to " << file 
+		      << ", approximation not cached" << std::endl;
+      }
+    }
+
+
     // Produce the partial-fraction-expansion (PFE) and its inverse (IPFE)
     void RatApprox::operator()(RemezCoeff_t& pfe, RemezCoeff_t& ipfe) const
     {
       START_CODE();
 
+      const std::string key = cacheKey(params);
+
+      std::map<std::string, CoeffPair_t>::const_iterator hit = approx_cache.find(key);
+      if (hit != approx_cache.end())
+      {
+	QDPIO::cout << name << ": reusing approximation " << key << std::endl;
+	pfe  = hit->second.first;
+	ipfe = hit->second.second;
+
+	END_CODE();
+	return;
+      }
+
+      const std::string file = params.cacheDir + "/" + key + ".xml";
+
+      if (params.cacheDir.size() > 0)
+      {
+	CoeffPair_t c;
+	if (readCache(params, file, c))
+	{
+	  QDPIO::cout << name << ": read approximation from " << file << std::endl;
+	  approx_cache[key] = c;
+	  pfe  = c.first;
+	  ipfe = c.second;
+
+	  END_CODE();
+	  return;
+	}
+      }
+
       unsigned long prec = abs(params.digitPrecision);
       unsigned long power_num = abs(params.numPower);
       unsigned long power_den = abs(params.denPower);
@@ -130,6 +366,14 @@ namespace Chroma
 	ipfe = remez.getPFE();
       }
 
+      approx_cache[key] = std::make_pair(pfe, ipfe);
+
+      if (params.cacheDir.size() > 0)
+      {
+	QDPIO::cout << name << ": write approximation to " << file << std::endl;
+	writeCache(params, file, approx_cache[key]);
+      }
+
       END_CODE();
     }
 
@@ -31,11 +31,19 @@ namespace Chroma
       Real upperMax;        /*!< upper bound of approximation region */
       int  degree;          /*!< degree of approximation */
       int  digitPrecision;  /*!< number of digits used for bigfloat calcs */
+      std::string cacheDir; /*!< optional directory of cached approximations */
     };
 
 
     //! Remez type of rational approximations
-    /*! @ingroup monomial */
+    /*! @ingroup monomial
+     *
+     * Approximations are kept in memory for the life of the job, so
+     * monomials with the same params run Remez only once. If  cacheDir  is
+     * set, they are also read from and written to files there, keyed by
+     * the powers, interval, degree and precision, so later runs skip the
+     * Remez algorithm altogether.
+     */
     class RatApprox : public RationalApprox
     {
     public:
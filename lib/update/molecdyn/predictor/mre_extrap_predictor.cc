@@ -3,6 +3,7 @@
 #include "meas/eig/gramschm.h"
 #include "meas/eig/gramschm_array.h"
 #include "update/molecdyn/predictor/lu_solve.h"
+#include "update/molecdyn/predictor/mre_extrapolate.h"
 
 
 namespace Chroma 
@@ -18,18 +19,28 @@ namespace Chroma
 								   const std::string& path) 
       {
 	unsigned int max_chrono = 1;
+	bool single_prec_history = false;
 	
 	try 
 	{
 	  XMLReader paramtop(xml, path);
 	  read( paramtop, "./MaxChrono", max_chrono);
+
+	  // Keep the history in single precision (Optional)
+	  if( paramtop.count("./SinglePrecHistory") == 1 ) { 
+	    read( paramtop, "./SinglePrecHistory", single_prec_history);
+	  }
 	}
 	catch( const std::string& e ) { 
 	  QDPIO::cerr << "Caught exception reading XML: " << e << std::endl;
 	  QDP_abort(1);
 	}
+
+	if( single_prec_history ) { 
+	  return new MinimalResidualExtrapolation4DChronoPredictor<LatticeFermionF>(max_chrono);
+	}
       
-	return new MinimalResidualExtrapolation4DChronoPredictor<LatticeFermion>(max_chrono);
+	return new MinimalResidualExtrapolation4DChronoPredictor<>(max_chrono);
       }
     
       //! Local registration flag
@@ -205,38 +216,20 @@ namespace Chroma
 			 
     }
 
-    // Now I need to form G_n m = v_[n]^{dag} A v[m]
-    multi2d<DComplex> G(Nvec,Nvec);
-
+    // A v[m] for all m
+    multi1d< multi1d<LatticeFermion> > Av(Nvec);
     for(int m = 0 ; m < Nvec; m++) { 
-      multi1d<LatticeFermion> tmpvec(N5);
+      Av[m].resize(N5);
 
       // 5D Matrix application
-      A(tmpvec, v[m], PLUS);
-
-
-      for(int n = 0; n < Nvec; n++) { 
-
-	// Compute 5D ioner product
-	G(n,m) = innerProduct(v[n][0], tmpvec[0], s);
-	for(int d5=1; d5 < N5; d5++) {
-	  G(n,m) += innerProduct(v[n][d5], tmpvec[d5], s);
-	}
-
-      }
+      A(Av[m], v[m], PLUS);
     }
 
-    // Now I need to form b_n = v[n]^{dag} chi
-    multi1d<DComplex> b(Nvec);
-
-    for(int n = 0; n < Nvec; n++) { 
-
-      // Loop over 5th Dim
-      b[n] = innerProduct(v[n][0], chi[0], s);
-      for(int d5=1; d5 < N5; d5++) { 
-	b[n] += innerProduct(v[n][d5], chi[d5], s);
-      }
-    }
+    // G_n m = v_[n]^{dag} A v[m] and b_n = v[n]^{dag} chi,
+    // all in one global sum
+    multi2d<DComplex> G;
+    multi1d<DComplex> b;
+    mreProjections(G, b, v, Av, chi, Nvec, s);
 
     // Solve G_nm a_m = b_n:
 
@@ -268,18 +261,8 @@ namespace Chroma
     }
 #endif
 
-    // Create the lnear combination
-
-    // First piece
-    for(int d5=0; d5 < N5; d5++) { 
-      psi[d5][s] = Complex(a[0])*v[0][d5];
-    
-
-      for(int n=1; n < Nvec; n++) { 
-	psi[d5][s] += Complex(a[n])*v[n][d5];
-      }
-
-    }
+    // Create the linear combination in one pass
+    mreCombination(psi, a, v, Nvec, s);
     
     END_CODE();
   }
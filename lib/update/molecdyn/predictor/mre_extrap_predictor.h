@@ -14,6 +14,7 @@
 #include "update/molecdyn/predictor/chrono_predictor_factory.h"
 #include "update/molecdyn/predictor/circular_buffer.h"
 #include "update/molecdyn/predictor/lu_solve.h"
+#include "update/molecdyn/predictor/mre_extrapolate.h"
 #include "meas/eig/gramschm.h"
 
 namespace Chroma 
@@ -27,157 +28,38 @@ namespace Chroma
   }
 
   //! Minimal residual predictor
-  /*! @ingroup predictor */
-  template<typename T>
+  /*! @ingroup predictor
+   *
+   * The previous solutions are kept in the storage type TS, which may be
+   * of lower precision than LatticeFermion, e.g. LatticeFermionF to keep
+   * twice as many vectors in the same memory. The extrapolation itself is
+   * done in the precision of LatticeFermion.
+   */
+  template<typename TS = LatticeFermion>
   class MinimalResidualExtrapolation4DChronoPredictor  
-    : public AbsTwoStepChronologicalPredictor4D<T> 
+    : public AbsTwoStepChronologicalPredictor4D<LatticeFermion> 
   {
+  public:
+    //! The fermions the extrapolation works on
+    typedef LatticeFermion  T;
+
   private:
-    Handle< CircularBuffer<T> > chrono_bufX;
-    Handle< CircularBuffer<T> > chrono_bufY;
+    Handle< CircularBuffer<TS> > chrono_bufX;
+    Handle< CircularBuffer<TS> > chrono_bufY;
 
-  void 
-  find_extrap_solution(
-		       T& psi,
-		       const LinearOperator<T>& M,
-		       const T& chi,
-		       const Handle<CircularBuffer<T> >& chrono_buf, 
-		       enum PlusMinus isign) 
+    //! Get the ith most recent solution, in the precision of T
+    void getVector(const Handle< CircularBuffer<TS> >& chrono_buf, int i, T& x) const
     {
-      START_CODE();
-      
-      const Subset& s= M.subset();
-      
-      
-#if 0
-      {
-	T r;
-	r[s] = chi;
-	T tmp;
-	M(tmp, psi, isign);
-	r[s] -= tmp;
-	Double norm_r = sqrt(norm2(r,s));
-	Double norm_chi = sqrt(norm2(chi,s));
-	QDPIO::cout << "MRE Predictor: before prediction || r || / || b || =" << norm_r/norm_chi << std::endl;
-      }
-#endif
-      
-      int Nvec = chrono_buf->size();
-      
-      
-      // Construct an orthonormal basis from the 
-      // vectors in the buffer. Stick to notation of paper and call these
-      // v
-      multi1d<T> v(Nvec);
-      
-      for(int i=0; i < Nvec; i++) { 
-	// Zero out the non subsetted part
-	v[i] = zero;
-	
-	// Grab the relevant std::vector from the chronobuf
-	T tmpvec;
-	chrono_buf->get(i, tmpvec);
-	
-	if( i == 0 ) { 
-	  // First std::vector we just take
-	  v[i][s] = tmpvec;
-	}
-	else { 
-	  // i-th std::vector. Orthogonalise against i-1 previous
-	  // std::vector, but i is an index running from 0. So I need
-	  // to pass i+1-1=i as the number of vectors to orthog against
-	  //
-	  // This is a very dumb GramSchmidt process and possibly
-	  // unstable, however apparently (according to the paper)
-	  // this is OK.
-	  GramSchm(tmpvec, v, i, s);
-	  v[i][s] = tmpvec;
-	}
-	// QDPIO::cout << "Norm v[i] = " << norm2(v[i],s) << std::endl;
-	// Normalise v[i]
-	Double norm = sqrt(norm2(v[i], s));
-	v[i][s] /= norm;
-	
-      }
-      
-      // Now I need to form G_n m = v_[n]^{dag} A v[m]
-      multi2d<DComplex> G(Nvec,Nvec);
-      
-      for(int m = 0 ; m < Nvec; m++) { 
-	T tmpvec;
-	M(tmpvec, v[m], isign);
-	
-	for(int n = 0; n < Nvec; n++) { 
-	  G(n,m) = innerProduct(v[n], tmpvec, s);
-	}
-      }
-      
-      // Now I need to form b_n = v[n]^{dag} chi
-      multi1d<DComplex> b(Nvec);
-      
-      for(int n = 0; n < Nvec; n++) { 
-	b[n] = innerProduct(v[n], chi, s);
-      }
-      
-      // Solve G_nm a_m = b_n:
-      
-      // First LU decompose G in place 
-      multi1d<DComplex> a(Nvec);
-      
-      LUSolve(a, G, b);
-      
-      // Check solution 
-      multi1d<DComplex> Ga(Nvec);
-      
-      for(int i=0; i < Nvec; i++) { 
-	Ga[i] = G(i,0)*a[0];
-	for(int j=1; j < Nvec; j++) { 
-	  Ga[i] += G(i,j)*a[j];
-	}
-      }
-      
-      multi1d<DComplex> r(Nvec);
-      for(int i=0; i < Nvec; i++) { 
-	r[i] = b[i]-Ga[i];
-      }
-      
-#if 0
-      QDPIO::cout << "Constraint Eq Solution Check" << std::endl;
-      for(int i=0; i < Nvec; i++) { 
-	QDPIO::cout << "   r[ " << i << "] = " << r[i] << std::endl;
-      }
-#endif
-      
-      // Create teh lnear combination
-      psi[s] = Complex(a[0])*v[0];
-      for(int n=1; n < Nvec; n++) { 
-	psi[s] += Complex(a[n])*v[n];
-      }
-      
-      
-#if 0
-      {
-	T r;
-	r[s] = chi;
-	T tmp;
-	M(tmp, psi, isign);
-	r[s] -= tmp;
-	Double norm_r = sqrt(norm2(r,s));
-	Double norm_chi = sqrt(norm2(chi,s));
-	QDPIO::cout << "MRE Predictor: after prediction || r || / || b || =" << norm_r/norm_chi << std::endl;
-      }
-#endif
-      
-      END_CODE();
+      TS stored;
+      chrono_buf->get(i, stored);
+      x = stored;
     }
 
-
-
   public:
     
     MinimalResidualExtrapolation4DChronoPredictor(unsigned int max_chrono) : 
-      chrono_bufX(new CircularBuffer<T>(max_chrono)),
-      chrono_bufY(new CircularBuffer<T>(max_chrono)) {}
+      chrono_bufX(new CircularBuffer<TS>(max_chrono)),
+      chrono_bufY(new CircularBuffer<TS>(max_chrono)) {}
     
     // Destructor is automagic
     ~MinimalResidualExtrapolation4DChronoPredictor(void) {}
@@ -202,7 +84,7 @@ namespace Chroma
       case 1:
 	{
 	  QDPIO::cout << "MRE Predictor: Only 1 std::vector stored. Giving you last solution " << std::endl;
-	  chrono_bufX->get(0,X);
+	  getVector(chrono_bufX, 0, X);
 	}
 	break;
       default:
@@ -211,7 +93,7 @@ namespace Chroma
 	  
 	  // Expect M is either  MdagM if we use chi
 	  // or                   M    if we minimize against Y
-	  find_extrap_solution(X, M, chi, chrono_bufX, PLUS);
+	  MREExtrapolate(X, M, chi, *chrono_bufX, PLUS);
 	}
 	break;
       }
@@ -242,14 +124,14 @@ namespace Chroma
       case 1:
 	{
 	  QDPIO::cout << "MRE Predictor: Only 1 std::vector stored. Giving you last solution " << std::endl;
-	  chrono_bufY->get(0,Y);
+	  getVector(chrono_bufY, 0, Y);
 	}
 	break;
       default:
 	{
 	  QDPIO::cout << "MRE Predictor: Finding Y extrapolation with "<< Nvec << " vectors" << std::endl;
 	  // Should have M as just M (not M^\dagger M) here.
-	  find_extrap_solution(Y, M, chi, chrono_bufY, MINUS);
+	  MREExtrapolate(Y, M, chi, *chrono_bufY, MINUS);
 	}
 	break;
       }
@@ -271,7 +153,8 @@ namespace Chroma
       START_CODE();
 
       QDPIO::cout << "MREPredictor: registering new X solution. " << std::endl;
-      chrono_bufX->push(X);
+      TS stored(X);
+      chrono_bufX->push(stored);
       QDPIO::cout << "MREPredictor: number of X vectors stored is = " << chrono_bufX->size() << std::endl;
     
       END_CODE();
@@ -283,7 +166,8 @@ namespace Chroma
       START_CODE();
 
       QDPIO::cout << "MREPredictor: registering new Y solution. " << std::endl;
-      chrono_bufY->push(Y);
+      TS stored(Y);
+      chrono_bufY->push(stored);
       QDPIO::cout << "MREPredictor: number of Y vectors stored is = " << chrono_bufY->size() << std::endl;
     
       END_CODE();
@@ -291,12 +175,14 @@ namespace Chroma
 
     void replaceXHead(const T& v)
     {
-      chrono_bufX->replaceHead(v);
+      TS stored(v);
+      chrono_bufX->replaceHead(stored);
     }
 
     void replaceYHead(const T& v)
     {
-      chrono_bufY->replaceHead(v);
+      TS stored(v);
+      chrono_bufY->replaceHead(stored);
     }
 
 
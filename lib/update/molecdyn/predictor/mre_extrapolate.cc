@@ -0,0 +1,362 @@
+/*! \file
+ * \brief Minimal residual extrapolation from a chronological history
+ */
+
+#include "update/molecdyn/predictor/mre_extrapolate.h"
+
+namespace Chroma
+{
+
+#ifndef QDP_IS_QDPJIT
+  namespace
+  {
+    //! Arguments of the projection site loop
+    struct MREProjectionArgs
+    {
+      const multi1d<LatticeFermion>& v;
+      const multi1d<LatticeFermion>& Av;
+      const LatticeFermion&          chi;
+      int                            Nvec;
+      const int*                     tab;
+      REAL64*                        sums;  /*!< 2*Nvec*(Nvec+1) partial sums per thread */
+    };
+
+    //! Local sum of <x, y> at one site
+    inline void siteInnerProduct(REAL64& re, REAL64& im,
+				 const LatticeFermion& x, const LatticeFermion& y, int site)
+    {
+      for(int s=0; s < Ns; ++s)
+	for(int c=0; c < Nc; ++c)
+	{
+	  REAL64 xr = x.elem(site).elem(s).elem(c).real();
+	  REAL64 xi = x.elem(site).elem(s).elem(c).imag();
+	  REAL64 yr = y.elem(site).elem(s).elem(c).real();
+	  REAL64 yi = y.elem(site).elem(s).elem(c).imag();
+
+	  re += xr*yr + xi*yi;
+	  im += xr*yi - xi*yr;
+	}
+    }
+
+    //! Local sums of G and b over the sites [lo,hi) of the site table
+    /*! Layout of the sums: G(n,m) at 2*(n*Nvec+m), b[n] at 2*(Nvec*Nvec+n) */
+    void mreProjectionSiteLoop(int lo, int hi, int myId, MREProjectionArgs* a)
+    {
+      const int Nvec = a->Nvec;
+      REAL64* sums = a->sums + 2*Nvec*(Nvec+1)*myId;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->tab[j];
+
+	for(int n=0; n < Nvec; ++n)
+	{
+	  for(int m=0; m < Nvec; ++m)
+	    siteInnerProduct(sums[2*(n*Nvec+m)], sums[2*(n*Nvec+m)+1], a->v[n], a->Av[m], site);
+
+	  siteInnerProduct(sums[2*(Nvec*Nvec+n)], sums[2*(Nvec*Nvec+n)+1], a->v[n], a->chi, site);
+	}
+      }
+    }
+
+
+    //! Arguments of the linear combination site loop
+    struct MRECombinationArgs
+    {
+      LatticeFermion&                psi;
+      const multi1d<LatticeFermion>& v;
+      const REAL64*                  coeff;  /*!< re, im of each coefficient */
+      int                            Nvec;
+      const int*                     tab;
+    };
+
+    //! psi = sum_n a[n] v[n] over the sites [lo,hi) of the site table
+    void mreCombinationSiteLoop(int lo, int hi, int myId, MRECombinationArgs* a)
+    {
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->tab[j];
+
+	for(int s=0; s < Ns; ++s)
+	  for(int c=0; c < Nc; ++c)
+	  {
+	    REAL64 re = 0;
+	    REAL64 im = 0;
+
+	    for(int n=0; n < a->Nvec; ++n)
+	    {
+	      REAL64 ar = a->coeff[2*n];
+	      REAL64 ai = a->coeff[2*n+1];
+	      REAL64 vr = a->v[n].elem(site).elem(s).elem(c).real();
+	      REAL64 vi = a->v[n].elem(site).elem(s).elem(c).imag();
+
+	      re += ar*vr - ai*vi;
+	      im += ar*vi + ai*vr;
+	    }
+
+	    a->psi.elem(site).elem(s).elem(c).real() = re;
+	    a->psi.elem(site).elem(s).elem(c).imag() = im;
+	  }
+      }
+    }
+
+
+    //! Arguments of the 5D projection site loop
+    struct MREProjection5DArgs
+    {
+      const multi2d<LatticeFermion>&            v;
+      const multi1d< multi1d<LatticeFermion> >& Av;
+      const multi1d<LatticeFermion>&            chi;
+      int                                       Nvec;
+      int                                       N5;
+      const int*                                tab;
+      REAL64*                                   sums;  /*!< 2*Nvec*(Nvec+1) partial sums per thread */
+    };
+
+    //! Local sums of the 5D G and b over the sites [lo,hi) of the site table
+    void mreProjection5DSiteLoop(int lo, int hi, int myId, MREProjection5DArgs* a)
+    {
+      const int Nvec = a->Nvec;
+      REAL64* sums = a->sums + 2*Nvec*(Nvec+1)*myId;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->tab[j];
+
+	for(int n=0; n < Nvec; ++n)
+	  for(int d5=0; d5 < a->N5; ++d5)
+	  {
+	    for(int m=0; m < Nvec; ++m)
+	      siteInnerProduct(sums[2*(n*Nvec+m)], sums[2*(n*Nvec+m)+1], a->v(n,d5), a->Av[m][d5], site);
+
+	    siteInnerProduct(sums[2*(Nvec*Nvec+n)], sums[2*(Nvec*Nvec+n)+1], a->v(n,d5), a->chi[d5], site);
+	  }
+      }
+    }
+
+
+    //! Arguments of the 5D linear combination site loop
+    struct MRECombination5DArgs
+    {
+      multi1d<LatticeFermion>&       psi;
+      const multi2d<LatticeFermion>& v;
+      const REAL64*                  coeff;  /*!< re, im of each coefficient */
+      int                            Nvec;
+      int                            N5;
+      const int*                     tab;
+    };
+
+    //! psi = sum_n a[n] v[n] over the sites [lo,hi) of the site table
+    void mreCombination5DSiteLoop(int lo, int hi, int myId, MRECombination5DArgs* a)
+    {
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->tab[j];
+
+	for(int d5=0; d5 < a->N5; ++d5)
+	  for(int s=0; s < Ns; ++s)
+	    for(int c=0; c < Nc; ++c)
+	    {
+	      REAL64 re = 0;
+	      REAL64 im = 0;
+
+	      for(int n=0; n < a->Nvec; ++n)
+	      {
+		REAL64 ar = a->coeff[2*n];
+		REAL64 ai = a->coeff[2*n+1];
+		REAL64 vr = a->v(n,d5).elem(site).elem(s).elem(c).real();
+		REAL64 vi = a->v(n,d5).elem(site).elem(s).elem(c).imag();
+
+		re += ar*vr - ai*vi;
+		im += ar*vi + ai*vr;
+	      }
+
+	      a->psi[d5].elem(site).elem(s).elem(c).real() = re;
+	      a->psi[d5].elem(site).elem(s).elem(c).imag() = im;
+	    }
+      }
+    }
+
+
+    //! Unpack the global sums of G and b
+    void unpackProjections(multi2d<DComplex>& G, multi1d<DComplex>& b,
+			   const multi1d<REAL64>& sums, int Nvec)
+    {
+      G.resize(Nvec, Nvec);
+      b.resize(Nvec);
+
+      for(int n=0; n < Nvec; ++n)
+      {
+	for(int m=0; m < Nvec; ++m)
+	  G(n,m) = cmplx(Double(sums[2*(n*Nvec+m)]), Double(sums[2*(n*Nvec+m)+1]));
+
+	b[n] = cmplx(Double(sums[2*(Nvec*Nvec+n)]), Double(sums[2*(Nvec*Nvec+n)+1]));
+      }
+    }
+
+
+    //! Coefficients as re, im pairs for the site loops
+    void packCoefficients(multi1d<REAL64>& coeff, const multi1d<DComplex>& a, int Nvec)
+    {
+      coeff.resize(2*Nvec);
+      for(int n=0; n < Nvec; ++n)
+      {
+	coeff[2*n]   = toDouble(real(a[n]));
+	coeff[2*n+1] = toDouble(imag(a[n]));
+      }
+    }
+
+
+    //! Collect the thread partial sums, then one global sum
+    void reduceSums(multi1d<REAL64>& sums, int nsum, int nthr)
+    {
+      for(int t=1; t < nthr; ++t)
+	for(int i=0; i < nsum; ++i)
+	  sums[i] += sums[nsum*t + i];
+
+      QDPInternal::globalSumArray(sums.slice(), nsum);
+    }
+  }
+#endif
+
+
+  // Gram matrix and projections in one global sum
+  void mreProjections(multi2d<DComplex>& G,
+		      multi1d<DComplex>& b,
+		      const multi1d<LatticeFermion>& v,
+		      const multi1d<LatticeFermion>& Av,
+		      const LatticeFermion& chi,
+		      const int Nvec,
+		      const Subset& s)
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    const int nsum = 2*Nvec*(Nvec+1);
+    const int nthr = qdpNumThreads();
+    multi1d<REAL64> sums(nsum*nthr);
+    sums = 0;
+
+    MREProjectionArgs args = {v, Av, chi, Nvec, s.siteTable().slice(), sums.slice()};
+    dispatch_to_threads(s.numSiteTable(), args, mreProjectionSiteLoop);
+
+    reduceSums(sums, nsum, nthr);
+    unpackProjections(G, b, sums, Nvec);
+#else
+    // No raw site access under QDP-JIT, one reduction per element
+    G.resize(Nvec, Nvec);
+    b.resize(Nvec);
+
+    for(int n=0; n < Nvec; ++n)
+    {
+      for(int m=0; m < Nvec; ++m)
+	G(n,m) = innerProduct(v[n], Av[m], s);
+
+      b[n] = innerProduct(v[n], chi, s);
+    }
+#endif
+
+    END_CODE();
+  }
+
+
+  // Gram matrix and projections of 5D vectors in one global sum
+  void mreProjections(multi2d<DComplex>& G,
+		      multi1d<DComplex>& b,
+		      const multi2d<LatticeFermion>& v,
+		      const multi1d< multi1d<LatticeFermion> >& Av,
+		      const multi1d<LatticeFermion>& chi,
+		      const int Nvec,
+		      const Subset& s)
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    const int nsum = 2*Nvec*(Nvec+1);
+    const int nthr = qdpNumThreads();
+    multi1d<REAL64> sums(nsum*nthr);
+    sums = 0;
+
+    MREProjection5DArgs args = {v, Av, chi, Nvec, chi.size(), s.siteTable().slice(), sums.slice()};
+    dispatch_to_threads(s.numSiteTable(), args, mreProjection5DSiteLoop);
+
+    reduceSums(sums, nsum, nthr);
+    unpackProjections(G, b, sums, Nvec);
+#else
+    // No raw site access under QDP-JIT, one reduction per element
+    const int N5 = chi.size();
+    G.resize(Nvec, Nvec);
+    b.resize(Nvec);
+
+    for(int n=0; n < Nvec; ++n)
+    {
+      for(int m=0; m < Nvec; ++m)
+      {
+	G(n,m) = innerProduct(v(n,0), Av[m][0], s);
+	for(int d5=1; d5 < N5; ++d5)
+	  G(n,m) += innerProduct(v(n,d5), Av[m][d5], s);
+      }
+
+      b[n] = innerProduct(v(n,0), chi[0], s);
+      for(int d5=1; d5 < N5; ++d5)
+	b[n] += innerProduct(v(n,d5), chi[d5], s);
+    }
+#endif
+
+    END_CODE();
+  }
+
+
+  // Linear combination in one pass
+  void mreCombination(LatticeFermion& psi,
+		      const multi1d<DComplex>& a,
+		      const multi1d<LatticeFermion>& v,
+		      const int Nvec,
+		      const Subset& s)
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    multi1d<REAL64> coeff;
+    packCoefficients(coeff, a, Nvec);
+
+    MRECombinationArgs args = {psi, v, coeff.slice(), Nvec, s.siteTable().slice()};
+    dispatch_to_threads(s.numSiteTable(), args, mreCombinationSiteLoop);
+#else
+    psi[s] = Complex(a[0])*v[0];
+    for(int n=1; n < Nvec; ++n)
+      psi[s] += Complex(a[n])*v[n];
+#endif
+
+    END_CODE();
+  }
+
+
+  // Linear combination of 5D vectors in one pass
+  void mreCombination(multi1d<LatticeFermion>& psi,
+		      const multi1d<DComplex>& a,
+		      const multi2d<LatticeFermion>& v,
+		      const int Nvec,
+		      const Subset& s)
+  {
+    START_CODE();
+
+#ifndef QDP_IS_QDPJIT
+    multi1d<REAL64> coeff;
+    packCoefficients(coeff, a, Nvec);
+
+    MRECombination5DArgs args = {psi, v, coeff.slice(), Nvec, v.size1(), s.siteTable().slice()};
+    dispatch_to_threads(s.numSiteTable(), args, mreCombination5DSiteLoop);
+#else
+    for(int d5=0; d5 < v.size1(); ++d5)
+    {
+      psi[d5][s] = Complex(a[0])*v(0,d5);
+      for(int n=1; n < Nvec; ++n)
+	psi[d5][s] += Complex(a[n])*v(n,d5);
+    }
+#endif
+
+    END_CODE();
+  }
+
+} // End Namespace Chroma
@@ -0,0 +1,148 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Minimal residual extrapolation from a chronological history
+ *
+ * Predictors for HMC
+ */
+
+#ifndef __mre_extrapolate_h__
+#define __mre_extrapolate_h__
+
+#include "chromabase.h"
+#include "linearop.h"
+#include "update/molecdyn/predictor/circular_buffer.h"
+#include "update/molecdyn/predictor/lu_solve.h"
+#include "meas/eig/gramschm.h"
+
+namespace Chroma
+{
+
+  //! Gram matrix and projections of the minimal residual extrapolation
+  /*! @ingroup predictor
+   *
+   * Computes  G(n,m) = <v[n], Av[m]>  and  b[n] = <v[n], chi>  for the
+   * first Nvec vectors, in one threaded sweep over the sites and a single
+   * global sum, instead of one reduction per matrix element.
+   */
+  void mreProjections(multi2d<DComplex>& G,
+		      multi1d<DComplex>& b,
+		      const multi1d<LatticeFermion>& v,
+		      const multi1d<LatticeFermion>& Av,
+		      const LatticeFermion& chi,
+		      const int Nvec,
+		      const Subset& s);
+
+  //! Linear combination  psi = sum_n a[n] v[n]  on the subset
+  /*! @ingroup predictor
+   *
+   * Done in one pass over the sites, instead of one pass per vector.
+   */
+  void mreCombination(LatticeFermion& psi,
+		      const multi1d<DComplex>& a,
+		      const multi1d<LatticeFermion>& v,
+		      const int Nvec,
+		      const Subset& s);
+
+  //! Gram matrix and projections of 5D vectors, v[n][d5]
+  /*! @ingroup predictor */
+  void mreProjections(multi2d<DComplex>& G,
+		      multi1d<DComplex>& b,
+		      const multi2d<LatticeFermion>& v,
+		      const multi1d< multi1d<LatticeFermion> >& Av,
+		      const multi1d<LatticeFermion>& chi,
+		      const int Nvec,
+		      const Subset& s);
+
+  //! Linear combination of 5D vectors, v[n][d5]
+  /*! @ingroup predictor */
+  void mreCombination(multi1d<LatticeFermion>& psi,
+		      const multi1d<DComplex>& a,
+		      const multi2d<LatticeFermion>& v,
+		      const int Nvec,
+		      const Subset& s);
+
+
+  //! Minimal residual extrapolation from a chronological history
+  /*! @ingroup predictor
+   *
+   * Finds the psi in the span of the stored solutions that minimises the
+   * residual of  M psi = chi  (Brower et al, hep-lat/9509012). The history
+   * may be kept in a lower precision TS than the fermions, the projection
+   * is always done in the precision of the fermions.
+   *
+   * Arguments:
+   *
+   *  \param psi         guess                              (Write)
+   *  \param M           linear operator                    (Read)
+   *  \param chi         source                             (Read)
+   *  \param chrono_buf  previous solutions, at least 2     (Read)
+   *  \param isign       apply M or M^dag                   (Read)
+   */
+  template<typename TS>
+  void MREExtrapolate(LatticeFermion& psi,
+		      const LinearOperator<LatticeFermion>& M,
+		      const LatticeFermion& chi,
+		      const CircularBuffer<TS>& chrono_buf,
+		      enum PlusMinus isign)
+  {
+    START_CODE();
+
+    const Subset& s = M.subset();
+    const int Nvec = chrono_buf.size();
+
+    // Construct an orthonormal basis from the
+    // vectors in the buffer. Stick to notation of paper and call these
+    // v
+    multi1d<LatticeFermion> v(Nvec);
+
+    for(int i=0; i < Nvec; i++) {
+      // Zero out the non subsetted part
+      v[i] = zero;
+
+      // Grab the relevant std::vector from the chronobuf,
+      // in the precision of the fermions
+      LatticeFermion tmpvec;
+      {
+	TS stored;
+	chrono_buf.get(i, stored);
+	tmpvec = stored;
+      }
+
+      if( i > 0 ) {
+	// Orthogonalise against the i previous vectors. Classical
+	// Gram-Schmidt twice, which is as stable as the modified one
+	// but needs one global sum per pass
+	GramSchmBlock(tmpvec, v, i, s);
+	GramSchmBlock(tmpvec, v, i, s);
+      }
+      v[i][s] = tmpvec;
+
+      // Normalise v[i]
+      Double norm = sqrt(norm2(v[i], s));
+      v[i][s] /= norm;
+    }
+
+    // A v[m] for all m
+    multi1d<LatticeFermion> Av(Nvec);
+    for(int m = 0 ; m < Nvec; m++) {
+      M(Av[m], v[m], isign);
+    }
+
+    // G_nm = v[n]^dag A v[m],  b_n = v[n]^dag chi
+    multi2d<DComplex> G;
+    multi1d<DComplex> b;
+    mreProjections(G, b, v, Av, chi, Nvec, s);
+
+    // Solve G_nm a_m = b_n:
+    multi1d<DComplex> a(Nvec);
+    LUSolve(a, G, b);
+
+    // Create the linear combination
+    mreCombination(psi, a, v, Nvec, s);
+
+    END_CODE();
+  }
+
+} // End Namespace Chroma
+
+#endif
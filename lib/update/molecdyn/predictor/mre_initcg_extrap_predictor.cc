@@ -3,7 +3,7 @@
 #include "update/molecdyn/predictor/mre_initcg_extrap_predictor.h"
 #include "meas/eig/gramschm.h"
 #include "meas/eig/gramschm_array.h"
-#include "update/molecdyn/predictor/lu_solve.h"
+#include "update/molecdyn/predictor/mre_extrapolate.h"
 #include "actions/ferm/invert/containers.h"
 #include "meas/eig/sn_jacob.h"
 
@@ -23,19 +23,25 @@ namespace Chroma
 	std::string opt_eigen_id;
 	int nevec;
 	int max_evec;
+	bool single_prec_history = false;
 	try 
 	{
 	  XMLReader paramtop(xml, path);
 	  read( paramtop, "./MaxChrono", max_chrono);
 	  read( paramtop, "./MaxEvec", max_evec);
 	  read( paramtop, "./opt_eigen_id", opt_eigen_id);
+
+	  // Keep the history in single precision (Optional)
+	  if( paramtop.count("./SinglePrecHistory") == 1 ) { 
+	    read( paramtop, "./SinglePrecHistory", single_prec_history);
+	  }
 	}
 	catch( const std::string& e ) { 
 	  QDPIO::cerr << "Caught exception reading XML: " << e << std::endl;
 	  QDP_abort(1);
 	}
       
-	return new MREInitCG4DChronoPredictor(max_chrono, opt_eigen_id, max_evec);
+	return new MREInitCG4DChronoPredictor(max_chrono, opt_eigen_id, max_evec, single_prec_history);
       }
     
       //! Local registration flag
@@ -86,7 +92,7 @@ namespace Chroma
 
   
 
-    int Nchrono = chrono_buf->size();
+    int Nchrono = single_prec_history ? chrono_buf_f->size() : chrono_buf->size();
 
     QDPIO::cout << "MREInitCG Predictor: Got " << Nchrono << " chrono vecs" << std::endl;
 
@@ -99,7 +105,14 @@ namespace Chroma
 
 	// If only one chrono std::vector exists, give that.
 	LatticeFermion tmpvec;
-	chrono_buf->get(0, tmpvec);
+	if( single_prec_history ) { 
+	  LatticeFermionF tmpvec_f;
+	  chrono_buf_f->get(0, tmpvec_f);
+	  tmpvec = tmpvec_f;
+	}
+	else {
+	  chrono_buf->get(0, tmpvec);
+	}
 	psi[s] = tmpvec;
 
       }
@@ -107,73 +120,13 @@ namespace Chroma
       else {
 	
 	// Otherwise do minimum norm extrapolation
-	multi1d<LatticeFermion> v(Nchrono);
-	QDPIO::cout << "MREInitCG Predictor: Orthonormalizing the " << Nchrono << " chrono vecs" << std::endl;
-	
-	// Orthogonalize current against the last N....
-	for(int i=0; i < Nchrono; i++) { 
-	  
-	  // Zero out the non subsetted part
-	  v[i] = zero;
-	  
-	  // Grab the relevant std::vector from the chronobuf
-	  // The way the circular buffer works is that i=0 is the
-	  // most recent... as i increases vectors become less recent.
-	  LatticeFermion tmpvec;
-	  chrono_buf->get(i, tmpvec);
-	  
-	  if( i == 0 ) { 
-	    // First std::vector we just take
-	    v[i][s] = tmpvec;
-	  }
-	  else { 
-	    // i-th std::vector. Orthogonalise against i-1 previous
-	    // std::vector, but i is an index running from 0. So I need
-	    // to pass i+1-1=i as the number of vectors to orthog against
-	    //
-	    // This is a very dumb GramSchmidt process and possibly
-	    // unstable, however apparently (according to the paper)
-	    // this is OK.
-	    GramSchm(tmpvec, v, i, s);
-	    GramSchm(tmpvec, v, i, s);
-	    v[i][s] = tmpvec;
-	  }
-	  // QDPIO::cout << "Norm v[i] = " << norm2(v[i],s) << std::endl;
-	  // Normalise v[i]
-	  Double norm = sqrt(norm2(v[i], s));
-	  v[i][s] /= norm;
-	}
-
-	// Now I need to form G_n m = v_[n]^{dag} A v[m]
-	multi2d<DComplex> G(Nchrono,Nchrono);
-	
-	for(int m = 0 ; m < Nchrono; m++) { 
-	  LatticeFermion tmpvec;
-	  A(tmpvec, v[m], PLUS);
-	
-	  for(int n = 0; n < Nchrono; n++) { 
-	    G(n,m) = innerProduct(v[n], tmpvec, s);
-	  }
-	}
+	QDPIO::cout << "MREInitCG Predictor: Extrapolating from the " << Nchrono << " chrono vecs" << std::endl;
 
-	// Now I need to form b_n = v[n]^{dag} chi
-	multi1d<DComplex> b(Nchrono);
-	
-	for(int n = 0; n < Nchrono; n++) { 
-	  b[n] = innerProduct(v[n], chi, s);
+	if( single_prec_history ) {
+	  MREExtrapolate(psi, A, chi, *chrono_buf_f, PLUS);
 	}
-
-	// Solve G_nm a_m = b_n:
-	
-	// First LU decompose G in place 
-	multi1d<DComplex> a(Nchrono);
-	
-	LUSolve(a, G, b);
-	
-	// Create teh lnear combination
-	psi[s] = Complex(a[0])*v[0];
-	for(int n=1; n < Nchrono; n++) { 
-	  psi[s] += Complex(a[n])*v[n];
+	else { 
+	  MREExtrapolate(psi, A, chi, *chrono_buf, PLUS);
 	}
       }
     }
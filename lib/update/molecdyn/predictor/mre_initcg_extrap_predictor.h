@@ -33,7 +33,10 @@ namespace Chroma
     : public AbsChronologicalPredictor4D<LatticeFermion> 
   {
   private:
-    Handle< CircularBuffer<LatticeFermion> > chrono_buf;
+    // Only one of them holds the history, depending on its precision
+    Handle< CircularBuffer<LatticeFermion> >  chrono_buf;
+    Handle< CircularBuffer<LatticeFermionF> > chrono_buf_f;
+    bool single_prec_history;
 
     void find_extrap_solution(LatticeFermion& psi, 
 			      const LinearOperator<LatticeFermion>& A,
@@ -44,7 +47,10 @@ namespace Chroma
     
   public:
     
-    MREInitCG4DChronoPredictor(unsigned int max_chrono, const std::string& eigen_id, unsigned int max_evec) : chrono_buf(new CircularBuffer<LatticeFermion>(max_chrono)),  opt_eigen_id(eigen_id), Neig(max_evec) {}
+    MREInitCG4DChronoPredictor(unsigned int max_chrono, const std::string& eigen_id, unsigned int max_evec, bool single_prec_history_ = false) : 
+      chrono_buf(new CircularBuffer<LatticeFermion>(single_prec_history_ ? 0 : max_chrono)),
+      chrono_buf_f(new CircularBuffer<LatticeFermionF>(single_prec_history_ ? max_chrono : 0)),
+      single_prec_history(single_prec_history_), opt_eigen_id(eigen_id), Neig(max_evec) {}
     
     // Destructor is automagic
     ~MREInitCG4DChronoPredictor(void) {}
@@ -57,6 +63,7 @@ namespace Chroma
     // No internal state so reset is a nop
     void reset(void) {
       chrono_buf->reset();
+      chrono_buf_f->reset();
     }
 
     // Ignore new std::vector
@@ -69,8 +76,12 @@ namespace Chroma
         chrono_buf->push(psi);
       }
 
+      if( chrono_buf_f->sizeMax() > 0 ) { 
+        LatticeFermionF psi_f(psi);
+        chrono_buf_f->push(psi_f);
+      }
       
-      QDPIO::cout << "MREPredictor: number of vectors stored is = " << chrono_buf->size() << std::endl;
+      QDPIO::cout << "MREPredictor: number of vectors stored is = " << (chrono_buf->size() + chrono_buf_f->size()) << std::endl;
         
       END_CODE();
     }
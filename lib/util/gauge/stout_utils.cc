@@ -166,8 +166,22 @@ namespace Chroma
       }
       
       // Now I can form the Q
+      getQsFromC(u[mu], C, Q, QQ);
+      
+      END_CODE();
+    }
+
+
+    /*! \ingroup gauge */
+    void getQsFromC(const LatticeColorMatrix& u_mu,
+		    const LatticeColorMatrix& C,
+		    LatticeColorMatrix& Q, 
+		    LatticeColorMatrix& QQ)
+    {
+      START_CODE();
+
       LatticeColorMatrix Omega;
-      Omega = C*adj(u[mu]); // Q_mu is Omega mu here (eq 2 part 2)
+      Omega = C*adj(u_mu); // Q_mu is Omega mu here (eq 2 part 2)
       
       LatticeColorMatrix tmp2 = adj(Omega) - Omega;
       LatticeColorMatrix tmp3 = trace(tmp2);
@@ -179,6 +193,56 @@ namespace Chroma
       
       END_CODE();
     }
+
+
+    /*! \ingroup gauge */
+    void getCs(const multi1d<LatticeColorMatrix>& u,
+	       multi1d<LatticeColorMatrix>& C,
+	       const multi1d<bool>& smear_in_this_dirP,
+	       const multi2d<Real>& rho)
+    {
+      START_CODE();
+
+      C.resize(Nd);
+      C = zero;
+
+      // Loop over planes: the staples of the mu-link in the nu direction and
+      // of the nu-link in the mu direction use the same two shifted links.
+      // Only the C of smeared directions are needed, and only the staples
+      // in smeared directions enter them, so a plane contributes to both
+      // of its links or to neither
+      for(int mu=0; mu < Nd; mu++) 
+      { 
+	if( !smear_in_this_dirP[mu] )
+	  continue;
+
+	for(int nu=mu+1; nu < Nd; nu++) 
+	{ 
+	  if( !smear_in_this_dirP[nu] )
+	    continue;
+
+	  LatticeColorMatrix U_mu_plus_nu = shift(u[mu], FORWARD, nu);
+	  LatticeColorMatrix U_nu_plus_mu = shift(u[nu], FORWARD, mu);
+	  LatticeColorMatrix tmp_mat;
+
+	  {
+	    // Forward and backward staple (see getQsandCs)
+	    tmp_mat  = u[nu]*U_mu_plus_nu*adj(U_nu_plus_mu);
+	    tmp_mat += shift(adj(u[nu])*u[mu]*U_nu_plus_mu, BACKWARD, nu);
+	    C[mu] += rho(mu,nu)*tmp_mat;
+	  }
+
+	  {
+	    // Same with the roles of mu and nu swapped
+	    tmp_mat  = u[mu]*U_nu_plus_mu*adj(U_mu_plus_nu);
+	    tmp_mat += shift(adj(u[mu])*u[nu]*U_mu_plus_nu, BACKWARD, mu);
+	    C[nu] += rho(nu,mu)*tmp_mat;
+	  }
+	}
+      }
+
+      END_CODE();
+    }
     
     /*! \ingroup gauge */
     // Do the force recursion from level i+1, to level i
@@ -939,6 +1003,10 @@ namespace Chroma
 		     const multi2d<Real>& rho)
     {
       START_CODE();
+
+      // Staples of all directions at once, sharing the shifted links
+      multi1d<LatticeColorMatrix> C;
+      getCs(current, C, smear_in_this_dirP, rho);
       
       for(int mu = 0; mu < Nd; mu++) 
       {
@@ -946,8 +1014,8 @@ namespace Chroma
 	{
 	  LatticeColorMatrix Q, QQ;
 	  
-	  // Q contains the staple term. C is a throwaway
-	  getQs(current, Q, QQ, mu, smear_in_this_dirP, rho);
+	  // Q contains the staple term
+	  getQsFromC(current[mu], C[mu], Q, QQ);
 	  
 	  // Now compute the f's
 	  multi1d<LatticeComplex> f;   // routine will resize these
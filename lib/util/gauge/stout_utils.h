@@ -66,6 +66,19 @@ namespace Chroma
 		    const multi1d<bool>& smear_in_this_dirP,
 		    const multi2d<Real>& rho);
 
+    //! Given the staple C of direction mu, form Q and Q^2
+    void getQsFromC(const LatticeColorMatrix& u_mu,
+		    const LatticeColorMatrix& C,
+		    LatticeColorMatrix& Q, 
+		    LatticeColorMatrix& QQ);
+
+    //! Construct the staples C of all directions, shifting each link pair only once
+    /*! C of the directions that are not smeared is left zero */
+    void getCs(const multi1d<LatticeColorMatrix>& u,
+	       multi1d<LatticeColorMatrix>& C,
+	       const multi1d<bool>& smear_in_this_dirP,
+	       const multi2d<Real>& rho);
+
     //! Given c0 and c1 compute the f-s and b-s
     /*! \ingroup gauge */
     void getFs(const LatticeColorMatrix& Q,
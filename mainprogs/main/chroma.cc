@@ -16,6 +16,7 @@ struct Params_t
 {
   multi1d<int>    nrow;
   std::string     inline_measurement_xml;
+  bool            free_named_objects;   /*!< erase named objects after their last consumer */
 };
 
 struct Inline_input_t
@@ -31,6 +32,10 @@ void read(XMLReader& xml, const std::string& path, Params_t& p)
   XMLReader paramtop(xml, path);
   read(paramtop, "nrow", p.nrow);
 
+  p.free_named_objects = false;
+  if (paramtop.count("FreeNamedObjects") > 0)
+    read(paramtop, "FreeNamedObjects", p.free_named_objects);
+
   XMLReader measurements_xml(paramtop, "InlineMeasurements");
   std::ostringstream inline_os;
   measurements_xml.print(inline_os);
@@ -207,6 +212,14 @@ int main(int argc, char *argv[])
 
     QDPIO::cout << "There are " << the_measurements.size() << " measurements " << std::endl;
 
+    // Named object dependencies of the measurements
+    Handle<InlineMeasurementSchedule> schedule;
+    if (input.param.free_named_objects)
+    {
+      schedule = new InlineMeasurementSchedule(MeasXML, "/InlineMeasurements");
+      schedule->print();
+    }
+
     // Reset and set the default gauge field
     InlineDefaultGaugeField::reset();
     InlineDefaultGaugeField::set(u, config_xml);
@@ -222,6 +235,9 @@ int main(int argc, char *argv[])
     for(int m=0; m < the_measurements.size(); m++) 
     {
       AbsInlineMeasurement& the_meas = *(the_measurements[m]);
+      if (input.param.free_named_objects)
+	schedule->prepare(m);
+
       if( cur_update % the_meas.getFrequency() == 0 ) 
       {
 	// Caller writes elem rule
@@ -231,7 +247,18 @@ int main(int argc, char *argv[])
 
 	xml_out.flush();
       }
+
+      if (input.param.free_named_objects)
+	schedule->release(m);
     }
+
+    // Return the displaced propagators shared by the measurements
+    TheDispPropCache::Instance().clear();
+
+    if (input.param.free_named_objects)
+      QDPIO::cout << "CHROMA: peak named object memory = " 
+		  << TheNamedObjMap::Instance().getPeakMemory() << " bytes/node" << std::endl;
+
     swatch.stop();
 
     QDPIO::cout << "CHROMA measurements: time= " 
@@ -28,7 +28,9 @@ namespace Chroma
     bool          rev_checkP;
     int           rev_check_frequency;
     bool          monitorForcesP;
-
+    HMCStepControlParams step_control;
+    bool          step_controlP;   /*!< AdaptiveStepControl group given */
+    int           clover_cache_entries;   /*!< param sets in TheCloverTermCache, -1 for the default */
   };
   
   void read(XMLReader& xml, const std::string& path, MCControl& p) 
@@ -105,6 +107,19 @@ namespace Chroma
 	p.monitorForcesP = true;
       }
 
+      // Adaptive step count, off unless asked for
+      p.step_controlP = false;
+      if( paramtop.count("./AdaptiveStepControl") == 1 ) {
+	read(paramtop, "./AdaptiveStepControl", p.step_control);
+	p.step_controlP = true;
+      }
+
+      // Clover terms kept for the monomials, one per param set
+      p.clover_cache_entries = -1;
+      if( paramtop.count("./CloverTermCacheEntries") == 1 ) {
+	read(paramtop, "./CloverTermCacheEntries", p.clover_cache_entries);
+      }
+
       if( paramtop.count("./InlineMeasurements") == 0 ) {
 	XMLBufferWriter dummy;
 	push(dummy, "InlineMeasurements");
@@ -159,6 +174,12 @@ namespace Chroma
 	write(xml, "ReverseCheckFrequency", p.rev_check_frequency);
       }
       write(xml, "MonitorForces", p.monitorForcesP);
+      if( p.step_controlP || p.step_control.enabledP ) {
+	write(xml, "AdaptiveStepControl", p.step_control);
+      }
+      if( p.clover_cache_entries >= 0 ) {
+	write(xml, "CloverTermCacheEntries", p.clover_cache_entries);
+      }
 
       xml << p.inline_measurement_xml;
       
@@ -368,6 +389,9 @@ namespace Chroma
     setForceMonitoring(mc_control.monitorForcesP) ;
     QDP::StopWatch swatch;
 
+    // Statistics of the trajectories, and the step count adaption
+    HMCStepControl step_control(mc_control.step_control, theHMCTrj.getIntegrator());
+
     XMLWriter& xml_out = TheXMLOutputWriter::Instance();
     XMLWriter& xml_log = TheXMLLogWriter::Instance();
 
@@ -392,6 +416,9 @@ namespace Chroma
       
       // Set the update number
       unsigned long cur_update=mc_control.start_update_num;
+
+      // A restarted run traces the MD energy into a file of its own
+      LCMMDIntegratorSteps::theMDEnergyTrace::Instance().setFirstTrajectory(cur_update+1);
       
       // Compute how many updates to do
       unsigned long total_updates = mc_control.n_warm_up_updates
@@ -432,6 +459,10 @@ namespace Chroma
 	write(xml_out, "WarmUpP", warm_up_p);
 	write(xml_log, "WarmUpP", warm_up_p);
 
+	// Time and outcome of the trajectory, for the step control
+	double trj_seconds = 0;
+	HMCTrjStatus trj_status;
+
 	bool do_reverse = false;
 	if( mc_control.rev_checkP 
 	    && ( cur_update % mc_control.rev_check_frequency == 0 )) {
@@ -461,6 +492,8 @@ namespace Chroma
 	  // This may do a reversibility check 
 	  theHMCTrj( gauge_state, warm_up_p, do_reverse ); 
 	  swatch.stop(); 
+	  trj_seconds = swatch.getTimeInSeconds();
+	  trj_status = theHMCTrj.getLastTrajectory();
 	  
 	  QDPIO::cout << "After HMC trajectory call: time= "
 		      << swatch.getTimeInSeconds() 
@@ -534,6 +567,8 @@ namespace Chroma
 	  swatch.start();
 	  theHMCTrj( gauge_state, warm_up_p, do_reverse  );
 	  swatch.stop();
+	  trj_seconds = swatch.getTimeInSeconds();
+	  trj_status = theHMCTrj.getLastTrajectory();
 	
 	  QDPIO::cout << "After HMC trajectory call: time= "
 		      << swatch.getTimeInSeconds() 
@@ -543,6 +578,11 @@ namespace Chroma
 	  write(xml_log, "seconds_for_trajectory", swatch.getTimeInSeconds());
 
 	}
+
+	// Any change of the step count takes effect from the next trajectory
+	step_control.update(trj_status, theHMCTrj.getIntegrator().getTrajLength(), trj_seconds);
+	mc_control.step_control = step_control.getParams();
+
 	swatch.reset();
 	swatch.start();
 
@@ -609,6 +649,9 @@ namespace Chroma
 	  }
 	  pop(xml_out); // pop("InlineObservables");
 
+	  // Return the displaced propagators shared by the measurements
+	  TheDispPropCache::Instance().clear();
+
 	  // Reset the default gauge field
 	  QDPIO::cout << "HMC: final resetting default gauge field" << std::endl;
 	  InlineDefaultGaugeField::reset();
@@ -731,6 +774,9 @@ int main(int argc, char *argv[])
     QDP_abort(1);
   }
 
+  if (mc_control.clover_cache_entries >= 0)
+    TheCloverTermCache::Instance().setMaxEntries(mc_control.clover_cache_entries);
+
   if (mc_control.start_update_num >= mc_control.n_production_updates)
   {
     QDPIO::cout << "hmc: run is finished" << std::endl;
@@ -0,0 +1,243 @@
+// Test and micro-benchmark of the fused BiCGStab BLAS kernels.
+// Checks every ord_* kernel of each instruction set available on this
+// machine against the base kernels of the build (the generic ones, or SSE
+// if configured), then reports its memory bandwidth.
+
+#include <iostream>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+#include "chroma.h"
+#include "chroma_config.h"
+#include "actions/ferm/invert/bicgstab_kernels.h"
+
+using namespace Chroma;
+using namespace Chroma::BiCGStabKernels;
+
+
+#ifdef BUILD_SCALARSITE_BICGSTAB
+namespace
+{
+  //! Print the bandwidth of one kernel
+  /*!
+   * \param name     kernel name
+   * \param fields   number of fermion fields read plus written
+   * \param bytes    bytes per real
+   * \param iter     number of applications
+   * \param secs     time for all applications
+   */
+  void report(const std::string& name, int fields, int bytes, int iter, double secs)
+  {
+    double vol = Layout::vol() / 2;
+    double gb = double(fields) * double(bytes) * double(4*3*2) * vol * double(iter) / 1.0e9;
+
+    QDPIO::cout << "  " << name << ":  " << 1.0e6*secs/double(iter) << " usec/call,  "
+		<< gb/secs << " GB/s" << std::endl;
+  }
+
+
+  //! Relative difference of two fields
+  template<typename T>
+  double relDiff(const T& a, const T& b)
+  {
+    double na = toDouble(norm2(a));
+    double nd = toDouble(norm2(a - b));
+    return (na > 0) ? sqrt(nd/na) : sqrt(nd);
+  }
+
+  //! Relative difference of two numbers
+  double relDiff(const Double& a, const Double& b)
+  {
+    double da = toDouble(a);
+    double dd = fabs(da - toDouble(b));
+    return (fabs(da) > 1) ? dd/fabs(da) : dd;
+  }
+
+  //! Relative difference of two complex numbers
+  double relDiff(const DComplex& a, const DComplex& b)
+  {
+    DComplex c = a - b;
+    double da = sqrt(toDouble(real(a)*real(a) + imag(a)*imag(a)));
+    double dd = sqrt(toDouble(real(c)*real(c) + imag(c)*imag(c)));
+    return (da > 1) ? dd/da : dd;
+  }
+
+
+  //! All fields and results the kernels read or write
+  struct KernelState
+  {
+    LatticeDiracFermionF xf, yf, zf;
+    LatticeDiracFermionD xd, yd, zd;
+    LatticeDiracFermionF3 rf, uf, vf, qf, r0f, f0f, sf, tf;
+    LatticeDiracFermionD3 rd, ud, vd, qd, r0d, f0d, sd, td;
+
+    Double norm, kappa, rnorm;
+    DComplex cdot, phi, pi, gamma, eta, theta;
+
+    //! Largest relative difference to another state
+    double diff(const KernelState& b) const
+    {
+      double d = 0;
+#define KERNEL_DIFF(v) d = std::max(d, relDiff(v, b.v))
+      KERNEL_DIFF(xf); KERNEL_DIFF(yf); KERNEL_DIFF(zf);
+      KERNEL_DIFF(xd); KERNEL_DIFF(yd); KERNEL_DIFF(zd);
+      KERNEL_DIFF(rf); KERNEL_DIFF(uf); KERNEL_DIFF(vf); KERNEL_DIFF(qf);
+      KERNEL_DIFF(r0f); KERNEL_DIFF(f0f); KERNEL_DIFF(sf); KERNEL_DIFF(tf);
+      KERNEL_DIFF(rd); KERNEL_DIFF(ud); KERNEL_DIFF(vd); KERNEL_DIFF(qd);
+      KERNEL_DIFF(r0d); KERNEL_DIFF(f0d); KERNEL_DIFF(sd); KERNEL_DIFF(td);
+      KERNEL_DIFF(norm); KERNEL_DIFF(kappa); KERNEL_DIFF(rnorm);
+      KERNEL_DIFF(cdot); KERNEL_DIFF(phi); KERNEL_DIFF(pi);
+      KERNEL_DIFF(gamma); KERNEL_DIFF(eta); KERNEL_DIFF(theta);
+#undef KERNEL_DIFF
+      return d;
+    }
+  };
+}
+#endif
+
+
+int main(int argc, char **argv)
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {8,8,8,16};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+#ifdef BUILD_SCALARSITE_BICGSTAB
+  initKernels();
+
+  const Subset& s = rb[0];
+  const int iter = 200;
+
+  // The inputs of every kernel call of the checks
+  KernelState init;
+  gaussian(init.xf); gaussian(init.yf); gaussian(init.zf);
+  gaussian(init.xd); gaussian(init.yd); gaussian(init.zd);
+  gaussian(init.rf); gaussian(init.uf); gaussian(init.vf); gaussian(init.qf);
+  gaussian(init.r0f); gaussian(init.f0f); gaussian(init.sf); gaussian(init.tf);
+  gaussian(init.rd); gaussian(init.ud); gaussian(init.vd); gaussian(init.qd);
+  gaussian(init.r0d); gaussian(init.f0d); gaussian(init.sd); gaussian(init.td);
+  init.norm = init.kappa = init.rnorm = zero;
+  init.cdot = init.phi = init.pi = init.gamma = init.eta = init.theta = zero;
+
+  KernelState st = init;
+  LatticeDiracFermionF& xf = st.xf;  LatticeDiracFermionF& yf = st.yf;  LatticeDiracFermionF& zf = st.zf;
+  LatticeDiracFermionD& xd = st.xd;  LatticeDiracFermionD& yd = st.yd;  LatticeDiracFermionD& zd = st.zd;
+  LatticeDiracFermionF3& rf = st.rf;  LatticeDiracFermionF3& uf = st.uf;  LatticeDiracFermionF3& vf = st.vf;
+  LatticeDiracFermionF3& qf = st.qf;  LatticeDiracFermionF3& r0f = st.r0f;  LatticeDiracFermionF3& f0f = st.f0f;
+  LatticeDiracFermionF3& sf = st.sf;  LatticeDiracFermionF3& tf = st.tf;
+  LatticeDiracFermionD3& rd = st.rd;  LatticeDiracFermionD3& ud = st.ud;  LatticeDiracFermionD3& vd = st.vd;
+  LatticeDiracFermionD3& qd = st.qd;  LatticeDiracFermionD3& r0d = st.r0d;  LatticeDiracFermionD3& f0d = st.f0d;
+  LatticeDiracFermionD3& sd = st.sd;  LatticeDiracFermionD3& td = st.td;
+
+  // Keep the iterates bounded: |a|,|b| < 1
+  ComplexF af = cmplx(RealF(0.3), RealF(-0.2));
+  ComplexF bf = cmplx(RealF(-0.1), RealF(0.25));
+  ComplexD ad = cmplx(RealD(0.3), RealD(-0.2));
+  ComplexD bd = cmplx(RealD(-0.1), RealD(0.25));
+
+  Double& norm = st.norm;  Double& kappa = st.kappa;  Double& rnorm = st.rnorm;
+  DComplex& cdot = st.cdot;  DComplex& phi = st.phi;  DComplex& pi = st.pi;
+  DComplex& gamma = st.gamma;  DComplex& eta = st.eta;  DComplex& theta = st.theta;
+
+  //
+  // Check the vector kernels against the base ones, from the same inputs.
+  // Single precision kernels may differ at round-off from FMA and the
+  // order of the sums
+  //
+  int nfail = 0;
+
+  for(int isa = KERNEL_ISA_BASE+1; isa <= getMaxKernelISA(); ++isa)
+  {
+    QDPIO::cout << "Check kernels: " << kernelISAName(KernelISA(isa)) << std::endl;
+
+#define CHECK_KERNEL(name, tol, call)					\
+    {									\
+      setKernelISA(KERNEL_ISA_BASE);					\
+      st = init;							\
+      call;								\
+      KernelState ref = st;						\
+      setKernelISA(KernelISA(isa));					\
+      st = init;							\
+      call;								\
+      double d = ref.diff(st);						\
+      bool ok = (d <= tol);						\
+      if (! ok) ++nfail;						\
+      QDPIO::cout << "  " << name << ":  rel. diff = " << d		\
+		  << (ok ? "  OK" : "  FAILED") << std::endl;		\
+    }
+
+    CHECK_KERNEL("xymz_normx          ", 1.0e-12, xymz_normx(xd, yd, zd, norm, s));
+    CHECK_KERNEL("yxpaymabz           ", 1.0e-5,  yxpaymabz(xf, yf, zf, af, bf, s));
+    CHECK_KERNEL("norm2x_cdotxy       ", 1.0e-5,  norm2x_cdotxy(xf, yf, norm, cdot, s));
+    CHECK_KERNEL("xpaypbz             ", 1.0e-5,  xpaypbz(xf, yf, zf, af, bf, s));
+    CHECK_KERNEL("xmay_normx_cdotzx   ", 1.0e-5,  xmay_normx_cdotzx(xf, yf, zf, af, norm, cdot, s));
+    CHECK_KERNEL("cxmay               ", 1.0e-5,  cxmay(xf, yf, af, s));
+    CHECK_KERNEL("ib_zvupdates (F)    ", 1.0e-5,  ibicgstab_zvupdates(rf, zf, vf, uf, qf, ad, bd, ad, bd, ad, s));
+    CHECK_KERNEL("ib_zvupdates (D)    ", 1.0e-12, ibicgstab_zvupdates(rd, zd, vd, ud, qd, ad, bd, ad, bd, ad, s));
+    CHECK_KERNEL("ib_rxupdate (F)     ", 1.0e-5,  ibicgstab_rxupdate(ad, sf, tf, zf, rf, xf, s));
+    CHECK_KERNEL("ib_rxupdate (D)     ", 1.0e-12, ibicgstab_rxupdate(ad, sd, td, zd, rd, xd, s));
+    CHECK_KERNEL("ib_stupdates (F)    ", 1.0e-5,  ibicgstab_stupdates_reduces(ad, rf, uf, vf, qf, r0f, f0f, sf, tf,
+									   phi, pi, gamma, eta, theta, kappa, rnorm, s));
+    CHECK_KERNEL("ib_stupdates (D)    ", 1.0e-12, ibicgstab_stupdates_reduces(ad, rd, ud, vd, qd, r0d, f0d, sd, td,
+									   phi, pi, gamma, eta, theta, kappa, rnorm, s));
+#undef CHECK_KERNEL
+  }
+
+  if (nfail > 0)
+  {
+    QDPIO::cerr << "t_bicgstab_kernels: " << nfail << " kernels differ from the base kernels" << std::endl;
+    QDP_abort(1);
+  }
+
+  //
+  // Timings
+  //
+  st = init;
+
+  for(int isa = KERNEL_ISA_BASE; isa <= getMaxKernelISA(); ++isa)
+  {
+    setKernelISA(KernelISA(isa));
+    QDPIO::cout << "Kernels: " << kernelISAName(getKernelISA()) << std::endl;
+
+    StopWatch swatch;
+
+#define TIME_KERNEL(name, fields, bytes, call)	\
+    swatch.reset(); swatch.start();		\
+    for(int i=0; i < iter; ++i) { call; }	\
+    swatch.stop();				\
+    report(name, fields, bytes, iter, swatch.getTimeInSeconds())
+
+    TIME_KERNEL("xymz_normx          ", 3, 8, xymz_normx(xd, yd, zd, norm, s));
+    TIME_KERNEL("yxpaymabz           ", 4, 4, yxpaymabz(xf, yf, zf, af, bf, s));
+    TIME_KERNEL("norm2x_cdotxy       ", 2, 4, norm2x_cdotxy(xf, yf, norm, cdot, s));
+    TIME_KERNEL("xpaypbz             ", 4, 4, xpaypbz(xf, yf, zf, af, bf, s));
+    TIME_KERNEL("xmay_normx_cdotzx   ", 4, 4, xmay_normx_cdotzx(xf, yf, zf, af, norm, cdot, s));
+    TIME_KERNEL("cxmay               ", 3, 4, cxmay(xf, yf, af, s));
+    TIME_KERNEL("ib_zvupdates (F)    ", 7, 4, ibicgstab_zvupdates(rf, zf, vf, uf, qf, ad, bd, ad, bd, ad, s));
+    TIME_KERNEL("ib_zvupdates (D)    ", 7, 8, ibicgstab_zvupdates(rd, zd, vd, ud, qd, ad, bd, ad, bd, ad, s));
+    TIME_KERNEL("ib_rxupdate (F)     ", 6, 4, ibicgstab_rxupdate(ad, sf, tf, zf, rf, xf, s));
+    TIME_KERNEL("ib_rxupdate (D)     ", 6, 8, ibicgstab_rxupdate(ad, sd, td, zd, rd, xd, s));
+    TIME_KERNEL("ib_stupdates (F)    ", 8, 4, ibicgstab_stupdates_reduces(ad, rf, uf, vf, qf, r0f, f0f, sf, tf,
+									 phi, pi, gamma, eta, theta, kappa, rnorm, s));
+    TIME_KERNEL("ib_stupdates (D)    ", 8, 8, ibicgstab_stupdates_reduces(ad, rd, ud, vd, qd, r0d, f0d, sd, td,
+									 phi, pi, gamma, eta, theta, kappa, rnorm, s));
+#undef TIME_KERNEL
+  }
+
+  finishKernels();
+#else
+  QDPIO::cout << "Scalarsite BiCGStab kernels are not enabled in this build" << std::endl;
+#endif
+
+  // Time to bolt
+  Chroma::finalize();
+
+  exit(0);
+}
@@ -46,6 +46,83 @@ int main(int argc, char *argv[])
   QDPCloverTerm qdp_clov;
   qdp_clov.create(fs, params);
 
+  // The cached clover terms must be the freshly built ones, shared by
+  // another FermState on the same links, and missed on other params
+  {
+    Handle< FermState<T,P,Q> > fs2(new PeriodicFermState<T,P,Q>(u));
+
+    Handle<CloverTerm> clov1, invclov1, clov2, invclov2;
+    TheCloverTermCache::Instance().get(clov1, invclov1, fs, params);
+    TheCloverTermCache::Instance().get(clov2, invclov2, fs2, params);
+
+    CloverTerm fresh, fresh_inv;
+    fresh.create(fs, params);
+    fresh_inv.create(fs, params, fresh);
+    fresh_inv.choles(0);
+
+    LatticeFermion psi, chi1, chi2;
+    gaussian(psi);
+
+    Double diff = zero;
+    for(int cb=0; cb < 2; ++cb)
+    {
+      chi1 = zero; chi2 = zero;
+      clov1->apply(chi1, psi, PLUS, cb);
+      fresh.apply(chi2, psi, PLUS, cb);
+      diff += norm2(chi1 - chi2, rb[cb]);
+
+      chi1 = zero; chi2 = zero;
+      invclov1->apply(chi1, psi, PLUS, cb);
+      fresh_inv.apply(chi2, psi, PLUS, cb);
+      diff += norm2(chi1 - chi2, rb[cb]);
+    }
+    diff /= norm2(psi);
+
+    CloverFermActParams aniso_params = params;
+    aniso_params.anisoParam.anisoP = true;
+    aniso_params.anisoParam.t_dir = Nd-1;
+    aniso_params.anisoParam.xi_0 = Real(2);
+    aniso_params.anisoParam.nu = Real(1);
+
+    Handle<CloverTerm> clov3, invclov3;
+    TheCloverTermCache::Instance().get(clov3, invclov3, fs, aniso_params);
+
+    bool sharedP = (clov1.operator->() == clov2.operator->()) &&
+      (invclov1.operator->() == invclov2.operator->());
+    bool missP = (clov3.operator->() != clov1.operator->());
+
+    QDPIO::cout << "CloverTermCache: |cached - fresh|^2/|psi|^2 = " << diff
+		<< "  shared = " << sharedP << "  aniso missed = " << missP << std::endl;
+
+    if (toDouble(diff) > 1.0e-12 || ! sharedP || ! missP)
+    {
+      QDPIO::cerr << "t_clover: CloverTermCache check failed" << std::endl;
+      QDP_abort(1);
+    }
+
+    // New links replace the entry of the same params
+    multi1d<LatticeColorMatrix> u_new(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+      u_new[mu] = u[mu] * Real(0.5);
+    Handle< FermState<T,P,Q> > fs_new(new PeriodicFermState<T,P,Q>(u_new));
+
+    int n_before = TheCloverTermCache::Instance().size();
+    Handle<CloverTerm> clov4, invclov4;
+    TheCloverTermCache::Instance().get(clov4, invclov4, fs_new, params);
+    int n_after = TheCloverTermCache::Instance().size();
+
+    QDPIO::cout << "CloverTermCache: entries before new links = " << n_before
+		<< "  after = " << n_after << std::endl;
+
+    if (n_before != 2 || n_after != 2 || clov4.operator->() == clov1.operator->())
+    {
+      QDPIO::cerr << "t_clover: CloverTermCache kept superseded links" << std::endl;
+      QDP_abort(1);
+    }
+
+    TheCloverTermCache::Instance().clear();
+  }
+
 
 
   LatticeFermion src, dest1, dest2;
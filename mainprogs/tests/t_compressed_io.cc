@@ -0,0 +1,172 @@
+// Round trip test of the compressed propagator and fermion storage.
+// Checks the per-column error bound of the 16 bit mantissas on fields
+// that fall off over many decades, and that a compressed record written
+// through QIO reads back bit for bit with its record XML, through the
+// same sized read as the QIO_READ_NAMED_OBJECT task.
+
+#include <iostream>
+#include <cstdio>
+
+#include "chroma.h"
+#include "io/compressed_io.h"
+
+using namespace Chroma;
+
+
+#ifndef QDP_IS_QDPJIT
+namespace
+{
+  //! Squared error bound per spinor relative to its norm
+  /*!
+   * Each real is rounded to 1/2 of 1/32767 of the largest modulus of
+   * its spinor, which is at most the norm of the spinor. Some slack is
+   * left for the single precision scale.
+   */
+  Real boundSq()
+  {
+    double q = 0.5 / 32767.0;
+    return Real(1.01 * double(2*Ns*Nc) * q * q);
+  }
+
+  //! Largest excess over the error bound, positive on failure
+  Double excess(const LatticeFermion& orig, const LatticeFermion& copy)
+  {
+    LatticeReal r = localNorm2(orig - copy) - boundSq()*localNorm2(orig);
+    return Double(globalMax(r));
+  }
+
+  //! A gaussian field falling off by 10^-2 per time slice
+  LatticeReal decay()
+  {
+    LatticeReal t = Layout::latticeCoordinate(Nd-1);
+    return exp(Real(-2.0*log(10.0)) * t);
+  }
+}
+#endif
+
+
+int main(int argc, char **argv)
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  XMLFileWriter xml("t_compressed_io.xml");
+  push(xml, "t_compressed_io");
+
+#ifndef QDP_IS_QDPJIT
+  int nfail = 0;
+
+  // Fermion in memory
+  {
+    LatticeFermion psi, psi_d;
+    gaussian(psi);
+    psi *= decay();
+
+    multi1d<LatticeInteger> obj;
+    compress(obj, psi);
+    decompress(psi_d, obj);
+
+    Double ex = excess(psi, psi_d);
+    write(xml, "fermion_excess", ex);
+    QDPIO::cout << "fermion: excess over the error bound = " << ex << std::endl;
+
+    if (toDouble(ex) > 0)
+      ++nfail;
+  }
+
+  // Propagator in memory and through QIO
+  {
+    LatticePropagator prop, prop_d, prop_r;
+    gaussian(prop);
+    prop *= decay();
+
+    multi1d<LatticeInteger> obj;
+    compress(obj, prop);
+    decompress(prop_d, obj);
+
+    Double ex_max = -1;
+    for(int spin_source=0; spin_source < Ns; ++spin_source)
+      for(int color_source=0; color_source < Nc; ++color_source)
+      {
+	LatticeFermion psi, psi_d;
+	PropToFerm(prop, psi, color_source, spin_source);
+	PropToFerm(prop_d, psi_d, color_source, spin_source);
+
+	Double ex = excess(psi, psi_d);
+	if (toBool(ex > ex_max))
+	  ex_max = ex;
+      }
+
+    write(xml, "propagator_excess", ex_max);
+    QDPIO::cout << "propagator: excess over the error bound = " << ex_max << std::endl;
+
+    if (toDouble(ex_max) > 0)
+      ++nfail;
+
+    // Write a record with some record XML of the object
+    const std::string file = "t_compressed_io.lime";
+    {
+      XMLBufferWriter file_xml, record_xml, obj_xml;
+      push(file_xml, "FileXML");
+      pop(file_xml);
+
+      push(obj_xml, "Propagator");
+      write(obj_xml, "marker", 42);
+      pop(obj_xml);
+
+      writeCompressedRecordXML(record_xml, obj_xml, "LatticePropagator");
+
+      QDPFileWriter to(file_xml, file, QDPIO_SINGLEFILE, QDPIO_SERIAL, QDPIO_OPEN);
+      write(to, record_xml, obj);
+      close(to);
+    }
+
+    // Read it back
+    {
+      multi1d<LatticeInteger> obj_r;
+      XMLReader file_xml;
+      XMLBufferWriter obj_xml;
+
+      QDPFileReader from(file_xml, file, QDPIO_SERIAL);
+      readCompressed(from, obj_xml, obj_r, "LatticePropagator");
+      close(from);
+
+      decompress(prop_r, obj_r);
+
+      XMLReader obj_rd(obj_xml);
+      int marker = 0;
+      read(obj_rd, "/Propagator/marker", marker);
+
+      Double diff = norm2(prop_r - prop_d);
+      write(xml, "qio_marker", marker);
+      write(xml, "qio_diff", diff);
+      QDPIO::cout << "QIO round trip: |diff|^2 = " << diff << "  marker = " << marker << std::endl;
+
+      if (toDouble(diff) != 0 || marker != 42)
+	++nfail;
+    }
+  }
+
+  if (nfail > 0)
+  {
+    QDPIO::cerr << "t_compressed_io: " << nfail << " checks failed" << std::endl;
+    QDP_abort(1);
+  }
+#else
+  QDPIO::cout << "t_compressed_io: compressed objects are not available with QDP-JIT" << std::endl;
+#endif
+
+  pop(xml);
+
+  // Time to bolt
+  Chroma::finalize();
+
+  exit(0);
+}
@@ -0,0 +1,200 @@
+// Test of the Wilson dslash force summed over several poles.
+// WilsonDslashBase::derivMultipole and the even-odd clover linop
+// derivEvenOddLinOpMP / derivOddEvenLinOpMP / derivEvenEvenLinOpMP /
+// derivOddOddLinOpMP must equal the sum over the poles of the single
+// pole derivatives, for both isigns and both checkerboards.
+
+#include <iostream>
+#include <cstdio>
+
+#include "chroma.h"
+
+using namespace Chroma;
+
+typedef LatticeFermion T;
+typedef multi1d<LatticeColorMatrix> P;
+typedef multi1d<LatticeColorMatrix> Q;
+
+
+//! Relative difference of two forces
+Double forceDiff(const P& ds_mp, const P& ds_sum)
+{
+  Double diff = zero;
+  Double norm = zero;
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    diff += norm2(ds_mp[mu] - ds_sum[mu]);
+    norm += norm2(ds_sum[mu]);
+  }
+
+  return diff / norm;
+}
+
+
+int main(int argc, char **argv)
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  XMLFileWriter xml("t_deriv_multipole.xml");
+  push(xml, "t_deriv_multipole");
+
+  int nfail = 0;
+  const Double tol = 1.0e-10;
+
+  // Random gauge field
+  multi1d<LatticeColorMatrix> u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  Handle< FermState<T,P,Q> > fs(new PeriodicFermState<T,P,Q>(u));
+
+  // Anisotropic coefficients so the weights are exercised too
+  multi1d<Real> coeffs(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+    coeffs[mu] = Real(1) + Real(0.1)*Real(mu);
+
+  QDPWilsonDslash D(fs, coeffs);
+
+  CloverFermActParams params;
+  params.Mass = Real(0.1);
+  params.clovCoeffR = Real(1.92);
+  params.clovCoeffT = Real(0.57);
+
+  EvenOddPrecCloverLinOp M(fs, params);
+
+  // The pole vectors
+  const int npoles = 5;
+  multi1d<T> chi(npoles), psi(npoles);
+  for(int i=0; i < npoles; ++i)
+  {
+    gaussian(chi[i]);
+    gaussian(psi[i]);
+  }
+
+  push(xml, "Dslash");
+  for(int isign = 1; isign >= -1; isign -= 2)
+  {
+    enum PlusMinus pm = (isign == 1) ? PLUS : MINUS;
+
+    for(int cb=0; cb < 2; ++cb)
+    {
+      P ds_mp, ds_sum, ds_tmp;
+      D.derivMultipole(ds_mp, chi, psi, pm, cb);
+
+      ds_sum.resize(Nd);
+      ds_sum = zero;
+      for(int i=0; i < npoles; ++i)
+      {
+	D.deriv(ds_tmp, chi[i], psi[i], pm, cb);
+	ds_sum += ds_tmp;
+      }
+
+      Double diff = forceDiff(ds_mp, ds_sum);
+
+      push(xml, "elem");
+      write(xml, "isign", isign);
+      write(xml, "cb", cb);
+      write(xml, "diff", diff);
+      pop(xml);
+
+      QDPIO::cout << "Dslash derivMultipole: isign = " << isign << " cb = " << cb
+		  << "  |diff|^2/|ds|^2 = " << diff << std::endl;
+
+      if (toBool(diff > tol))
+	++nfail;
+    }
+
+    // Both checkerboards at once
+    P ds_mp, ds_sum, ds_tmp;
+    D.derivMultipole(ds_mp, chi, psi, pm);
+
+    ds_sum.resize(Nd);
+    ds_sum = zero;
+    for(int i=0; i < npoles; ++i)
+    {
+      D.deriv(ds_tmp, chi[i], psi[i], pm);
+      ds_sum += ds_tmp;
+    }
+
+    Double diff = forceDiff(ds_mp, ds_sum);
+
+    QDPIO::cout << "Dslash derivMultipole: isign = " << isign << " both cb"
+		<< "  |diff|^2/|ds|^2 = " << diff << std::endl;
+
+    if (toBool(diff > tol))
+      ++nfail;
+  }
+  pop(xml);
+
+  push(xml, "EvenOddPrecCloverLinOp");
+  for(int isign = 1; isign >= -1; isign -= 2)
+  {
+    enum PlusMinus pm = (isign == 1) ? PLUS : MINUS;
+
+    for(int block=0; block < 4; ++block)
+    {
+      P ds_mp, ds_sum, ds_tmp;
+
+      switch(block)
+      {
+      case 0: M.derivEvenOddLinOpMP(ds_mp, chi, psi, pm); break;
+      case 1: M.derivOddEvenLinOpMP(ds_mp, chi, psi, pm); break;
+      case 2: M.derivEvenEvenLinOpMP(ds_mp, chi, psi, pm); break;
+      case 3: M.derivOddOddLinOpMP(ds_mp, chi, psi, pm); break;
+      }
+
+      ds_sum.resize(Nd);
+      ds_sum = zero;
+      for(int i=0; i < npoles; ++i)
+      {
+	switch(block)
+	{
+	case 0: M.derivEvenOddLinOp(ds_tmp, chi[i], psi[i], pm); break;
+	case 1: M.derivOddEvenLinOp(ds_tmp, chi[i], psi[i], pm); break;
+	case 2: M.derivEvenEvenLinOp(ds_tmp, chi[i], psi[i], pm); break;
+	case 3: M.derivOddOddLinOp(ds_tmp, chi[i], psi[i], pm); break;
+	}
+	ds_sum += ds_tmp;
+      }
+
+      Double diff = forceDiff(ds_mp, ds_sum);
+
+      push(xml, "elem");
+      write(xml, "isign", isign);
+      write(xml, "block", block);
+      write(xml, "diff", diff);
+      pop(xml);
+
+      QDPIO::cout << "EvenOddPrecCloverLinOp MP: isign = " << isign << " block = " << block
+		  << "  |diff|^2/|ds|^2 = " << diff << std::endl;
+
+      if (toBool(diff > tol))
+	++nfail;
+    }
+  }
+  pop(xml);
+
+  if (nfail > 0)
+  {
+    QDPIO::cerr << "t_deriv_multipole: " << nfail << " checks failed" << std::endl;
+    QDP_abort(1);
+  }
+
+  pop(xml);
+
+  // Time to bolt
+  Chroma::finalize();
+
+  exit(0);
+}
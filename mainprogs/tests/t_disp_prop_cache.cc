@@ -0,0 +1,153 @@
+// Test of the cache of derivative-displaced propagators.
+// Two operators on the same propagator sharing their nabla paths, D_x
+// and B_x, applied from two tasks with the same key build the paths
+// only once and agree with the uncached displacements. The key changes
+// with the smearing and when the named propagator is recreated.
+
+#include <iostream>
+#include <cstdio>
+
+#include "chroma.h"
+#include "meas/inline/io/named_objmap.h"
+
+using namespace Chroma;
+
+
+int main(int argc, char **argv)
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  XMLFileWriter xml("t_disp_prop_cache.xml");
+  push(xml, "t_disp_prop_cache");
+
+  int nfail = 0;
+
+  // Named gauge field and propagator
+  const std::string gauge_id = "t_disp_prop_cache_gauge";
+  const std::string prop_id  = "t_disp_prop_cache_prop";
+
+  TheNamedObjMap::Instance().create< multi1d<LatticeColorMatrix> >(gauge_id);
+  multi1d<LatticeColorMatrix>& u =
+    TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(gauge_id);
+  u.resize(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  TheNamedObjMap::Instance().create<LatticePropagator>(prop_id);
+  LatticePropagator& prop = TheNamedObjMap::Instance().getData<LatticePropagator>(prop_id);
+  gaussian(prop);
+
+  // Sinks differing only in their displacement share a key
+  const std::string smear_xml = "<SmearingParam><wvf_param>2.0</wvf_param></SmearingParam>";
+  const std::string sink_d = smear_xml + "<Displacement><DisplacementType>D-DISPLACEMENT</DisplacementType></Displacement>";
+  const std::string sink_b = smear_xml + "<Displacement><DisplacementType>B-DISPLACEMENT</DisplacementType></Displacement>";
+  const std::string sink_o = "<SmearingParam><wvf_param>3.0</wvf_param></SmearingParam>";
+
+  std::string key_d = dispPropSourceKey(prop_id, gauge_id, sink_d);
+  std::string key_b = dispPropSourceKey(prop_id, gauge_id, sink_b);
+  std::string key_o = dispPropSourceKey(prop_id, gauge_id, sink_o);
+
+  QDPIO::cout << "key = " << key_d << std::endl;
+
+  if (key_d != key_b)
+  {
+    QDPIO::cerr << "displacements do not share a key" << std::endl;
+    ++nfail;
+  }
+
+  if (key_d == key_o)
+  {
+    QDPIO::cerr << "different smearings share a key" << std::endl;
+    ++nfail;
+  }
+
+  // Two tasks on the same key
+  DispPropCache& cache = TheDispPropCache::Instance();
+  const int length = 1;
+  LatticePropagator d_cached, b_cached;
+
+  unsigned long builds_start = cache.getBuilds();
+  {
+    DispPropCacheSource disp_source(key_d);
+    d_cached = cache.rightD(prop, u, 0, length);
+  }
+  unsigned long builds_d = cache.getBuilds() - builds_start;
+
+  {
+    DispPropCacheSource disp_source(key_b);
+    b_cached = cache.rightB(prop, u, 0, length);
+  }
+  unsigned long builds_b = cache.getBuilds() - builds_start - builds_d;
+
+  write(xml, "builds_d", builds_d);
+  write(xml, "builds_b", builds_b);
+  QDPIO::cout << "D_x built " << builds_d << " nablas, B_x built " << builds_b << std::endl;
+
+  // D_x builds nabla_y, nabla_z, nabla_z nabla_y and nabla_y nabla_z; B_x reuses them
+  if (builds_d != 4 || builds_b != 0)
+  {
+    QDPIO::cerr << "shared paths were rebuilt" << std::endl;
+    ++nfail;
+  }
+
+  // Outside of a task nothing is cached
+  cache.rightD(prop, u, 0, length);
+  if (cache.getBuilds() != builds_start + builds_d)
+  {
+    QDPIO::cerr << "displacement outside of a task used the cache" << std::endl;
+    ++nfail;
+  }
+
+  Double diff_d = norm2(d_cached - Chroma::rightD(prop, u, 0, length));
+  Double diff_b = norm2(b_cached - Chroma::rightB(prop, u, 0, length));
+  Double norm_d = norm2(d_cached);
+  Double norm_b = norm2(b_cached);
+
+  write(xml, "diff_d", diff_d);
+  write(xml, "diff_b", diff_b);
+  QDPIO::cout << "|D_x diff|^2 = " << diff_d << "  |B_x diff|^2 = " << diff_b << std::endl;
+
+  if (toDouble(diff_d) > 1.0e-10*toDouble(norm_d) || toDouble(diff_b) > 1.0e-10*toDouble(norm_b))
+  {
+    QDPIO::cerr << "cached displacements differ from the uncached ones" << std::endl;
+    ++nfail;
+  }
+
+  // A recreated propagator gets a new key
+  TheNamedObjMap::Instance().erase(prop_id);
+  TheNamedObjMap::Instance().create<LatticePropagator>(prop_id);
+
+  if (dispPropSourceKey(prop_id, gauge_id, sink_d) == key_d)
+  {
+    QDPIO::cerr << "recreated propagator keeps its key" << std::endl;
+    ++nfail;
+  }
+
+  cache.clear();
+  TheNamedObjMap::Instance().erase(prop_id);
+  TheNamedObjMap::Instance().erase(gauge_id);
+
+  if (nfail > 0)
+  {
+    QDPIO::cerr << "t_disp_prop_cache: " << nfail << " checks failed" << std::endl;
+    QDP_abort(1);
+  }
+
+  pop(xml);
+
+  // Time to bolt
+  Chroma::finalize();
+
+  exit(0);
+}
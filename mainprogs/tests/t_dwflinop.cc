@@ -53,6 +53,107 @@ void readSzinFerm(multi1d<LatticeFermion>& q, const std::string& file)
 }
 
 
+//! Relative difference of two 5D fields on a subset
+Double relDiff(const multi1d<LatticeFermion>& a, const multi1d<LatticeFermion>& b,
+	       const Subset& s)
+{
+  Double nd = zero;
+  Double nb = zero;
+  for(int m=0; m < a.size(); ++m)
+  {
+    nd += norm2(a[m] - b[m], s);
+    nb += norm2(b[m], s);
+  }
+
+  return sqrt(nd / nb);
+}
+
+
+//! Check an even-odd preconditioned array operator
+/*!
+ * The fused operator() is compared with the composition of the blocks,
+ * and both with the unpreconditioned operator, which does not use the
+ * fifth dimension kernels: with  x_o = psi_o  and  x_e = -A_ee^{-1} D_eo psi_o
+ * the even sites of  M x  vanish and the odd sites are  M_prec psi.
+ *
+ * \return number of failed checks
+ */
+int checkEOPrec(XMLWriter& xml, const std::string& name,
+		const EvenOddPrecLinearOperatorArray<LatticeFermion,
+		multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> >& A,
+		const LinearOperatorArray<LatticeFermion>& M,
+		const multi1d<LatticeFermion>& psi)
+{
+  const int N5 = A.size();
+  const double tol = (sizeof(REAL) == sizeof(float)) ? 1.0e-5 : 1.0e-10;
+  int nfail = 0;
+
+  push(xml, name);
+
+  for(int is=0; is < 2; ++is)
+  {
+    enum PlusMinus isign = (is == 0) ? PLUS : MINUS;
+
+    // Fused operator
+    multi1d<LatticeFermion> chi(N5);
+    A(chi, psi, isign);
+
+    // Composition of the blocks
+    multi1d<LatticeFermion> tmp1(N5), tmp2(N5), ref(N5);
+    A.evenOddLinOp(tmp1, psi, isign);
+    A.evenEvenInvLinOp(tmp2, tmp1, isign);
+    A.oddEvenLinOp(tmp1, tmp2, isign);
+    A.oddOddLinOp(ref, psi, isign);
+    for(int m=0; m < N5; ++m)
+      ref[m][rb[1]] -= tmp1[m];
+
+    // Unpreconditioned operator on the Schur vector
+    multi1d<LatticeFermion> x(N5), Mx(N5);
+    A.evenOddLinOp(tmp1, psi, isign);
+    A.evenEvenInvLinOp(tmp2, tmp1, isign);
+    for(int m=0; m < N5; ++m)
+    {
+      x[m][rb[0]] = -tmp2[m];
+      x[m][rb[1]] = psi[m];
+    }
+    M(Mx, x, isign);
+
+    Double d_blocks = relDiff(chi, ref, rb[1]);
+    Double d_unprec = relDiff(chi, Mx, rb[1]);
+
+    // The even sites of M x relative to the source
+    Double ne = zero;
+    Double np = zero;
+    for(int m=0; m < N5; ++m)
+    {
+      ne += norm2(Mx[m], rb[0]);
+      np += norm2(psi[m], rb[1]);
+    }
+    Double d_even = sqrt(ne / np);
+
+    push(xml, (isign == PLUS) ? "PLUS" : "MINUS");
+    write(xml, "fused_vs_blocks", d_blocks);
+    write(xml, "fused_vs_unprec", d_unprec);
+    write(xml, "unprec_even", d_even);
+    pop(xml);
+
+    QDPIO::cout << name << ((isign == PLUS) ? " PLUS" : " MINUS")
+		<< ": fused vs blocks = " << d_blocks
+		<< "  fused vs unprec = " << d_unprec
+		<< "  unprec even sites = " << d_even << std::endl;
+
+    if (toDouble(d_blocks) > tol || toDouble(d_unprec) > tol || toDouble(d_even) > tol)
+    {
+      QDPIO::cerr << name << ": mismatch for isign = " << isign << std::endl;
+      ++nfail;
+    }
+  }
+
+  pop(xml);
+
+  return nfail;
+}
+
 
 int main(int argc, char **argv)
 {
@@ -137,6 +238,39 @@ int main(int argc, char **argv)
   write(xml, "nn2", nn2);
   pop(xml);
 
+  // Fused fifth dimension kernels of the even-odd operators
+  {
+    AnisoParam_t aniso;
+    int nfail = 0;
+
+    multi1d<LatticeFermion> psi_o(N5);
+    for(int m=0; m < N5; ++m)
+    {
+      psi_o[m] = zero;
+      psi_o[m][rb[1]] = psi[m];
+    }
+
+    EvenOddPrecDWLinOpArray A_dwf(state, WilsonMass, m_q, N5, aniso);
+    UnprecDWLinOpArray      M_dwf(state, WilsonMass, m_q, N5, aniso);
+    nfail += checkEOPrec(xml, "eoprec_dwf", A_dwf, M_dwf, psi_o);
+
+    Real b5 = 1.5;
+    Real c5 = 0.5;
+    multi1d<Real> b5_arr(N5), c5_arr(N5);
+    b5_arr = b5;
+    c5_arr = c5;
+
+    EvenOddPrecNEFDWLinOpArray A_nef(state, WilsonMass, b5, c5, m_q, N5);
+    UnprecNEFDWLinOpArray      M_nef(state, WilsonMass, b5_arr, c5_arr, m_q, N5);
+    nfail += checkEOPrec(xml, "eoprec_nef", A_nef, M_nef, psi_o);
+
+    if (nfail > 0)
+    {
+      QDPIO::cerr << "t_dwflinop: " << nfail << " checks of the even-odd operators failed" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
  
 #if 0
   if (N5 != Ls)
@@ -0,0 +1,191 @@
+// Test of the Chebyshev preconditioned CG for M^dag M.
+// The Lanczos bounds of lanczosBoundsMdagM are checked against a power
+// iteration, and InvCG2ChebyPrec against InvCG2 on the same system: both
+// must reach the requested true residual and agree on the solution, also
+// when the lower bound overestimates the spectrum. The iteration counts
+// and global sums of both solvers are printed.
+
+#include <iostream>
+#include <cstdio>
+
+#include "chroma.h"
+#include "actions/ferm/invert/invcg2_cheby_prec.h"
+
+using namespace Chroma;
+
+typedef LatticeFermion T;
+typedef multi1d<LatticeColorMatrix> P;
+typedef multi1d<LatticeColorMatrix> Q;
+
+
+//! Rayleigh quotient of  shift - M^dag M  after n power iterations, shifted back
+Double powerIteration(const LinearOperator<T>& M, const T& start, int n, const Real& shift)
+{
+  const Subset& s = M.subset();
+
+  T v, mv, mmv;
+  v = zero;
+  v[s] = start;
+  v[s] *= Real(1) / sqrt(norm2(v, s));
+
+  Double lambda = zero;
+  for(int k=0; k < n; ++k)
+  {
+    M(mv, v, PLUS);
+    M(mmv, mv, MINUS);
+    mmv[s] = shift*v - mmv;
+
+    lambda = innerProductReal(v, mmv, s);
+    v[s] = mmv * (Real(1) / sqrt(norm2(mmv, s)));
+  }
+
+  return Double(shift) - lambda;
+}
+
+
+//! Relative true residual of  M^dag M psi = chi
+Double trueResid(const LinearOperator<T>& M, const T& chi, const T& psi)
+{
+  const Subset& s = M.subset();
+
+  T mp, mmp;
+  M(mp, psi, PLUS);
+  M(mmp, mp, MINUS);
+
+  return sqrt(norm2(chi - mmp, s) / norm2(chi, s));
+}
+
+
+int main(int argc, char **argv)
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  XMLFileWriter xml("t_invcg2_cheby.xml");
+  push(xml, "t_invcg2_cheby");
+
+  int nfail = 0;
+
+  // Random gauge field
+  multi1d<LatticeColorMatrix> u(Nd);
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    gaussian(u[mu]);
+    reunit(u[mu]);
+  }
+
+  Handle< FermState<T,P,Q> > fs(new PeriodicFermState<T,P,Q>(u));
+  EvenOddPrecWilsonLinOp M(fs, Real(0.1));
+  const Subset& s = M.subset();
+
+  T chi;
+  chi = zero;
+  gaussian(chi, s);
+
+  //
+  // Spectral bounds
+  //
+  const int n_lanczos = 50;
+  Real lambda_min, lambda_max;
+  lanczosBoundsMdagM(M, chi, n_lanczos, lambda_min, lambda_max);
+
+  Double pow_max = powerIteration(M, chi, 500, Real(0));
+  Double pow_min = powerIteration(M, chi, 500, Real(1.01*toDouble(pow_max)));
+
+  push(xml, "Bounds");
+  write(xml, "lambda_min", lambda_min);
+  write(xml, "lambda_max", lambda_max);
+  write(xml, "pow_min", pow_min);
+  write(xml, "pow_max", pow_max);
+  pop(xml);
+
+  QDPIO::cout << "Lanczos bounds = [" << lambda_min << ", " << lambda_max << "]"
+	      << "  power iteration = [" << pow_min << ", " << pow_max << "]" << std::endl;
+
+  // The largest eigenvalue converges in both; the lowest one is only
+  // approached from above, so compare it on the scale of the spectrum
+  double lmin = toDouble(lambda_min);
+  double lmax = toDouble(lambda_max);
+  if (fabs(lmax - toDouble(pow_max)) > 1.0e-2*toDouble(pow_max)
+      || fabs(lmin - toDouble(pow_min)) > 1.0e-2*toDouble(pow_max)
+      || lmin <= 0 || lmin >= lmax)
+  {
+    QDPIO::cerr << "Lanczos bounds disagree with the power iteration" << std::endl;
+    ++nfail;
+  }
+
+  //
+  // Solves
+  //
+  const Real RsdCG = 1.0e-8;
+  const int MaxCG = 2000;
+  const int order = 8;
+
+  T psi_cg;
+  psi_cg = zero;
+  SystemSolverResults_t res_cg = InvCG2(M, chi, psi_cg, RsdCG, MaxCG);
+  Double resid_cg = trueResid(M, chi, psi_cg);
+
+  // The lower bound overestimated five times keeps the preconditioner positive
+  for(int over=1; over <= 5; over += 4)
+  {
+    T psi_cheby;
+    psi_cheby = zero;
+    SystemSolverResults_t res_cheby = InvCG2ChebyPrec(M, chi, psi_cheby,
+						      Real(over)*lambda_min, Real(1.1)*lambda_max, order,
+						      RsdCG, MaxCG);
+
+    Double resid_cheby = trueResid(M, chi, psi_cheby);
+    Double diff = sqrt(norm2(psi_cheby - psi_cg, s) / norm2(psi_cg, s));
+
+    push(xml, "Solve");
+    write(xml, "lambda_min_factor", over);
+    write(xml, "cg_iter", res_cg.n_count);
+    write(xml, "cheby_iter", res_cheby.n_count);
+    write(xml, "cg_global_sums", 2*res_cg.n_count+2);
+    write(xml, "cheby_global_sums", 2*res_cheby.n_count+2);
+    write(xml, "cheby_applications", 2*order*res_cheby.n_count);
+    write(xml, "resid_cg", resid_cg);
+    write(xml, "resid_cheby", resid_cheby);
+    write(xml, "diff", diff);
+    pop(xml);
+
+    QDPIO::cout << "lambda_min x " << over
+		<< ": InvCG2 " << res_cg.n_count << " iterations, "
+		<< "InvCG2ChebyPrec " << res_cheby.n_count << " iterations, "
+		<< "resid = " << resid_cg << " / " << resid_cheby
+		<< "  |psi diff|/|psi| = " << diff << std::endl;
+
+    if (toDouble(resid_cheby) > 10*toDouble(RsdCG) || toDouble(resid_cg) > 10*toDouble(RsdCG))
+    {
+      QDPIO::cerr << "solver missed the residual" << std::endl;
+      ++nfail;
+    }
+
+    if (toDouble(diff) > 1.0e-4)
+    {
+      QDPIO::cerr << "InvCG2ChebyPrec and InvCG2 disagree" << std::endl;
+      ++nfail;
+    }
+  }
+
+  if (nfail > 0)
+  {
+    QDPIO::cerr << "t_invcg2_cheby: " << nfail << " checks failed" << std::endl;
+    QDP_abort(1);
+  }
+
+  pop(xml);
+
+  // Time to bolt
+  Chroma::finalize();
+
+  exit(0);
+}
@@ -3,10 +3,72 @@
 #include <cstdio>
 
 #include "chroma.h"
+#include "actions/ferm/linop/lwldslash_compressed_w.h"
+#include "actions/ferm/linop/lwldslash_overlap_w.h"
 
 
 using namespace Chroma;
 
+typedef LatticeFermion               T;
+typedef multi1d<LatticeColorMatrix>  P;
+typedef multi1d<LatticeColorMatrix>  Q;
+
+
+//! Largest relative difference of two blocks of vectors on a subset
+Double maxRelDiff(const multi1d<LatticeFermion>& a, const multi1d<LatticeFermion>& b,
+		  const Subset& s)
+{
+  Double d = zero;
+  for(int i=0; i < a.size(); ++i)
+  {
+    Double di = sqrt(norm2(a[i] - b[i], s) / norm2(b[i], s));
+    if (toBool(di > d))
+      d = di;
+  }
+
+  return d;
+}
+
+
+//! Compare a multi-RHS linop apply with one apply per vector
+bool checkMultiRHS(const std::string& name, const LinearOperator<LatticeFermion>& M,
+		   const multi1d<LatticeFermion>& psi)
+{
+  bool ok = true;
+
+  for(int isign = 1; isign >= -1; isign -= 2) 
+  {
+    enum PlusMinus pm = (isign == 1 ? PLUS : MINUS);
+
+    multi1d<LatticeFermion> chi, ref(psi.size());
+    M.applyMultiRHS(chi, psi, pm);
+    for(int i=0; i < psi.size(); ++i)
+      M(ref[i], psi[i], pm);
+
+    Double d = maxRelDiff(chi, ref, M.subset());
+    QDPIO::cout << name << " multi-RHS: isign = " << isign << "  rel diff = " << d << std::endl;
+
+    if (toDouble(d) > 1.0e-5)
+      ok = false;
+  }
+
+  return ok;
+}
+
+
+//! Time per lattice point in micro sec of a dslash applied iter times
+template<typename TT, typename PP, typename QQ>
+double timeDslash(const WilsonDslashBase<TT,PP,QQ>& D, const TT& psi, TT& chi, int iter)
+{
+  clock_t myt1 = clock();
+  for(int i=0; i < iter; i++)
+    D.apply(chi, psi, PLUS, 0);
+  clock_t myt2 = clock();
+
+  double mydt = (double)(myt2-myt1)/((double)(CLOCKS_PER_SEC));
+  return 1.0e6*mydt/((double)(iter*(Layout::vol()/2)));
+}
+
 
 int main(int argc, char **argv)
 {
@@ -21,9 +83,11 @@ int main(int argc, char **argv)
   Layout::create();
 
   //! Test out dslash
+  // Start up a weak field, so the clover term below is invertible
+  struct Cfg_t config = { CFG_TYPE_WEAK_FIELD, "dummy" };
   multi1d<LatticeColorMatrix> u(Nd);
-  for(int m=0; m < u.size(); ++m)
-    gaussian(u[m]);
+  XMLReader gauge_file_xml, gauge_xml;
+  gaugeStartup(gauge_file_xml, gauge_xml, u, config);
 
   LatticeFermion psi, chi;
   random(psi);
@@ -36,7 +100,8 @@ int main(int argc, char **argv)
   QDPIO::cout << "Constructing WilsonDslash" << std::endl;
 
   // WilsonDslash class can be optimised
-  WilsonDslash D(u);
+  Handle< FermState<T,P,Q> > state(new PeriodicFermState<T,P,Q>(u));
+  WilsonDslash D(state);
 
   QDPIO::cout << "Done" << std::endl;
 
@@ -68,6 +133,215 @@ int main(int argc, char **argv)
   }
   
 
+  //! Multi-RHS applies against one apply per vector
+  {
+    bool ok = true;
+
+    multi1d<LatticeFermion> psis(3);
+    for(int n=0; n < psis.size(); ++n)
+      gaussian(psis[n]);
+
+    for(isign = 1; isign >= -1; isign -= 2) {
+      for(cb = 0; cb < 2; ++cb) { 
+	enum PlusMinus pm = (isign == 1 ? PLUS : MINUS);
+
+	multi1d<LatticeFermion> chis, ref(psis.size());
+	D.applyMultiRHS(chis, psis, pm, cb);
+	for(int n=0; n < psis.size(); ++n)
+	  D.apply(ref[n], psis[n], pm, cb);
+
+	Double d = maxRelDiff(chis, ref, rb[cb]);
+	QDPIO::cout << "WilsonDslash multi-RHS: cb = " << cb << " isign = " << isign 
+		    << "  rel diff = " << d << std::endl;
+
+	if (toDouble(d) > 1.0e-5)
+	  ok = false;
+      }
+    }
+
+    EvenOddPrecWilsonLinOp M_w(state, Real(0.1));
+    ok &= checkMultiRHS("EvenOddPrecWilsonLinOp", M_w, psis);
+
+    CloverFermActParams cparam;
+    cparam.Mass = Real(0.1);
+    cparam.clovCoeffR = Real(1.92);
+    cparam.clovCoeffT = Real(0.57);
+    EvenOddPrecCloverLinOp M_c(state, cparam);
+    ok &= checkMultiRHS("EvenOddPrecCloverLinOp", M_c, psis);
+
+    if (! ok)
+    {
+      QDPIO::cerr << "t_lwldslash: multi-RHS apply differs" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+
+  //! QDPWilsonDslash on packed links against the QDP expressions of
+  //! QDPWilsonDslashOpt, with anisotropy coefficients
+  {
+    bool ok = true;
+
+    multi1d<Real> coeffs(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+      coeffs[mu] = Real(1.0 + 0.1*mu);
+
+    QDPWilsonDslash D_p(state, coeffs);
+    QDPWilsonDslashOpt D_ref(state, coeffs);
+
+    for(isign = 1; isign >= -1; isign -= 2) {
+      for(cb = 0; cb < 2; ++cb) { 
+	enum PlusMinus pm = (isign == 1 ? PLUS : MINUS);
+
+	LatticeFermion ref;
+	D_ref.apply(ref, psi, pm, cb);
+	D_p.apply(chi, psi, pm, cb);
+
+	Double d = sqrt(norm2(chi - ref, rb[cb]) / norm2(ref, rb[cb]));
+	QDPIO::cout << "QDPWilsonDslash packed links: cb = " << cb << " isign = " << isign 
+		    << "  rel diff = " << d << std::endl;
+
+	if (toDouble(d) > 1.0e-5)
+	  ok = false;
+      }
+    }
+
+    double t_ref = timeDslash(D_ref, psi, chi, iter/10);
+    double t_p   = timeDslash(D_p, psi, chi, iter/10);
+
+    QDPIO::cout << "QDPWilsonDslash packed links: the time per lattice point is " << t_p 
+		<< " micro sec, QDP expressions " << t_ref << " micro sec, speedup = " 
+		<< t_ref/t_p << std::endl;
+
+    if (! ok)
+    {
+      QDPIO::cerr << "t_lwldslash: dslash on packed links differs" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+
+  //! Dslash with the halo exchange overlapped against QDPWilsonDslash.
+  //! Run with a -geom splitting the lattice to exercise the messages
+  {
+    bool ok = true;
+
+    QDPWilsonDslash D_ref(state);
+    QDPWilsonDslashOverlap D_ov(state);
+
+    for(isign = 1; isign >= -1; isign -= 2) {
+      for(cb = 0; cb < 2; ++cb) { 
+	enum PlusMinus pm = (isign == 1 ? PLUS : MINUS);
+
+	LatticeFermion ref;
+	D_ref.apply(ref, psi, pm, cb);
+	D_ov.apply(chi, psi, pm, cb);
+
+	Double d = sqrt(norm2(chi - ref, rb[cb]) / norm2(ref, rb[cb]));
+	QDPIO::cout << "QDPWilsonDslashOverlap: cb = " << cb << " isign = " << isign 
+		    << "  rel diff = " << d << std::endl;
+
+	if (toDouble(d) > 1.0e-5)
+	  ok = false;
+      }
+    }
+
+    double t_ref = timeDslash(D_ref, psi, chi, iter/10);
+    double t_ov  = timeDslash(D_ov, psi, chi, iter/10);
+
+    const DslashCommTimings& t = D_ov.totalTimings();
+    QDPIO::cout << "QDPWilsonDslashOverlap: the time per lattice point is " << t_ov 
+		<< " micro sec, QDPWilsonDslash " << t_ref << " micro sec" << std::endl;
+    QDPIO::cout << "QDPWilsonDslashOverlap: " << t.calls << " calls: compute = " << t.compute 
+		<< " secs  comm = " << t.comm << " secs  wait = " << t.wait << " secs" << std::endl;
+
+    if (! ok)
+    {
+      QDPIO::cerr << "t_lwldslash: overlapped dslash differs" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+
+  //! Compressed link single precision dslash against QDPWilsonDslashF
+  {
+    bool ok = true;
+
+    typedef LatticeFermionF               TF;
+    typedef multi1d<LatticeColorMatrixF>  QF;
+
+    // Random SU(3) links, as 8 numbers cannot keep links close to the unit
+    // matrix, with the last time slice flipped as by antiperiodic BCs
+    multi1d<LatticeColorMatrix> u_hot(Nd);
+    HotSt(u_hot);
+
+    QF u_f(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+      u_f[mu] = u_hot[mu];
+    u_f[Nd-1] = where(Layout::latticeCoordinate(Nd-1) == nrow[Nd-1]-1, -u_f[Nd-1], u_f[Nd-1]);
+
+    Handle< FermState<TF,QF,QF> > state_f(new PeriodicFermState<TF,QF,QF>(u_f));
+
+    AnisoParam_t aniso;
+    QDPWilsonDslashF D_ref(state_f, aniso);
+
+    LatticeFermionF psi_f, chi_f, ref_f;
+    gaussian(psi_f);
+
+    int iter_c = iter / 10;
+
+    double t_ref = timeDslash(D_ref, psi_f, chi_f, iter_c);
+    QDPIO::cout << "QDPWilsonDslashF: the time per lattice point is " << t_ref << " micro sec" 
+		<< " (" <<  (double)(1392.0f/t_ref) << ") Mflops " << std::endl;
+
+    const int recons[] = {18, 12, 8};
+    for(int half=0; half < 2; ++half) {
+      for(int r=0; r < 3; ++r) {
+	WilsonGaugeCompressionParams comp;
+	comp.reconstruct = recons[r];
+	comp.half_precP = (half == 1);
+
+	QDPWilsonDslashCompressedF D_c(state_f, aniso, comp);
+
+	// The 16 bit links keep about 4.5 digits
+	double tol = (comp.half_precP) ? 1.0e-2 : 1.0e-4;
+
+	for(isign = 1; isign >= -1; isign -= 2) {
+	  for(cb = 0; cb < 2; ++cb) { 
+	    enum PlusMinus pm = (isign == 1 ? PLUS : MINUS);
+
+	    D_ref.apply(ref_f, psi_f, pm, cb);
+	    D_c.apply(chi_f, psi_f, pm, cb);
+
+	    Double d = sqrt(norm2(chi_f - ref_f, rb[cb]) / norm2(ref_f, rb[cb]));
+	    QDPIO::cout << "QDPWilsonDslashCompressedF: reconstruct = " << comp.reconstruct
+			<< " half = " << comp.half_precP << " cb = " << cb << " isign = " << isign 
+			<< "  rel diff = " << d << std::endl;
+
+	    if (toDouble(d) > tol)
+	      ok = false;
+	  }
+	}
+
+	double t_c = timeDslash(D_c, psi_f, chi_f, iter_c);
+	QDPIO::cout << "QDPWilsonDslashCompressedF: reconstruct = " << comp.reconstruct
+		    << " half = " << comp.half_precP << ": the time per lattice point is " << t_c 
+		    << " micro sec (" << (double)(1392.0f/t_c) << ") Mflops, speedup = " 
+		    << t_ref/t_c << std::endl;
+      }
+    }
+
+    ThePackedGaugeCacheF::Instance().clear();
+    ThePackedGaugeCacheH::Instance().clear();
+
+    if (! ok)
+    {
+      QDPIO::cerr << "t_lwldslash: compressed link dslash differs" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+
   //! Create and try a more sophisticated operator
   /* Real Kappa = 0.1;
   PreconditionedWilson  M(u,Kappa);
@@ -1,6 +1,8 @@
 
 
 #include "chroma.h"
+#include "actions/ferm/linop/lwldslash_overlap_w.h"
+#include "actions/ferm/linop/lwldslash_array_overlap_w.h"
 
 #include <iostream>
 #include <cstdio>
@@ -526,6 +528,134 @@ int main(int argc, char **argv)
     }
   }
 	  
+
+  // The 5D dslash on packed links against N5 applies of the QDP
+  // expressions of QDPWilsonDslashOpt, the path it used before
+  {
+    push(xml,"Packed_array_test");
+
+    Double max_diff = zero;
+    for(cb = 0; cb < 2; cb++) { 
+      for(isign = 1; isign >= -1; isign -= 2) { 
+	enum PlusMinus pm = (isign > 0 ? PLUS : MINUS);
+
+	D5.apply(chis1, psis, pm, cb);
+
+	Double n5 = zero;
+	Double d5 = zero;
+	for(int i=0; i < N5; i++) {
+	  D.apply(chis2[i], psis[i], pm, cb);
+	  n5 += norm2( chis1[i] - chis2[i], rb[cb] );
+	  d5 += norm2( chis2[i], rb[cb] );
+	}
+	Double r5 = n5 / d5;
+
+	QDPIO::cout << "Packed test: cb = " << cb << " isign = " << isign 
+		    << "  || D5 - D ||^2/|| D ||^2 = " << r5 << std::endl;
+
+	if (toBool(r5 > max_diff)) max_diff = r5;
+      }
+    }
+
+    const int titer = 20;
+    QDP::StopWatch swatch;
+
+    swatch.reset();
+    swatch.start();
+    for(int i=0; i < titer; i++)
+      D5.apply(chis1, psis, PLUS, 0);
+    swatch.stop();
+    double t_p = swatch.getTimeInSeconds();
+
+    swatch.reset();
+    swatch.start();
+    for(int i=0; i < titer; i++)
+      for(int k=0; k < N5; k++)
+	D.apply(chis2[k], psis[k], PLUS, 0);
+    swatch.stop();
+    double t_ref = swatch.getTimeInSeconds();
+
+    QDPInternal::globalSum(t_p);
+    QDPInternal::globalSum(t_ref);
+    t_p   *= 1.0e6 / double(titer*N5*(Layout::sitesOnNode()/2)*Layout::numNodes());
+    t_ref *= 1.0e6 / double(titer*N5*(Layout::sitesOnNode()/2)*Layout::numNodes());
+
+    QDPIO::cout << "QDPWilsonDslashArrayOpt packed links: the time per lattice point is " << t_p
+		<< " micro sec, QDP expressions " << t_ref << " micro sec, speedup = " 
+		<< t_ref/t_p << std::endl;
+
+    write(xml,"max_rel_norm2_diff",max_diff);
+    write(xml,"usec_packed",t_p);
+    write(xml,"usec_qdp",t_ref);
+    pop(xml);
+
+    if (toDouble(max_diff) > 1.0e-10)
+    {
+      QDPIO::cerr << "t_lwldslash_array: the dslash on packed links differs" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
+
+  // The dslashes with the halo exchange overlapped. Run with a -geom
+  // splitting the lattice to exercise the messages
+  {
+    QDPIO::cout << "Constructing QDPWilsonDslashOverlap and QDPWilsonDslashArrayOverlap N5=" << N5 << std::endl;
+    QDPWilsonDslashOverlap D_ov(state);
+    QDPWilsonDslashArrayOverlap D5_ov(state, N5);
+    QDPIO::cout << "Done" << std::endl;
+
+    push(xml,"Overlap_correctness_test");
+
+    Double max_diff = zero;
+    for(cb = 0; cb < 2; cb++) { 
+      for(isign = 1; isign >= -1; isign -= 2) { 
+	enum PlusMinus pm = (isign > 0 ? PLUS : MINUS);
+
+	D.apply(chi, psi, pm, cb);
+	D_ov.apply(chi2, psi, pm, cb);
+	Double r4 = norm2(chi2 - chi, rb[cb]) / norm2(chi, rb[cb]);
+
+	D5.apply(chis1, psis, pm, cb);
+	D5_ov.apply(chis2, psis, pm, cb);
+
+	Double n5 = zero;
+	Double d5 = zero;
+	for(int i=0; i < N5; i++) {
+	  n5 += norm2( chis2[i] - chis1[i], rb[cb] );
+	  d5 += norm2( chis1[i], rb[cb] );
+	}
+	Double r5 = n5 / d5;
+
+	QDPIO::cout << "Overlap test: cb = " << cb << " isign = " << isign 
+		    << "  || D - D_ov ||^2/|| D ||^2 = " << r4 
+		    << "  || D5 - D5_ov ||^2/|| D5 ||^2 = " << r5 << std::endl;
+
+	push(xml,"Overlap_test");
+	write(xml,"isign", isign);
+	write(xml,"cb", cb);
+	write(xml,"rel_norm2_diff",r4);
+	write(xml,"rel_norm2_diff_array",r5);
+	pop(xml);
+
+	if (toBool(r4 > max_diff)) max_diff = r4;
+	if (toBool(r5 > max_diff)) max_diff = r5;
+      }
+    }
+
+    const DslashCommTimings& t = D5_ov.lastTimings();
+    QDPIO::cout << "QDPWilsonDslashArrayOverlap: last call compute = " << t.compute 
+		<< " secs  comm = " << t.comm << " secs  wait = " << t.wait << " secs" << std::endl;
+
+    pop(xml);
+
+    if (toDouble(max_diff) > 1.0e-10)
+    {
+      QDPIO::cerr << "t_lwldslash_array: the overlapped dslash differs" << std::endl;
+      QDP_abort(1);
+    }
+  }
+
   pop(xml);
 
 
@@ -0,0 +1,171 @@
+// Test of the block multishift CG.
+// MInvCG2Block must give the MInvCG2 solutions of each source for every
+// shift. On a pure gauge field a gauge transformed constant source is an
+// eigenvector of M^dag M; it converges in the first step and has to
+// leave the block while the other sources carry on.
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+#include "chroma.h"
+#include "actions/ferm/invert/minvcg2_block.h"
+
+using namespace Chroma;
+
+typedef LatticeFermion T;
+typedef multi1d<LatticeColorMatrix> P;
+typedef multi1d<LatticeColorMatrix> Q;
+
+
+//! Compare the block solve with the one source solves, returns the number of failures
+int checkBlock(XMLWriter& xml, const std::string& name,
+	       const LinearOperator<T>& M, const multi1d<T>& chi,
+	       const multi1d<Real>& shifts, const multi1d<Real>& RsdCG, int MaxCG,
+	       multi1d<int>& n_count)
+{
+  const Subset& s = M.subset();
+  int nfail = 0;
+
+  multi1d< multi1d<T> > psi_block;
+  MInvCG2Block(M, chi, psi_block, shifts, RsdCG, MaxCG, n_count);
+
+  push(xml, name);
+  for(int n=0; n < chi.size(); ++n)
+  {
+    multi1d<T> psi;
+    int n_single;
+    MInvCG2(M, chi[n], psi, shifts, RsdCG, MaxCG, n_single);
+
+    double diff = 0;
+    for(int i=0; i < shifts.size(); ++i)
+      diff = std::max(diff, toDouble(norm2(psi_block[n][i] - psi[i], s) / norm2(psi[i], s)));
+
+    push(xml, "elem");
+    write(xml, "n", n);
+    write(xml, "n_count_block", n_count[n]);
+    write(xml, "n_count_single", n_single);
+    write(xml, "diff", diff);
+    pop(xml);
+
+    QDPIO::cout << name << ": source " << n << "  iterations block = " << n_count[n]
+		<< "  single = " << n_single << "  max |psi diff|^2/|psi|^2 = " << diff << std::endl;
+
+    if (diff > 1.0e-16 || std::abs(n_count[n] - n_single) > 1)
+    {
+      QDPIO::cerr << name << ": source " << n << " differs from MInvCG2" << std::endl;
+      ++nfail;
+    }
+  }
+  pop(xml);
+
+  return nfail;
+}
+
+
+int main(int argc, char **argv)
+{
+  // Put the machine into a known state
+  Chroma::initialize(&argc, &argv);
+
+  // Setup the layout
+  const int foo[] = {4,4,4,8};
+  multi1d<int> nrow(Nd);
+  nrow = foo;  // Use only Nd elements
+  Layout::setLattSize(nrow);
+  Layout::create();
+
+  XMLFileWriter xml("t_minvcg2_block.xml");
+  push(xml, "t_minvcg2_block");
+
+  int nfail = 0;
+
+  // Shifts of a typical rational approximation
+  multi1d<Real> shifts(4);
+  shifts[0] = 0.001;
+  shifts[1] = 0.01;
+  shifts[2] = 0.1;
+  shifts[3] = 1.0;
+
+  multi1d<Real> RsdCG(shifts.size());
+  RsdCG = Real(1.0e-9);
+  const int MaxCG = 2000;
+
+  //
+  // Random gauge field, random sources
+  //
+  {
+    multi1d<LatticeColorMatrix> u(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      gaussian(u[mu]);
+      reunit(u[mu]);
+    }
+
+    Handle< FermState<T,P,Q> > fs(new PeriodicFermState<T,P,Q>(u));
+    EvenOddPrecWilsonLinOp M(fs, Real(0.1));
+
+    multi1d<T> chi(3);
+    for(int n=0; n < chi.size(); ++n)
+    {
+      chi[n] = zero;
+      gaussian(chi[n], M.subset());
+    }
+
+    multi1d<int> n_count;
+    nfail += checkBlock(xml, "Random", M, chi, shifts, RsdCG, MaxCG, n_count);
+  }
+
+  //
+  // Pure gauge field, one source converging early
+  //
+  {
+    LatticeColorMatrix g;
+    gaussian(g);
+    reunit(g);
+
+    multi1d<LatticeColorMatrix> u(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+      u[mu] = g * shift(adj(g), FORWARD, mu);
+
+    Handle< FermState<T,P,Q> > fs(new PeriodicFermState<T,P,Q>(u));
+    EvenOddPrecWilsonLinOp M(fs, Real(0.1));
+
+    // The constant vector is a zero momentum eigenvector of the free operator
+    LatticeColorVector cv = zero;
+    pokeColor(cv, LatticeComplex(1), 0);
+    LatticeFermion c = zero;
+    pokeSpin(c, cv, 0);
+
+    multi1d<T> chi(3);
+    for(int n=0; n < chi.size(); ++n)
+    {
+      chi[n] = zero;
+      gaussian(chi[n], M.subset());
+    }
+    chi[1][M.subset()] = g * c;
+
+    multi1d<int> n_count;
+    nfail += checkBlock(xml, "Early", M, chi, shifts, RsdCG, MaxCG, n_count);
+
+    if (n_count[1] > 2 || n_count[1] >= n_count[0] || n_count[1] >= n_count[2])
+    {
+      QDPIO::cerr << "Early: the eigenvector source did not leave the block early" << std::endl;
+      ++nfail;
+    }
+  }
+
+  if (nfail > 0)
+  {
+    QDPIO::cerr << "t_minvcg2_block: " << nfail << " checks failed" << std::endl;
+    QDP_abort(1);
+  }
+
+  pop(xml);
+
+  // Time to bolt
+  Chroma::finalize();
+
+  exit(0);
+}